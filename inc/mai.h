@@ -0,0 +1,219 @@
+/**
+ * @file    mai.h
+ * @brief   This module defines the Module Abstraction Interface (MAI), between
+ *          the TAI platform adapter and the module adapters, see
+ *          docs/TAI-MAI.md
+ *
+ * @remark  Licensed under the Apache License, Version 2.0 (the "License"); you
+ *          may not use this file except in compliance with the License. You may
+ *          obtain a copy of the License at
+ *          http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * @remark  THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ *          CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ *          LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ *          FOR A PARTICULAR PURPOSE, MERCHANTABILITY OR NON-INFRINGEMENT.
+ *
+ * @remark  See the Apache Version 2.0 License for specific language governing
+ *          permissions and limitations under the License.
+ */
+
+#if !defined (__MAI_H_)
+#define __MAI_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "tai.h"
+
+/**
+ * @defgroup MAI MAI - Module adapter entry points
+ *
+ * A module adapter is a shared library driving one kind of module, loaded by
+ * the platform adapter with dlopen(). It provides the TAI method tables of
+ * tai_api_query() through mai_api_query(), and the platform adapter hands the
+ * calls of the adapter host over to it. The platform adapter calls the method
+ * table functions of a module adapter from a single worker thread of its own,
+ * so a module adapter does not need to be reentrant, while the notifications
+ * of the module adapter go to the adapter host unchanged.
+ *
+ * @{
+ */
+
+/**
+ * @brief Maximum number of module adapters loaded by a platform adapter
+ */
+#define MAI_MAX_ADAPTERS                        8
+
+/**
+ * @brief Bits of the ids reserved for the platform adapter
+ *
+ * Every object id, transaction id, attribute subscription id and asynchronous
+ * request id a module adapter returns must carry the id prefix given in
+ * #mai_service_method_table_t in these bits. The prefix is the index of the
+ * module adapter plus one, so the platform adapter finds the owner of an id
+ * with a shift and no lookup, and ids of different module adapters never
+ * collide.
+ */
+#define MAI_ID_PREFIX_SHIFT                     48
+#define MAI_ID_PREFIX_MASK                      (0xffULL << MAI_ID_PREFIX_SHIFT)
+
+/**
+ * @brief The index of the module adapter owning an id, MAI_MAX_ADAPTERS or
+ *        more if the id has no valid prefix
+ */
+#define MAI_ID_ADAPTER(id)                      \
+    ((uint32_t)(((id) & MAI_ID_PREFIX_MASK) >> MAI_ID_PREFIX_SHIFT) - 1)
+
+/**
+ * @brief Module presence notification of a module adapter, see
+ *        #tai_module_presence_event_fn
+ *
+ * @param[in] context The context of #mai_service_method_table_t
+ * @param[in] present true if the module was inserted, false if it was removed
+ * @param[in] module_location The location of the module
+ */
+typedef void (*mai_module_presence_event_fn)(
+        _In_ void *context,
+        _In_ bool present,
+        _In_ char *module_location);
+
+/**
+ * @brief Batched module presence notification of a module adapter, see
+ *        #tai_module_presence_batch_fn
+ *
+ * @param[in] context The context of #mai_service_method_table_t
+ * @param[in] count Number of events
+ * @param[in] events The events, valid only during the call
+ */
+typedef void (*mai_module_presence_batch_fn)(
+        _In_ void *context,
+        _In_ uint32_t count,
+        _In_ const tai_module_presence_event_t *events);
+
+/**
+ * @brief Method table of the services exposed by the platform adapter for a
+ * module adapter, and the namespace the module adapter is given
+ */
+typedef struct _mai_service_method_table_t
+{
+    /**
+     * @brief Opaque pointer passed back to the notifications
+     */
+    void                           *context;
+
+    /**
+     * @brief Notification of module insertion/removal
+     */
+    mai_module_presence_event_fn    module_presence;
+
+    /**
+     * @brief Batched notification of module insertion/removal. Optional, NULL
+     *        if unused. When it is set the module adapter calls it instead of
+     *        module_presence.
+     */
+    mai_module_presence_batch_fn    module_presence_batch;
+
+    /**
+     * @brief The id prefix, to be set in every id, see #MAI_ID_PREFIX_MASK
+     */
+    uint64_t                        id_prefix;
+
+    /**
+     * @brief The platform slots of the module adapter start after this one.
+     *        A module adapter reporting its modules at decimal locations
+     *        numbers them from location_base + 1.
+     */
+    uint32_t                        location_base;
+
+} mai_service_method_table_t;
+
+/**
+ * @brief Module adapter initialization call
+ *
+ * @param[in] flags Bitmap of TAI_API_INITIALIZE_FLAG_xxx, other bits must be
+ *                  zero
+ * @param[in] services Methods table with services provided by the platform
+ *                  adapter
+ *
+ * @return #TAI_STATUS_SUCCESS on success, failure status code on error
+ */
+tai_status_t mai_api_initialize(
+        _In_ uint64_t flags,
+        _In_ const mai_service_method_table_t *services);
+
+/**
+ * @brief Retrieve the method table of a TAI API of the module adapter, see
+ *        tai_api_query()
+ *
+ * @param[in] tai_api_id The API ID whose method table is being retrieved.
+ * @param[out] api_method_table The method table, valid until
+ *        mai_api_uninitialize() is called
+ *
+ * @return #TAI_STATUS_SUCCESS on success, failure status code on error
+ */
+tai_status_t mai_api_query(
+        _In_ tai_api_t tai_api_id,
+        _Out_ void** api_method_table);
+
+/**
+ * @brief Uninitialize the module adapter, see tai_api_uninitialize()
+ *
+ * @return #TAI_STATUS_SUCCESS on success, failure status code on error
+ */
+tai_status_t mai_api_uninitialize(void);
+
+/**
+ * @brief Set the log level of the module adapter, see tai_log_set()
+ *
+ * @param[in] tai_api_id The API ID whose logging level is being set
+ * @param[in] log_level Log level
+ *
+ * @return #TAI_STATUS_SUCCESS on success, failure status code on error
+ */
+tai_status_t mai_log_set(
+        _In_ tai_api_t tai_api_id,
+        _In_ tai_log_level_t log_level);
+
+/**
+ * @brief Query the type of an object of the module adapter, see
+ *        tai_object_type_query(). May be called from any thread.
+ *
+ * @param[in] tai_object_id Object id
+ *
+ * @return #TAI_OBJECT_TYPE_NULL when tai_object_id is not valid
+ */
+tai_object_type_t mai_object_type_query(
+        _In_ tai_object_id_t tai_object_id);
+
+/**
+ * @brief Query the module of an object of the module adapter, see
+ *        tai_module_id_query(). May be called from any thread.
+ *
+ * @param[in] tai_object_id Object id
+ *
+ * @return #TAI_NULL_OBJECT_ID when tai_object_id is not valid
+ */
+tai_object_id_t mai_module_id_query(
+        _In_ tai_object_id_t tai_object_id);
+
+/**
+ * @brief Generate the dump file of the module adapter, see
+ *        tai_dbg_generate_dump()
+ *
+ * @param[in] dump_file_name Full path for dump file
+ *
+ * @return #TAI_STATUS_SUCCESS on success, failure status code on error
+ */
+tai_status_t mai_dbg_generate_dump(
+        _In_ const char *dump_file_name);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+#endif /** __MAI_H_ */
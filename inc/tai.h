@@ -91,6 +91,29 @@ typedef void (*tai_module_presence_event_fn)(
         _In_ bool present,
         _In_ char * module_location);
 
+/**
+ * @brief A module presence change, see #tai_module_presence_event_fn
+ */
+typedef struct _tai_module_presence_event_t
+{
+    bool present;
+    char *module_location;
+} tai_module_presence_event_t;
+
+/**
+ * @brief Batched variant of #tai_module_presence_event_fn. The adapter reports
+ *        the presence changes it has detected together, in the order they
+ *        happened, so that the adapter host handles a burst of changes (e.g. at
+ *        boot or when several modules are swapped) with a single wakeup. The
+ *        same context restrictions as #tai_module_presence_event_fn apply.
+ *
+ * @param[in] count Number of events
+ * @param[in] events The events, valid only during the call
+ */
+typedef void (*tai_module_presence_batch_fn)(
+        _In_ uint32_t count,
+        _In_ const tai_module_presence_event_t *events);
+
 /**
  * @brief Method table that contains function pointers for services exposed by
  * the adapter host for the adapter. This is currently a single service: module
@@ -103,8 +126,30 @@ typedef struct _tai_service_method_table_t
      */
     tai_module_presence_event_fn    module_presence;
 
+    /**
+     * @brief Batched notification of module insertion/removal. Optional, set
+     *        it to NULL if unused. When it is set the adapter calls it
+     *        instead of module_presence.
+     */
+    tai_module_presence_batch_fn    module_presence_batch;
+
 } tai_service_method_table_t;
 
+/**
+ * @brief Warm start flag of tai_api_initialize()
+ *
+ * The adapter restores the objects it had before the adapter host restarted
+ * (and, if it keeps one, its attribute cache) from a snapshot it persisted,
+ * instead of enumerating the hardware first. The restored modules are
+ * announced through module presence right away; creating them, and their
+ * host and network interfaces, with the same location and indexes returns the
+ * ids they had before the restart. The adapter then reconciles the restored
+ * objects with the hardware in the background, announcing the modules which
+ * appeared or disappeared meanwhile. Without a usable snapshot the adapter
+ * starts cold.
+ */
+#define TAI_API_INITIALIZE_FLAG_WARM_START      0x1
+
 /**
  * @brief Adapter module initialization call
  *
@@ -112,7 +157,8 @@ typedef struct _tai_service_method_table_t
  * initialize any data/control structures that may be necessary during
  * subsequent TAI operations.
  *
- * @param[in] flags Reserved for future use, must be zero
+ * @param[in] flags Bitmap of TAI_API_INITIALIZE_FLAG_xxx, other bits must be
+ *                  zero
  * @param[in] services Methods table with services provided by adapter host
  *
  * @return #TAI_STATUS_SUCCESS on success, failure status code on error
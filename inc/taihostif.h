@@ -198,17 +198,205 @@ typedef tai_status_t (*tai_get_host_interface_attributes_fn)(
         _In_ uint32_t attr_count,
         _Inout_ tai_attribute_t *attr_list);
 
+/**
+ * @brief Bulk host interface creation
+ *
+ * @param[in] module_id Module id on which the host interfaces exist
+ * @param[in] object_count Number of host interfaces to create
+ * @param[in] attr_count List of attr_count. Caller passes the number of
+ *            attributes for each host interface to create.
+ * @param[in] attr_list List of attributes for every host interface
+ * @param[in] mode Bulk operation error handling mode
+ * @param[out] object_id List of host interface ids returned
+ * @param[out] object_statuses List of status for every host interface. Caller
+ *             needs to allocate the buffer.
+ *
+ * @return #TAI_STATUS_SUCCESS on success when all host interfaces are created or
+ * #TAI_STATUS_FAILURE when any of the host interfaces fails to create. When there
+ * is a failure, the caller is expected to go through the list of returned
+ * statuses to find out which fails and which succeeds.
+ */
+typedef tai_status_t (*tai_bulk_create_host_interface_fn)(
+        _In_ tai_object_id_t module_id,
+        _In_ uint32_t object_count,
+        _In_ const uint32_t *attr_count,
+        _In_ const tai_attribute_t **attr_list,
+        _In_ tai_bulk_op_error_mode_t mode,
+        _Out_ tai_object_id_t *object_id,
+        _Out_ tai_status_t *object_statuses);
+
+/**
+ * @brief Bulk host interface removal
+ *
+ * @param[in] object_count Number of host interfaces to remove
+ * @param[in] object_id List of host interface ids
+ * @param[in] mode Bulk operation error handling mode
+ * @param[out] object_statuses List of status for every host interface. Caller
+ *             needs to allocate the buffer.
+ *
+ * @return #TAI_STATUS_SUCCESS on success when all host interfaces are removed or
+ * #TAI_STATUS_FAILURE when any of the host interfaces fails to remove
+ */
+typedef tai_status_t (*tai_bulk_remove_host_interface_fn)(
+        _In_ uint32_t object_count,
+        _In_ const tai_object_id_t *object_id,
+        _In_ tai_bulk_op_error_mode_t mode,
+        _Out_ tai_status_t *object_statuses);
+
+/**
+ * @brief Bulk set of host interface attribute values
+ *
+ * @param[in] object_count Number of host interfaces
+ * @param[in] object_id List of host interface ids
+ * @param[in] attr_count List of attr_count, one per host interface
+ * @param[in] attr_list List of attributes for every host interface
+ * @param[in] mode Bulk operation error handling mode
+ * @param[out] object_statuses List of status for every host interface. Caller
+ *             needs to allocate the buffer.
+ *
+ * @return #TAI_STATUS_SUCCESS on success when all host interfaces are updated or
+ * #TAI_STATUS_FAILURE when any of the host interfaces fails to update
+ */
+typedef tai_status_t (*tai_bulk_set_host_interface_attributes_fn)(
+        _In_ uint32_t object_count,
+        _In_ const tai_object_id_t *object_id,
+        _In_ const uint32_t *attr_count,
+        _In_ const tai_attribute_t **attr_list,
+        _In_ tai_bulk_op_error_mode_t mode,
+        _Out_ tai_status_t *object_statuses);
+
+/**
+ * @brief Bulk get of host interface attribute values
+ *
+ * @param[in] object_count Number of host interfaces
+ * @param[in] object_id List of host interface ids
+ * @param[in] attr_count List of attr_count, one per host interface
+ * @param[inout] attr_list List of attributes for every host interface
+ * @param[in] mode Bulk operation error handling mode
+ * @param[out] object_statuses List of status for every host interface. Caller
+ *             needs to allocate the buffer.
+ *
+ * @return #TAI_STATUS_SUCCESS on success when all host interfaces are retrieved or
+ * #TAI_STATUS_FAILURE when any of the host interfaces fails to retrieve
+ */
+typedef tai_status_t (*tai_bulk_get_host_interface_attributes_fn)(
+        _In_ uint32_t object_count,
+        _In_ const tai_object_id_t *object_id,
+        _In_ const uint32_t *attr_count,
+        _Inout_ tai_attribute_t **attr_list,
+        _In_ tai_bulk_op_error_mode_t mode,
+        _Out_ tai_status_t *object_statuses);
+
+/**
+ * @brief Get multiple host interface attribute values, list values are allocated by
+ * the adapter
+ *
+ * Unlike #tai_get_host_interface_attributes_fn the caller does not provide the buffers
+ * of list attributes (char, float, u32, object and object map lists) and the
+ * count and list members are ignored on input. The adapter sizes and fills
+ * every list in the same call, so a list of unknown length is read without the
+ * #TAI_STATUS_BUFFER_OVERFLOW and retry round trip. The lists stay valid until
+ * the attribute list is passed to #tai_free_host_interface_attributes_fn.
+ *
+ * @param[in] host_interface_id Host interface id
+ * @param[in] attr_count Number of attributes
+ * @param[inout] attr_list Array of attributes
+ *
+ * @return #TAI_STATUS_SUCCESS on success, failure status code on error. Nothing
+ * has to be released on error.
+ */
+typedef tai_status_t (*tai_get_host_interface_attributes_alloc_fn)(
+        _In_ tai_object_id_t host_interface_id,
+        _In_ uint32_t attr_count,
+        _Inout_ tai_attribute_t *attr_list);
+
+/**
+ * @brief Release the lists returned by #tai_get_host_interface_attributes_alloc_fn
+ *
+ * Each list is released on its own, so the lists of an attribute list may be
+ * released all at once or a part at a time, in any order.
+ *
+ * @param[in] attr_count Number of attributes
+ * @param[in] attr_list Array of attributes, as returned by
+ * #tai_get_host_interface_attributes_alloc_fn, or a part of it
+ *
+ * @return #TAI_STATUS_SUCCESS on success, failure status code on error
+ */
+typedef tai_status_t (*tai_free_host_interface_attributes_fn)(
+        _In_ uint32_t attr_count,
+        _In_ tai_attribute_t *attr_list);
+
+/**
+ * @brief Set multiple host interface attribute values asynchronously
+ *
+ * Returns as soon as the request is queued. The adapter then applies the
+ * attributes as #tai_set_host_interface_attributes_fn would and reports the result
+ * through the completion callback. The attribute list must stay valid until
+ * the callback has been called.
+ *
+ * @param[in] host_interface_id Host interface id
+ * @param[in] attr_count Number of attributes
+ * @param[in] attr_list Array of attributes
+ * @param[in] completion Completion callback
+ * @param[in] context Opaque pointer passed to the completion callback
+ * @param[out] request_id Id of the request, passed to the completion callback
+ *
+ * @return #TAI_STATUS_SUCCESS if the request was queued, failure status code on
+ * error, in which case the callback is not called
+ */
+typedef tai_status_t (*tai_set_host_interface_attributes_async_fn)(
+        _In_ tai_object_id_t host_interface_id,
+        _In_ uint32_t attr_count,
+        _In_ const tai_attribute_t *attr_list,
+        _In_ tai_async_completion_fn completion,
+        _In_ void *context,
+        _Out_ tai_async_request_id_t *request_id);
+
+/**
+ * @brief Get multiple host interface attribute values asynchronously
+ *
+ * Returns as soon as the request is queued. The adapter then reads the
+ * attributes as #tai_get_host_interface_attributes_fn would and reports the result
+ * through the completion callback. The attribute list must stay valid until
+ * the callback has been called.
+ *
+ * @param[in] host_interface_id Host interface id
+ * @param[in] attr_count Number of attributes
+ * @param[inout] attr_list Array of attributes
+ * @param[in] completion Completion callback
+ * @param[in] context Opaque pointer passed to the completion callback
+ * @param[out] request_id Id of the request, passed to the completion callback
+ *
+ * @return #TAI_STATUS_SUCCESS if the request was queued, failure status code on
+ * error, in which case the callback is not called
+ */
+typedef tai_status_t (*tai_get_host_interface_attributes_async_fn)(
+        _In_ tai_object_id_t host_interface_id,
+        _In_ uint32_t attr_count,
+        _Inout_ tai_attribute_t *attr_list,
+        _In_ tai_async_completion_fn completion,
+        _In_ void *context,
+        _Out_ tai_async_request_id_t *request_id);
+
 /**
  * @brief Host interface methods table retrieved with tai_api_query()
  */
 typedef struct _tai_host_interface_api_t
 {
-    tai_create_host_interface_fn                create_host_interface;
-    tai_remove_host_interface_fn                remove_host_interface;
-    tai_set_host_interface_attribute_fn         set_host_interface_attribute;
-    tai_set_host_interface_attributes_fn        set_host_interface_attributes;
-    tai_get_host_interface_attribute_fn         get_host_interface_attribute;
-    tai_get_host_interface_attributes_fn        get_host_interface_attributes;
+    tai_create_host_interface_fn                 create_host_interface;
+    tai_remove_host_interface_fn                 remove_host_interface;
+    tai_set_host_interface_attribute_fn          set_host_interface_attribute;
+    tai_set_host_interface_attributes_fn         set_host_interface_attributes;
+    tai_get_host_interface_attribute_fn          get_host_interface_attribute;
+    tai_get_host_interface_attributes_fn         get_host_interface_attributes;
+    tai_bulk_create_host_interface_fn            bulk_create_host_interface;
+    tai_bulk_remove_host_interface_fn            bulk_remove_host_interface;
+    tai_bulk_set_host_interface_attributes_fn    bulk_set_host_interface_attributes;
+    tai_bulk_get_host_interface_attributes_fn    bulk_get_host_interface_attributes;
+    tai_get_host_interface_attributes_alloc_fn   get_host_interface_attributes_alloc;
+    tai_free_host_interface_attributes_fn        free_host_interface_attributes;
+    tai_set_host_interface_attributes_async_fn   set_host_interface_attributes_async;
+    tai_get_host_interface_attributes_async_fn   get_host_interface_attributes_async;
 
 } tai_host_interface_api_t;
 
@@ -97,6 +97,7 @@ typedef enum _tai_module_attr_t
      *
      * @type #tai_char_list_t
      * @flags MANDATORY_ON_CREATE | CREATE_ONLY
+     * @cache IMMUTABLE
      */
     TAI_MODULE_ATTR_LOCATION  = TAI_MODULE_ATTR_START,
 
@@ -104,6 +105,7 @@ typedef enum _tai_module_attr_t
      * @brief The module vendor's name
      * @type #tai_char_list_t
      * @flags READ_ONLY
+     * @cache IMMUTABLE
      */
     TAI_MODULE_ATTR_VENDOR_NAME,
 
@@ -111,6 +113,7 @@ typedef enum _tai_module_attr_t
      * @brief The module vendor's part number
      * @type #tai_char_list_t
      * @flags READ_ONLY
+     * @cache IMMUTABLE
      */
     TAI_MODULE_ATTR_VENDOR_PART_NUMBER,
 
@@ -118,6 +121,7 @@ typedef enum _tai_module_attr_t
      * @brief The module vendor's serial number
      * @type #tai_char_list_t
      * @flags READ_ONLY
+     * @cache IMMUTABLE
      */
     TAI_MODULE_ATTR_VENDOR_SERIAL_NUMBER,
 
@@ -161,6 +165,7 @@ typedef enum _tai_module_attr_t
      *
      * @type #tai_uint32_t
      * @flags READ_ONLY
+     * @cache IMMUTABLE
      */
     TAI_MODULE_ATTR_NUM_HOST_INTERFACES,
 
@@ -169,6 +174,7 @@ typedef enum _tai_module_attr_t
      *
      * @type #tai_uint32_t
      * @flags READ_ONLY
+     * @cache IMMUTABLE
      */
     TAI_MODULE_ATTR_NUM_NETWORK_INTERFACES,
 
@@ -187,6 +193,7 @@ typedef enum _tai_module_attr_t
      * by setting some netif attributes (e.g TAI_NETWORK_INTERFACE_ATTR_MODULATION_FORMAT )
      *
      * @type #tai_object_map_list_t
+     * @cache NEVER
      */
     TAI_MODULE_ATTR_TRIBUTARY_MAPPING,
 
@@ -224,6 +231,73 @@ typedef void (*tai_module_state_change_notification_fn)(
         _In_ tai_object_id_t module_id,
         _In_ tai_module_oper_status_t module_oper_status);
 
+/**
+ * @brief Threshold crossed by a threshold alarm
+ */
+typedef enum _tai_threshold_alarm_type_t
+{
+    /** The value rose above the high threshold */
+    TAI_THRESHOLD_ALARM_TYPE_HIGH,
+
+    /** The value fell below the low threshold */
+    TAI_THRESHOLD_ALARM_TYPE_LOW,
+
+} tai_threshold_alarm_type_t;
+
+/**
+ * @brief A threshold crossing detected by the adapter
+ */
+typedef struct _tai_threshold_alarm_t
+{
+    /** Object of the attribute, the module or one of its interfaces */
+    tai_object_id_t object_id;
+
+    /** The monitored attribute */
+    tai_attr_id_t attr_id;
+
+    /** The threshold crossed */
+    tai_threshold_alarm_type_t type;
+
+    /** true when the alarm is raised, false when it is cleared */
+    bool raised;
+
+    /** The value which crossed the threshold */
+    float value;
+
+    /** Sampling time of the value in nanoseconds since the Epoch
+     *  (CLOCK_REALTIME) */
+    uint64_t timestamp;
+
+} tai_threshold_alarm_t;
+
+/**
+ * @brief Threshold alarm notification
+ *
+ * Called from an adapter thread each time a monitored attribute crosses one
+ * of its thresholds. The adapter host must not invoke other TAI interfaces
+ * from it.
+ *
+ * @param[in] module_id Module Id
+ * @param[in] alarm The crossing, only valid for the duration of the call
+ */
+typedef void (*tai_module_threshold_alarm_notification_fn)(
+        _In_ tai_object_id_t module_id,
+        _In_ const tai_threshold_alarm_t *alarm);
+
+/**
+ * @brief Tributary mapping change notification
+ *
+ * Called when #TAI_MODULE_ATTR_TRIBUTARY_MAPPING of the module may have
+ * changed, for instance after a network interface was created or its
+ * modulation format was set. It may be called from the thread setting the
+ * attribute or from an adapter thread; the adapter host must not invoke other
+ * TAI interfaces from it.
+ *
+ * @param[in] module_id Module Id
+ */
+typedef void (*tai_module_tributary_mapping_change_notification_fn)(
+        _In_ tai_object_id_t module_id);
+
 /**
  *  @brief Module notification table. Functions are provided by adapter host to
  *         adapter in create_module function.
@@ -232,8 +306,246 @@ typedef struct _tai_module_notification_t
 {
     tai_module_shutdown_request_notification_fn shutdown_request;
     tai_module_state_change_notification_fn     state_change;
+    tai_module_threshold_alarm_notification_fn  threshold_alarm;
+    tai_module_tributary_mapping_change_notification_fn tributary_mapping_change;
 } tai_module_notification_t;
 
+/**
+ * @brief Thresholds of a read-only float attribute, such as
+ *        #TAI_MODULE_ATTR_TEMP or #TAI_NETWORK_INTERFACE_ATTR_CURRENT_BER
+ *
+ * An alarm is raised when the value rises above high, and cleared when it
+ * falls below high - hysteresis. Likewise an alarm is raised when the value
+ * falls below low, and cleared when it rises above low + hysteresis.
+ */
+typedef struct _tai_attribute_threshold_t
+{
+    /** Object of the attribute, the module or one of its interfaces */
+    tai_object_id_t object_id;
+
+    /** The monitored attribute */
+    tai_attr_id_t attr_id;
+
+    /** Whether the high threshold is monitored */
+    bool high_enabled;
+
+    /** High threshold */
+    float high;
+
+    /** Whether the low threshold is monitored */
+    bool low_enabled;
+
+    /** Low threshold */
+    float low;
+
+    /** Distance the value has to move back past a threshold to clear its
+     *  alarm, 0 or more */
+    float hysteresis;
+
+} tai_attribute_threshold_t;
+
+/**
+ * @brief Attribute subscription id
+ */
+typedef uint64_t tai_subscription_id_t;
+
+/**
+ * @brief A timestamped attribute value delivered by an attribute subscription
+ */
+typedef struct _tai_attribute_sample_t
+{
+    /** Object on which the attribute was sampled */
+    tai_object_id_t object_id;
+
+    /** Sampling time in nanoseconds since the Epoch (CLOCK_REALTIME) */
+    uint64_t timestamp;
+
+    /** The attribute id and the sampled value */
+    tai_attribute_t attr;
+
+} tai_attribute_sample_t;
+
+/**
+ * @brief Attribute subscription notification
+ *
+ * Called by the adapter once per sampling interval with every sample taken in
+ * that interval. The samples are ordered by object, then by attribute, in the
+ * order given at subscription time. The sample buffer is owned by the adapter
+ * and is only valid for the duration of the call. Like the other
+ * notifications, this function may be called from an adapter thread and the
+ * adapter host must not invoke other TAI interfaces from it.
+ *
+ * @param[in] subscription_id Subscription id
+ * @param[in] context Context pointer given at subscription time
+ * @param[in] sample_count Number of samples
+ * @param[in] samples Array of samples
+ */
+typedef void (*tai_attribute_subscription_notification_fn)(
+        _In_ tai_subscription_id_t subscription_id,
+        _In_ void *context,
+        _In_ uint32_t sample_count,
+        _In_ const tai_attribute_sample_t *samples);
+
+/**
+ * @brief Attribute subscription parameters
+ *
+ * Every attribute of attr_list is sampled on every object of object_list. All
+ * objects must be of type object_type and belong to the same module. Only
+ * attributes with a scalar value type can be subscribed.
+ */
+typedef struct _tai_attribute_subscription_t
+{
+    /** Type of the subscribed objects */
+    tai_object_type_t object_type;
+
+    /** Number of subscribed objects */
+    uint32_t object_count;
+
+    /** Subscribed objects */
+    const tai_object_id_t *object_list;
+
+    /** Number of subscribed attributes */
+    uint32_t attr_count;
+
+    /** Subscribed attribute ids */
+    const tai_attr_id_t *attr_list;
+
+    /** Sampling interval in microseconds */
+    uint32_t interval_us;
+
+    /** Function called with each batch of samples */
+    tai_attribute_subscription_notification_fn notify;
+
+    /** Opaque pointer passed back to notify */
+    void *context;
+
+} tai_attribute_subscription_t;
+
+/**
+ * @brief Duration of the performance monitoring bins
+ */
+typedef enum _tai_pm_interval_t
+{
+    /** 15 minute bins */
+    TAI_PM_INTERVAL_15_MIN,
+
+    /** 24 hour bins */
+    TAI_PM_INTERVAL_24_HOUR,
+
+    TAI_PM_INTERVAL_MAX,
+
+} tai_pm_interval_t;
+
+/**
+ * @brief The statistics of an attribute over a completed bin
+ */
+typedef struct _tai_pm_bin_t
+{
+    /** Object of the attribute, the module or one of its interfaces */
+    tai_object_id_t object_id;
+
+    /** The monitored attribute */
+    tai_attr_id_t attr_id;
+
+    /** Number of samples in the bin */
+    uint32_t sample_count;
+
+    /** Start of the bin in nanoseconds since the Epoch (CLOCK_REALTIME),
+     *  aligned to the bin duration */
+    uint64_t start;
+
+    /** Minimum sampled value */
+    float min;
+
+    /** Maximum sampled value */
+    float max;
+
+    /** Average of the samples */
+    float avg;
+
+} tai_pm_bin_t;
+
+/**
+ * @brief Select an attribute in a telemetry snapshot attribute mask
+ *
+ * Only attribute ids lower than 64 can be part of a snapshot.
+ */
+#define TAI_TELEMETRY_ATTR_MASK(attr_id)        (1ULL << (attr_id))
+
+/**
+ * @brief Storage of one telemetry snapshot column
+ *
+ * Attributes of type #tai_float_t use the flt member. All other attributes,
+ * including enums, booleans and bitmaps, are widened to 32 bits and use the
+ * u32 member.
+ */
+typedef union _tai_telemetry_column_data_t
+{
+    tai_float_t  *flt;
+    tai_uint32_t *u32;
+} tai_telemetry_column_data_t;
+
+/**
+ * @brief One column of a telemetry snapshot
+ *
+ * A column holds the value of one attribute for every interface of a module.
+ * The buffer is allocated by the caller, contiguous, and indexed by the
+ * interface index (TAI_NETWORK_INTERFACE_ATTR_INDEX or
+ * TAI_HOST_INTERFACE_ATTR_INDEX).
+ */
+typedef struct _tai_telemetry_column_t
+{
+    /** Attribute id of the column, filled by the adapter */
+    tai_attr_id_t attr_id;
+
+    /** Caller allocated row buffer */
+    tai_telemetry_column_data_t data;
+
+} tai_telemetry_column_t;
+
+/**
+ * @brief Structure-of-arrays snapshot of the interfaces of a module
+ *
+ * The attribute masks select the attributes to be read. The column arrays
+ * must have one entry per bit set in the corresponding mask; columns are
+ * filled in ascending attribute id order. The row counts are set by the
+ * caller to the capacity of the column buffers and updated by the adapter to
+ * the number of interfaces on the module.
+ */
+typedef struct _tai_telemetry_snapshot_t
+{
+    /** Sampling time in nanoseconds since the Epoch, filled by the adapter */
+    uint64_t timestamp;
+
+    /** Network interface attributes, see #TAI_TELEMETRY_ATTR_MASK */
+    uint64_t netif_attr_mask;
+
+    /** Host interface attributes, see #TAI_TELEMETRY_ATTR_MASK */
+    uint64_t hostif_attr_mask;
+
+    /** Capacity, then number, of network interface rows */
+    uint32_t netif_count;
+
+    /** Capacity, then number, of host interface rows */
+    uint32_t hostif_count;
+
+    /**
+     * Network interface rows holding the values of a created interface, bit n
+     * for row n, filled by the adapter. The other rows are zero.
+     */
+    uint64_t netif_valid_mask;
+
+    /** Host interface rows holding the values of a created interface */
+    uint64_t hostif_valid_mask;
+
+    /** Network interface columns */
+    tai_telemetry_column_t *netif_columns;
+
+    /** Host interface columns */
+    tai_telemetry_column_t *hostif_columns;
+
+} tai_telemetry_snapshot_t;
+
 /**
  * @brief Create module
  *
@@ -318,17 +630,413 @@ typedef tai_status_t (*tai_get_module_attributes_fn)(
         _In_ uint32_t attr_count,
         _Inout_ tai_attribute_t *attr_list);
 
+/**
+ * @brief Bulk module creation
+ *
+ * @param[in] object_count Number of modules to create
+ * @param[in] attr_count List of attr_count. Caller passes the number of
+ *            attributes for each module to create.
+ * @param[in] attr_list List of attributes for every module
+ * @param[in] notifications Notification table shared by every module
+ * @param[in] mode Bulk operation error handling mode
+ * @param[out] object_id List of module ids returned
+ * @param[out] object_statuses List of status for every module. Caller needs
+ *             to allocate the buffer.
+ *
+ * @return #TAI_STATUS_SUCCESS on success when all modules are created or
+ * #TAI_STATUS_FAILURE when any of the modules fails to create. When there is
+ * a failure, the caller is expected to go through the list of returned
+ * statuses to find out which fails and which succeeds.
+ */
+typedef tai_status_t (*tai_bulk_create_module_fn)(
+        _In_ uint32_t object_count,
+        _In_ const uint32_t *attr_count,
+        _In_ const tai_attribute_t **attr_list,
+        _In_ tai_module_notification_t *notifications,
+        _In_ tai_bulk_op_error_mode_t mode,
+        _Out_ tai_object_id_t *object_id,
+        _Out_ tai_status_t *object_statuses);
+
+/**
+ * @brief Bulk module removal
+ *
+ * @param[in] object_count Number of modules to remove
+ * @param[in] object_id List of module ids
+ * @param[in] mode Bulk operation error handling mode
+ * @param[out] object_statuses List of status for every module. Caller needs
+ *             to allocate the buffer.
+ *
+ * @return #TAI_STATUS_SUCCESS on success when all modules are removed or
+ * #TAI_STATUS_FAILURE when any of the modules fails to remove
+ */
+typedef tai_status_t (*tai_bulk_remove_module_fn)(
+        _In_ uint32_t object_count,
+        _In_ const tai_object_id_t *object_id,
+        _In_ tai_bulk_op_error_mode_t mode,
+        _Out_ tai_status_t *object_statuses);
+
+/**
+ * @brief Bulk set of module attribute values
+ *
+ * @param[in] object_count Number of modules
+ * @param[in] object_id List of module ids
+ * @param[in] attr_count List of attr_count, one per module
+ * @param[in] attr_list List of attributes for every module
+ * @param[in] mode Bulk operation error handling mode
+ * @param[out] object_statuses List of status for every module. Caller needs
+ *             to allocate the buffer.
+ *
+ * @return #TAI_STATUS_SUCCESS on success when all modules are updated or
+ * #TAI_STATUS_FAILURE when any of the modules fails to update
+ */
+typedef tai_status_t (*tai_bulk_set_module_attributes_fn)(
+        _In_ uint32_t object_count,
+        _In_ const tai_object_id_t *object_id,
+        _In_ const uint32_t *attr_count,
+        _In_ const tai_attribute_t **attr_list,
+        _In_ tai_bulk_op_error_mode_t mode,
+        _Out_ tai_status_t *object_statuses);
+
+/**
+ * @brief Bulk get of module attribute values
+ *
+ * @param[in] object_count Number of modules
+ * @param[in] object_id List of module ids
+ * @param[in] attr_count List of attr_count, one per module
+ * @param[inout] attr_list List of attributes for every module
+ * @param[in] mode Bulk operation error handling mode
+ * @param[out] object_statuses List of status for every module. Caller needs
+ *             to allocate the buffer.
+ *
+ * @return #TAI_STATUS_SUCCESS on success when all modules are retrieved or
+ * #TAI_STATUS_FAILURE when any of the modules fails to retrieve
+ */
+typedef tai_status_t (*tai_bulk_get_module_attributes_fn)(
+        _In_ uint32_t object_count,
+        _In_ const tai_object_id_t *object_id,
+        _In_ const uint32_t *attr_count,
+        _Inout_ tai_attribute_t **attr_list,
+        _In_ tai_bulk_op_error_mode_t mode,
+        _Out_ tai_status_t *object_statuses);
+
+/**
+ * @brief Subscribe to periodic attribute samples
+ *
+ * Instead of polling the attributes with the get functions, the adapter host
+ * registers a set of attributes, a sampling interval and a callback. The
+ * adapter samples the attributes itself and delivers timestamped batches
+ * through the callback until the subscription is removed.
+ *
+ * @param[out] subscription_id Subscription id
+ * @param[in] module_id Module id on which the subscribed objects exist
+ * @param[in] subscription Subscription parameters
+ *
+ * @return #TAI_STATUS_SUCCESS on success, failure status code on error. An
+ * attribute which can not be subscribed is reported with
+ * #TAI_STATUS_ATTR_NOT_SUPPORTED_0 plus its index in attr_list.
+ */
+typedef tai_status_t (*tai_create_attribute_subscription_fn)(
+        _Out_ tai_subscription_id_t *subscription_id,
+        _In_ tai_object_id_t module_id,
+        _In_ const tai_attribute_subscription_t *subscription);
+
+/**
+ * @brief Remove an attribute subscription
+ *
+ * No notification for the subscription is delivered after this function
+ * returns.
+ *
+ * @param[in] subscription_id Subscription id
+ *
+ * @return #TAI_STATUS_SUCCESS on success, failure status code on error
+ */
+typedef tai_status_t (*tai_remove_attribute_subscription_fn)(
+        _In_ tai_subscription_id_t subscription_id);
+
+/**
+ * @brief Read a telemetry snapshot of every interface of a module
+ *
+ * Fills a caller provided structure-of-arrays buffer with one column per
+ * selected attribute and one row per interface, in a single call.
+ *
+ * @param[in] module_id Module id
+ * @param[inout] snapshot Snapshot request and buffer
+ *
+ * @return #TAI_STATUS_SUCCESS on success, #TAI_STATUS_BUFFER_OVERFLOW if a row
+ * capacity is too small (the row counts are then set to the required values),
+ * failure status code on error. An attribute which can not be part of a
+ * snapshot is reported with #TAI_STATUS_ATTR_NOT_SUPPORTED_0 plus the index of
+ * its column.
+ */
+typedef tai_status_t (*tai_get_module_telemetry_snapshot_fn)(
+        _In_ tai_object_id_t module_id,
+        _Inout_ tai_telemetry_snapshot_t *snapshot);
+
+/**
+ * @brief Get multiple module attribute values, list values are allocated by
+ * the adapter
+ *
+ * Unlike #tai_get_module_attributes_fn the caller does not provide the buffers
+ * of list attributes (char, float, u32, object and object map lists) and the
+ * count and list members are ignored on input. The adapter sizes and fills
+ * every list in the same call, so a list of unknown length is read without the
+ * #TAI_STATUS_BUFFER_OVERFLOW and retry round trip. The lists stay valid until
+ * the attribute list is passed to #tai_free_module_attributes_fn.
+ *
+ * @param[in] module_id Module id
+ * @param[in] attr_count Number of attributes
+ * @param[inout] attr_list Array of attributes
+ *
+ * @return #TAI_STATUS_SUCCESS on success, failure status code on error. Nothing
+ * has to be released on error.
+ */
+typedef tai_status_t (*tai_get_module_attributes_alloc_fn)(
+        _In_ tai_object_id_t module_id,
+        _In_ uint32_t attr_count,
+        _Inout_ tai_attribute_t *attr_list);
+
+/**
+ * @brief Release the lists returned by #tai_get_module_attributes_alloc_fn
+ *
+ * Each list is released on its own, so the lists of an attribute list may be
+ * released all at once or a part at a time, in any order.
+ *
+ * @param[in] attr_count Number of attributes
+ * @param[in] attr_list Array of attributes, as returned by
+ * #tai_get_module_attributes_alloc_fn, or a part of it
+ *
+ * @return #TAI_STATUS_SUCCESS on success, failure status code on error
+ */
+typedef tai_status_t (*tai_free_module_attributes_fn)(
+        _In_ uint32_t attr_count,
+        _In_ tai_attribute_t *attr_list);
+
+/**
+ * @brief Set multiple module attribute values asynchronously
+ *
+ * Returns as soon as the request is queued. The adapter then applies the
+ * attributes as #tai_set_module_attributes_fn would and reports the result
+ * through the completion callback. The attribute list must stay valid until
+ * the callback has been called.
+ *
+ * @param[in] module_id Module id
+ * @param[in] attr_count Number of attributes
+ * @param[in] attr_list Array of attributes
+ * @param[in] completion Completion callback
+ * @param[in] context Opaque pointer passed to the completion callback
+ * @param[out] request_id Id of the request, passed to the completion callback
+ *
+ * @return #TAI_STATUS_SUCCESS if the request was queued, failure status code on
+ * error, in which case the callback is not called
+ */
+typedef tai_status_t (*tai_set_module_attributes_async_fn)(
+        _In_ tai_object_id_t module_id,
+        _In_ uint32_t attr_count,
+        _In_ const tai_attribute_t *attr_list,
+        _In_ tai_async_completion_fn completion,
+        _In_ void *context,
+        _Out_ tai_async_request_id_t *request_id);
+
+/**
+ * @brief Get multiple module attribute values asynchronously
+ *
+ * Returns as soon as the request is queued. The adapter then reads the
+ * attributes as #tai_get_module_attributes_fn would and reports the result
+ * through the completion callback. The attribute list must stay valid until
+ * the callback has been called.
+ *
+ * @param[in] module_id Module id
+ * @param[in] attr_count Number of attributes
+ * @param[inout] attr_list Array of attributes
+ * @param[in] completion Completion callback
+ * @param[in] context Opaque pointer passed to the completion callback
+ * @param[out] request_id Id of the request, passed to the completion callback
+ *
+ * @return #TAI_STATUS_SUCCESS if the request was queued, failure status code on
+ * error, in which case the callback is not called
+ */
+typedef tai_status_t (*tai_get_module_attributes_async_fn)(
+        _In_ tai_object_id_t module_id,
+        _In_ uint32_t attr_count,
+        _Inout_ tai_attribute_t *attr_list,
+        _In_ tai_async_completion_fn completion,
+        _In_ void *context,
+        _Out_ tai_async_request_id_t *request_id);
+
+/**
+ * @brief Begin a transaction on a module
+ *
+ * Attribute sets staged in the transaction, on the module and on its host and
+ * network interfaces, are applied together by #tai_commit_transaction_fn. The
+ * adapter is free to reorder and to merge the staged sets into the shortest
+ * hardware sequence, e.g. a single laser retune for a grid spacing, a channel
+ * and a modulation format change.
+ *
+ * @param[out] transaction_id Transaction id
+ * @param[in] module_id Module id
+ *
+ * @return #TAI_STATUS_SUCCESS on success, failure status code on error
+ */
+typedef tai_status_t (*tai_begin_transaction_fn)(
+        _Out_ tai_transaction_id_t *transaction_id,
+        _In_ tai_object_id_t module_id);
+
+/**
+ * @brief Stage attribute sets in a transaction
+ *
+ * The attributes are validated but not applied. When the same attribute of
+ * the same object is staged twice the last value wins.
+ *
+ * @param[in] transaction_id Transaction id
+ * @param[in] object_id The module of the transaction or one of its interfaces
+ * @param[in] attr_count Number of attributes
+ * @param[in] attr_list Array of attributes
+ *
+ * @return #TAI_STATUS_SUCCESS on success, failure status code on error, in
+ * which case none of the attributes is staged
+ */
+typedef tai_status_t (*tai_stage_attributes_fn)(
+        _In_ tai_transaction_id_t transaction_id,
+        _In_ tai_object_id_t object_id,
+        _In_ uint32_t attr_count,
+        _In_ const tai_attribute_t *attr_list);
+
+/**
+ * @brief Apply every set staged in a transaction and end the transaction
+ *
+ * Either all of the staged sets are applied, or none: if the hardware fails
+ * part way the adapter restores the values it had already changed.
+ *
+ * @param[in] transaction_id Transaction id
+ *
+ * @return #TAI_STATUS_SUCCESS on success, failure status code on error
+ */
+typedef tai_status_t (*tai_commit_transaction_fn)(
+        _In_ tai_transaction_id_t transaction_id);
+
+/**
+ * @brief Discard the sets staged in a transaction and end the transaction
+ *
+ * @param[in] transaction_id Transaction id
+ *
+ * @return #TAI_STATUS_SUCCESS on success, failure status code on error
+ */
+typedef tai_status_t (*tai_abort_transaction_fn)(
+        _In_ tai_transaction_id_t transaction_id);
+
+/**
+ * @brief Set the thresholds of an attribute
+ *
+ * The adapter evaluates the thresholds each time the hardware samples the
+ * attribute and calls the threshold_alarm notification of the module on each
+ * crossing. Setting the thresholds of an attribute replaces the previous ones
+ * and clears their alarms without notification; disabling both thresholds
+ * stops the monitoring. The thresholds are dropped with their object.
+ *
+ * @param[in] threshold The attribute and its thresholds
+ *
+ * @return #TAI_STATUS_SUCCESS on success, failure status code on error
+ */
+typedef tai_status_t (*tai_set_attribute_threshold_fn)(
+        _In_ const tai_attribute_threshold_t *threshold);
+
+/**
+ * @brief Read the completed performance monitoring bins of a module
+ *
+ * The adapter samples the monitored attributes of the module and of its
+ * interfaces, for instance the temperature, the BER and the optical powers,
+ * and keeps the minimum, maximum and average of each attribute over
+ * consecutive bins. A limited number of completed bins is kept per attribute,
+ * the oldest being dropped first. The bins are returned ordered by object,
+ * then by attribute, then from the oldest to the most recent.
+ *
+ * @param[in] module_id Module id
+ * @param[in] interval The duration of the bins
+ * @param[in] since Only return the bins starting at or after this time, in
+ * nanoseconds since the Epoch; 0 for every bin kept
+ * @param[in,out] bin_count Size of bins, set to the number of bins returned
+ * @param[out] bins The completed bins
+ *
+ * @return #TAI_STATUS_SUCCESS on success, #TAI_STATUS_BUFFER_OVERFLOW with
+ * bin_count set to the required size if bins is too small, failure status
+ * code on error
+ */
+typedef tai_status_t (*tai_get_pm_bins_fn)(
+        _In_ tai_object_id_t module_id,
+        _In_ tai_pm_interval_t interval,
+        _In_ uint64_t since,
+        _Inout_ uint32_t *bin_count,
+        _Out_ tai_pm_bin_t *bins);
+
+/**
+ * @brief Read the change generations of objects
+ *
+ * The generation of an attribute group changes whenever the value of one of
+ * its attributes may have changed. A poller keeps the generations it last saw
+ * and only reads the objects, or the groups, which moved on.
+ *
+ * @param[in] object_count Number of objects
+ * @param[in,out] generations The objects, modules or interfaces of any module,
+ * and their generations. A removed object gets generation 0.
+ *
+ * @return #TAI_STATUS_SUCCESS on success, failure status code on error
+ */
+typedef tai_status_t (*tai_get_object_generations_fn)(
+        _In_ uint32_t object_count,
+        _Inout_ tai_object_generation_t *generations);
+
+/**
+ * @brief Get the value of module attributes if they changed
+ *
+ * @param[in] module_id Module id
+ * @param[in] generation The generation of the previous read, 0 to read
+ * unconditionally
+ * @param[out] current_generation The latest generation of the groups of the
+ * attributes, to be passed to the next call
+ * @param[in] attr_count Number of attributes
+ * @param[inout] attr_list Array of attributes
+ *
+ * @return #TAI_STATUS_SUCCESS if the attributes were read,
+ * #TAI_STATUS_NOT_MODIFIED if none of them changed since generation, in which
+ * case attr_list is untouched, failure status code on error
+ */
+typedef tai_status_t (*tai_get_module_attributes_if_changed_fn)(
+        _In_ tai_object_id_t module_id,
+        _In_ tai_generation_t generation,
+        _Out_ tai_generation_t *current_generation,
+        _In_ uint32_t attr_count,
+        _Inout_ tai_attribute_t *attr_list);
+
 /**
  * @brief Module method table retrieved with tai_api_query()
  */
 typedef struct _tai_module_api_t
 {
-    tai_create_module_fn            create_module;
-    tai_remove_module_fn            remove_module;
-    tai_set_module_attribute_fn     set_module_attribute;
-    tai_set_module_attributes_fn    set_module_attributes;
-    tai_get_module_attribute_fn     get_module_attribute;
-    tai_get_module_attributes_fn    get_module_attributes;
+    tai_create_module_fn                 create_module;
+    tai_remove_module_fn                 remove_module;
+    tai_set_module_attribute_fn          set_module_attribute;
+    tai_set_module_attributes_fn         set_module_attributes;
+    tai_get_module_attribute_fn          get_module_attribute;
+    tai_get_module_attributes_fn         get_module_attributes;
+    tai_bulk_create_module_fn            bulk_create_module;
+    tai_bulk_remove_module_fn            bulk_remove_module;
+    tai_bulk_set_module_attributes_fn    bulk_set_module_attributes;
+    tai_bulk_get_module_attributes_fn    bulk_get_module_attributes;
+    tai_create_attribute_subscription_fn create_attribute_subscription;
+    tai_remove_attribute_subscription_fn remove_attribute_subscription;
+    tai_get_module_telemetry_snapshot_fn get_module_telemetry_snapshot;
+    tai_get_module_attributes_alloc_fn   get_module_attributes_alloc;
+    tai_free_module_attributes_fn        free_module_attributes;
+    tai_set_module_attributes_async_fn   set_module_attributes_async;
+    tai_get_module_attributes_async_fn   get_module_attributes_async;
+    tai_begin_transaction_fn             begin_transaction;
+    tai_stage_attributes_fn              stage_attributes;
+    tai_commit_transaction_fn            commit_transaction;
+    tai_abort_transaction_fn             abort_transaction;
+    tai_get_object_generations_fn        get_object_generations;
+    tai_get_module_attributes_if_changed_fn get_module_attributes_if_changed;
+    tai_set_attribute_threshold_fn       set_attribute_threshold;
+    tai_get_pm_bins_fn                   get_pm_bins;
 
 } tai_module_api_t;
 
@@ -174,6 +174,11 @@
  */
 #define TAI_STATUS_NOT_EXECUTED                     TAI_STATUS_CODE(0x00000017L)
 
+/**
+ * @brief Attributes not read, they did not change since the given generation
+ */
+#define TAI_STATUS_NOT_MODIFIED                     TAI_STATUS_CODE(0x00000018L)
+
 /**
  * @brief Attribute is invalid
  *
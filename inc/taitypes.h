@@ -86,6 +86,10 @@ typedef void *tai_pointer_t;
  * callee will set the count member to the actual number of object id and return
  * #TAI_STATUS_BUFFER_OVERFLOW. Once the caller gets such return code, it should
  * use the returned count member to re-allocate list and retry.
+ *
+ * The same applies to the other list types. The get_xxx_attributes_alloc()
+ * method table functions avoid the retry: the adapter allocates and fills the
+ * lists in one call and the caller releases them with free_xxx_attributes().
  */
 typedef struct _tai_object_list_t
 {
@@ -115,6 +119,26 @@ typedef enum _tai_common_api_t
     TAI_COMMON_API_MAX         = 8,
 } tai_common_api_t;
 
+/**
+ * @brief Error handling mode of the bulk operations
+ */
+typedef enum _tai_bulk_op_error_mode_t
+{
+    /**
+     * @brief Bulk operation stops on the first failed object
+     *
+     * Objects following the failed one are not processed and their status is
+     * set to #TAI_STATUS_NOT_EXECUTED.
+     */
+    TAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR,
+
+    /**
+     * @brief Bulk operation processes every object regardless of failures
+     */
+    TAI_BULK_OP_ERROR_MODE_IGNORE_ERROR,
+
+} tai_bulk_op_error_mode_t;
+
 /**
  * @brief TAI object type
  */
@@ -237,6 +261,73 @@ typedef struct _tai_attribute_t
     tai_attribute_value_t value;
 } tai_attribute_t;
 
+/**
+ * @brief Asynchronous request id
+ */
+typedef uint64_t tai_async_request_id_t;
+
+/**
+ * @brief Transaction id
+ */
+typedef uint64_t tai_transaction_id_t;
+
+/**
+ * @brief Change generation
+ *
+ * Generations only increase, across every object of an adapter. 0 is never
+ * used for a live object.
+ */
+typedef uint64_t tai_generation_t;
+
+/**
+ * @brief Groups of attributes with their own change generation
+ */
+typedef enum _tai_attr_group_t
+{
+    /** Attributes which can be set */
+    TAI_ATTR_GROUP_CONFIG,
+
+    /** Read-only attributes: state, status and telemetry */
+    TAI_ATTR_GROUP_STATE,
+
+    TAI_ATTR_GROUP_MAX,
+} tai_attr_group_t;
+
+/**
+ * @brief Change generations of an object
+ */
+typedef struct _tai_object_generation_t
+{
+    /** The object, set by the caller */
+    tai_object_id_t object_id;
+
+    /** Latest generation of the object, the maximum of its groups. 0 if the
+     *  object does not exist. */
+    tai_generation_t generation;
+
+    /** Generation of each #tai_attr_group_t of the object */
+    tai_generation_t group_generation[TAI_ATTR_GROUP_MAX];
+} tai_object_generation_t;
+
+/**
+ * @brief Completion callback of an asynchronous set or get
+ *
+ * Called once per request from an adapter thread.
+ *
+ * @param[in] request_id The id returned when the request was submitted
+ * @param[in] context The context passed when the request was submitted
+ * @param[in] status The status the synchronous function would have returned
+ * @param[in] attr_count Number of attributes of the request
+ * @param[in] attr_list The attributes of the request. For a get they hold the
+ * retrieved values.
+ */
+typedef void (*tai_async_completion_fn)(
+        _In_ tai_async_request_id_t request_id,
+        _In_ void *context,
+        _In_ tai_status_t status,
+        _In_ uint32_t attr_count,
+        _In_ const tai_attribute_t *attr_list);
+
 /**
  * @}
  */
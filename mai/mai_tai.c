@@ -0,0 +1,2440 @@
+/**
+ *  @file    mai_tai.c
+ *  @brief   The TAI platform adapter, dispatching the TAI calls to the module
+ *           adapters of the platform over the Module Abstraction Interface,
+ *           see docs/TAI-MAI.md and inc/mai.h
+ *
+ *  @remark  Licensed under the Apache License, Version 2.0 (the "License"); you
+ *           may not use this file except in compliance with the License. You may
+ *           obtain a copy of the License at
+ *           http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  @remark  THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ *           CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ *           LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ *           FOR A PARTICULAR PURPOSE, MERCHANTABILITY OR NON-INFRINGEMENT.
+ *
+ *  @remark  See the Apache Version 2.0 License for specific language governing
+ *           permissions and limitations under the License.
+ */
+
+
+#include <dlfcn.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <syslog.h>
+#include "tai.h"
+#include "mai.h"
+#include "stub_log.h"
+
+
+static tai_service_method_table_t adapter_host_fns;
+static bool                       initialized = false;
+
+
+/*------------------------------------------------------------------------------
+
+                               Module Adapters
+
+------------------------------------------------------------------------------*/
+
+#undef  __TAI_MODULE__
+#define __TAI_MODULE__ TAI_API_UNSPECIFIED
+
+/** @brief The module adapters loaded when TAI_MAI_ADAPTERS is not set */
+#define MAI_DEFAULT_ADAPTERS "libModuleA.so,libModuleB.so"
+
+typedef struct _mai_adapter_t mai_adapter_t;
+typedef struct _mai_call_t    mai_call_t;
+
+typedef tai_status_t (*mai_api_initialize_fn)(
+    _In_ uint64_t flags, _In_ const mai_service_method_table_t *services);
+typedef tai_status_t (*mai_api_query_fn)(
+    _In_ tai_api_t tai_api_id, _Out_ void **api_method_table);
+typedef tai_status_t (*mai_api_uninitialize_fn)(void);
+typedef tai_status_t (*mai_log_set_fn)(
+    _In_ tai_api_t tai_api_id, _In_ tai_log_level_t log_level);
+typedef tai_object_type_t (*mai_object_type_query_fn)(_In_ tai_object_id_t tai_object_id);
+typedef tai_object_id_t (*mai_module_id_query_fn)(_In_ tai_object_id_t tai_object_id);
+typedef tai_status_t (*mai_dbg_generate_dump_fn)(_In_ const char *dump_file_name);
+
+/**
+ * @brief Run a call on a module adapter, from the worker of the module adapter
+ *
+ * @param [in] adapter The module adapter
+ * @param [in,out] call The call and its arguments
+ *
+ * @return The status of the call
+ */
+typedef tai_status_t (*mai_call_fn)(
+    _In_ const mai_adapter_t *adapter,
+    _Inout_ mai_call_t       *call);
+
+/**
+ * @brief The completion of the calls a thread handed over to workers
+ */
+typedef struct _mai_wait_t {
+    pthread_mutex_t lock;
+    pthread_cond_t  cond;
+    uint32_t        pending;    /**< Calls not completed yet */
+} mai_wait_t;
+
+/**
+ * @brief A call of the adapter host, handed over to the worker of a module
+ *        adapter. Each function uses the arguments it needs.
+ */
+struct _mai_call_t {
+    mai_call_fn              fn;
+    tai_object_id_t          id;            /**< Object, transaction or subscription */
+    uint64_t                 value;         /**< Generation or time */
+    uint32_t                 count;         /**< Attributes, or objects of a bulk run */
+    uint32_t                 start;         /**< First object of a bulk run */
+    const tai_object_id_t   *ids;           /**< Objects of a bulk operation */
+    const uint32_t          *counts;        /**< Attribute counts of a bulk operation */
+    const void              *lists;         /**< Attribute lists of a bulk operation */
+    tai_status_t            *statuses;      /**< Statuses of a bulk operation */
+    tai_bulk_op_error_mode_t mode;
+    tai_pm_interval_t        interval;
+    const void              *in;
+    void                    *inout;
+    void                    *out;
+    tai_async_completion_fn  completion;
+    void                    *context;
+    tai_status_t             status;        /**< Set by the worker */
+    mai_wait_t              *wait;
+    mai_call_t              *next;
+};
+
+/**
+ * @brief A module adapter, its entry points and its worker. The entries are
+ *        set by tai_api_initialize() and read-only until
+ *        tai_api_uninitialize(), the dispatch of a call is a single index.
+ */
+struct _mai_adapter_t {
+    uint32_t                           index;
+    char                              *path;
+    void                              *handle;
+    mai_api_initialize_fn              api_initialize;
+    mai_api_query_fn                   api_query;
+    mai_api_uninitialize_fn            api_uninitialize;
+    mai_log_set_fn                     log_set;
+    mai_object_type_query_fn           object_type_query;
+    mai_module_id_query_fn             module_id_query;
+    mai_dbg_generate_dump_fn           dbg_generate_dump;
+    const tai_module_api_t            *module_api;
+    const tai_host_interface_api_t    *hostif_api;
+    const tai_network_interface_api_t *netif_api;
+
+    /* The worker and its queue of calls */
+    pthread_t                          worker;
+    bool                               worker_started;
+    bool                               stopping;
+    pthread_mutex_t                    lock;
+    pthread_cond_t                     cond;
+    mai_call_t                        *head;
+    mai_call_t                        *tail;
+};
+
+static mai_adapter_t mai_adapters[MAI_MAX_ADAPTERS];
+static uint32_t      mai_adapter_count = 0;
+
+/**
+ * @brief The module adapter owning an id
+ *
+ * @param [in] id An object, transaction or subscription id
+ *
+ * @return The module adapter, NULL if the id has no valid prefix
+ */
+static mai_adapter_t *mai_adapter_of(_In_ uint64_t id)
+{
+    uint32_t index = MAI_ID_ADAPTER(id);
+
+    return (index < mai_adapter_count) ? &mai_adapters[index] : NULL;
+}
+
+/**
+ * @brief Call a function of a module adapter method table, if the module
+ *        adapter provides it
+ */
+#define MAI_FORWARD(table, fn, ...) \
+    ((NULL != (table)->fn) ? (table)->fn(__VA_ARGS__) : TAI_STATUS_NOT_IMPLEMENTED)
+
+/**
+ * @brief The locations reported by the module adapters. The adapter host
+ *        creates a module with the location of its presence event, which
+ *        tells the module adapter to create it with.
+ */
+static struct {
+    char     location[TAI_MAX_HARDWARE_ID_LEN];
+    uint32_t adapter;
+} mai_locations[MAI_MAX_ADAPTERS * TAI_MAX_MODULES];
+static uint32_t        mai_location_count = 0;
+static pthread_mutex_t mai_locations_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/**
+ * @brief Record the module adapter reporting a location
+ *
+ * @param [in] adapter The module adapter
+ * @param [in] location The location of a presence event
+ */
+static void mai_location_add(
+    _In_ const mai_adapter_t *adapter,
+    _In_ const char          *location)
+{
+    uint32_t idx;
+
+    if ((NULL == location) || (strlen(location) >= TAI_MAX_HARDWARE_ID_LEN)) {
+        return;
+    }
+    pthread_mutex_lock(&mai_locations_lock);
+    for (idx = 0; idx < mai_location_count; idx++) {
+        if (0 == strcmp(mai_locations[idx].location, location)) {
+            break;
+        }
+    }
+    if (idx < mai_location_count) {
+        if (mai_locations[idx].adapter != adapter->index) {
+            TAI_SYSLOG_WARN("Location %s reported by %s is owned by %s", location,
+                            adapter->path, mai_adapters[mai_locations[idx].adapter].path);
+        }
+    } else if (idx < (sizeof(mai_locations) / sizeof(mai_locations[0]))) {
+        strcpy(mai_locations[idx].location, location);
+        mai_locations[idx].adapter = adapter->index;
+        mai_location_count++;
+    } else {
+        TAI_SYSLOG_ERROR("Too many module locations, ignoring %s", location);
+    }
+    pthread_mutex_unlock(&mai_locations_lock);
+}
+
+/**
+ * @brief The index of the module adapter of the module to be created from an
+ *        attribute list
+ *
+ * @param [in] attr_count Number of attributes
+ * @param [in] attr_list The create attributes, with TAI_MODULE_ATTR_LOCATION
+ *
+ * @return The index of the module adapter, MAI_MAX_ADAPTERS if the location
+ *         is missing or unknown
+ */
+static uint32_t mai_location_owner(
+    _In_ uint32_t               attr_count,
+    _In_ const tai_attribute_t *attr_list)
+{
+    const tai_char_list_t *location = NULL;
+    uint32_t idx, owner = MAI_MAX_ADAPTERS;
+
+    for (idx = 0; (NULL != attr_list) && (idx < attr_count); idx++) {
+        if (TAI_MODULE_ATTR_LOCATION == attr_list[idx].id) {
+            location = &attr_list[idx].value.charlist;
+            break;
+        }
+    }
+    if ((NULL == location) || (NULL == location->list) ||
+        (location->count >= TAI_MAX_HARDWARE_ID_LEN)) {
+        return owner;
+    }
+    pthread_mutex_lock(&mai_locations_lock);
+    for (idx = 0; idx < mai_location_count; idx++) {
+        if ((strlen(mai_locations[idx].location) == location->count) &&
+            (0 == memcmp(mai_locations[idx].location, location->list, location->count))) {
+            owner = mai_locations[idx].adapter;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&mai_locations_lock);
+    return owner;
+}
+
+/**
+ * @brief Lists returned by the get_xxx_attributes_alloc functions, to be
+ *        released by the module adapter which allocated them
+ */
+typedef struct _mai_alloc_t {
+    const tai_attribute_t *attr_list;
+    uint32_t               attr_count;
+    uint32_t               remaining;   /**< Attributes not released yet */
+    const mai_adapter_t   *adapter;
+    struct _mai_alloc_t   *next;
+} mai_alloc_t;
+
+static mai_alloc_t     *mai_allocs = NULL;
+static pthread_mutex_t  mai_allocs_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/**
+ * @brief Record the module adapter which allocated the lists of an attribute
+ *        list
+ *
+ * @return TAI_STATUS_SUCCESS on success, TAI_STATUS_NO_MEMORY on failure
+ */
+static tai_status_t mai_alloc_add(
+    _In_ const tai_attribute_t *attr_list,
+    _In_ uint32_t               attr_count,
+    _In_ const mai_adapter_t   *adapter)
+{
+    mai_alloc_t *alloc = malloc(sizeof(*alloc));
+
+    if (NULL == alloc) {
+        return TAI_STATUS_NO_MEMORY;
+    }
+    alloc->attr_list = attr_list;
+    alloc->attr_count = attr_count;
+    alloc->remaining = attr_count;
+    alloc->adapter = adapter;
+    pthread_mutex_lock(&mai_allocs_lock);
+    alloc->next = mai_allocs;
+    mai_allocs = alloc;
+    pthread_mutex_unlock(&mai_allocs_lock);
+    return TAI_STATUS_SUCCESS;
+}
+
+/**
+ * @brief Release attributes of a list recorded by mai_alloc_add(), the list
+ *        is forgotten once all of its attributes are released
+ *
+ * @param [in] attr_list The released attributes, the recorded list or a part
+ *             of it
+ * @param [in] attr_count The number of released attributes
+ *
+ * @return The module adapter which allocated the lists, NULL if unknown
+ */
+static const mai_adapter_t *mai_alloc_remove(
+    _In_ const tai_attribute_t *attr_list,
+    _In_ uint32_t               attr_count)
+{
+    const mai_adapter_t *adapter = NULL;
+    mai_alloc_t **prev, *alloc;
+
+    pthread_mutex_lock(&mai_allocs_lock);
+    for (prev = &mai_allocs; NULL != (alloc = *prev); prev = &alloc->next) {
+        if ((attr_list >= alloc->attr_list) &&
+            (attr_list + attr_count <= alloc->attr_list + alloc->attr_count)) {
+            adapter = alloc->adapter;
+            alloc->remaining -= (attr_count < alloc->remaining) ? attr_count : alloc->remaining;
+            if (0 == alloc->remaining) {
+                *prev = alloc->next;
+                free(alloc);
+            }
+            break;
+        }
+    }
+    pthread_mutex_unlock(&mai_allocs_lock);
+    return adapter;
+}
+
+
+/*------------------------------------------------------------------------------
+
+                                   Workers
+
+------------------------------------------------------------------------------*/
+
+/**
+ * @brief Each module adapter has a worker thread running the calls of the
+ *        adapter host in order. A module adapter is never entered by two
+ *        threads at a time, and a module adapter slow to answer only holds
+ *        up the callers waiting for it: the calls of other threads to other
+ *        module adapters, and the runs of a bulk operation spanning several
+ *        module adapters, proceed in parallel.
+ */
+
+/** @brief The completion of the calls of the thread */
+static __thread mai_wait_t mai_thread_wait = {
+    PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, 0
+};
+
+/**
+ * @brief The worker of a module adapter
+ *
+ * @param [in] arg The module adapter
+ *
+ * @return NULL
+ */
+static void *mai_worker(_In_ void *arg)
+{
+    mai_adapter_t *adapter = arg;
+    mai_call_t *call;
+    mai_wait_t *wait;
+    tai_status_t status;
+
+    pthread_mutex_lock(&adapter->lock);
+    for (;;) {
+        while ((NULL == adapter->head) && !adapter->stopping) {
+            pthread_cond_wait(&adapter->cond, &adapter->lock);
+        }
+        if (NULL == (call = adapter->head)) {
+            break;
+        }
+        if (NULL == (adapter->head = call->next)) {
+            adapter->tail = NULL;
+        }
+        pthread_mutex_unlock(&adapter->lock);
+
+        status = call->fn(adapter, call);
+
+        /* The call belongs to the caller again once it is completed */
+        wait = call->wait;
+        pthread_mutex_lock(&wait->lock);
+        call->status = status;
+        if (0 == --wait->pending) {
+            pthread_cond_signal(&wait->cond);
+        }
+        pthread_mutex_unlock(&wait->lock);
+
+        pthread_mutex_lock(&adapter->lock);
+    }
+    pthread_mutex_unlock(&adapter->lock);
+    return NULL;
+}
+
+/**
+ * @brief Queue a call to the worker of a module adapter, completed in
+ *        mai_thread_wait
+ *
+ * @param [in] adapter The module adapter
+ * @param [in,out] call The call, which must stay valid until completed
+ */
+static void mai_submit(
+    _In_ mai_adapter_t  *adapter,
+    _Inout_ mai_call_t  *call)
+{
+    call->wait = &mai_thread_wait;
+    call->next = NULL;
+    pthread_mutex_lock(&mai_thread_wait.lock);
+    mai_thread_wait.pending++;
+    pthread_mutex_unlock(&mai_thread_wait.lock);
+
+    pthread_mutex_lock(&adapter->lock);
+    if (NULL == adapter->tail) {
+        adapter->head = call;
+    } else {
+        adapter->tail->next = call;
+    }
+    adapter->tail = call;
+    pthread_cond_signal(&adapter->cond);
+    pthread_mutex_unlock(&adapter->lock);
+}
+
+/**
+ * @brief Wait for every call the thread submitted
+ */
+static void mai_wait_calls(void)
+{
+    pthread_mutex_lock(&mai_thread_wait.lock);
+    while (0 != mai_thread_wait.pending) {
+        pthread_cond_wait(&mai_thread_wait.cond, &mai_thread_wait.lock);
+    }
+    pthread_mutex_unlock(&mai_thread_wait.lock);
+}
+
+/**
+ * @brief Run a call on a module adapter and wait for its completion
+ *
+ * @param [in] adapter The module adapter, NULL if the id of the call is not
+ *             valid
+ * @param [in,out] call The call
+ *
+ * @return The status of the call, TAI_STATUS_INVALID_OBJECT_ID without module
+ *         adapter
+ */
+static tai_status_t mai_call_adapter(
+    _In_ mai_adapter_t  *adapter,
+    _Inout_ mai_call_t  *call)
+{
+    if (NULL == adapter) {
+        TAI_SYSLOG_ERROR("Unknown id 0x%lx", call->id);
+        return TAI_STATUS_INVALID_OBJECT_ID;
+    }
+    mai_submit(adapter, call);
+    mai_wait_calls();
+    return call->status;
+}
+
+/**
+ * @brief Run a call on the module adapter owning an id
+ *
+ * @param [in] id The object, transaction or subscription id routing the call
+ * @param [in,out] call The call
+ *
+ * @return The status of the call
+ */
+static tai_status_t mai_call(
+    _In_ uint64_t       id,
+    _Inout_ mai_call_t *call)
+{
+    if (!initialized) {
+        return TAI_STATUS_UNINITIALIZED;
+    }
+    return mai_call_adapter(mai_adapter_of(id), call);
+}
+
+/**
+ * @brief Run a bulk operation whose objects may belong to several module
+ *        adapters
+ *
+ * The objects are split into runs of consecutive objects of the same module
+ * adapter, each handed to the module adapter as a bulk operation of its own.
+ * The runs are run in parallel by the workers, or one after the other in
+ * STOP_ON_ERROR mode, stopping at the first run which fails.
+ *
+ * @param [in] object_count Number of objects
+ * @param [in] owners The index of the module adapter of each object,
+ *             MAI_MAX_ADAPTERS for an object without module adapter
+ * @param [in] invalid The status of the objects without module adapter
+ * @param [in] call The operation, with the arrays of every object. The
+ *             statuses may be NULL, for an operation without statuses.
+ *
+ * @return TAI_STATUS_SUCCESS on success, TAI_STATUS_FAILURE if an object
+ *         failed, or the status of the first run which failed for an
+ *         operation without statuses
+ */
+static tai_status_t mai_bulk_call(
+    _In_ uint32_t          object_count,
+    _In_ const uint32_t   *owners,
+    _In_ tai_status_t      invalid,
+    _In_ const mai_call_t *call)
+{
+    bool stop = (TAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR == call->mode);
+    tai_status_t ret = TAI_STATUS_SUCCESS;
+    uint32_t idx, end, start, runs = 0;
+    mai_call_t *run;
+
+    run = calloc(object_count, sizeof(*run));
+    if (NULL == run) {
+        return TAI_STATUS_NO_MEMORY;
+    }
+    for (start = 0; start < object_count; start = end) {
+        for (end = start + 1; (end < object_count) && (owners[end] == owners[start]); end++);
+        if (owners[start] >= mai_adapter_count) {
+            TAI_SYSLOG_ERROR("No module adapter for the objects %u to %u", start, end - 1);
+            ret = (NULL == call->statuses) ? invalid : TAI_STATUS_FAILURE;
+            for (idx = start; (NULL != call->statuses) && (idx < end); idx++) {
+                call->statuses[idx] = invalid;
+            }
+        } else {
+            run[runs] = *call;
+            run[runs].start = start;
+            run[runs].count = end - start;
+            mai_submit(&mai_adapters[owners[start]], &run[runs]);
+            if (stop) {
+                mai_wait_calls();
+                if (TAI_STATUS_SUCCESS != run[runs].status) {
+                    ret = run[runs].status;
+                }
+            }
+            runs++;
+        }
+        if (stop && (TAI_STATUS_SUCCESS != ret)) {
+            for (idx = end; (NULL != call->statuses) && (idx < object_count); idx++) {
+                call->statuses[idx] = TAI_STATUS_NOT_EXECUTED;
+            }
+            break;
+        }
+    }
+    mai_wait_calls();
+    for (idx = 0; (TAI_STATUS_SUCCESS == ret) && (idx < runs); idx++) {
+        ret = run[idx].status;
+    }
+    free(run);
+    if ((NULL != call->statuses) && (TAI_STATUS_SUCCESS != ret)) {
+        return TAI_STATUS_FAILURE;
+    }
+    return ret;
+}
+
+/**
+ * @brief The module adapter of each object of a bulk operation
+ *
+ * @param [in] object_count Number of objects
+ * @param [in] object_id The objects
+ *
+ * @return The index of the module adapter of each object, to be freed by the
+ *         caller, NULL if out of memory
+ */
+static uint32_t *mai_bulk_owners(
+    _In_ uint32_t               object_count,
+    _In_ const tai_object_id_t *object_id)
+{
+    uint32_t *owners = malloc(object_count * sizeof(*owners));
+    uint32_t idx;
+
+    for (idx = 0; (NULL != owners) && (idx < object_count); idx++) {
+        owners[idx] = MAI_ID_ADAPTER(object_id[idx]);
+        if (owners[idx] >= mai_adapter_count) {
+            owners[idx] = MAI_MAX_ADAPTERS;
+        }
+    }
+    return owners;
+}
+
+/**
+ * @brief Run a bulk operation on objects of any module adapter
+ *
+ * @param [in] call The operation, with the object ids and statuses of every
+ *             object
+ * @param [in] object_count Number of objects
+ *
+ * @return See mai_bulk_call()
+ */
+static tai_status_t mai_bulk_objects(
+    _In_ const mai_call_t *call,
+    _In_ uint32_t          object_count)
+{
+    tai_status_t ret;
+    uint32_t *owners;
+
+    if (!initialized) {
+        return TAI_STATUS_UNINITIALIZED;
+    }
+    if ((0 == object_count) || (NULL == call->ids) || (NULL == call->statuses)) {
+        return TAI_STATUS_INVALID_PARAMETER;
+    }
+    if (NULL == (owners = mai_bulk_owners(object_count, call->ids))) {
+        return TAI_STATUS_NO_MEMORY;
+    }
+    ret = mai_bulk_call(object_count, owners, TAI_STATUS_INVALID_OBJECT_ID, call);
+    free(owners);
+    return ret;
+}
+
+
+/*------------------------------------------------------------------------------
+
+                               Module Presence
+
+------------------------------------------------------------------------------*/
+
+/**
+ * @brief Presence change of a module adapter, forwarded to the adapter host
+ *
+ * @param [in] context The module adapter
+ * @param [in] present true if the module was inserted, false if removed
+ * @param [in] module_location The location of the module
+ */
+static void mai_module_presence(
+    _In_ void *context,
+    _In_ bool  present,
+    _In_ char *module_location)
+{
+    mai_location_add(context, module_location);
+    if (NULL != adapter_host_fns.module_presence) {
+        adapter_host_fns.module_presence(present, module_location);
+    }
+}
+
+/**
+ * @brief Batch of presence changes of a module adapter, forwarded to the
+ *        adapter host
+ *
+ * @param [in] context The module adapter
+ * @param [in] count Number of events
+ * @param [in] events The events
+ */
+static void mai_module_presence_batch(
+    _In_ void                              *context,
+    _In_ uint32_t                           count,
+    _In_ const tai_module_presence_event_t *events)
+{
+    uint32_t idx;
+
+    for (idx = 0; idx < count; idx++) {
+        mai_location_add(context, events[idx].module_location);
+    }
+    adapter_host_fns.module_presence_batch(count, events);
+}
+
+
+/*------------------------------------------------------------------------------
+
+                           Module Object Functions
+
+------------------------------------------------------------------------------*/
+
+#undef  __TAI_MODULE__
+#define __TAI_MODULE__ TAI_API_MODULE
+
+/** @brief Worker side of mai_create_module() */
+static tai_status_t mai_do_create_module(const mai_adapter_t *adapter, mai_call_t *call)
+{
+    return MAI_FORWARD(adapter->module_api, create_module, call->out, call->count,
+                       call->in, call->inout);
+}
+
+/**
+ * @brief Create a module on the module adapter which reported its location
+ *
+ * @param [out] module_id Pointer to a module ID
+ * @param [in] attr_count A count of the number of elements in the attr_list
+ * @param [in] attr_list A list of attribute values to set, with
+ *             TAI_MODULE_ATTR_LOCATION
+ * @param [in] notifications The notification functions of the module
+ *
+ * @return TAI_STATUS_SUCCESS on success, failure status code on error
+ */
+static tai_status_t mai_create_module(
+    _Out_ tai_object_id_t           *module_id,
+    _In_ uint32_t                    attr_count,
+    _In_ const tai_attribute_t      *attr_list,
+    _In_ tai_module_notification_t  *notifications)
+{
+    mai_call_t call = {
+        .fn = mai_do_create_module, .out = module_id, .count = attr_count,
+        .in = attr_list, .inout = notifications
+    };
+    uint32_t owner;
+
+    if (!initialized) {
+        return TAI_STATUS_UNINITIALIZED;
+    }
+    owner = mai_location_owner(attr_count, attr_list);
+    if (owner >= mai_adapter_count) {
+        TAI_SYSLOG_ERROR("No module adapter for the location of the module");
+        return TAI_STATUS_INVALID_PARAMETER;
+    }
+    return mai_call_adapter(&mai_adapters[owner], &call);
+}
+
+/** @brief Worker side of mai_remove_module() */
+static tai_status_t mai_do_remove_module(const mai_adapter_t *adapter, mai_call_t *call)
+{
+    return MAI_FORWARD(adapter->module_api, remove_module, call->id);
+}
+
+/** @brief Remove a module, see #tai_remove_module_fn */
+static tai_status_t mai_remove_module(_In_ tai_object_id_t module_id)
+{
+    mai_call_t call = { .fn = mai_do_remove_module, .id = module_id };
+
+    return mai_call(module_id, &call);
+}
+
+/** @brief Worker side of mai_set_module_attribute() */
+static tai_status_t mai_do_set_module_attribute(const mai_adapter_t *adapter, mai_call_t *call)
+{
+    return MAI_FORWARD(adapter->module_api, set_module_attribute, call->id, call->in);
+}
+
+/** @brief Set a module attribute, see #tai_set_module_attribute_fn */
+static tai_status_t mai_set_module_attribute(
+    _In_ tai_object_id_t        module_id,
+    _In_ const tai_attribute_t *attr)
+{
+    mai_call_t call = { .fn = mai_do_set_module_attribute, .id = module_id, .in = attr };
+
+    return mai_call(module_id, &call);
+}
+
+/** @brief Worker side of mai_set_module_attributes() */
+static tai_status_t mai_do_set_module_attributes(const mai_adapter_t *adapter, mai_call_t *call)
+{
+    return MAI_FORWARD(adapter->module_api, set_module_attributes, call->id, call->count,
+                       call->in);
+}
+
+/** @brief Set module attributes, see #tai_set_module_attributes_fn */
+static tai_status_t mai_set_module_attributes(
+    _In_ tai_object_id_t        module_id,
+    _In_ uint32_t               attr_count,
+    _In_ const tai_attribute_t *attr_list)
+{
+    mai_call_t call = {
+        .fn = mai_do_set_module_attributes, .id = module_id, .count = attr_count,
+        .in = attr_list
+    };
+
+    return mai_call(module_id, &call);
+}
+
+/** @brief Worker side of mai_get_module_attribute() */
+static tai_status_t mai_do_get_module_attribute(const mai_adapter_t *adapter, mai_call_t *call)
+{
+    return MAI_FORWARD(adapter->module_api, get_module_attribute, call->id, call->inout);
+}
+
+/** @brief Get a module attribute, see #tai_get_module_attribute_fn */
+static tai_status_t mai_get_module_attribute(
+    _In_ tai_object_id_t     module_id,
+    _Inout_ tai_attribute_t *attr)
+{
+    mai_call_t call = { .fn = mai_do_get_module_attribute, .id = module_id, .inout = attr };
+
+    return mai_call(module_id, &call);
+}
+
+/** @brief Worker side of mai_get_module_attributes() */
+static tai_status_t mai_do_get_module_attributes(const mai_adapter_t *adapter, mai_call_t *call)
+{
+    return MAI_FORWARD(adapter->module_api, get_module_attributes, call->id, call->count,
+                       call->inout);
+}
+
+/** @brief Get module attributes, see #tai_get_module_attributes_fn */
+static tai_status_t mai_get_module_attributes(
+    _In_ tai_object_id_t     module_id,
+    _In_ uint32_t            attr_count,
+    _Inout_ tai_attribute_t *attr_list)
+{
+    mai_call_t call = {
+        .fn = mai_do_get_module_attributes, .id = module_id, .count = attr_count,
+        .inout = attr_list
+    };
+
+    return mai_call(module_id, &call);
+}
+
+/** @brief Worker side of a run of mai_bulk_create_module() */
+static tai_status_t mai_do_bulk_create_module(const mai_adapter_t *adapter, mai_call_t *call)
+{
+    return MAI_FORWARD(adapter->module_api, bulk_create_module, call->count,
+                       &call->counts[call->start],
+                       &((const tai_attribute_t **)call->lists)[call->start],
+                       call->inout, call->mode,
+                       &((tai_object_id_t *)call->out)[call->start],
+                       &call->statuses[call->start]);
+}
+
+/**
+ * @brief Create modules, each on the module adapter which reported its
+ *        location, see #tai_bulk_create_module_fn
+ */
+static tai_status_t mai_bulk_create_module(
+    _In_ uint32_t                   object_count,
+    _In_ const uint32_t            *attr_count,
+    _In_ const tai_attribute_t    **attr_list,
+    _In_ tai_module_notification_t *notifications,
+    _In_ tai_bulk_op_error_mode_t   mode,
+    _Out_ tai_object_id_t          *object_id,
+    _Out_ tai_status_t             *object_statuses)
+{
+    mai_call_t call = {
+        .fn = mai_do_bulk_create_module, .counts = attr_count, .lists = attr_list,
+        .inout = notifications, .mode = mode, .out = object_id,
+        .statuses = object_statuses
+    };
+    tai_status_t ret;
+    uint32_t *owners, idx;
+
+    if (!initialized) {
+        return TAI_STATUS_UNINITIALIZED;
+    }
+    if ((0 == object_count) || (NULL == attr_count) || (NULL == attr_list) ||
+        (NULL == object_id) || (NULL == object_statuses)) {
+        return TAI_STATUS_INVALID_PARAMETER;
+    }
+    if (NULL == (owners = malloc(object_count * sizeof(*owners)))) {
+        return TAI_STATUS_NO_MEMORY;
+    }
+    for (idx = 0; idx < object_count; idx++) {
+        owners[idx] = mai_location_owner(attr_count[idx], attr_list[idx]);
+        object_id[idx] = TAI_NULL_OBJECT_ID;
+    }
+    ret = mai_bulk_call(object_count, owners, TAI_STATUS_INVALID_PARAMETER, &call);
+    free(owners);
+    return ret;
+}
+
+/** @brief Worker side of a run of mai_bulk_remove_module() */
+static tai_status_t mai_do_bulk_remove_module(const mai_adapter_t *adapter, mai_call_t *call)
+{
+    return MAI_FORWARD(adapter->module_api, bulk_remove_module, call->count,
+                       &call->ids[call->start], call->mode, &call->statuses[call->start]);
+}
+
+/** @brief Remove modules, see #tai_bulk_remove_module_fn */
+static tai_status_t mai_bulk_remove_module(
+    _In_ uint32_t                 object_count,
+    _In_ const tai_object_id_t   *object_id,
+    _In_ tai_bulk_op_error_mode_t mode,
+    _Out_ tai_status_t           *object_statuses)
+{
+    mai_call_t call = {
+        .fn = mai_do_bulk_remove_module, .ids = object_id, .mode = mode,
+        .statuses = object_statuses
+    };
+
+    return mai_bulk_objects(&call, object_count);
+}
+
+/** @brief Worker side of a run of mai_bulk_set_module_attributes() */
+static tai_status_t mai_do_bulk_set_module_attributes(const mai_adapter_t *adapter, mai_call_t *call)
+{
+    return MAI_FORWARD(adapter->module_api, bulk_set_module_attributes, call->count,
+                       &call->ids[call->start], &call->counts[call->start],
+                       &((const tai_attribute_t **)call->lists)[call->start],
+                       call->mode, &call->statuses[call->start]);
+}
+
+/** @brief Set attributes of modules, see #tai_bulk_set_module_attributes_fn */
+static tai_status_t mai_bulk_set_module_attributes(
+    _In_ uint32_t                 object_count,
+    _In_ const tai_object_id_t   *object_id,
+    _In_ const uint32_t          *attr_count,
+    _In_ const tai_attribute_t  **attr_list,
+    _In_ tai_bulk_op_error_mode_t mode,
+    _Out_ tai_status_t           *object_statuses)
+{
+    mai_call_t call = {
+        .fn = mai_do_bulk_set_module_attributes, .ids = object_id, .counts = attr_count,
+        .lists = attr_list, .mode = mode, .statuses = object_statuses
+    };
+
+    return mai_bulk_objects(&call, object_count);
+}
+
+/** @brief Worker side of a run of mai_bulk_get_module_attributes() */
+static tai_status_t mai_do_bulk_get_module_attributes(const mai_adapter_t *adapter, mai_call_t *call)
+{
+    return MAI_FORWARD(adapter->module_api, bulk_get_module_attributes, call->count,
+                       &call->ids[call->start], &call->counts[call->start],
+                       &((tai_attribute_t **)call->lists)[call->start],
+                       call->mode, &call->statuses[call->start]);
+}
+
+/** @brief Get attributes of modules, see #tai_bulk_get_module_attributes_fn */
+static tai_status_t mai_bulk_get_module_attributes(
+    _In_ uint32_t                 object_count,
+    _In_ const tai_object_id_t   *object_id,
+    _In_ const uint32_t          *attr_count,
+    _Inout_ tai_attribute_t     **attr_list,
+    _In_ tai_bulk_op_error_mode_t mode,
+    _Out_ tai_status_t           *object_statuses)
+{
+    mai_call_t call = {
+        .fn = mai_do_bulk_get_module_attributes, .ids = object_id, .counts = attr_count,
+        .lists = attr_list, .mode = mode, .statuses = object_statuses
+    };
+
+    return mai_bulk_objects(&call, object_count);
+}
+
+/** @brief Worker side of mai_create_attribute_subscription() */
+static tai_status_t mai_do_create_attribute_subscription(const mai_adapter_t *adapter,
+                                                         mai_call_t *call)
+{
+    return MAI_FORWARD(adapter->module_api, create_attribute_subscription, call->out,
+                       call->id, call->in);
+}
+
+/** @brief Subscribe to attribute samples, see #tai_create_attribute_subscription_fn */
+static tai_status_t mai_create_attribute_subscription(
+    _Out_ tai_subscription_id_t              *subscription_id,
+    _In_ tai_object_id_t                      module_id,
+    _In_ const tai_attribute_subscription_t  *subscription)
+{
+    mai_call_t call = {
+        .fn = mai_do_create_attribute_subscription, .out = subscription_id,
+        .id = module_id, .in = subscription
+    };
+
+    return mai_call(module_id, &call);
+}
+
+/** @brief Worker side of mai_remove_attribute_subscription() */
+static tai_status_t mai_do_remove_attribute_subscription(const mai_adapter_t *adapter,
+                                                         mai_call_t *call)
+{
+    return MAI_FORWARD(adapter->module_api, remove_attribute_subscription, call->id);
+}
+
+/** @brief Remove an attribute subscription, see #tai_remove_attribute_subscription_fn */
+static tai_status_t mai_remove_attribute_subscription(_In_ tai_subscription_id_t subscription_id)
+{
+    mai_call_t call = { .fn = mai_do_remove_attribute_subscription, .id = subscription_id };
+
+    return mai_call(subscription_id, &call);
+}
+
+/** @brief Worker side of mai_get_module_telemetry_snapshot() */
+static tai_status_t mai_do_get_module_telemetry_snapshot(const mai_adapter_t *adapter,
+                                                         mai_call_t *call)
+{
+    return MAI_FORWARD(adapter->module_api, get_module_telemetry_snapshot, call->id,
+                       call->inout);
+}
+
+/** @brief Read a telemetry snapshot, see #tai_get_module_telemetry_snapshot_fn */
+static tai_status_t mai_get_module_telemetry_snapshot(
+    _In_ tai_object_id_t              module_id,
+    _Inout_ tai_telemetry_snapshot_t *snapshot)
+{
+    mai_call_t call = {
+        .fn = mai_do_get_module_telemetry_snapshot, .id = module_id, .inout = snapshot
+    };
+
+    return mai_call(module_id, &call);
+}
+
+/** @brief Worker side of mai_get_module_attributes_alloc() */
+static tai_status_t mai_do_get_module_attributes_alloc(const mai_adapter_t *adapter,
+                                                       mai_call_t *call)
+{
+    tai_status_t ret;
+
+    ret = MAI_FORWARD(adapter->module_api, get_module_attributes_alloc, call->id,
+                      call->count, call->inout);
+    if ((TAI_STATUS_SUCCESS == ret) &&
+        (TAI_STATUS_SUCCESS != (ret = mai_alloc_add(call->inout, call->count, adapter)))) {
+        adapter->module_api->free_module_attributes(call->count, call->inout);
+    }
+    return ret;
+}
+
+/** @brief Get module attributes, see #tai_get_module_attributes_alloc_fn */
+static tai_status_t mai_get_module_attributes_alloc(
+    _In_ tai_object_id_t     module_id,
+    _In_ uint32_t            attr_count,
+    _Inout_ tai_attribute_t *attr_list)
+{
+    mai_call_t call = {
+        .fn = mai_do_get_module_attributes_alloc, .id = module_id, .count = attr_count,
+        .inout = attr_list
+    };
+
+    return mai_call(module_id, &call);
+}
+
+/** @brief Worker side of mai_free_module_attributes() */
+static tai_status_t mai_do_free_module_attributes(const mai_adapter_t *adapter, mai_call_t *call)
+{
+    return MAI_FORWARD(adapter->module_api, free_module_attributes, call->count, call->inout);
+}
+
+/**
+ * @brief Release the lists of mai_get_module_attributes_alloc(), in the module
+ *        adapter which allocated them, see #tai_free_module_attributes_fn
+ */
+static tai_status_t mai_free_module_attributes(
+    _In_ uint32_t         attr_count,
+    _In_ tai_attribute_t *attr_list)
+{
+    mai_call_t call = {
+        .fn = mai_do_free_module_attributes, .count = attr_count, .inout = attr_list
+    };
+    const mai_adapter_t *adapter = mai_alloc_remove(attr_list, attr_count);
+
+    if (NULL == adapter) {
+        TAI_SYSLOG_ERROR("Attribute list not returned by get_module_attributes_alloc");
+        return TAI_STATUS_INVALID_PARAMETER;
+    }
+    return mai_call_adapter((mai_adapter_t *)adapter, &call);
+}
+
+/** @brief Worker side of mai_set_module_attributes_async() */
+static tai_status_t mai_do_set_module_attributes_async(const mai_adapter_t *adapter,
+                                                       mai_call_t *call)
+{
+    return MAI_FORWARD(adapter->module_api, set_module_attributes_async, call->id,
+                       call->count, call->in, call->completion, call->context, call->out);
+}
+
+/** @brief Set module attributes asynchronously, see #tai_set_module_attributes_async_fn */
+static tai_status_t mai_set_module_attributes_async(
+    _In_ tai_object_id_t          module_id,
+    _In_ uint32_t                 attr_count,
+    _In_ const tai_attribute_t   *attr_list,
+    _In_ tai_async_completion_fn  completion,
+    _In_ void                    *context,
+    _Out_ tai_async_request_id_t *request_id)
+{
+    mai_call_t call = {
+        .fn = mai_do_set_module_attributes_async, .id = module_id, .count = attr_count,
+        .in = attr_list, .completion = completion, .context = context, .out = request_id
+    };
+
+    return mai_call(module_id, &call);
+}
+
+/** @brief Worker side of mai_get_module_attributes_async() */
+static tai_status_t mai_do_get_module_attributes_async(const mai_adapter_t *adapter,
+                                                       mai_call_t *call)
+{
+    return MAI_FORWARD(adapter->module_api, get_module_attributes_async, call->id,
+                       call->count, call->inout, call->completion, call->context, call->out);
+}
+
+/** @brief Get module attributes asynchronously, see #tai_get_module_attributes_async_fn */
+static tai_status_t mai_get_module_attributes_async(
+    _In_ tai_object_id_t          module_id,
+    _In_ uint32_t                 attr_count,
+    _Inout_ tai_attribute_t      *attr_list,
+    _In_ tai_async_completion_fn  completion,
+    _In_ void                    *context,
+    _Out_ tai_async_request_id_t *request_id)
+{
+    mai_call_t call = {
+        .fn = mai_do_get_module_attributes_async, .id = module_id, .count = attr_count,
+        .inout = attr_list, .completion = completion, .context = context, .out = request_id
+    };
+
+    return mai_call(module_id, &call);
+}
+
+/** @brief Worker side of mai_begin_transaction() */
+static tai_status_t mai_do_begin_transaction(const mai_adapter_t *adapter, mai_call_t *call)
+{
+    return MAI_FORWARD(adapter->module_api, begin_transaction, call->out, call->id);
+}
+
+/** @brief Begin a transaction on a module, see #tai_begin_transaction_fn */
+static tai_status_t mai_begin_transaction(
+    _Out_ tai_transaction_id_t *transaction_id,
+    _In_ tai_object_id_t        module_id)
+{
+    mai_call_t call = { .fn = mai_do_begin_transaction, .out = transaction_id, .id = module_id };
+
+    return mai_call(module_id, &call);
+}
+
+/** @brief Worker side of mai_stage_attributes() */
+static tai_status_t mai_do_stage_attributes(const mai_adapter_t *adapter, mai_call_t *call)
+{
+    return MAI_FORWARD(adapter->module_api, stage_attributes, call->id, call->value,
+                       call->count, call->in);
+}
+
+/** @brief Stage attribute sets in a transaction, see #tai_stage_attributes_fn */
+static tai_status_t mai_stage_attributes(
+    _In_ tai_transaction_id_t   transaction_id,
+    _In_ tai_object_id_t        object_id,
+    _In_ uint32_t               attr_count,
+    _In_ const tai_attribute_t *attr_list)
+{
+    mai_call_t call = {
+        .fn = mai_do_stage_attributes, .id = transaction_id, .value = object_id,
+        .count = attr_count, .in = attr_list
+    };
+
+    return mai_call(transaction_id, &call);
+}
+
+/** @brief Worker side of mai_commit_transaction() */
+static tai_status_t mai_do_commit_transaction(const mai_adapter_t *adapter, mai_call_t *call)
+{
+    return MAI_FORWARD(adapter->module_api, commit_transaction, call->id);
+}
+
+/** @brief Apply a transaction, see #tai_commit_transaction_fn */
+static tai_status_t mai_commit_transaction(_In_ tai_transaction_id_t transaction_id)
+{
+    mai_call_t call = { .fn = mai_do_commit_transaction, .id = transaction_id };
+
+    return mai_call(transaction_id, &call);
+}
+
+/** @brief Worker side of mai_abort_transaction() */
+static tai_status_t mai_do_abort_transaction(const mai_adapter_t *adapter, mai_call_t *call)
+{
+    return MAI_FORWARD(adapter->module_api, abort_transaction, call->id);
+}
+
+/** @brief Discard a transaction, see #tai_abort_transaction_fn */
+static tai_status_t mai_abort_transaction(_In_ tai_transaction_id_t transaction_id)
+{
+    mai_call_t call = { .fn = mai_do_abort_transaction, .id = transaction_id };
+
+    return mai_call(transaction_id, &call);
+}
+
+/** @brief Worker side of a run of mai_get_object_generations() */
+static tai_status_t mai_do_get_object_generations(const mai_adapter_t *adapter, mai_call_t *call)
+{
+    return MAI_FORWARD(adapter->module_api, get_object_generations, call->count,
+                       &((tai_object_generation_t *)call->inout)[call->start]);
+}
+
+/**
+ * @brief Read the change generations of objects of any module adapter. An
+ *        object without module adapter gets generation 0, like a removed
+ *        object. See #tai_get_object_generations_fn
+ */
+static tai_status_t mai_get_object_generations(
+    _In_ uint32_t                    object_count,
+    _Inout_ tai_object_generation_t *generations)
+{
+    mai_call_t call = {
+        .fn = mai_do_get_object_generations, .inout = generations,
+        .mode = TAI_BULK_OP_ERROR_MODE_IGNORE_ERROR
+    };
+    tai_status_t ret;
+    uint32_t *owners, idx;
+
+    if (!initialized) {
+        return TAI_STATUS_UNINITIALIZED;
+    }
+    if ((0 != object_count) && (NULL == generations)) {
+        return TAI_STATUS_INVALID_PARAMETER;
+    }
+    if (0 == object_count) {
+        return TAI_STATUS_SUCCESS;
+    }
+    if (NULL == (owners = malloc(object_count * sizeof(*owners)))) {
+        return TAI_STATUS_NO_MEMORY;
+    }
+    for (idx = 0; idx < object_count; idx++) {
+        owners[idx] = MAI_ID_ADAPTER(generations[idx].object_id);
+        if (owners[idx] >= mai_adapter_count) {
+            /* Handed to no module adapter, at generation 0 from the start */
+            owners[idx] = mai_adapter_count;
+            memset(&generations[idx].generation, 0,
+                   sizeof(generations[idx]) - sizeof(generations[idx].object_id));
+        }
+    }
+    ret = mai_bulk_call(object_count, owners, TAI_STATUS_SUCCESS, &call);
+    free(owners);
+    return ret;
+}
+
+/** @brief Worker side of mai_get_module_attributes_if_changed() */
+static tai_status_t mai_do_get_module_attributes_if_changed(const mai_adapter_t *adapter,
+                                                            mai_call_t *call)
+{
+    return MAI_FORWARD(adapter->module_api, get_module_attributes_if_changed, call->id,
+                       call->value, call->out, call->count, call->inout);
+}
+
+/** @brief Get module attributes if they changed, see #tai_get_module_attributes_if_changed_fn */
+static tai_status_t mai_get_module_attributes_if_changed(
+    _In_ tai_object_id_t    module_id,
+    _In_ tai_generation_t   generation,
+    _Out_ tai_generation_t *current_generation,
+    _In_ uint32_t           attr_count,
+    _Inout_ tai_attribute_t *attr_list)
+{
+    mai_call_t call = {
+        .fn = mai_do_get_module_attributes_if_changed, .id = module_id,
+        .value = generation, .out = current_generation, .count = attr_count,
+        .inout = attr_list
+    };
+
+    return mai_call(module_id, &call);
+}
+
+/** @brief Worker side of mai_set_attribute_threshold() */
+static tai_status_t mai_do_set_attribute_threshold(const mai_adapter_t *adapter, mai_call_t *call)
+{
+    return MAI_FORWARD(adapter->module_api, set_attribute_threshold, call->in);
+}
+
+/** @brief Set the thresholds of an attribute, see #tai_set_attribute_threshold_fn */
+static tai_status_t mai_set_attribute_threshold(_In_ const tai_attribute_threshold_t *threshold)
+{
+    mai_call_t call = { .fn = mai_do_set_attribute_threshold, .in = threshold };
+
+    if (NULL == threshold) {
+        return TAI_STATUS_INVALID_PARAMETER;
+    }
+    call.id = threshold->object_id;
+    return mai_call(threshold->object_id, &call);
+}
+
+/** @brief Worker side of mai_get_pm_bins() */
+static tai_status_t mai_do_get_pm_bins(const mai_adapter_t *adapter, mai_call_t *call)
+{
+    return MAI_FORWARD(adapter->module_api, get_pm_bins, call->id, call->interval,
+                       call->value, call->inout, call->out);
+}
+
+/** @brief Read the performance monitoring bins of a module, see #tai_get_pm_bins_fn */
+static tai_status_t mai_get_pm_bins(
+    _In_ tai_object_id_t    module_id,
+    _In_ tai_pm_interval_t  interval,
+    _In_ uint64_t           since,
+    _Inout_ uint32_t       *bin_count,
+    _Out_ tai_pm_bin_t     *bins)
+{
+    mai_call_t call = {
+        .fn = mai_do_get_pm_bins, .id = module_id, .interval = interval, .value = since,
+        .inout = bin_count, .out = bins
+    };
+
+    return mai_call(module_id, &call);
+}
+
+/**
+ * @brief The module functions of the platform adapter
+ */
+static const tai_module_api_t mai_module_api = {
+    .create_module                    = mai_create_module,
+    .remove_module                    = mai_remove_module,
+    .set_module_attribute             = mai_set_module_attribute,
+    .set_module_attributes            = mai_set_module_attributes,
+    .get_module_attribute             = mai_get_module_attribute,
+    .get_module_attributes            = mai_get_module_attributes,
+    .bulk_create_module               = mai_bulk_create_module,
+    .bulk_remove_module               = mai_bulk_remove_module,
+    .bulk_set_module_attributes       = mai_bulk_set_module_attributes,
+    .bulk_get_module_attributes       = mai_bulk_get_module_attributes,
+    .create_attribute_subscription    = mai_create_attribute_subscription,
+    .remove_attribute_subscription    = mai_remove_attribute_subscription,
+    .get_module_telemetry_snapshot    = mai_get_module_telemetry_snapshot,
+    .get_module_attributes_alloc      = mai_get_module_attributes_alloc,
+    .free_module_attributes           = mai_free_module_attributes,
+    .set_module_attributes_async      = mai_set_module_attributes_async,
+    .get_module_attributes_async      = mai_get_module_attributes_async,
+    .begin_transaction                = mai_begin_transaction,
+    .stage_attributes                 = mai_stage_attributes,
+    .commit_transaction               = mai_commit_transaction,
+    .abort_transaction                = mai_abort_transaction,
+    .get_object_generations           = mai_get_object_generations,
+    .get_module_attributes_if_changed = mai_get_module_attributes_if_changed,
+    .set_attribute_threshold          = mai_set_attribute_threshold,
+    .get_pm_bins                      = mai_get_pm_bins
+};
+
+
+/*------------------------------------------------------------------------------
+
+                           Host Interface Functions
+
+------------------------------------------------------------------------------*/
+
+#undef  __TAI_MODULE__
+#define __TAI_MODULE__ TAI_API_HOSTIF
+
+/** @brief Worker side of mai_create_host_interface() */
+static tai_status_t mai_do_create_host_interface(const mai_adapter_t *adapter, mai_call_t *call)
+{
+    return MAI_FORWARD(adapter->hostif_api, create_host_interface, call->out, call->id,
+                       call->count, call->in);
+}
+
+/** @brief Create a host interface, see #tai_create_host_interface_fn */
+static tai_status_t mai_create_host_interface(
+    _Out_ tai_object_id_t      *host_interface_id,
+    _In_ tai_object_id_t        module_id,
+    _In_ uint32_t               attr_count,
+    _In_ const tai_attribute_t *attr_list)
+{
+    mai_call_t call = {
+        .fn = mai_do_create_host_interface, .out = host_interface_id, .id = module_id,
+        .count = attr_count, .in = attr_list
+    };
+
+    return mai_call(module_id, &call);
+}
+
+/** @brief Worker side of mai_remove_host_interface() */
+static tai_status_t mai_do_remove_host_interface(const mai_adapter_t *adapter, mai_call_t *call)
+{
+    return MAI_FORWARD(adapter->hostif_api, remove_host_interface, call->id);
+}
+
+/** @brief Remove a host interface, see #tai_remove_host_interface_fn */
+static tai_status_t mai_remove_host_interface(_In_ tai_object_id_t host_interface_id)
+{
+    mai_call_t call = { .fn = mai_do_remove_host_interface, .id = host_interface_id };
+
+    return mai_call(host_interface_id, &call);
+}
+
+/** @brief Worker side of mai_set_host_interface_attribute() */
+static tai_status_t mai_do_set_host_interface_attribute(const mai_adapter_t *adapter,
+                                                        mai_call_t *call)
+{
+    return MAI_FORWARD(adapter->hostif_api, set_host_interface_attribute, call->id, call->in);
+}
+
+/** @brief Set a host interface attribute, see #tai_set_host_interface_attribute_fn */
+static tai_status_t mai_set_host_interface_attribute(
+    _In_ tai_object_id_t        host_interface_id,
+    _In_ const tai_attribute_t *attr)
+{
+    mai_call_t call = {
+        .fn = mai_do_set_host_interface_attribute, .id = host_interface_id, .in = attr
+    };
+
+    return mai_call(host_interface_id, &call);
+}
+
+/** @brief Worker side of mai_set_host_interface_attributes() */
+static tai_status_t mai_do_set_host_interface_attributes(const mai_adapter_t *adapter,
+                                                         mai_call_t *call)
+{
+    return MAI_FORWARD(adapter->hostif_api, set_host_interface_attributes, call->id,
+                       call->count, call->in);
+}
+
+/** @brief Set host interface attributes, see #tai_set_host_interface_attributes_fn */
+static tai_status_t mai_set_host_interface_attributes(
+    _In_ tai_object_id_t        host_interface_id,
+    _In_ uint32_t               attr_count,
+    _In_ const tai_attribute_t *attr_list)
+{
+    mai_call_t call = {
+        .fn = mai_do_set_host_interface_attributes, .id = host_interface_id,
+        .count = attr_count, .in = attr_list
+    };
+
+    return mai_call(host_interface_id, &call);
+}
+
+/** @brief Worker side of mai_get_host_interface_attribute() */
+static tai_status_t mai_do_get_host_interface_attribute(const mai_adapter_t *adapter,
+                                                        mai_call_t *call)
+{
+    return MAI_FORWARD(adapter->hostif_api, get_host_interface_attribute, call->id,
+                       call->inout);
+}
+
+/** @brief Get a host interface attribute, see #tai_get_host_interface_attribute_fn */
+static tai_status_t mai_get_host_interface_attribute(
+    _In_ tai_object_id_t     host_interface_id,
+    _Inout_ tai_attribute_t *attr)
+{
+    mai_call_t call = {
+        .fn = mai_do_get_host_interface_attribute, .id = host_interface_id, .inout = attr
+    };
+
+    return mai_call(host_interface_id, &call);
+}
+
+/** @brief Worker side of mai_get_host_interface_attributes() */
+static tai_status_t mai_do_get_host_interface_attributes(const mai_adapter_t *adapter,
+                                                         mai_call_t *call)
+{
+    return MAI_FORWARD(adapter->hostif_api, get_host_interface_attributes, call->id,
+                       call->count, call->inout);
+}
+
+/** @brief Get host interface attributes, see #tai_get_host_interface_attributes_fn */
+static tai_status_t mai_get_host_interface_attributes(
+    _In_ tai_object_id_t     host_interface_id,
+    _In_ uint32_t            attr_count,
+    _Inout_ tai_attribute_t *attr_list)
+{
+    mai_call_t call = {
+        .fn = mai_do_get_host_interface_attributes, .id = host_interface_id,
+        .count = attr_count, .inout = attr_list
+    };
+
+    return mai_call(host_interface_id, &call);
+}
+
+/** @brief Worker side of mai_bulk_create_host_interface() */
+static tai_status_t mai_do_bulk_create_host_interface(const mai_adapter_t *adapter,
+                                                      mai_call_t *call)
+{
+    return MAI_FORWARD(adapter->hostif_api, bulk_create_host_interface, call->id,
+                       call->count, call->counts, (const tai_attribute_t **)call->lists,
+                       call->mode, call->out, call->statuses);
+}
+
+/** @brief Create host interfaces of a module, see #tai_bulk_create_host_interface_fn */
+static tai_status_t mai_bulk_create_host_interface(
+    _In_ tai_object_id_t          module_id,
+    _In_ uint32_t                 object_count,
+    _In_ const uint32_t          *attr_count,
+    _In_ const tai_attribute_t  **attr_list,
+    _In_ tai_bulk_op_error_mode_t mode,
+    _Out_ tai_object_id_t        *object_id,
+    _Out_ tai_status_t           *object_statuses)
+{
+    mai_call_t call = {
+        .fn = mai_do_bulk_create_host_interface, .id = module_id, .count = object_count,
+        .counts = attr_count, .lists = attr_list, .mode = mode, .out = object_id,
+        .statuses = object_statuses
+    };
+
+    return mai_call(module_id, &call);
+}
+
+/** @brief Worker side of a run of mai_bulk_remove_host_interface() */
+static tai_status_t mai_do_bulk_remove_host_interface(const mai_adapter_t *adapter,
+                                                      mai_call_t *call)
+{
+    return MAI_FORWARD(adapter->hostif_api, bulk_remove_host_interface, call->count,
+                       &call->ids[call->start], call->mode, &call->statuses[call->start]);
+}
+
+/** @brief Remove host interfaces, see #tai_bulk_remove_host_interface_fn */
+static tai_status_t mai_bulk_remove_host_interface(
+    _In_ uint32_t                 object_count,
+    _In_ const tai_object_id_t   *object_id,
+    _In_ tai_bulk_op_error_mode_t mode,
+    _Out_ tai_status_t           *object_statuses)
+{
+    mai_call_t call = {
+        .fn = mai_do_bulk_remove_host_interface, .ids = object_id, .mode = mode,
+        .statuses = object_statuses
+    };
+
+    return mai_bulk_objects(&call, object_count);
+}
+
+/** @brief Worker side of a run of mai_bulk_set_host_interface_attributes() */
+static tai_status_t mai_do_bulk_set_host_interface_attributes(const mai_adapter_t *adapter,
+                                                             mai_call_t *call)
+{
+    return MAI_FORWARD(adapter->hostif_api, bulk_set_host_interface_attributes, call->count,
+                       &call->ids[call->start], &call->counts[call->start],
+                       &((const tai_attribute_t **)call->lists)[call->start],
+                       call->mode, &call->statuses[call->start]);
+}
+
+/** @brief Set attributes of host interfaces, see #tai_bulk_set_host_interface_attributes_fn */
+static tai_status_t mai_bulk_set_host_interface_attributes(
+    _In_ uint32_t                 object_count,
+    _In_ const tai_object_id_t   *object_id,
+    _In_ const uint32_t          *attr_count,
+    _In_ const tai_attribute_t  **attr_list,
+    _In_ tai_bulk_op_error_mode_t mode,
+    _Out_ tai_status_t           *object_statuses)
+{
+    mai_call_t call = {
+        .fn = mai_do_bulk_set_host_interface_attributes, .ids = object_id,
+        .counts = attr_count, .lists = attr_list, .mode = mode,
+        .statuses = object_statuses
+    };
+
+    return mai_bulk_objects(&call, object_count);
+}
+
+/** @brief Worker side of a run of mai_bulk_get_host_interface_attributes() */
+static tai_status_t mai_do_bulk_get_host_interface_attributes(const mai_adapter_t *adapter,
+                                                             mai_call_t *call)
+{
+    return MAI_FORWARD(adapter->hostif_api, bulk_get_host_interface_attributes, call->count,
+                       &call->ids[call->start], &call->counts[call->start],
+                       &((tai_attribute_t **)call->lists)[call->start],
+                       call->mode, &call->statuses[call->start]);
+}
+
+/** @brief Get attributes of host interfaces, see #tai_bulk_get_host_interface_attributes_fn */
+static tai_status_t mai_bulk_get_host_interface_attributes(
+    _In_ uint32_t                 object_count,
+    _In_ const tai_object_id_t   *object_id,
+    _In_ const uint32_t          *attr_count,
+    _Inout_ tai_attribute_t     **attr_list,
+    _In_ tai_bulk_op_error_mode_t mode,
+    _Out_ tai_status_t           *object_statuses)
+{
+    mai_call_t call = {
+        .fn = mai_do_bulk_get_host_interface_attributes, .ids = object_id,
+        .counts = attr_count, .lists = attr_list, .mode = mode,
+        .statuses = object_statuses
+    };
+
+    return mai_bulk_objects(&call, object_count);
+}
+
+/** @brief Worker side of mai_get_host_interface_attributes_alloc() */
+static tai_status_t mai_do_get_host_interface_attributes_alloc(const mai_adapter_t *adapter,
+                                                               mai_call_t *call)
+{
+    tai_status_t ret;
+
+    ret = MAI_FORWARD(adapter->hostif_api, get_host_interface_attributes_alloc, call->id,
+                      call->count, call->inout);
+    if ((TAI_STATUS_SUCCESS == ret) &&
+        (TAI_STATUS_SUCCESS != (ret = mai_alloc_add(call->inout, call->count, adapter)))) {
+        adapter->hostif_api->free_host_interface_attributes(call->count, call->inout);
+    }
+    return ret;
+}
+
+/** @brief Get host interface attributes, see #tai_get_host_interface_attributes_alloc_fn */
+static tai_status_t mai_get_host_interface_attributes_alloc(
+    _In_ tai_object_id_t     host_interface_id,
+    _In_ uint32_t            attr_count,
+    _Inout_ tai_attribute_t *attr_list)
+{
+    mai_call_t call = {
+        .fn = mai_do_get_host_interface_attributes_alloc, .id = host_interface_id,
+        .count = attr_count, .inout = attr_list
+    };
+
+    return mai_call(host_interface_id, &call);
+}
+
+/** @brief Worker side of mai_free_host_interface_attributes() */
+static tai_status_t mai_do_free_host_interface_attributes(const mai_adapter_t *adapter,
+                                                          mai_call_t *call)
+{
+    return MAI_FORWARD(adapter->hostif_api, free_host_interface_attributes, call->count,
+                       call->inout);
+}
+
+/**
+ * @brief Release the lists of mai_get_host_interface_attributes_alloc(), see
+ *        #tai_free_host_interface_attributes_fn
+ */
+static tai_status_t mai_free_host_interface_attributes(
+    _In_ uint32_t         attr_count,
+    _In_ tai_attribute_t *attr_list)
+{
+    mai_call_t call = {
+        .fn = mai_do_free_host_interface_attributes, .count = attr_count,
+        .inout = attr_list
+    };
+    const mai_adapter_t *adapter = mai_alloc_remove(attr_list, attr_count);
+
+    if (NULL == adapter) {
+        TAI_SYSLOG_ERROR("Attribute list not returned by get_host_interface_attributes_alloc");
+        return TAI_STATUS_INVALID_PARAMETER;
+    }
+    return mai_call_adapter((mai_adapter_t *)adapter, &call);
+}
+
+/** @brief Worker side of mai_set_host_interface_attributes_async() */
+static tai_status_t mai_do_set_host_interface_attributes_async(const mai_adapter_t *adapter,
+                                                               mai_call_t *call)
+{
+    return MAI_FORWARD(adapter->hostif_api, set_host_interface_attributes_async, call->id,
+                       call->count, call->in, call->completion, call->context, call->out);
+}
+
+/**
+ * @brief Set host interface attributes asynchronously, see
+ *        #tai_set_host_interface_attributes_async_fn
+ */
+static tai_status_t mai_set_host_interface_attributes_async(
+    _In_ tai_object_id_t          host_interface_id,
+    _In_ uint32_t                 attr_count,
+    _In_ const tai_attribute_t   *attr_list,
+    _In_ tai_async_completion_fn  completion,
+    _In_ void                    *context,
+    _Out_ tai_async_request_id_t *request_id)
+{
+    mai_call_t call = {
+        .fn = mai_do_set_host_interface_attributes_async, .id = host_interface_id,
+        .count = attr_count, .in = attr_list, .completion = completion,
+        .context = context, .out = request_id
+    };
+
+    return mai_call(host_interface_id, &call);
+}
+
+/** @brief Worker side of mai_get_host_interface_attributes_async() */
+static tai_status_t mai_do_get_host_interface_attributes_async(const mai_adapter_t *adapter,
+                                                               mai_call_t *call)
+{
+    return MAI_FORWARD(adapter->hostif_api, get_host_interface_attributes_async, call->id,
+                       call->count, call->inout, call->completion, call->context, call->out);
+}
+
+/**
+ * @brief Get host interface attributes asynchronously, see
+ *        #tai_get_host_interface_attributes_async_fn
+ */
+static tai_status_t mai_get_host_interface_attributes_async(
+    _In_ tai_object_id_t          host_interface_id,
+    _In_ uint32_t                 attr_count,
+    _Inout_ tai_attribute_t      *attr_list,
+    _In_ tai_async_completion_fn  completion,
+    _In_ void                    *context,
+    _Out_ tai_async_request_id_t *request_id)
+{
+    mai_call_t call = {
+        .fn = mai_do_get_host_interface_attributes_async, .id = host_interface_id,
+        .count = attr_count, .inout = attr_list, .completion = completion,
+        .context = context, .out = request_id
+    };
+
+    return mai_call(host_interface_id, &call);
+}
+
+/**
+ * @brief The host interface functions of the platform adapter
+ */
+static const tai_host_interface_api_t mai_host_interface_api = {
+    .create_host_interface               = mai_create_host_interface,
+    .remove_host_interface               = mai_remove_host_interface,
+    .set_host_interface_attribute        = mai_set_host_interface_attribute,
+    .set_host_interface_attributes       = mai_set_host_interface_attributes,
+    .get_host_interface_attribute        = mai_get_host_interface_attribute,
+    .get_host_interface_attributes       = mai_get_host_interface_attributes,
+    .bulk_create_host_interface          = mai_bulk_create_host_interface,
+    .bulk_remove_host_interface          = mai_bulk_remove_host_interface,
+    .bulk_set_host_interface_attributes  = mai_bulk_set_host_interface_attributes,
+    .bulk_get_host_interface_attributes  = mai_bulk_get_host_interface_attributes,
+    .get_host_interface_attributes_alloc = mai_get_host_interface_attributes_alloc,
+    .free_host_interface_attributes      = mai_free_host_interface_attributes,
+    .set_host_interface_attributes_async = mai_set_host_interface_attributes_async,
+    .get_host_interface_attributes_async = mai_get_host_interface_attributes_async
+};
+
+
+/*------------------------------------------------------------------------------
+
+                          Network Interface Functions
+
+------------------------------------------------------------------------------*/
+
+#undef  __TAI_MODULE__
+#define __TAI_MODULE__ TAI_API_NETWORKIF
+
+/** @brief Worker side of mai_create_network_interface() */
+static tai_status_t mai_do_create_network_interface(const mai_adapter_t *adapter,
+                                                    mai_call_t *call)
+{
+    return MAI_FORWARD(adapter->netif_api, create_network_interface, call->out, call->id,
+                       call->count, call->in);
+}
+
+/** @brief Create a network interface, see #tai_create_network_interface_fn */
+static tai_status_t mai_create_network_interface(
+    _Out_ tai_object_id_t      *network_interface_id,
+    _In_ tai_object_id_t        module_id,
+    _In_ uint32_t               attr_count,
+    _In_ const tai_attribute_t *attr_list)
+{
+    mai_call_t call = {
+        .fn = mai_do_create_network_interface, .out = network_interface_id,
+        .id = module_id, .count = attr_count, .in = attr_list
+    };
+
+    return mai_call(module_id, &call);
+}
+
+/** @brief Worker side of mai_remove_network_interface() */
+static tai_status_t mai_do_remove_network_interface(const mai_adapter_t *adapter,
+                                                    mai_call_t *call)
+{
+    return MAI_FORWARD(adapter->netif_api, remove_network_interface, call->id);
+}
+
+/** @brief Remove a network interface, see #tai_remove_network_interface_fn */
+static tai_status_t mai_remove_network_interface(_In_ tai_object_id_t network_interface_id)
+{
+    mai_call_t call = { .fn = mai_do_remove_network_interface, .id = network_interface_id };
+
+    return mai_call(network_interface_id, &call);
+}
+
+/** @brief Worker side of mai_set_network_interface_attribute() */
+static tai_status_t mai_do_set_network_interface_attribute(const mai_adapter_t *adapter,
+                                                           mai_call_t *call)
+{
+    return MAI_FORWARD(adapter->netif_api, set_network_interface_attribute, call->id,
+                       call->in);
+}
+
+/** @brief Set a network interface attribute, see #tai_set_network_interface_attribute_fn */
+static tai_status_t mai_set_network_interface_attribute(
+    _In_ tai_object_id_t        network_interface_id,
+    _In_ const tai_attribute_t *attr)
+{
+    mai_call_t call = {
+        .fn = mai_do_set_network_interface_attribute, .id = network_interface_id,
+        .in = attr
+    };
+
+    return mai_call(network_interface_id, &call);
+}
+
+/** @brief Worker side of mai_set_network_interface_attributes() */
+static tai_status_t mai_do_set_network_interface_attributes(const mai_adapter_t *adapter,
+                                                            mai_call_t *call)
+{
+    return MAI_FORWARD(adapter->netif_api, set_network_interface_attributes, call->id,
+                       call->count, call->in);
+}
+
+/** @brief Set network interface attributes, see #tai_set_network_interface_attributes_fn */
+static tai_status_t mai_set_network_interface_attributes(
+    _In_ tai_object_id_t        network_interface_id,
+    _In_ uint32_t               attr_count,
+    _In_ const tai_attribute_t *attr_list)
+{
+    mai_call_t call = {
+        .fn = mai_do_set_network_interface_attributes, .id = network_interface_id,
+        .count = attr_count, .in = attr_list
+    };
+
+    return mai_call(network_interface_id, &call);
+}
+
+/** @brief Worker side of mai_get_network_interface_attribute() */
+static tai_status_t mai_do_get_network_interface_attribute(const mai_adapter_t *adapter,
+                                                           mai_call_t *call)
+{
+    return MAI_FORWARD(adapter->netif_api, get_network_interface_attribute, call->id,
+                       call->inout);
+}
+
+/** @brief Get a network interface attribute, see #tai_get_network_interface_attribute_fn */
+static tai_status_t mai_get_network_interface_attribute(
+    _In_ tai_object_id_t     network_interface_id,
+    _Inout_ tai_attribute_t *attr)
+{
+    mai_call_t call = {
+        .fn = mai_do_get_network_interface_attribute, .id = network_interface_id,
+        .inout = attr
+    };
+
+    return mai_call(network_interface_id, &call);
+}
+
+/** @brief Worker side of mai_get_network_interface_attributes() */
+static tai_status_t mai_do_get_network_interface_attributes(const mai_adapter_t *adapter,
+                                                            mai_call_t *call)
+{
+    return MAI_FORWARD(adapter->netif_api, get_network_interface_attributes, call->id,
+                       call->count, call->inout);
+}
+
+/** @brief Get network interface attributes, see #tai_get_network_interface_attributes_fn */
+static tai_status_t mai_get_network_interface_attributes(
+    _In_ tai_object_id_t     network_interface_id,
+    _In_ uint32_t            attr_count,
+    _Inout_ tai_attribute_t *attr_list)
+{
+    mai_call_t call = {
+        .fn = mai_do_get_network_interface_attributes, .id = network_interface_id,
+        .count = attr_count, .inout = attr_list
+    };
+
+    return mai_call(network_interface_id, &call);
+}
+
+/** @brief Worker side of mai_bulk_create_network_interface() */
+static tai_status_t mai_do_bulk_create_network_interface(const mai_adapter_t *adapter,
+                                                         mai_call_t *call)
+{
+    return MAI_FORWARD(adapter->netif_api, bulk_create_network_interface, call->id,
+                       call->count, call->counts, (const tai_attribute_t **)call->lists,
+                       call->mode, call->out, call->statuses);
+}
+
+/** @brief Create network interfaces of a module, see #tai_bulk_create_network_interface_fn */
+static tai_status_t mai_bulk_create_network_interface(
+    _In_ tai_object_id_t          module_id,
+    _In_ uint32_t                 object_count,
+    _In_ const uint32_t          *attr_count,
+    _In_ const tai_attribute_t  **attr_list,
+    _In_ tai_bulk_op_error_mode_t mode,
+    _Out_ tai_object_id_t        *object_id,
+    _Out_ tai_status_t           *object_statuses)
+{
+    mai_call_t call = {
+        .fn = mai_do_bulk_create_network_interface, .id = module_id,
+        .count = object_count, .counts = attr_count, .lists = attr_list, .mode = mode,
+        .out = object_id, .statuses = object_statuses
+    };
+
+    return mai_call(module_id, &call);
+}
+
+/** @brief Worker side of a run of mai_bulk_remove_network_interface() */
+static tai_status_t mai_do_bulk_remove_network_interface(const mai_adapter_t *adapter,
+                                                         mai_call_t *call)
+{
+    return MAI_FORWARD(adapter->netif_api, bulk_remove_network_interface, call->count,
+                       &call->ids[call->start], call->mode, &call->statuses[call->start]);
+}
+
+/** @brief Remove network interfaces, see #tai_bulk_remove_network_interface_fn */
+static tai_status_t mai_bulk_remove_network_interface(
+    _In_ uint32_t                 object_count,
+    _In_ const tai_object_id_t   *object_id,
+    _In_ tai_bulk_op_error_mode_t mode,
+    _Out_ tai_status_t           *object_statuses)
+{
+    mai_call_t call = {
+        .fn = mai_do_bulk_remove_network_interface, .ids = object_id, .mode = mode,
+        .statuses = object_statuses
+    };
+
+    return mai_bulk_objects(&call, object_count);
+}
+
+/** @brief Worker side of a run of mai_bulk_set_network_interface_attributes() */
+static tai_status_t mai_do_bulk_set_network_interface_attributes(const mai_adapter_t *adapter,
+                                                                mai_call_t *call)
+{
+    return MAI_FORWARD(adapter->netif_api, bulk_set_network_interface_attributes,
+                       call->count, &call->ids[call->start], &call->counts[call->start],
+                       &((const tai_attribute_t **)call->lists)[call->start],
+                       call->mode, &call->statuses[call->start]);
+}
+
+/**
+ * @brief Set attributes of network interfaces, see
+ *        #tai_bulk_set_network_interface_attributes_fn
+ */
+static tai_status_t mai_bulk_set_network_interface_attributes(
+    _In_ uint32_t                 object_count,
+    _In_ const tai_object_id_t   *object_id,
+    _In_ const uint32_t          *attr_count,
+    _In_ const tai_attribute_t  **attr_list,
+    _In_ tai_bulk_op_error_mode_t mode,
+    _Out_ tai_status_t           *object_statuses)
+{
+    mai_call_t call = {
+        .fn = mai_do_bulk_set_network_interface_attributes, .ids = object_id,
+        .counts = attr_count, .lists = attr_list, .mode = mode,
+        .statuses = object_statuses
+    };
+
+    return mai_bulk_objects(&call, object_count);
+}
+
+/** @brief Worker side of a run of mai_bulk_get_network_interface_attributes() */
+static tai_status_t mai_do_bulk_get_network_interface_attributes(const mai_adapter_t *adapter,
+                                                                mai_call_t *call)
+{
+    return MAI_FORWARD(adapter->netif_api, bulk_get_network_interface_attributes,
+                       call->count, &call->ids[call->start], &call->counts[call->start],
+                       &((tai_attribute_t **)call->lists)[call->start],
+                       call->mode, &call->statuses[call->start]);
+}
+
+/**
+ * @brief Get attributes of network interfaces, see
+ *        #tai_bulk_get_network_interface_attributes_fn
+ */
+static tai_status_t mai_bulk_get_network_interface_attributes(
+    _In_ uint32_t                 object_count,
+    _In_ const tai_object_id_t   *object_id,
+    _In_ const uint32_t          *attr_count,
+    _Inout_ tai_attribute_t     **attr_list,
+    _In_ tai_bulk_op_error_mode_t mode,
+    _Out_ tai_status_t           *object_statuses)
+{
+    mai_call_t call = {
+        .fn = mai_do_bulk_get_network_interface_attributes, .ids = object_id,
+        .counts = attr_count, .lists = attr_list, .mode = mode,
+        .statuses = object_statuses
+    };
+
+    return mai_bulk_objects(&call, object_count);
+}
+
+/** @brief Worker side of mai_get_network_interface_attributes_alloc() */
+static tai_status_t mai_do_get_network_interface_attributes_alloc(const mai_adapter_t *adapter,
+                                                                  mai_call_t *call)
+{
+    tai_status_t ret;
+
+    ret = MAI_FORWARD(adapter->netif_api, get_network_interface_attributes_alloc, call->id,
+                      call->count, call->inout);
+    if ((TAI_STATUS_SUCCESS == ret) &&
+        (TAI_STATUS_SUCCESS != (ret = mai_alloc_add(call->inout, call->count, adapter)))) {
+        adapter->netif_api->free_network_interface_attributes(call->count, call->inout);
+    }
+    return ret;
+}
+
+/**
+ * @brief Get network interface attributes, see
+ *        #tai_get_network_interface_attributes_alloc_fn
+ */
+static tai_status_t mai_get_network_interface_attributes_alloc(
+    _In_ tai_object_id_t     network_interface_id,
+    _In_ uint32_t            attr_count,
+    _Inout_ tai_attribute_t *attr_list)
+{
+    mai_call_t call = {
+        .fn = mai_do_get_network_interface_attributes_alloc, .id = network_interface_id,
+        .count = attr_count, .inout = attr_list
+    };
+
+    return mai_call(network_interface_id, &call);
+}
+
+/** @brief Worker side of mai_free_network_interface_attributes() */
+static tai_status_t mai_do_free_network_interface_attributes(const mai_adapter_t *adapter,
+                                                             mai_call_t *call)
+{
+    return MAI_FORWARD(adapter->netif_api, free_network_interface_attributes, call->count,
+                       call->inout);
+}
+
+/**
+ * @brief Release the lists of mai_get_network_interface_attributes_alloc(),
+ *        see #tai_free_network_interface_attributes_fn
+ */
+static tai_status_t mai_free_network_interface_attributes(
+    _In_ uint32_t         attr_count,
+    _In_ tai_attribute_t *attr_list)
+{
+    mai_call_t call = {
+        .fn = mai_do_free_network_interface_attributes, .count = attr_count,
+        .inout = attr_list
+    };
+    const mai_adapter_t *adapter = mai_alloc_remove(attr_list, attr_count);
+
+    if (NULL == adapter) {
+        TAI_SYSLOG_ERROR("Attribute list not returned by get_network_interface_attributes_alloc");
+        return TAI_STATUS_INVALID_PARAMETER;
+    }
+    return mai_call_adapter((mai_adapter_t *)adapter, &call);
+}
+
+/** @brief Worker side of mai_set_network_interface_attributes_async() */
+static tai_status_t mai_do_set_network_interface_attributes_async(const mai_adapter_t *adapter,
+                                                                  mai_call_t *call)
+{
+    return MAI_FORWARD(adapter->netif_api, set_network_interface_attributes_async, call->id,
+                       call->count, call->in, call->completion, call->context, call->out);
+}
+
+/**
+ * @brief Set network interface attributes asynchronously, see
+ *        #tai_set_network_interface_attributes_async_fn
+ */
+static tai_status_t mai_set_network_interface_attributes_async(
+    _In_ tai_object_id_t          network_interface_id,
+    _In_ uint32_t                 attr_count,
+    _In_ const tai_attribute_t   *attr_list,
+    _In_ tai_async_completion_fn  completion,
+    _In_ void                    *context,
+    _Out_ tai_async_request_id_t *request_id)
+{
+    mai_call_t call = {
+        .fn = mai_do_set_network_interface_attributes_async, .id = network_interface_id,
+        .count = attr_count, .in = attr_list, .completion = completion,
+        .context = context, .out = request_id
+    };
+
+    return mai_call(network_interface_id, &call);
+}
+
+/** @brief Worker side of mai_get_network_interface_attributes_async() */
+static tai_status_t mai_do_get_network_interface_attributes_async(const mai_adapter_t *adapter,
+                                                                  mai_call_t *call)
+{
+    return MAI_FORWARD(adapter->netif_api, get_network_interface_attributes_async, call->id,
+                       call->count, call->inout, call->completion, call->context, call->out);
+}
+
+/**
+ * @brief Get network interface attributes asynchronously, see
+ *        #tai_get_network_interface_attributes_async_fn
+ */
+static tai_status_t mai_get_network_interface_attributes_async(
+    _In_ tai_object_id_t          network_interface_id,
+    _In_ uint32_t                 attr_count,
+    _Inout_ tai_attribute_t      *attr_list,
+    _In_ tai_async_completion_fn  completion,
+    _In_ void                    *context,
+    _Out_ tai_async_request_id_t *request_id)
+{
+    mai_call_t call = {
+        .fn = mai_do_get_network_interface_attributes_async, .id = network_interface_id,
+        .count = attr_count, .inout = attr_list, .completion = completion,
+        .context = context, .out = request_id
+    };
+
+    return mai_call(network_interface_id, &call);
+}
+
+/** @brief Worker side of mai_get_network_interface_attributes_if_changed() */
+static tai_status_t mai_do_get_network_interface_attributes_if_changed(
+    const mai_adapter_t *adapter, mai_call_t *call)
+{
+    return MAI_FORWARD(adapter->netif_api, get_network_interface_attributes_if_changed,
+                       call->id, call->value, call->out, call->count, call->inout);
+}
+
+/**
+ * @brief Get network interface attributes if they changed, see
+ *        #tai_get_network_interface_attributes_if_changed_fn
+ */
+static tai_status_t mai_get_network_interface_attributes_if_changed(
+    _In_ tai_object_id_t     network_interface_id,
+    _In_ tai_generation_t    generation,
+    _Out_ tai_generation_t  *current_generation,
+    _In_ uint32_t            attr_count,
+    _Inout_ tai_attribute_t *attr_list)
+{
+    mai_call_t call = {
+        .fn = mai_do_get_network_interface_attributes_if_changed, .id = network_interface_id,
+        .value = generation, .out = current_generation, .count = attr_count,
+        .inout = attr_list
+    };
+
+    return mai_call(network_interface_id, &call);
+}
+
+/**
+ * @brief The network interface functions of the platform adapter
+ */
+static const tai_network_interface_api_t mai_network_interface_api = {
+    .create_network_interface                    = mai_create_network_interface,
+    .remove_network_interface                    = mai_remove_network_interface,
+    .set_network_interface_attribute             = mai_set_network_interface_attribute,
+    .set_network_interface_attributes            = mai_set_network_interface_attributes,
+    .get_network_interface_attribute             = mai_get_network_interface_attribute,
+    .get_network_interface_attributes            = mai_get_network_interface_attributes,
+    .bulk_create_network_interface               = mai_bulk_create_network_interface,
+    .bulk_remove_network_interface               = mai_bulk_remove_network_interface,
+    .bulk_set_network_interface_attributes       = mai_bulk_set_network_interface_attributes,
+    .bulk_get_network_interface_attributes       = mai_bulk_get_network_interface_attributes,
+    .get_network_interface_attributes_alloc      = mai_get_network_interface_attributes_alloc,
+    .free_network_interface_attributes           = mai_free_network_interface_attributes,
+    .set_network_interface_attributes_async      = mai_set_network_interface_attributes_async,
+    .get_network_interface_attributes_async      = mai_get_network_interface_attributes_async,
+    .get_network_interface_attributes_if_changed = mai_get_network_interface_attributes_if_changed
+};
+
+
+/*------------------------------------------------------------------------------
+
+                               TAI API Functions
+
+------------------------------------------------------------------------------*/
+
+#undef  __TAI_MODULE__
+#define __TAI_MODULE__ TAI_API_UNSPECIFIED
+
+/**
+ * @brief Unload a module adapter, after stopping its worker
+ *
+ * @param [in,out] adapter The module adapter
+ * @param [in] initialized Whether mai_api_initialize() succeeded
+ */
+static void mai_adapter_unload(
+    _Inout_ mai_adapter_t *adapter,
+    _In_ bool              initialized)
+{
+    if (adapter->worker_started) {
+        pthread_mutex_lock(&adapter->lock);
+        adapter->stopping = true;
+        pthread_cond_signal(&adapter->cond);
+        pthread_mutex_unlock(&adapter->lock);
+        pthread_join(adapter->worker, NULL);
+    }
+    pthread_cond_destroy(&adapter->cond);
+    pthread_mutex_destroy(&adapter->lock);
+    if (initialized && (TAI_STATUS_SUCCESS != adapter->api_uninitialize())) {
+        TAI_SYSLOG_ERROR("Failed to uninitialize %s", adapter->path);
+    }
+    if (NULL != adapter->handle) {
+        dlclose(adapter->handle);
+    }
+    free(adapter->path);
+    memset(adapter, 0, sizeof(*adapter));
+}
+
+/**
+ * @brief Load and initialize a module adapter and start its worker
+ *
+ * @param [out] adapter The module adapter
+ * @param [in] index The index of the module adapter
+ * @param [in] path The module adapter library, as given to dlopen()
+ * @param [in] flags The flags of tai_api_initialize()
+ *
+ * @return TAI_STATUS_SUCCESS on success, failure status code on error
+ */
+static tai_status_t mai_adapter_load(
+    _Out_ mai_adapter_t *adapter,
+    _In_ uint32_t        index,
+    _In_ const char     *path,
+    _In_ uint64_t        flags)
+{
+    mai_service_method_table_t services = {
+        .context               = adapter,
+        .module_presence       = mai_module_presence,
+        .module_presence_batch = (NULL != adapter_host_fns.module_presence_batch) ?
+                                 mai_module_presence_batch : NULL,
+        .id_prefix             = (uint64_t)(index + 1) << MAI_ID_PREFIX_SHIFT,
+        .location_base         = index * TAI_MAX_MODULES
+    };
+    tai_status_t ret;
+
+    memset(adapter, 0, sizeof(*adapter));
+    adapter->index = index;
+    adapter->path = strdup(path);
+    pthread_mutex_init(&adapter->lock, NULL);
+    pthread_cond_init(&adapter->cond, NULL);
+    adapter->handle = dlopen(path, RTLD_NOW | RTLD_LOCAL);
+    if ((NULL == adapter->path) || (NULL == adapter->handle)) {
+        TAI_SYSLOG_ERROR("Failed to load the module adapter %s: %s", path, dlerror());
+        mai_adapter_unload(adapter, false);
+        return TAI_STATUS_FAILURE;
+    }
+    adapter->api_initialize = (mai_api_initialize_fn)dlsym(adapter->handle, "mai_api_initialize");
+    adapter->api_query = (mai_api_query_fn)dlsym(adapter->handle, "mai_api_query");
+    adapter->api_uninitialize = (mai_api_uninitialize_fn)dlsym(adapter->handle, "mai_api_uninitialize");
+    adapter->log_set = (mai_log_set_fn)dlsym(adapter->handle, "mai_log_set");
+    adapter->object_type_query = (mai_object_type_query_fn)dlsym(adapter->handle,
+                                                                 "mai_object_type_query");
+    adapter->module_id_query = (mai_module_id_query_fn)dlsym(adapter->handle,
+                                                             "mai_module_id_query");
+    adapter->dbg_generate_dump = (mai_dbg_generate_dump_fn)dlsym(adapter->handle,
+                                                                 "mai_dbg_generate_dump");
+    if ((NULL == adapter->api_initialize) || (NULL == adapter->api_query) ||
+        (NULL == adapter->api_uninitialize) || (NULL == adapter->log_set) ||
+        (NULL == adapter->object_type_query) || (NULL == adapter->module_id_query) ||
+        (NULL == adapter->dbg_generate_dump)) {
+        TAI_SYSLOG_ERROR("%s is not a module adapter", path);
+        mai_adapter_unload(adapter, false);
+        return TAI_STATUS_FAILURE;
+    }
+
+    ret = adapter->api_initialize(flags, &services);
+    if (TAI_STATUS_SUCCESS != ret) {
+        TAI_SYSLOG_ERROR("Failed to initialize %s: %d", path, ret);
+        mai_adapter_unload(adapter, false);
+        return ret;
+    }
+    if ((TAI_STATUS_SUCCESS != (ret = adapter->api_query(TAI_API_MODULE,
+                                                         (void **)&adapter->module_api))) ||
+        (TAI_STATUS_SUCCESS != (ret = adapter->api_query(TAI_API_HOSTIF,
+                                                         (void **)&adapter->hostif_api))) ||
+        (TAI_STATUS_SUCCESS != (ret = adapter->api_query(TAI_API_NETWORKIF,
+                                                         (void **)&adapter->netif_api)))) {
+        TAI_SYSLOG_ERROR("Failed to query the method tables of %s: %d", path, ret);
+        mai_adapter_unload(adapter, true);
+        return ret;
+    }
+    if (0 != pthread_create(&adapter->worker, NULL, mai_worker, adapter)) {
+        TAI_SYSLOG_ERROR("Failed to start the worker of %s", path);
+        mai_adapter_unload(adapter, true);
+        return TAI_STATUS_FAILURE;
+    }
+    adapter->worker_started = true;
+    TAI_SYSLOG_NOTICE("Loaded the module adapter %s, locations from %u", path,
+                      services.location_base + 1);
+    return TAI_STATUS_SUCCESS;
+}
+
+/**
+ *  @brief  Adapter module initialization call. Loads the module adapters
+ *          listed in TAI_MAI_ADAPTERS, separated by commas, libModuleA.so and
+ *          libModuleB.so by default.
+ *
+ *  @param [in] flags Bitmap of TAI_API_INITIALIZE_FLAG_xxx, passed to the
+ *              module adapters
+ *  @param [in] services Methods table with services provided by adapter host
+ *
+ *  @return #TAI_STATUS_SUCCESS on success, failure status code on error
+ */
+tai_status_t tai_api_initialize(_In_ uint64_t flags,
+                                _In_ const tai_service_method_table_t* services)
+{
+    const char *str = getenv("TAI_MAI_ADAPTERS");
+    char *list, *path, *save = NULL;
+    tai_status_t ret = TAI_STATUS_SUCCESS;
+
+    openlog("mai_tai_adapter", LOG_PID, LOG_USER);
+    stub_log_init();
+    if (initialized) {
+        TAI_SYSLOG_ERROR("TAI API already initialized");
+        return TAI_STATUS_FAILURE;
+    }
+    if (NULL == services) {
+        TAI_SYSLOG_ERROR("Invalid services handle passed to TAI API initialize");
+        return TAI_STATUS_INVALID_PARAMETER;
+    }
+    memcpy(&adapter_host_fns, services, sizeof(adapter_host_fns));
+
+    if ((NULL == str) || ('\0' == *str)) {
+        str = MAI_DEFAULT_ADAPTERS;
+    }
+    if (NULL == (list = strdup(str))) {
+        return TAI_STATUS_NO_MEMORY;
+    }
+    /* The adapter host is called from the module adapters once loaded */
+    initialized = true;
+    mai_adapter_count = 0;
+    mai_location_count = 0;
+    for (path = strtok_r(list, ",", &save); NULL != path; path = strtok_r(NULL, ",", &save)) {
+        if (MAI_MAX_ADAPTERS == mai_adapter_count) {
+            TAI_SYSLOG_ERROR("More than %u module adapters", MAI_MAX_ADAPTERS);
+            ret = TAI_STATUS_FAILURE;
+            break;
+        }
+        ret = mai_adapter_load(&mai_adapters[mai_adapter_count], mai_adapter_count, path, flags);
+        if (TAI_STATUS_SUCCESS != ret) {
+            break;
+        }
+        mai_adapter_count++;
+    }
+    free(list);
+    if ((TAI_STATUS_SUCCESS == ret) && (0 == mai_adapter_count)) {
+        TAI_SYSLOG_ERROR("No module adapter");
+        ret = TAI_STATUS_FAILURE;
+    }
+    if (TAI_STATUS_SUCCESS != ret) {
+        tai_api_uninitialize();
+    }
+    return ret;
+}
+
+/**
+ *  @brief  Retrieve a pointer to the C-style method table for desired TAI
+ *          functionality as specified by the given tai_api_id.
+ *
+ *  @param [in] tai_api_id TAI api ID
+ *  @param [out] api_method_table Caller allocated method table. The table must
+ *               remain valid until the tai_api_uninitialize() is called.
+ *  @return #TAI_STATUS_SUCCESS on success, failure status code on error
+ */
+tai_status_t tai_api_query(_In_ tai_api_t tai_api_id,
+                           _Out_ void** api_method_table)
+{
+    if (!initialized) {
+        TAI_SYSLOG_ERROR("TAI API not initialized before calling API query");
+        return TAI_STATUS_UNINITIALIZED;
+    }
+    if (NULL == api_method_table) {
+        TAI_SYSLOG_ERROR("NULL method table passed to TAI API initialize");
+        return TAI_STATUS_INVALID_PARAMETER;
+    }
+
+    switch (tai_api_id) {
+        case TAI_API_MODULE:
+            *(const tai_module_api_t**)api_method_table = &mai_module_api;
+            return TAI_STATUS_SUCCESS;
+
+        case TAI_API_HOSTIF:
+            *(const tai_host_interface_api_t**)api_method_table =
+                &mai_host_interface_api;
+            return TAI_STATUS_SUCCESS;
+
+        case TAI_API_NETWORKIF:
+            *(const tai_network_interface_api_t**)api_method_table =
+                &mai_network_interface_api;
+            return TAI_STATUS_SUCCESS;
+
+        default:
+            TAI_SYSLOG_ERROR("Invalid API type %d", tai_api_id);
+            return TAI_STATUS_INVALID_PARAMETER;
+    }
+}
+
+/**
+ *  @brief  Uninitialization of the adapter module. Stops the workers and
+ *          uninitializes and unloads the module adapters.
+ *
+ *  @return #TAI_STATUS_SUCCESS on success, failure status code on error
+ */
+tai_status_t tai_api_uninitialize(void)
+{
+    mai_alloc_t *alloc;
+
+    while (0 != mai_adapter_count) {
+        mai_adapter_unload(&mai_adapters[--mai_adapter_count], true);
+    }
+    while (NULL != (alloc = mai_allocs)) {
+        mai_allocs = alloc->next;
+        free(alloc);
+    }
+    mai_location_count = 0;
+    initialized = false;
+    memset(&adapter_host_fns, 0, sizeof(adapter_host_fns));
+    stub_log_fini();
+    closelog();
+
+    return TAI_STATUS_SUCCESS;
+}
+
+/**
+ * @brief Query tai object type, from the module adapter of the object
+ *
+ * @param [in] tai_object_id
+ *
+ * @return Return #TAI_OBJECT_TYPE_NULL when tai_object_id is not valid.
+ *         Otherwise, return a valid tai object type TAI_OBJECT_TYPE_XXX
+ */
+tai_object_type_t tai_object_type_query(_In_ tai_object_id_t tai_object_id)
+{
+    const mai_adapter_t *adapter = mai_adapter_of(tai_object_id);
+
+    if (NULL == adapter) {
+        TAI_SYSLOG_ERROR("Unknown object id 0x%lx", tai_object_id);
+        return TAI_OBJECT_TYPE_NULL;
+    }
+    return adapter->object_type_query(tai_object_id);
+}
+
+/**
+ * @brief Query tai module id, from the module adapter of the object
+ *
+ * @param [in] tai_object_id
+ *
+ * @return Return #TAI_NULL_OBJECT_ID when tai_object_id is not valid.
+ *         Otherwise, return the module id of the object, or the object itself
+ *         if it is a module
+ */
+tai_object_id_t tai_module_id_query(_In_ tai_object_id_t tai_object_id)
+{
+    const mai_adapter_t *adapter = mai_adapter_of(tai_object_id);
+
+    if (NULL == adapter) {
+        TAI_SYSLOG_ERROR("Unknown object id 0x%lx", tai_object_id);
+        return TAI_NULL_OBJECT_ID;
+    }
+    return adapter->module_id_query(tai_object_id);
+}
+
+/**
+ * @brief Set log level for a tai api module, in the platform adapter and in
+ *        every module adapter. The default log level is TAI_LOG_WARN.
+ *
+ * @param [in] tai_api_id - TAI api ID
+ * @param [in] log_level - log level
+ *
+ * @return #TAI_STATUS_SUCCESS on success, failure status code on error
+ */
+tai_status_t tai_log_set(_In_ tai_api_t tai_api_id,
+                         _In_ tai_log_level_t log_level)
+{
+    tai_status_t ret = TAI_STATUS_SUCCESS;
+    uint32_t idx;
+
+    if ((TAI_API_UNSPECIFIED > tai_api_id) || (TAI_API_MAX <= tai_api_id)) {
+        TAI_SYSLOG_ERROR("Invalid API type %d", tai_api_id);
+        return TAI_STATUS_INVALID_PARAMETER;
+    }
+
+    if ((TAI_LOG_LEVEL_DEBUG > log_level) || (TAI_LOG_LEVEL_MAX <= log_level)) {
+        TAI_SYSLOG_ERROR("Invalid log level %d\n", log_level);
+        return TAI_STATUS_INVALID_PARAMETER;
+    }
+
+    stub_log_set_level(tai_api_id, log_level);
+    for (idx = 0; idx < mai_adapter_count; idx++) {
+        if (TAI_STATUS_SUCCESS != mai_adapters[idx].log_set(tai_api_id, log_level)) {
+            ret = TAI_STATUS_FAILURE;
+        }
+    }
+    return ret;
+}
+
+/** @brief Worker side of tai_dbg_generate_dump() */
+static tai_status_t mai_do_dbg_generate_dump(const mai_adapter_t *adapter, mai_call_t *call)
+{
+    return adapter->dbg_generate_dump(call->in);
+}
+
+/**
+ * @brief Generate dump file. Each module adapter writes its own dump, to the
+ *        file name followed by "." and the number of the module adapter, from
+ *        1.
+ *
+ * @param [in] dump_file_name Full path for dump file
+ *
+ * @return #TAI_STATUS_SUCCESS on success, failure status code on error
+ */
+tai_status_t tai_dbg_generate_dump(_In_ const char *dump_file_name)
+{
+    mai_call_t call = { .fn = mai_do_dbg_generate_dump };
+    tai_status_t ret = TAI_STATUS_SUCCESS;
+    size_t size;
+    char *name;
+    uint32_t idx;
+
+    if (NULL == dump_file_name) {
+        TAI_SYSLOG_ERROR("NULL dump file name passed");
+        return TAI_STATUS_INVALID_PARAMETER;
+    }
+    if (!initialized) {
+        return TAI_STATUS_UNINITIALIZED;
+    }
+    size = strlen(dump_file_name) + 12;
+    if (NULL == (name = malloc(size))) {
+        return TAI_STATUS_NO_MEMORY;
+    }
+    for (idx = 0; (TAI_STATUS_SUCCESS == ret) && (idx < mai_adapter_count); idx++) {
+        snprintf(name, size, "%s.%u", dump_file_name, idx + 1);
+        call.in = name;
+        ret = mai_call_adapter(&mai_adapters[idx], &call);
+    }
+    free(name);
+    return ret;
+}
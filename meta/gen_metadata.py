@@ -0,0 +1,445 @@
+#!/usr/bin/env python3
+#
+# Copyright (C) 2018 Nippon Telegraph and Telephone Corporation.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+# implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""Generate taimetadata.h from the @type, @flags and @cache annotations of the
+attribute enums declared in the TAI headers.
+
+usage: gen_metadata.py <inc dir> <output>
+"""
+
+import os
+import re
+import sys
+
+# header, attribute enum, object type
+OBJECTS = [
+    ('taimodule.h',     'tai_module_attr_t',            'TAI_OBJECT_TYPE_MODULE'),
+    ('taihostif.h',     'tai_host_interface_attr_t',    'TAI_OBJECT_TYPE_HOSTIF'),
+    ('tainetworkif.h',  'tai_network_interface_attr_t', 'TAI_OBJECT_TYPE_NETWORKIF'),
+]
+
+OBJECT_TYPE_MAX = 4
+
+VALUE_TYPES = {
+    'bool':                   'BOOLDATA',
+    'char':                   'CHARDATA',
+    'tai_uint8_t':            'U8',
+    'tai_int8_t':             'S8',
+    'tai_uint16_t':           'U16',
+    'tai_int16_t':            'S16',
+    'tai_uint32_t':           'U32',
+    'tai_int32_t':            'S32',
+    'tai_uint64_t':           'U64',
+    'tai_int64_t':            'S64',
+    'tai_float_t':            'FLT',
+    'tai_pointer_t':          'PTR',
+    'tai_object_id_t':        'OID',
+    'tai_object_list_t':      'OBJLIST',
+    'tai_char_list_t':        'CHARLIST',
+    'tai_u8_list_t':          'U8LIST',
+    'tai_s8_list_t':          'S8LIST',
+    'tai_u16_list_t':         'U16LIST',
+    'tai_s16_list_t':         'S16LIST',
+    'tai_u32_list_t':         'U32LIST',
+    'tai_s32_list_t':         'S32LIST',
+    'tai_float_list_t':       'FLOATLIST',
+    'tai_u32_range_t':        'U32RANGE',
+    'tai_s32_range_t':        'S32RANGE',
+    'tai_object_map_list_t':  'OBJMAPLIST',
+}
+
+FLAGS = ('MANDATORY_ON_CREATE', 'CREATE_ONLY', 'CREATE_AND_SET', 'READ_ONLY')
+
+CACHE_POLICIES = ('NEVER', 'TTL', 'IMMUTABLE')
+
+ENUM_RE = re.compile(r'typedef\s+enum\s+_(\w+)\s*\{(.*?)\}\s*(\w+)\s*;', re.S)
+COMMENT_RE = re.compile(r'/\*.*?\*/', re.S)
+
+
+class Error(Exception):
+    pass
+
+
+def strip_comments(text):
+    return COMMENT_RE.sub(lambda m: '\n' * m.group(0).count('\n'), text)
+
+
+def parse_int(value, known):
+    value = value.strip()
+    if value in known:
+        return known[value]
+    return int(value, 0)
+
+
+def parse_enums(text):
+    """Return {enum name: [(value name, value, explicit)]} of every enum."""
+    enums = {}
+    for m in ENUM_RE.finditer(text):
+        name = m.group(3)
+        values = []
+        known = {}
+        current = -1
+        for entry in strip_comments(m.group(2)).split(','):
+            entry = entry.strip()
+            if not entry:
+                continue
+            explicit = '=' in entry
+            if explicit:
+                vname, v = [x.strip() for x in entry.split('=', 1)]
+                current = parse_int(v, known)
+            else:
+                vname = entry
+                current += 1
+            known[vname] = current
+            values.append((vname, current, explicit))
+        enums[name] = values
+    return enums
+
+
+def parse_attrs(text, enum_name):
+    """Return [(attr name, value, type, flags, cache policy)] of an attribute enum."""
+    m = re.search(r'typedef\s+enum\s+_%s\s*\{(.*?)\}\s*%s\s*;' %
+                  (enum_name, enum_name), text, re.S)
+    if not m:
+        raise Error('%s not found' % enum_name)
+    body = m.group(1)
+    attrs = []
+    known = {}
+    current = -1
+    # each entry is an optional doc comment followed by the enumerator
+    for em in re.finditer(r'(/\*\*(?:(?!\*/).)*\*/)?\s*(\w+)\s*(?:=\s*([\w]+))?\s*,?',
+                          body, re.S):
+        doc, vname, v = em.group(1), em.group(2), em.group(3)
+        if v is not None:
+            current = parse_int(v, known)
+        else:
+            current += 1
+        known[vname] = current
+        if vname.endswith('_START') or vname.endswith('_END'):
+            continue
+        doc = doc or ''
+        t = re.search(r'@type\s+(.+)', doc)
+        if not t:
+            raise Error('%s has no @type' % vname)
+        f = re.search(r'@flags\s+(.+)', doc)
+        flags = [x.strip() for x in f.group(1).split('|')] if f else ['CREATE_AND_SET']
+        for flag in flags:
+            if flag not in FLAGS:
+                raise Error('%s has an unknown flag %s' % (vname, flag))
+        c = re.search(r'@cache\s+(\w+)', doc)
+        cache = c.group(1) if c else 'TTL'
+        if cache not in CACHE_POLICIES:
+            raise Error('%s has an unknown cache policy %s' % (vname, cache))
+        attrs.append((vname, current, t.group(1).strip(), flags, cache))
+    return attrs
+
+
+def short_name(name):
+    return name.lower().replace('_', '-')
+
+
+def common_prefix(names):
+    if len(names) == 1:
+        return names[0][:names[0].rfind('_') + 1]
+    prefix = os.path.commonprefix(names)
+    return prefix[:prefix.rfind('_') + 1]
+
+
+def resolve_type(attr, attrtype, enums):
+    """Return (value type, enum name or None)."""
+    words = [w.lstrip('#') for w in attrtype.split()]
+    enum = None
+    if len(words) == 3 and words[1] == 'of':
+        enum = words[2]
+    elif len(words) != 1:
+        raise Error('%s has an unknown @type %s' % (attr, attrtype))
+    base = words[0]
+    if base in enums:
+        return 'S32', base
+    if base not in VALUE_TYPES:
+        raise Error('%s has an unknown @type %s' % (attr, attrtype))
+    if enum is not None and enum not in enums:
+        raise Error('%s uses an unknown enum %s' % (attr, enum))
+    return VALUE_TYPES[base], enum
+
+
+def generate(incdir):
+    text = ''
+    for header, _, _ in OBJECTS:
+        with open(os.path.join(incdir, header)) as f:
+            text += f.read()
+    enums = parse_enums(text)
+
+    objects = []
+    used = []
+    for header, enum_name, objtype in OBJECTS:
+        attrs = []
+        prefix = enum_name[:-len('attr_t')].upper() + 'ATTR_'
+        for vname, value, attrtype, flags, cache in parse_attrs(text, enum_name):
+            vt, enum = resolve_type(vname, attrtype, enums)
+            if enum and enum not in used:
+                used.append(enum)
+            attrs.append((vname, value, short_name(vname[len(prefix):]),
+                          vt, flags, enum, cache))
+        objects.append((enum_name, objtype, attrs))
+
+    out = []
+    w = out.append
+    w('/*')
+    w(' * This file is generated by meta/gen_metadata.py from the TAI headers.')
+    w(' * Do not edit it, run "make meta" to regenerate it.')
+    w(' */')
+    w('')
+    w('#if !defined (__TAIMETADATA_H_)')
+    w('#define __TAIMETADATA_H_')
+    w('')
+    w('#include <string.h>')
+    w('#include "taimetadatatypes.h"')
+    w('')
+
+    for enum in used:
+        values = [v for v in enums[enum] if not v[0].endswith('_MAX')]
+        names = [v[0] for v in values]
+        prefix = common_prefix(names)
+        flags = all(v[2] and v[1] > 0 and (v[1] & (v[1] - 1)) == 0 for v in values)
+        w('static const int32_t tai_metadata_%s_values[] = {' % enum)
+        for vname, _, _ in values:
+            w('    %s,' % vname)
+        w('};')
+        w('')
+        w('static const char *const tai_metadata_%s_names[] = {' % enum)
+        for vname in names:
+            w('    "%s",' % vname)
+        w('};')
+        w('')
+        w('static const char *const tai_metadata_%s_short_names[] = {' % enum)
+        for vname in names:
+            w('    "%s",' % short_name(vname[len(prefix):]))
+        w('};')
+        w('')
+        w('static const tai_enum_metadata_t tai_metadata_enum_%s = {' % enum)
+        w('    "%s",' % enum)
+        w('    %d,' % len(values))
+        w('    tai_metadata_%s_values,' % enum)
+        w('    tai_metadata_%s_names,' % enum)
+        w('    tai_metadata_%s_short_names,' % enum)
+        w('    %s,' % ('true' if flags else 'false'))
+        w('};')
+        w('')
+
+    for enum_name, objtype, attrs in objects:
+        for vname, value, sname, vt, flags, enum, cache in attrs:
+            w('static const tai_attr_metadata_t tai_metadata_attr_%s = {' % vname)
+            w('    %s,' % objtype)
+            w('    %s,' % vname)
+            w('    "%s",' % vname)
+            w('    "%s",' % sname)
+            w('    TAI_ATTR_VALUE_TYPE_%s,' % vt)
+            w('    %s,' % ' | '.join('TAI_ATTR_FLAGS_' + f for f in flags))
+            w('    %s,' % ('&tai_metadata_enum_' + enum if enum else 'NULL'))
+            w('    TAI_ATTR_CACHE_POLICY_%s,' % cache)
+            w('};')
+            w('')
+
+    for enum_name, objtype, attrs in objects:
+        count = max(a[1] for a in attrs) + 1
+        byid = {a[1]: a for a in attrs}
+        w('/* indexed by #%s */' % enum_name)
+        w('static const tai_attr_metadata_t *const tai_metadata_object_type_%s[] = {' %
+          enum_name)
+        for i in range(count):
+            w('    %s,' % ('&tai_metadata_attr_' + byid[i][0] if i in byid else 'NULL'))
+        w('    NULL,')
+        w('};')
+        w('')
+
+    w('/* indexed by #tai_object_type_t */')
+    w('static const tai_attr_metadata_t *const *const tai_metadata_attr_by_object_type[] = {')
+    for i in range(OBJECT_TYPE_MAX):
+        o = [x for x in objects if x[1] == OBJECTS[i - 1][2]] if i > 0 else []
+        w('    %s,' % ('tai_metadata_object_type_' + o[0][0] if o else 'NULL'))
+    w('};')
+    w('')
+    w('static const size_t tai_metadata_attr_by_object_type_count[] = {')
+    for i in range(OBJECT_TYPE_MAX):
+        o = [x for x in objects if x[1] == OBJECTS[i - 1][2]] if i > 0 else []
+        w('    %d,' % (max(a[1] for a in o[0][2]) + 1 if o else 0))
+    w('};')
+    w('')
+    w('/* the mandatory on create attributes as a mask of attribute ids,')
+    w(' * indexed by #tai_object_type_t */')
+    w('static const uint64_t tai_metadata_mandatory_on_create[] = {')
+    for i in range(OBJECT_TYPE_MAX):
+        o = [x for x in objects if x[1] == OBJECTS[i - 1][2]] if i > 0 else []
+        mask = 0
+        for a in (o[0][2] if o else []):
+            if 'MANDATORY_ON_CREATE' in a[4]:
+                if a[1] >= 64:
+                    raise ValueError('%s: mandatory attribute id above 63' % a[0])
+                mask |= 1 << a[1]
+        w('    0x%xULL,' % mask)
+    w('};')
+    w('')
+    w('''/**
+ * @brief Get the metadata of an attribute
+ *
+ * @param [in] object_type The object type
+ * @param [in] attr_id The attribute id
+ *
+ * @return The metadata, NULL if the attribute is unknown
+ */
+static inline const tai_attr_metadata_t *tai_metadata_get_attr_metadata(
+    _In_ tai_object_type_t object_type,
+    _In_ tai_attr_id_t attr_id)
+{
+    if (object_type <= TAI_OBJECT_TYPE_NULL || object_type >= TAI_OBJECT_TYPE_MAX) {
+        return NULL;
+    }
+    if (attr_id >= tai_metadata_attr_by_object_type_count[object_type]) {
+        return NULL;
+    }
+    return tai_metadata_attr_by_object_type[object_type][attr_id];
+}
+
+/**
+ * @brief Get the metadata of an attribute by its short name
+ *
+ * @param [in] object_type The object type
+ * @param [in] short_name The attribute short name, e.g. "tx-enable"
+ *
+ * @return The metadata, NULL if the attribute is unknown
+ */
+static inline const tai_attr_metadata_t *tai_metadata_get_attr_metadata_by_short_name(
+    _In_ tai_object_type_t object_type,
+    _In_ const char *short_name)
+{
+    size_t i;
+    const tai_attr_metadata_t *md;
+
+    if (object_type <= TAI_OBJECT_TYPE_NULL || object_type >= TAI_OBJECT_TYPE_MAX) {
+        return NULL;
+    }
+    for (i = 0; i < tai_metadata_attr_by_object_type_count[object_type]; i++) {
+        md = tai_metadata_attr_by_object_type[object_type][i];
+        if (md && strcmp(md->attridshortname, short_name) == 0) {
+            return md;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Check the value of an enum attribute against its enum
+ *
+ * @param [in] md The metadata of the attribute
+ * @param [in] value The value
+ *
+ * @return false if the attribute is an enum and the value is not one of its
+ *         values, true otherwise
+ */
+static inline bool tai_metadata_is_valid_enum_value(
+    _In_ const tai_attr_metadata_t *md,
+    _In_ const tai_attribute_value_t *value)
+{
+    size_t i;
+
+    if (md->enummetadata == NULL || md->enummetadata->containsflags || TAI_META_IS_LIST(md)) {
+        return true;
+    }
+    for (i = 0; i < md->enummetadata->valuescount; i++) {
+        if (md->enummetadata->values[i] == value->s32) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Check a list of attributes passed to a create or a set function
+ *        against their metadata, in a single pass over the list
+ *
+ * Every attribute is looked up by its id and the mandatory attributes are
+ * checked with a mask, so that adapters validate lists of any length in
+ * linear time.
+ *
+ * @param [in] object_type The object type
+ * @param [in] create true for the attributes of a create, false for a set
+ * @param [in] attr_count The number of attributes in the list
+ * @param [in] attr_list The attributes
+ *
+ * @return TAI_STATUS_SUCCESS if the attributes are valid. Otherwise
+ *         TAI_STATUS_ATTR_NOT_SUPPORTED_0 for an unknown attribute,
+ *         TAI_STATUS_INVALID_ATTRIBUTE_0 for an attribute which can not be
+ *         written and TAI_STATUS_INVALID_ATTR_VALUE_0 for an invalid enum value,
+ *         plus the index of the attribute, or
+ *         TAI_STATUS_MANDATORY_ATTRIBUTE_MISSING, or
+ *         TAI_STATUS_INVALID_PARAMETER for an unknown object type.
+ */
+static inline tai_status_t tai_metadata_check_attr_list(
+    _In_ tai_object_type_t object_type,
+    _In_ bool create,
+    _In_ uint32_t attr_count,
+    _In_ const tai_attribute_t *attr_list)
+{
+    const tai_attr_metadata_t *md;
+    uint64_t given = 0;
+    uint32_t i;
+
+    if (object_type <= TAI_OBJECT_TYPE_NULL || object_type >= TAI_OBJECT_TYPE_MAX) {
+        return TAI_STATUS_INVALID_PARAMETER;
+    }
+    for (i = 0; i < attr_count; i++) {
+        md = tai_metadata_get_attr_metadata(object_type, attr_list[i].id);
+        if (md == NULL) {
+            return TAI_STATUS_ATTR_NOT_SUPPORTED_0 + i;
+        }
+        if (TAI_META_IS_READ_ONLY(md) || (!create && TAI_META_IS_CREATE_ONLY(md))) {
+            return TAI_STATUS_INVALID_ATTRIBUTE_0 + i;
+        }
+        if (!tai_metadata_is_valid_enum_value(md, &attr_list[i].value)) {
+            return TAI_STATUS_INVALID_ATTR_VALUE_0 + i;
+        }
+        if (attr_list[i].id < 64) {
+            given |= 1ULL << attr_list[i].id;
+        }
+    }
+    if (create && (tai_metadata_mandatory_on_create[object_type] & ~given) != 0) {
+        return TAI_STATUS_MANDATORY_ATTRIBUTE_MISSING;
+    }
+    return TAI_STATUS_SUCCESS;
+}
+
+#endif /** __TAIMETADATA_H_ */''')
+    return '\n'.join(out) + '\n'
+
+
+def main():
+    if len(sys.argv) != 3:
+        sys.stderr.write(__doc__)
+        return 1
+    try:
+        content = generate(sys.argv[1])
+    except Error as e:
+        sys.stderr.write('gen_metadata.py: %s\n' % e)
+        return 1
+    with open(sys.argv[2], 'w') as f:
+        f.write(content)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,1092 @@
+/*
+ * This file is generated by meta/gen_metadata.py from the TAI headers.
+ * Do not edit it, run "make meta" to regenerate it.
+ */
+
+#if !defined (__TAIMETADATA_H_)
+#define __TAIMETADATA_H_
+
+#include <string.h>
+#include "taimetadatatypes.h"
+
+static const int32_t tai_metadata_tai_module_oper_status_t_values[] = {
+    TAI_MODULE_OPER_STATUS_UNKNOWN,
+    TAI_MODULE_OPER_STATUS_INITIALIZE,
+    TAI_MODULE_OPER_STATUS_READY,
+};
+
+static const char *const tai_metadata_tai_module_oper_status_t_names[] = {
+    "TAI_MODULE_OPER_STATUS_UNKNOWN",
+    "TAI_MODULE_OPER_STATUS_INITIALIZE",
+    "TAI_MODULE_OPER_STATUS_READY",
+};
+
+static const char *const tai_metadata_tai_module_oper_status_t_short_names[] = {
+    "unknown",
+    "initialize",
+    "ready",
+};
+
+static const tai_enum_metadata_t tai_metadata_enum_tai_module_oper_status_t = {
+    "tai_module_oper_status_t",
+    3,
+    tai_metadata_tai_module_oper_status_t_values,
+    tai_metadata_tai_module_oper_status_t_names,
+    tai_metadata_tai_module_oper_status_t_short_names,
+    false,
+};
+
+static const int32_t tai_metadata_tai_module_admin_status_t_values[] = {
+    TAI_MODULE_ADMIN_STATUS_UNKNOWN,
+    TAI_MODULE_ADMIN_STATUS_DOWN,
+    TAI_MODULE_ADMIN_STATUS_UP,
+};
+
+static const char *const tai_metadata_tai_module_admin_status_t_names[] = {
+    "TAI_MODULE_ADMIN_STATUS_UNKNOWN",
+    "TAI_MODULE_ADMIN_STATUS_DOWN",
+    "TAI_MODULE_ADMIN_STATUS_UP",
+};
+
+static const char *const tai_metadata_tai_module_admin_status_t_short_names[] = {
+    "unknown",
+    "down",
+    "up",
+};
+
+static const tai_enum_metadata_t tai_metadata_enum_tai_module_admin_status_t = {
+    "tai_module_admin_status_t",
+    3,
+    tai_metadata_tai_module_admin_status_t_values,
+    tai_metadata_tai_module_admin_status_t_names,
+    tai_metadata_tai_module_admin_status_t_short_names,
+    false,
+};
+
+static const int32_t tai_metadata_tai_host_interface_lane_faults_t_values[] = {
+    TAI_HOST_INTERFACE_LANE_FAULT_LOSS_OF_LOCK,
+    TAI_HOST_INTERFACE_LANE_FAULT_TX_FIFIO_ERR,
+};
+
+static const char *const tai_metadata_tai_host_interface_lane_faults_t_names[] = {
+    "TAI_HOST_INTERFACE_LANE_FAULT_LOSS_OF_LOCK",
+    "TAI_HOST_INTERFACE_LANE_FAULT_TX_FIFIO_ERR",
+};
+
+static const char *const tai_metadata_tai_host_interface_lane_faults_t_short_names[] = {
+    "loss-of-lock",
+    "tx-fifio-err",
+};
+
+static const tai_enum_metadata_t tai_metadata_enum_tai_host_interface_lane_faults_t = {
+    "tai_host_interface_lane_faults_t",
+    2,
+    tai_metadata_tai_host_interface_lane_faults_t_values,
+    tai_metadata_tai_host_interface_lane_faults_t_names,
+    tai_metadata_tai_host_interface_lane_faults_t_short_names,
+    true,
+};
+
+static const int32_t tai_metadata_tai_host_interface_tx_align_status_t_values[] = {
+    TAI_HOST_INTERFACE_TX_ALIGN_CDR_LOCK_FAULT,
+    TAI_HOST_INTERFACE_TX_ALIGN_LOSS,
+    TAI_HOST_INTERFACE_TX_ALIGN_OUT,
+    TAI_HOST_INTERFACE_TX_ALIGN_DESKEW_LOCK,
+};
+
+static const char *const tai_metadata_tai_host_interface_tx_align_status_t_names[] = {
+    "TAI_HOST_INTERFACE_TX_ALIGN_CDR_LOCK_FAULT",
+    "TAI_HOST_INTERFACE_TX_ALIGN_LOSS",
+    "TAI_HOST_INTERFACE_TX_ALIGN_OUT",
+    "TAI_HOST_INTERFACE_TX_ALIGN_DESKEW_LOCK",
+};
+
+static const char *const tai_metadata_tai_host_interface_tx_align_status_t_short_names[] = {
+    "cdr-lock-fault",
+    "loss",
+    "out",
+    "deskew-lock",
+};
+
+static const tai_enum_metadata_t tai_metadata_enum_tai_host_interface_tx_align_status_t = {
+    "tai_host_interface_tx_align_status_t",
+    4,
+    tai_metadata_tai_host_interface_tx_align_status_t_values,
+    tai_metadata_tai_host_interface_tx_align_status_t_names,
+    tai_metadata_tai_host_interface_tx_align_status_t_short_names,
+    true,
+};
+
+static const int32_t tai_metadata_tai_host_interface_fec_type_t_values[] = {
+    TAI_HOST_INTERFACE_FEC_TYPE_NONE,
+    TAI_HOST_INTERFACE_FEC_TYPE_RS,
+    TAI_HOST_INTERFACE_FEC_TYPE_FC,
+};
+
+static const char *const tai_metadata_tai_host_interface_fec_type_t_names[] = {
+    "TAI_HOST_INTERFACE_FEC_TYPE_NONE",
+    "TAI_HOST_INTERFACE_FEC_TYPE_RS",
+    "TAI_HOST_INTERFACE_FEC_TYPE_FC",
+};
+
+static const char *const tai_metadata_tai_host_interface_fec_type_t_short_names[] = {
+    "none",
+    "rs",
+    "fc",
+};
+
+static const tai_enum_metadata_t tai_metadata_enum_tai_host_interface_fec_type_t = {
+    "tai_host_interface_fec_type_t",
+    3,
+    tai_metadata_tai_host_interface_fec_type_t_values,
+    tai_metadata_tai_host_interface_fec_type_t_names,
+    tai_metadata_tai_host_interface_fec_type_t_short_names,
+    false,
+};
+
+static const int32_t tai_metadata_tai_network_interface_tx_align_status_t_values[] = {
+    TAI_NETWORK_INTERFACE_TX_ALIGN_LOSS,
+    TAI_NETWORK_INTERFACE_TX_ALIGN_OUT,
+    TAI_NETWORK_INTERFACE_TX_ALIGN_CMU_LOCK,
+    TAI_NETWORK_INTERFACE_TX_ALIGN_REF_CLOCK,
+    TAI_NETWORK_INTERFACE_TX_ALIGN_TIMING,
+};
+
+static const char *const tai_metadata_tai_network_interface_tx_align_status_t_names[] = {
+    "TAI_NETWORK_INTERFACE_TX_ALIGN_LOSS",
+    "TAI_NETWORK_INTERFACE_TX_ALIGN_OUT",
+    "TAI_NETWORK_INTERFACE_TX_ALIGN_CMU_LOCK",
+    "TAI_NETWORK_INTERFACE_TX_ALIGN_REF_CLOCK",
+    "TAI_NETWORK_INTERFACE_TX_ALIGN_TIMING",
+};
+
+static const char *const tai_metadata_tai_network_interface_tx_align_status_t_short_names[] = {
+    "loss",
+    "out",
+    "cmu-lock",
+    "ref-clock",
+    "timing",
+};
+
+static const tai_enum_metadata_t tai_metadata_enum_tai_network_interface_tx_align_status_t = {
+    "tai_network_interface_tx_align_status_t",
+    5,
+    tai_metadata_tai_network_interface_tx_align_status_t_values,
+    tai_metadata_tai_network_interface_tx_align_status_t_names,
+    tai_metadata_tai_network_interface_tx_align_status_t_short_names,
+    true,
+};
+
+static const int32_t tai_metadata_tai_network_interface_rx_align_status_t_values[] = {
+    TAI_NETWORK_INTERFACE_RX_ALIGN_MODEM_SYNC,
+    TAI_NETWORK_INTERFACE_RX_ALIGN_MODEM_LOCK,
+    TAI_NETWORK_INTERFACE_RX_ALIGN_LOSS,
+    TAI_NETWORK_INTERFACE_RX_ALIGN_OUT,
+    TAI_NETWORK_INTERFACE_RX_ALIGN_TIMING,
+};
+
+static const char *const tai_metadata_tai_network_interface_rx_align_status_t_names[] = {
+    "TAI_NETWORK_INTERFACE_RX_ALIGN_MODEM_SYNC",
+    "TAI_NETWORK_INTERFACE_RX_ALIGN_MODEM_LOCK",
+    "TAI_NETWORK_INTERFACE_RX_ALIGN_LOSS",
+    "TAI_NETWORK_INTERFACE_RX_ALIGN_OUT",
+    "TAI_NETWORK_INTERFACE_RX_ALIGN_TIMING",
+};
+
+static const char *const tai_metadata_tai_network_interface_rx_align_status_t_short_names[] = {
+    "modem-sync",
+    "modem-lock",
+    "loss",
+    "out",
+    "timing",
+};
+
+static const tai_enum_metadata_t tai_metadata_enum_tai_network_interface_rx_align_status_t = {
+    "tai_network_interface_rx_align_status_t",
+    5,
+    tai_metadata_tai_network_interface_rx_align_status_t_values,
+    tai_metadata_tai_network_interface_rx_align_status_t_names,
+    tai_metadata_tai_network_interface_rx_align_status_t_short_names,
+    true,
+};
+
+static const int32_t tai_metadata_tai_network_interface_tx_grid_spacing_t_values[] = {
+    TAI_NETWORK_INTERFACE_TX_GRID_SPACING_UNKNOWN,
+    TAI_NETWORK_INTERFACE_TX_GRID_SPACING_100_GHZ,
+    TAI_NETWORK_INTERFACE_TX_GRID_SPACING_50_GHZ,
+    TAI_NETWORK_INTERFACE_TX_GRID_SPACING_33_GHZ,
+    TAI_NETWORK_INTERFACE_TX_GRID_SPACING_25_GHZ,
+    TAI_NETWORK_INTERFACE_TX_GRID_SPACING_12_5_GHZ,
+    TAI_NETWORK_INTERFACE_TX_GRID_SPACING_6_25_GHZ,
+};
+
+static const char *const tai_metadata_tai_network_interface_tx_grid_spacing_t_names[] = {
+    "TAI_NETWORK_INTERFACE_TX_GRID_SPACING_UNKNOWN",
+    "TAI_NETWORK_INTERFACE_TX_GRID_SPACING_100_GHZ",
+    "TAI_NETWORK_INTERFACE_TX_GRID_SPACING_50_GHZ",
+    "TAI_NETWORK_INTERFACE_TX_GRID_SPACING_33_GHZ",
+    "TAI_NETWORK_INTERFACE_TX_GRID_SPACING_25_GHZ",
+    "TAI_NETWORK_INTERFACE_TX_GRID_SPACING_12_5_GHZ",
+    "TAI_NETWORK_INTERFACE_TX_GRID_SPACING_6_25_GHZ",
+};
+
+static const char *const tai_metadata_tai_network_interface_tx_grid_spacing_t_short_names[] = {
+    "unknown",
+    "100-ghz",
+    "50-ghz",
+    "33-ghz",
+    "25-ghz",
+    "12-5-ghz",
+    "6-25-ghz",
+};
+
+static const tai_enum_metadata_t tai_metadata_enum_tai_network_interface_tx_grid_spacing_t = {
+    "tai_network_interface_tx_grid_spacing_t",
+    7,
+    tai_metadata_tai_network_interface_tx_grid_spacing_t_values,
+    tai_metadata_tai_network_interface_tx_grid_spacing_t_names,
+    tai_metadata_tai_network_interface_tx_grid_spacing_t_short_names,
+    false,
+};
+
+static const int32_t tai_metadata_tai_network_interface_modulation_format_t_values[] = {
+    TAI_NETWORK_INTERFACE_MODULATION_FORMAT_UNKNOWN,
+    TAI_NETWORK_INTERFACE_MODULATION_FORMAT_BPSK,
+    TAI_NETWORK_INTERFACE_MODULATION_FORMAT_DP_BPSK,
+    TAI_NETWORK_INTERFACE_MODULATION_FORMAT_QPSK,
+    TAI_NETWORK_INTERFACE_MODULATION_FORMAT_DP_QPSK,
+    TAI_NETWORK_INTERFACE_MODULATION_FORMAT_8_QAM,
+    TAI_NETWORK_INTERFACE_MODULATION_FORMAT_DP_8_QAM,
+    TAI_NETWORK_INTERFACE_MODULATION_FORMAT_16_QAM,
+    TAI_NETWORK_INTERFACE_MODULATION_FORMAT_DP_16_QAM,
+    TAI_NETWORK_INTERFACE_MODULATION_FORMAT_32_QAM,
+    TAI_NETWORK_INTERFACE_MODULATION_FORMAT_DP_32_QAM,
+    TAI_NETWORK_INTERFACE_MODULATION_FORMAT_64_QAM,
+    TAI_NETWORK_INTERFACE_MODULATION_FORMAT_DP_64_QAM,
+};
+
+static const char *const tai_metadata_tai_network_interface_modulation_format_t_names[] = {
+    "TAI_NETWORK_INTERFACE_MODULATION_FORMAT_UNKNOWN",
+    "TAI_NETWORK_INTERFACE_MODULATION_FORMAT_BPSK",
+    "TAI_NETWORK_INTERFACE_MODULATION_FORMAT_DP_BPSK",
+    "TAI_NETWORK_INTERFACE_MODULATION_FORMAT_QPSK",
+    "TAI_NETWORK_INTERFACE_MODULATION_FORMAT_DP_QPSK",
+    "TAI_NETWORK_INTERFACE_MODULATION_FORMAT_8_QAM",
+    "TAI_NETWORK_INTERFACE_MODULATION_FORMAT_DP_8_QAM",
+    "TAI_NETWORK_INTERFACE_MODULATION_FORMAT_16_QAM",
+    "TAI_NETWORK_INTERFACE_MODULATION_FORMAT_DP_16_QAM",
+    "TAI_NETWORK_INTERFACE_MODULATION_FORMAT_32_QAM",
+    "TAI_NETWORK_INTERFACE_MODULATION_FORMAT_DP_32_QAM",
+    "TAI_NETWORK_INTERFACE_MODULATION_FORMAT_64_QAM",
+    "TAI_NETWORK_INTERFACE_MODULATION_FORMAT_DP_64_QAM",
+};
+
+static const char *const tai_metadata_tai_network_interface_modulation_format_t_short_names[] = {
+    "unknown",
+    "bpsk",
+    "dp-bpsk",
+    "qpsk",
+    "dp-qpsk",
+    "8-qam",
+    "dp-8-qam",
+    "16-qam",
+    "dp-16-qam",
+    "32-qam",
+    "dp-32-qam",
+    "64-qam",
+    "dp-64-qam",
+};
+
+static const tai_enum_metadata_t tai_metadata_enum_tai_network_interface_modulation_format_t = {
+    "tai_network_interface_modulation_format_t",
+    13,
+    tai_metadata_tai_network_interface_modulation_format_t_values,
+    tai_metadata_tai_network_interface_modulation_format_t_names,
+    tai_metadata_tai_network_interface_modulation_format_t_short_names,
+    false,
+};
+
+static const int32_t tai_metadata_tai_network_interface_oper_status_t_values[] = {
+    TAI_NETWORK_INTERFACE_OPER_STATUS_UNKNOWN,
+    TAI_NETWORK_INTERFACE_OPER_STATUS_RESET,
+    TAI_NETWORK_INTERFACE_OPER_STATUS_INITIALIZE,
+    TAI_NETWORK_INTERFACE_OPER_STATUS_LOW_POWER,
+    TAI_NETWORK_INTERFACE_OPER_STATUS_HIGH_POWER_UP,
+    TAI_NETWORK_INTERFACE_OPER_STATUS_TX_OFF,
+    TAI_NETWORK_INTERFACE_OPER_STATUS_TX_TURN_ON,
+    TAI_NETWORK_INTERFACE_OPER_STATUS_READY,
+    TAI_NETWORK_INTERFACE_OPER_STATUS_TX_TURN_OFF,
+    TAI_NETWORK_INTERFACE_OPER_STATUS_HIGH_POWER_DOWN,
+    TAI_NETWORK_INTERFACE_OPER_STATUS_FAULT,
+};
+
+static const char *const tai_metadata_tai_network_interface_oper_status_t_names[] = {
+    "TAI_NETWORK_INTERFACE_OPER_STATUS_UNKNOWN",
+    "TAI_NETWORK_INTERFACE_OPER_STATUS_RESET",
+    "TAI_NETWORK_INTERFACE_OPER_STATUS_INITIALIZE",
+    "TAI_NETWORK_INTERFACE_OPER_STATUS_LOW_POWER",
+    "TAI_NETWORK_INTERFACE_OPER_STATUS_HIGH_POWER_UP",
+    "TAI_NETWORK_INTERFACE_OPER_STATUS_TX_OFF",
+    "TAI_NETWORK_INTERFACE_OPER_STATUS_TX_TURN_ON",
+    "TAI_NETWORK_INTERFACE_OPER_STATUS_READY",
+    "TAI_NETWORK_INTERFACE_OPER_STATUS_TX_TURN_OFF",
+    "TAI_NETWORK_INTERFACE_OPER_STATUS_HIGH_POWER_DOWN",
+    "TAI_NETWORK_INTERFACE_OPER_STATUS_FAULT",
+};
+
+static const char *const tai_metadata_tai_network_interface_oper_status_t_short_names[] = {
+    "unknown",
+    "reset",
+    "initialize",
+    "low-power",
+    "high-power-up",
+    "tx-off",
+    "tx-turn-on",
+    "ready",
+    "tx-turn-off",
+    "high-power-down",
+    "fault",
+};
+
+static const tai_enum_metadata_t tai_metadata_enum_tai_network_interface_oper_status_t = {
+    "tai_network_interface_oper_status_t",
+    11,
+    tai_metadata_tai_network_interface_oper_status_t_values,
+    tai_metadata_tai_network_interface_oper_status_t_names,
+    tai_metadata_tai_network_interface_oper_status_t_short_names,
+    false,
+};
+
+static const int32_t tai_metadata_tai_network_interface_laser_grid_spacing_t_values[] = {
+    TAI_NETWORK_INTERFACE_LASER_GRID_SPACING_6_25_GHZ,
+    TAI_NETWORK_INTERFACE_LASER_GRID_SPACING_12_5_GHZ,
+    TAI_NETWORK_INTERFACE_LASER_GRID_SPACING_25_GHZ,
+    TAI_NETWORK_INTERFACE_LASER_GRID_SPACING_33_GHZ,
+    TAI_NETWORK_INTERFACE_LASER_GRID_SPACING_50_GHZ,
+    TAI_NETWORK_INTERFACE_LASER_GRID_SPACING_100_GHZ,
+};
+
+static const char *const tai_metadata_tai_network_interface_laser_grid_spacing_t_names[] = {
+    "TAI_NETWORK_INTERFACE_LASER_GRID_SPACING_6_25_GHZ",
+    "TAI_NETWORK_INTERFACE_LASER_GRID_SPACING_12_5_GHZ",
+    "TAI_NETWORK_INTERFACE_LASER_GRID_SPACING_25_GHZ",
+    "TAI_NETWORK_INTERFACE_LASER_GRID_SPACING_33_GHZ",
+    "TAI_NETWORK_INTERFACE_LASER_GRID_SPACING_50_GHZ",
+    "TAI_NETWORK_INTERFACE_LASER_GRID_SPACING_100_GHZ",
+};
+
+static const char *const tai_metadata_tai_network_interface_laser_grid_spacing_t_short_names[] = {
+    "6-25-ghz",
+    "12-5-ghz",
+    "25-ghz",
+    "33-ghz",
+    "50-ghz",
+    "100-ghz",
+};
+
+static const tai_enum_metadata_t tai_metadata_enum_tai_network_interface_laser_grid_spacing_t = {
+    "tai_network_interface_laser_grid_spacing_t",
+    6,
+    tai_metadata_tai_network_interface_laser_grid_spacing_t_values,
+    tai_metadata_tai_network_interface_laser_grid_spacing_t_names,
+    tai_metadata_tai_network_interface_laser_grid_spacing_t_short_names,
+    true,
+};
+
+static const tai_attr_metadata_t tai_metadata_attr_TAI_MODULE_ATTR_LOCATION = {
+    TAI_OBJECT_TYPE_MODULE,
+    TAI_MODULE_ATTR_LOCATION,
+    "TAI_MODULE_ATTR_LOCATION",
+    "location",
+    TAI_ATTR_VALUE_TYPE_CHARLIST,
+    TAI_ATTR_FLAGS_MANDATORY_ON_CREATE | TAI_ATTR_FLAGS_CREATE_ONLY,
+    NULL,
+    TAI_ATTR_CACHE_POLICY_IMMUTABLE,
+};
+
+static const tai_attr_metadata_t tai_metadata_attr_TAI_MODULE_ATTR_VENDOR_NAME = {
+    TAI_OBJECT_TYPE_MODULE,
+    TAI_MODULE_ATTR_VENDOR_NAME,
+    "TAI_MODULE_ATTR_VENDOR_NAME",
+    "vendor-name",
+    TAI_ATTR_VALUE_TYPE_CHARLIST,
+    TAI_ATTR_FLAGS_READ_ONLY,
+    NULL,
+    TAI_ATTR_CACHE_POLICY_IMMUTABLE,
+};
+
+static const tai_attr_metadata_t tai_metadata_attr_TAI_MODULE_ATTR_VENDOR_PART_NUMBER = {
+    TAI_OBJECT_TYPE_MODULE,
+    TAI_MODULE_ATTR_VENDOR_PART_NUMBER,
+    "TAI_MODULE_ATTR_VENDOR_PART_NUMBER",
+    "vendor-part-number",
+    TAI_ATTR_VALUE_TYPE_CHARLIST,
+    TAI_ATTR_FLAGS_READ_ONLY,
+    NULL,
+    TAI_ATTR_CACHE_POLICY_IMMUTABLE,
+};
+
+static const tai_attr_metadata_t tai_metadata_attr_TAI_MODULE_ATTR_VENDOR_SERIAL_NUMBER = {
+    TAI_OBJECT_TYPE_MODULE,
+    TAI_MODULE_ATTR_VENDOR_SERIAL_NUMBER,
+    "TAI_MODULE_ATTR_VENDOR_SERIAL_NUMBER",
+    "vendor-serial-number",
+    TAI_ATTR_VALUE_TYPE_CHARLIST,
+    TAI_ATTR_FLAGS_READ_ONLY,
+    NULL,
+    TAI_ATTR_CACHE_POLICY_IMMUTABLE,
+};
+
+static const tai_attr_metadata_t tai_metadata_attr_TAI_MODULE_ATTR_FIRMWARE_VERSIONS = {
+    TAI_OBJECT_TYPE_MODULE,
+    TAI_MODULE_ATTR_FIRMWARE_VERSIONS,
+    "TAI_MODULE_ATTR_FIRMWARE_VERSIONS",
+    "firmware-versions",
+    TAI_ATTR_VALUE_TYPE_FLOATLIST,
+    TAI_ATTR_FLAGS_READ_ONLY,
+    NULL,
+    TAI_ATTR_CACHE_POLICY_TTL,
+};
+
+static const tai_attr_metadata_t tai_metadata_attr_TAI_MODULE_ATTR_OPER_STATUS = {
+    TAI_OBJECT_TYPE_MODULE,
+    TAI_MODULE_ATTR_OPER_STATUS,
+    "TAI_MODULE_ATTR_OPER_STATUS",
+    "oper-status",
+    TAI_ATTR_VALUE_TYPE_S32,
+    TAI_ATTR_FLAGS_READ_ONLY,
+    &tai_metadata_enum_tai_module_oper_status_t,
+    TAI_ATTR_CACHE_POLICY_TTL,
+};
+
+static const tai_attr_metadata_t tai_metadata_attr_TAI_MODULE_ATTR_TEMP = {
+    TAI_OBJECT_TYPE_MODULE,
+    TAI_MODULE_ATTR_TEMP,
+    "TAI_MODULE_ATTR_TEMP",
+    "temp",
+    TAI_ATTR_VALUE_TYPE_FLT,
+    TAI_ATTR_FLAGS_READ_ONLY,
+    NULL,
+    TAI_ATTR_CACHE_POLICY_TTL,
+};
+
+static const tai_attr_metadata_t tai_metadata_attr_TAI_MODULE_ATTR_POWER = {
+    TAI_OBJECT_TYPE_MODULE,
+    TAI_MODULE_ATTR_POWER,
+    "TAI_MODULE_ATTR_POWER",
+    "power",
+    TAI_ATTR_VALUE_TYPE_FLT,
+    TAI_ATTR_FLAGS_READ_ONLY,
+    NULL,
+    TAI_ATTR_CACHE_POLICY_TTL,
+};
+
+static const tai_attr_metadata_t tai_metadata_attr_TAI_MODULE_ATTR_NUM_HOST_INTERFACES = {
+    TAI_OBJECT_TYPE_MODULE,
+    TAI_MODULE_ATTR_NUM_HOST_INTERFACES,
+    "TAI_MODULE_ATTR_NUM_HOST_INTERFACES",
+    "num-host-interfaces",
+    TAI_ATTR_VALUE_TYPE_U32,
+    TAI_ATTR_FLAGS_READ_ONLY,
+    NULL,
+    TAI_ATTR_CACHE_POLICY_IMMUTABLE,
+};
+
+static const tai_attr_metadata_t tai_metadata_attr_TAI_MODULE_ATTR_NUM_NETWORK_INTERFACES = {
+    TAI_OBJECT_TYPE_MODULE,
+    TAI_MODULE_ATTR_NUM_NETWORK_INTERFACES,
+    "TAI_MODULE_ATTR_NUM_NETWORK_INTERFACES",
+    "num-network-interfaces",
+    TAI_ATTR_VALUE_TYPE_U32,
+    TAI_ATTR_FLAGS_READ_ONLY,
+    NULL,
+    TAI_ATTR_CACHE_POLICY_IMMUTABLE,
+};
+
+static const tai_attr_metadata_t tai_metadata_attr_TAI_MODULE_ATTR_ADMIN_STATUS = {
+    TAI_OBJECT_TYPE_MODULE,
+    TAI_MODULE_ATTR_ADMIN_STATUS,
+    "TAI_MODULE_ATTR_ADMIN_STATUS",
+    "admin-status",
+    TAI_ATTR_VALUE_TYPE_S32,
+    TAI_ATTR_FLAGS_CREATE_AND_SET,
+    &tai_metadata_enum_tai_module_admin_status_t,
+    TAI_ATTR_CACHE_POLICY_TTL,
+};
+
+static const tai_attr_metadata_t tai_metadata_attr_TAI_MODULE_ATTR_TRIBUTARY_MAPPING = {
+    TAI_OBJECT_TYPE_MODULE,
+    TAI_MODULE_ATTR_TRIBUTARY_MAPPING,
+    "TAI_MODULE_ATTR_TRIBUTARY_MAPPING",
+    "tributary-mapping",
+    TAI_ATTR_VALUE_TYPE_OBJMAPLIST,
+    TAI_ATTR_FLAGS_CREATE_AND_SET,
+    NULL,
+    TAI_ATTR_CACHE_POLICY_NEVER,
+};
+
+static const tai_attr_metadata_t tai_metadata_attr_TAI_HOST_INTERFACE_ATTR_INDEX = {
+    TAI_OBJECT_TYPE_HOSTIF,
+    TAI_HOST_INTERFACE_ATTR_INDEX,
+    "TAI_HOST_INTERFACE_ATTR_INDEX",
+    "index",
+    TAI_ATTR_VALUE_TYPE_U32,
+    TAI_ATTR_FLAGS_MANDATORY_ON_CREATE | TAI_ATTR_FLAGS_CREATE_ONLY,
+    NULL,
+    TAI_ATTR_CACHE_POLICY_TTL,
+};
+
+static const tai_attr_metadata_t tai_metadata_attr_TAI_HOST_INTERFACE_ATTR_LANE_FAULTS = {
+    TAI_OBJECT_TYPE_HOSTIF,
+    TAI_HOST_INTERFACE_ATTR_LANE_FAULTS,
+    "TAI_HOST_INTERFACE_ATTR_LANE_FAULTS",
+    "lane-faults",
+    TAI_ATTR_VALUE_TYPE_U32LIST,
+    TAI_ATTR_FLAGS_READ_ONLY,
+    &tai_metadata_enum_tai_host_interface_lane_faults_t,
+    TAI_ATTR_CACHE_POLICY_TTL,
+};
+
+static const tai_attr_metadata_t tai_metadata_attr_TAI_HOST_INTERFACE_ATTR_TX_ALIGN_STATUS = {
+    TAI_OBJECT_TYPE_HOSTIF,
+    TAI_HOST_INTERFACE_ATTR_TX_ALIGN_STATUS,
+    "TAI_HOST_INTERFACE_ATTR_TX_ALIGN_STATUS",
+    "tx-align-status",
+    TAI_ATTR_VALUE_TYPE_S32,
+    TAI_ATTR_FLAGS_READ_ONLY,
+    &tai_metadata_enum_tai_host_interface_tx_align_status_t,
+    TAI_ATTR_CACHE_POLICY_TTL,
+};
+
+static const tai_attr_metadata_t tai_metadata_attr_TAI_HOST_INTERFACE_ATTR_FEC_TYPE = {
+    TAI_OBJECT_TYPE_HOSTIF,
+    TAI_HOST_INTERFACE_ATTR_FEC_TYPE,
+    "TAI_HOST_INTERFACE_ATTR_FEC_TYPE",
+    "fec-type",
+    TAI_ATTR_VALUE_TYPE_S32,
+    TAI_ATTR_FLAGS_CREATE_AND_SET,
+    &tai_metadata_enum_tai_host_interface_fec_type_t,
+    TAI_ATTR_CACHE_POLICY_TTL,
+};
+
+static const tai_attr_metadata_t tai_metadata_attr_TAI_NETWORK_INTERFACE_ATTR_INDEX = {
+    TAI_OBJECT_TYPE_NETWORKIF,
+    TAI_NETWORK_INTERFACE_ATTR_INDEX,
+    "TAI_NETWORK_INTERFACE_ATTR_INDEX",
+    "index",
+    TAI_ATTR_VALUE_TYPE_U32,
+    TAI_ATTR_FLAGS_MANDATORY_ON_CREATE | TAI_ATTR_FLAGS_CREATE_ONLY,
+    NULL,
+    TAI_ATTR_CACHE_POLICY_TTL,
+};
+
+static const tai_attr_metadata_t tai_metadata_attr_TAI_NETWORK_INTERFACE_ATTR_TX_ALIGN_STATUS = {
+    TAI_OBJECT_TYPE_NETWORKIF,
+    TAI_NETWORK_INTERFACE_ATTR_TX_ALIGN_STATUS,
+    "TAI_NETWORK_INTERFACE_ATTR_TX_ALIGN_STATUS",
+    "tx-align-status",
+    TAI_ATTR_VALUE_TYPE_S32,
+    TAI_ATTR_FLAGS_READ_ONLY,
+    &tai_metadata_enum_tai_network_interface_tx_align_status_t,
+    TAI_ATTR_CACHE_POLICY_TTL,
+};
+
+static const tai_attr_metadata_t tai_metadata_attr_TAI_NETWORK_INTERFACE_ATTR_RX_ALIGN_STATUS = {
+    TAI_OBJECT_TYPE_NETWORKIF,
+    TAI_NETWORK_INTERFACE_ATTR_RX_ALIGN_STATUS,
+    "TAI_NETWORK_INTERFACE_ATTR_RX_ALIGN_STATUS",
+    "rx-align-status",
+    TAI_ATTR_VALUE_TYPE_S32,
+    TAI_ATTR_FLAGS_READ_ONLY,
+    &tai_metadata_enum_tai_network_interface_rx_align_status_t,
+    TAI_ATTR_CACHE_POLICY_TTL,
+};
+
+static const tai_attr_metadata_t tai_metadata_attr_TAI_NETWORK_INTERFACE_ATTR_TX_ENABLE = {
+    TAI_OBJECT_TYPE_NETWORKIF,
+    TAI_NETWORK_INTERFACE_ATTR_TX_ENABLE,
+    "TAI_NETWORK_INTERFACE_ATTR_TX_ENABLE",
+    "tx-enable",
+    TAI_ATTR_VALUE_TYPE_BOOLDATA,
+    TAI_ATTR_FLAGS_CREATE_AND_SET,
+    NULL,
+    TAI_ATTR_CACHE_POLICY_TTL,
+};
+
+static const tai_attr_metadata_t tai_metadata_attr_TAI_NETWORK_INTERFACE_ATTR_TX_GRID_SPACING = {
+    TAI_OBJECT_TYPE_NETWORKIF,
+    TAI_NETWORK_INTERFACE_ATTR_TX_GRID_SPACING,
+    "TAI_NETWORK_INTERFACE_ATTR_TX_GRID_SPACING",
+    "tx-grid-spacing",
+    TAI_ATTR_VALUE_TYPE_S32,
+    TAI_ATTR_FLAGS_CREATE_AND_SET,
+    &tai_metadata_enum_tai_network_interface_tx_grid_spacing_t,
+    TAI_ATTR_CACHE_POLICY_TTL,
+};
+
+static const tai_attr_metadata_t tai_metadata_attr_TAI_NETWORK_INTERFACE_ATTR_TX_CHANNEL = {
+    TAI_OBJECT_TYPE_NETWORKIF,
+    TAI_NETWORK_INTERFACE_ATTR_TX_CHANNEL,
+    "TAI_NETWORK_INTERFACE_ATTR_TX_CHANNEL",
+    "tx-channel",
+    TAI_ATTR_VALUE_TYPE_U16,
+    TAI_ATTR_FLAGS_CREATE_AND_SET,
+    NULL,
+    TAI_ATTR_CACHE_POLICY_TTL,
+};
+
+static const tai_attr_metadata_t tai_metadata_attr_TAI_NETWORK_INTERFACE_ATTR_OUTPUT_POWER = {
+    TAI_OBJECT_TYPE_NETWORKIF,
+    TAI_NETWORK_INTERFACE_ATTR_OUTPUT_POWER,
+    "TAI_NETWORK_INTERFACE_ATTR_OUTPUT_POWER",
+    "output-power",
+    TAI_ATTR_VALUE_TYPE_FLT,
+    TAI_ATTR_FLAGS_CREATE_AND_SET,
+    NULL,
+    TAI_ATTR_CACHE_POLICY_TTL,
+};
+
+static const tai_attr_metadata_t tai_metadata_attr_TAI_NETWORK_INTERFACE_ATTR_CURRENT_OUTPUT_POWER = {
+    TAI_OBJECT_TYPE_NETWORKIF,
+    TAI_NETWORK_INTERFACE_ATTR_CURRENT_OUTPUT_POWER,
+    "TAI_NETWORK_INTERFACE_ATTR_CURRENT_OUTPUT_POWER",
+    "current-output-power",
+    TAI_ATTR_VALUE_TYPE_FLT,
+    TAI_ATTR_FLAGS_READ_ONLY,
+    NULL,
+    TAI_ATTR_CACHE_POLICY_TTL,
+};
+
+static const tai_attr_metadata_t tai_metadata_attr_TAI_NETWORK_INTERFACE_ATTR_TX_LASER_FREQ = {
+    TAI_OBJECT_TYPE_NETWORKIF,
+    TAI_NETWORK_INTERFACE_ATTR_TX_LASER_FREQ,
+    "TAI_NETWORK_INTERFACE_ATTR_TX_LASER_FREQ",
+    "tx-laser-freq",
+    TAI_ATTR_VALUE_TYPE_U64,
+    TAI_ATTR_FLAGS_READ_ONLY,
+    NULL,
+    TAI_ATTR_CACHE_POLICY_TTL,
+};
+
+static const tai_attr_metadata_t tai_metadata_attr_TAI_NETWORK_INTERFACE_ATTR_TX_FINE_TUNE_LASER_FREQ = {
+    TAI_OBJECT_TYPE_NETWORKIF,
+    TAI_NETWORK_INTERFACE_ATTR_TX_FINE_TUNE_LASER_FREQ,
+    "TAI_NETWORK_INTERFACE_ATTR_TX_FINE_TUNE_LASER_FREQ",
+    "tx-fine-tune-laser-freq",
+    TAI_ATTR_VALUE_TYPE_U64,
+    TAI_ATTR_FLAGS_CREATE_AND_SET,
+    NULL,
+    TAI_ATTR_CACHE_POLICY_TTL,
+};
+
+static const tai_attr_metadata_t tai_metadata_attr_TAI_NETWORK_INTERFACE_ATTR_MODULATION_FORMAT = {
+    TAI_OBJECT_TYPE_NETWORKIF,
+    TAI_NETWORK_INTERFACE_ATTR_MODULATION_FORMAT,
+    "TAI_NETWORK_INTERFACE_ATTR_MODULATION_FORMAT",
+    "modulation-format",
+    TAI_ATTR_VALUE_TYPE_S32,
+    TAI_ATTR_FLAGS_CREATE_AND_SET,
+    &tai_metadata_enum_tai_network_interface_modulation_format_t,
+    TAI_ATTR_CACHE_POLICY_TTL,
+};
+
+static const tai_attr_metadata_t tai_metadata_attr_TAI_NETWORK_INTERFACE_ATTR_CURRENT_BER = {
+    TAI_OBJECT_TYPE_NETWORKIF,
+    TAI_NETWORK_INTERFACE_ATTR_CURRENT_BER,
+    "TAI_NETWORK_INTERFACE_ATTR_CURRENT_BER",
+    "current-ber",
+    TAI_ATTR_VALUE_TYPE_FLT,
+    TAI_ATTR_FLAGS_READ_ONLY,
+    NULL,
+    TAI_ATTR_CACHE_POLICY_TTL,
+};
+
+static const tai_attr_metadata_t tai_metadata_attr_TAI_NETWORK_INTERFACE_ATTR_CURRENT_BER_PERIOD = {
+    TAI_OBJECT_TYPE_NETWORKIF,
+    TAI_NETWORK_INTERFACE_ATTR_CURRENT_BER_PERIOD,
+    "TAI_NETWORK_INTERFACE_ATTR_CURRENT_BER_PERIOD",
+    "current-ber-period",
+    TAI_ATTR_VALUE_TYPE_U32,
+    TAI_ATTR_FLAGS_READ_ONLY,
+    NULL,
+    TAI_ATTR_CACHE_POLICY_TTL,
+};
+
+static const tai_attr_metadata_t tai_metadata_attr_TAI_NETWORK_INTERFACE_ATTR_DIFFERENTIAL_ENCODING = {
+    TAI_OBJECT_TYPE_NETWORKIF,
+    TAI_NETWORK_INTERFACE_ATTR_DIFFERENTIAL_ENCODING,
+    "TAI_NETWORK_INTERFACE_ATTR_DIFFERENTIAL_ENCODING",
+    "differential-encoding",
+    TAI_ATTR_VALUE_TYPE_BOOLDATA,
+    TAI_ATTR_FLAGS_CREATE_AND_SET,
+    NULL,
+    TAI_ATTR_CACHE_POLICY_TTL,
+};
+
+static const tai_attr_metadata_t tai_metadata_attr_TAI_NETWORK_INTERFACE_ATTR_OPER_STATUS = {
+    TAI_OBJECT_TYPE_NETWORKIF,
+    TAI_NETWORK_INTERFACE_ATTR_OPER_STATUS,
+    "TAI_NETWORK_INTERFACE_ATTR_OPER_STATUS",
+    "oper-status",
+    TAI_ATTR_VALUE_TYPE_S32,
+    TAI_ATTR_FLAGS_CREATE_AND_SET,
+    &tai_metadata_enum_tai_network_interface_oper_status_t,
+    TAI_ATTR_CACHE_POLICY_TTL,
+};
+
+static const tai_attr_metadata_t tai_metadata_attr_TAI_NETWORK_INTERFACE_ATTR_MIN_LASER_FREQ = {
+    TAI_OBJECT_TYPE_NETWORKIF,
+    TAI_NETWORK_INTERFACE_ATTR_MIN_LASER_FREQ,
+    "TAI_NETWORK_INTERFACE_ATTR_MIN_LASER_FREQ",
+    "min-laser-freq",
+    TAI_ATTR_VALUE_TYPE_U64,
+    TAI_ATTR_FLAGS_READ_ONLY,
+    NULL,
+    TAI_ATTR_CACHE_POLICY_IMMUTABLE,
+};
+
+static const tai_attr_metadata_t tai_metadata_attr_TAI_NETWORK_INTERFACE_ATTR_MAX_LASER_FREQ = {
+    TAI_OBJECT_TYPE_NETWORKIF,
+    TAI_NETWORK_INTERFACE_ATTR_MAX_LASER_FREQ,
+    "TAI_NETWORK_INTERFACE_ATTR_MAX_LASER_FREQ",
+    "max-laser-freq",
+    TAI_ATTR_VALUE_TYPE_U64,
+    TAI_ATTR_FLAGS_READ_ONLY,
+    NULL,
+    TAI_ATTR_CACHE_POLICY_IMMUTABLE,
+};
+
+static const tai_attr_metadata_t tai_metadata_attr_TAI_NETWORK_INTERFACE_ATTR_LASER_GRID_SUPPORT = {
+    TAI_OBJECT_TYPE_NETWORKIF,
+    TAI_NETWORK_INTERFACE_ATTR_LASER_GRID_SUPPORT,
+    "TAI_NETWORK_INTERFACE_ATTR_LASER_GRID_SUPPORT",
+    "laser-grid-support",
+    TAI_ATTR_VALUE_TYPE_S32,
+    TAI_ATTR_FLAGS_READ_ONLY,
+    &tai_metadata_enum_tai_network_interface_laser_grid_spacing_t,
+    TAI_ATTR_CACHE_POLICY_IMMUTABLE,
+};
+
+static const tai_attr_metadata_t tai_metadata_attr_TAI_NETWORK_INTERFACE_ATTR_CURRENT_INPUT_POWER = {
+    TAI_OBJECT_TYPE_NETWORKIF,
+    TAI_NETWORK_INTERFACE_ATTR_CURRENT_INPUT_POWER,
+    "TAI_NETWORK_INTERFACE_ATTR_CURRENT_INPUT_POWER",
+    "current-input-power",
+    TAI_ATTR_VALUE_TYPE_FLT,
+    TAI_ATTR_FLAGS_READ_ONLY,
+    NULL,
+    TAI_ATTR_CACHE_POLICY_TTL,
+};
+
+static const tai_attr_metadata_t tai_metadata_attr_TAI_NETWORK_INTERFACE_ATTR_CURRENT_POST_VOA_TOTAL_POWER = {
+    TAI_OBJECT_TYPE_NETWORKIF,
+    TAI_NETWORK_INTERFACE_ATTR_CURRENT_POST_VOA_TOTAL_POWER,
+    "TAI_NETWORK_INTERFACE_ATTR_CURRENT_POST_VOA_TOTAL_POWER",
+    "current-post-voa-total-power",
+    TAI_ATTR_VALUE_TYPE_FLT,
+    TAI_ATTR_FLAGS_READ_ONLY,
+    NULL,
+    TAI_ATTR_CACHE_POLICY_TTL,
+};
+
+static const tai_attr_metadata_t tai_metadata_attr_TAI_NETWORK_INTERFACE_ATTR_CURRENT_PROVISIONED_CHANNEL_POWER = {
+    TAI_OBJECT_TYPE_NETWORKIF,
+    TAI_NETWORK_INTERFACE_ATTR_CURRENT_PROVISIONED_CHANNEL_POWER,
+    "TAI_NETWORK_INTERFACE_ATTR_CURRENT_PROVISIONED_CHANNEL_POWER",
+    "current-provisioned-channel-power",
+    TAI_ATTR_VALUE_TYPE_FLT,
+    TAI_ATTR_FLAGS_READ_ONLY,
+    NULL,
+    TAI_ATTR_CACHE_POLICY_TTL,
+};
+
+static const tai_attr_metadata_t tai_metadata_attr_TAI_NETWORK_INTERFACE_ATTR_PULSE_SHAPING_TX = {
+    TAI_OBJECT_TYPE_NETWORKIF,
+    TAI_NETWORK_INTERFACE_ATTR_PULSE_SHAPING_TX,
+    "TAI_NETWORK_INTERFACE_ATTR_PULSE_SHAPING_TX",
+    "pulse-shaping-tx",
+    TAI_ATTR_VALUE_TYPE_BOOLDATA,
+    TAI_ATTR_FLAGS_CREATE_AND_SET,
+    NULL,
+    TAI_ATTR_CACHE_POLICY_TTL,
+};
+
+static const tai_attr_metadata_t tai_metadata_attr_TAI_NETWORK_INTERFACE_ATTR_PULSE_SHAPING_RX = {
+    TAI_OBJECT_TYPE_NETWORKIF,
+    TAI_NETWORK_INTERFACE_ATTR_PULSE_SHAPING_RX,
+    "TAI_NETWORK_INTERFACE_ATTR_PULSE_SHAPING_RX",
+    "pulse-shaping-rx",
+    TAI_ATTR_VALUE_TYPE_BOOLDATA,
+    TAI_ATTR_FLAGS_CREATE_AND_SET,
+    NULL,
+    TAI_ATTR_CACHE_POLICY_TTL,
+};
+
+static const tai_attr_metadata_t tai_metadata_attr_TAI_NETWORK_INTERFACE_ATTR_PULSE_SHAPING_TX_BETA = {
+    TAI_OBJECT_TYPE_NETWORKIF,
+    TAI_NETWORK_INTERFACE_ATTR_PULSE_SHAPING_TX_BETA,
+    "TAI_NETWORK_INTERFACE_ATTR_PULSE_SHAPING_TX_BETA",
+    "pulse-shaping-tx-beta",
+    TAI_ATTR_VALUE_TYPE_FLT,
+    TAI_ATTR_FLAGS_CREATE_AND_SET,
+    NULL,
+    TAI_ATTR_CACHE_POLICY_TTL,
+};
+
+static const tai_attr_metadata_t tai_metadata_attr_TAI_NETWORK_INTERFACE_ATTR_PULSE_SHAPING_RX_BETA = {
+    TAI_OBJECT_TYPE_NETWORKIF,
+    TAI_NETWORK_INTERFACE_ATTR_PULSE_SHAPING_RX_BETA,
+    "TAI_NETWORK_INTERFACE_ATTR_PULSE_SHAPING_RX_BETA",
+    "pulse-shaping-rx-beta",
+    TAI_ATTR_VALUE_TYPE_FLT,
+    TAI_ATTR_FLAGS_CREATE_AND_SET,
+    NULL,
+    TAI_ATTR_CACHE_POLICY_TTL,
+};
+
+static const tai_attr_metadata_t tai_metadata_attr_TAI_NETWORK_INTERFACE_ATTR_VOA_RX = {
+    TAI_OBJECT_TYPE_NETWORKIF,
+    TAI_NETWORK_INTERFACE_ATTR_VOA_RX,
+    "TAI_NETWORK_INTERFACE_ATTR_VOA_RX",
+    "voa-rx",
+    TAI_ATTR_VALUE_TYPE_FLT,
+    TAI_ATTR_FLAGS_CREATE_AND_SET,
+    NULL,
+    TAI_ATTR_CACHE_POLICY_TTL,
+};
+
+static const tai_attr_metadata_t tai_metadata_attr_TAI_NETWORK_INTERFACE_ATTR_CHANNEL_FREQ = {
+    TAI_OBJECT_TYPE_NETWORKIF,
+    TAI_NETWORK_INTERFACE_ATTR_CHANNEL_FREQ,
+    "TAI_NETWORK_INTERFACE_ATTR_CHANNEL_FREQ",
+    "channel-freq",
+    TAI_ATTR_VALUE_TYPE_FLT,
+    TAI_ATTR_FLAGS_CREATE_AND_SET,
+    NULL,
+    TAI_ATTR_CACHE_POLICY_TTL,
+};
+
+static const tai_attr_metadata_t tai_metadata_attr_TAI_NETWORK_INTERFACE_ATTR_CHANNEL_LAMBDA = {
+    TAI_OBJECT_TYPE_NETWORKIF,
+    TAI_NETWORK_INTERFACE_ATTR_CHANNEL_LAMBDA,
+    "TAI_NETWORK_INTERFACE_ATTR_CHANNEL_LAMBDA",
+    "channel-lambda",
+    TAI_ATTR_VALUE_TYPE_FLT,
+    TAI_ATTR_FLAGS_CREATE_AND_SET,
+    NULL,
+    TAI_ATTR_CACHE_POLICY_TTL,
+};
+
+/* indexed by #tai_module_attr_t */
+static const tai_attr_metadata_t *const tai_metadata_object_type_tai_module_attr_t[] = {
+    &tai_metadata_attr_TAI_MODULE_ATTR_LOCATION,
+    &tai_metadata_attr_TAI_MODULE_ATTR_VENDOR_NAME,
+    &tai_metadata_attr_TAI_MODULE_ATTR_VENDOR_PART_NUMBER,
+    &tai_metadata_attr_TAI_MODULE_ATTR_VENDOR_SERIAL_NUMBER,
+    &tai_metadata_attr_TAI_MODULE_ATTR_FIRMWARE_VERSIONS,
+    &tai_metadata_attr_TAI_MODULE_ATTR_OPER_STATUS,
+    &tai_metadata_attr_TAI_MODULE_ATTR_TEMP,
+    &tai_metadata_attr_TAI_MODULE_ATTR_POWER,
+    &tai_metadata_attr_TAI_MODULE_ATTR_NUM_HOST_INTERFACES,
+    &tai_metadata_attr_TAI_MODULE_ATTR_NUM_NETWORK_INTERFACES,
+    &tai_metadata_attr_TAI_MODULE_ATTR_ADMIN_STATUS,
+    &tai_metadata_attr_TAI_MODULE_ATTR_TRIBUTARY_MAPPING,
+    NULL,
+};
+
+/* indexed by #tai_host_interface_attr_t */
+static const tai_attr_metadata_t *const tai_metadata_object_type_tai_host_interface_attr_t[] = {
+    &tai_metadata_attr_TAI_HOST_INTERFACE_ATTR_INDEX,
+    &tai_metadata_attr_TAI_HOST_INTERFACE_ATTR_LANE_FAULTS,
+    &tai_metadata_attr_TAI_HOST_INTERFACE_ATTR_TX_ALIGN_STATUS,
+    &tai_metadata_attr_TAI_HOST_INTERFACE_ATTR_FEC_TYPE,
+    NULL,
+};
+
+/* indexed by #tai_network_interface_attr_t */
+static const tai_attr_metadata_t *const tai_metadata_object_type_tai_network_interface_attr_t[] = {
+    &tai_metadata_attr_TAI_NETWORK_INTERFACE_ATTR_INDEX,
+    &tai_metadata_attr_TAI_NETWORK_INTERFACE_ATTR_TX_ALIGN_STATUS,
+    &tai_metadata_attr_TAI_NETWORK_INTERFACE_ATTR_RX_ALIGN_STATUS,
+    &tai_metadata_attr_TAI_NETWORK_INTERFACE_ATTR_TX_ENABLE,
+    &tai_metadata_attr_TAI_NETWORK_INTERFACE_ATTR_TX_GRID_SPACING,
+    &tai_metadata_attr_TAI_NETWORK_INTERFACE_ATTR_TX_CHANNEL,
+    &tai_metadata_attr_TAI_NETWORK_INTERFACE_ATTR_OUTPUT_POWER,
+    &tai_metadata_attr_TAI_NETWORK_INTERFACE_ATTR_CURRENT_OUTPUT_POWER,
+    &tai_metadata_attr_TAI_NETWORK_INTERFACE_ATTR_TX_LASER_FREQ,
+    &tai_metadata_attr_TAI_NETWORK_INTERFACE_ATTR_TX_FINE_TUNE_LASER_FREQ,
+    &tai_metadata_attr_TAI_NETWORK_INTERFACE_ATTR_MODULATION_FORMAT,
+    &tai_metadata_attr_TAI_NETWORK_INTERFACE_ATTR_CURRENT_BER,
+    &tai_metadata_attr_TAI_NETWORK_INTERFACE_ATTR_CURRENT_BER_PERIOD,
+    &tai_metadata_attr_TAI_NETWORK_INTERFACE_ATTR_DIFFERENTIAL_ENCODING,
+    &tai_metadata_attr_TAI_NETWORK_INTERFACE_ATTR_OPER_STATUS,
+    &tai_metadata_attr_TAI_NETWORK_INTERFACE_ATTR_MIN_LASER_FREQ,
+    &tai_metadata_attr_TAI_NETWORK_INTERFACE_ATTR_MAX_LASER_FREQ,
+    &tai_metadata_attr_TAI_NETWORK_INTERFACE_ATTR_LASER_GRID_SUPPORT,
+    &tai_metadata_attr_TAI_NETWORK_INTERFACE_ATTR_CURRENT_INPUT_POWER,
+    &tai_metadata_attr_TAI_NETWORK_INTERFACE_ATTR_CURRENT_POST_VOA_TOTAL_POWER,
+    &tai_metadata_attr_TAI_NETWORK_INTERFACE_ATTR_CURRENT_PROVISIONED_CHANNEL_POWER,
+    &tai_metadata_attr_TAI_NETWORK_INTERFACE_ATTR_PULSE_SHAPING_TX,
+    &tai_metadata_attr_TAI_NETWORK_INTERFACE_ATTR_PULSE_SHAPING_RX,
+    &tai_metadata_attr_TAI_NETWORK_INTERFACE_ATTR_PULSE_SHAPING_TX_BETA,
+    &tai_metadata_attr_TAI_NETWORK_INTERFACE_ATTR_PULSE_SHAPING_RX_BETA,
+    &tai_metadata_attr_TAI_NETWORK_INTERFACE_ATTR_VOA_RX,
+    &tai_metadata_attr_TAI_NETWORK_INTERFACE_ATTR_CHANNEL_FREQ,
+    &tai_metadata_attr_TAI_NETWORK_INTERFACE_ATTR_CHANNEL_LAMBDA,
+    NULL,
+};
+
+/* indexed by #tai_object_type_t */
+static const tai_attr_metadata_t *const *const tai_metadata_attr_by_object_type[] = {
+    NULL,
+    tai_metadata_object_type_tai_module_attr_t,
+    tai_metadata_object_type_tai_host_interface_attr_t,
+    tai_metadata_object_type_tai_network_interface_attr_t,
+};
+
+static const size_t tai_metadata_attr_by_object_type_count[] = {
+    0,
+    12,
+    4,
+    28,
+};
+
+/* the mandatory on create attributes as a mask of attribute ids,
+ * indexed by #tai_object_type_t */
+static const uint64_t tai_metadata_mandatory_on_create[] = {
+    0x0ULL,
+    0x1ULL,
+    0x1ULL,
+    0x1ULL,
+};
+
+/**
+ * @brief Get the metadata of an attribute
+ *
+ * @param [in] object_type The object type
+ * @param [in] attr_id The attribute id
+ *
+ * @return The metadata, NULL if the attribute is unknown
+ */
+static inline const tai_attr_metadata_t *tai_metadata_get_attr_metadata(
+    _In_ tai_object_type_t object_type,
+    _In_ tai_attr_id_t attr_id)
+{
+    if (object_type <= TAI_OBJECT_TYPE_NULL || object_type >= TAI_OBJECT_TYPE_MAX) {
+        return NULL;
+    }
+    if (attr_id >= tai_metadata_attr_by_object_type_count[object_type]) {
+        return NULL;
+    }
+    return tai_metadata_attr_by_object_type[object_type][attr_id];
+}
+
+/**
+ * @brief Get the metadata of an attribute by its short name
+ *
+ * @param [in] object_type The object type
+ * @param [in] short_name The attribute short name, e.g. "tx-enable"
+ *
+ * @return The metadata, NULL if the attribute is unknown
+ */
+static inline const tai_attr_metadata_t *tai_metadata_get_attr_metadata_by_short_name(
+    _In_ tai_object_type_t object_type,
+    _In_ const char *short_name)
+{
+    size_t i;
+    const tai_attr_metadata_t *md;
+
+    if (object_type <= TAI_OBJECT_TYPE_NULL || object_type >= TAI_OBJECT_TYPE_MAX) {
+        return NULL;
+    }
+    for (i = 0; i < tai_metadata_attr_by_object_type_count[object_type]; i++) {
+        md = tai_metadata_attr_by_object_type[object_type][i];
+        if (md && strcmp(md->attridshortname, short_name) == 0) {
+            return md;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Check the value of an enum attribute against its enum
+ *
+ * @param [in] md The metadata of the attribute
+ * @param [in] value The value
+ *
+ * @return false if the attribute is an enum and the value is not one of its
+ *         values, true otherwise
+ */
+static inline bool tai_metadata_is_valid_enum_value(
+    _In_ const tai_attr_metadata_t *md,
+    _In_ const tai_attribute_value_t *value)
+{
+    size_t i;
+
+    if (md->enummetadata == NULL || md->enummetadata->containsflags || TAI_META_IS_LIST(md)) {
+        return true;
+    }
+    for (i = 0; i < md->enummetadata->valuescount; i++) {
+        if (md->enummetadata->values[i] == value->s32) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Check a list of attributes passed to a create or a set function
+ *        against their metadata, in a single pass over the list
+ *
+ * Every attribute is looked up by its id and the mandatory attributes are
+ * checked with a mask, so that adapters validate lists of any length in
+ * linear time.
+ *
+ * @param [in] object_type The object type
+ * @param [in] create true for the attributes of a create, false for a set
+ * @param [in] attr_count The number of attributes in the list
+ * @param [in] attr_list The attributes
+ *
+ * @return TAI_STATUS_SUCCESS if the attributes are valid. Otherwise
+ *         TAI_STATUS_ATTR_NOT_SUPPORTED_0 for an unknown attribute,
+ *         TAI_STATUS_INVALID_ATTRIBUTE_0 for an attribute which can not be
+ *         written and TAI_STATUS_INVALID_ATTR_VALUE_0 for an invalid enum value,
+ *         plus the index of the attribute, or
+ *         TAI_STATUS_MANDATORY_ATTRIBUTE_MISSING, or
+ *         TAI_STATUS_INVALID_PARAMETER for an unknown object type.
+ */
+static inline tai_status_t tai_metadata_check_attr_list(
+    _In_ tai_object_type_t object_type,
+    _In_ bool create,
+    _In_ uint32_t attr_count,
+    _In_ const tai_attribute_t *attr_list)
+{
+    const tai_attr_metadata_t *md;
+    uint64_t given = 0;
+    uint32_t i;
+
+    if (object_type <= TAI_OBJECT_TYPE_NULL || object_type >= TAI_OBJECT_TYPE_MAX) {
+        return TAI_STATUS_INVALID_PARAMETER;
+    }
+    for (i = 0; i < attr_count; i++) {
+        md = tai_metadata_get_attr_metadata(object_type, attr_list[i].id);
+        if (md == NULL) {
+            return TAI_STATUS_ATTR_NOT_SUPPORTED_0 + i;
+        }
+        if (TAI_META_IS_READ_ONLY(md) || (!create && TAI_META_IS_CREATE_ONLY(md))) {
+            return TAI_STATUS_INVALID_ATTRIBUTE_0 + i;
+        }
+        if (!tai_metadata_is_valid_enum_value(md, &attr_list[i].value)) {
+            return TAI_STATUS_INVALID_ATTR_VALUE_0 + i;
+        }
+        if (attr_list[i].id < 64) {
+            given |= 1ULL << attr_list[i].id;
+        }
+    }
+    if (create && (tai_metadata_mandatory_on_create[object_type] & ~given) != 0) {
+        return TAI_STATUS_MANDATORY_ATTRIBUTE_MISSING;
+    }
+    return TAI_STATUS_SUCCESS;
+}
+
+#endif /** __TAIMETADATA_H_ */
@@ -0,0 +1,190 @@
+/**
+ * @file    taimetadatatypes.h
+ * @brief   This module defines the TAI attribute metadata types
+ *
+ * @copyright Copyright (c) 2014 Microsoft Open Technologies, Inc.
+ * @copyright Copyright (c) 2018 Nippon Telegraph and Telephone Corporation
+ *
+ * @remark  Licensed under the Apache License, Version 2.0 (the "License"); you
+ *          may not use this file except in compliance with the License. You may
+ *          obtain a copy of the License at
+ *          http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * @remark  THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ *          CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ *          LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ *          FOR A PARTICULAR PURPOSE, MERCHANTABILITY OR NON-INFRINGEMENT.
+ *
+ * @remark  See the Apache Version 2.0 License for specific language governing
+ *          permissions and limitations under the License.
+ */
+
+#if !defined (__TAIMETADATATYPES_H_)
+#define __TAIMETADATATYPES_H_
+
+#include <stddef.h>
+#include "tai.h"
+
+/**
+ * @defgroup TAIMETADATATYPES TAI - Metadata Types Definitions
+ *
+ * The metadata describes every attribute declared in the TAI headers. It is
+ * generated from the \@type and \@flags annotations of the attribute enums by
+ * meta/gen_metadata.py, see taimetadata.h.
+ *
+ * @{
+ */
+
+/**
+ * @brief The member of #tai_attribute_value_t used by an attribute
+ */
+typedef enum _tai_attr_value_type_t
+{
+    TAI_ATTR_VALUE_TYPE_UNSPECIFIED,
+    TAI_ATTR_VALUE_TYPE_BOOLDATA,
+    TAI_ATTR_VALUE_TYPE_CHARDATA,
+    TAI_ATTR_VALUE_TYPE_U8,
+    TAI_ATTR_VALUE_TYPE_S8,
+    TAI_ATTR_VALUE_TYPE_U16,
+    TAI_ATTR_VALUE_TYPE_S16,
+    TAI_ATTR_VALUE_TYPE_U32,
+    TAI_ATTR_VALUE_TYPE_S32,
+    TAI_ATTR_VALUE_TYPE_U64,
+    TAI_ATTR_VALUE_TYPE_S64,
+    TAI_ATTR_VALUE_TYPE_FLT,
+    TAI_ATTR_VALUE_TYPE_PTR,
+    TAI_ATTR_VALUE_TYPE_OID,
+    TAI_ATTR_VALUE_TYPE_OBJLIST,
+    TAI_ATTR_VALUE_TYPE_CHARLIST,
+    TAI_ATTR_VALUE_TYPE_U8LIST,
+    TAI_ATTR_VALUE_TYPE_S8LIST,
+    TAI_ATTR_VALUE_TYPE_U16LIST,
+    TAI_ATTR_VALUE_TYPE_S16LIST,
+    TAI_ATTR_VALUE_TYPE_U32LIST,
+    TAI_ATTR_VALUE_TYPE_S32LIST,
+    TAI_ATTR_VALUE_TYPE_FLOATLIST,
+    TAI_ATTR_VALUE_TYPE_U32RANGE,
+    TAI_ATTR_VALUE_TYPE_S32RANGE,
+    TAI_ATTR_VALUE_TYPE_OBJMAPLIST,
+    TAI_ATTR_VALUE_TYPE_MAX
+} tai_attr_value_type_t;
+
+/**
+ * @brief Attribute access flags, a bitmap
+ */
+typedef enum _tai_attr_flags_t
+{
+    /** The attribute must be passed to the create function */
+    TAI_ATTR_FLAGS_MANDATORY_ON_CREATE = 0x01,
+
+    /** The attribute can only be passed to the create function */
+    TAI_ATTR_FLAGS_CREATE_ONLY         = 0x02,
+
+    /** The attribute can be passed to the create and set functions */
+    TAI_ATTR_FLAGS_CREATE_AND_SET      = 0x04,
+
+    /** The attribute can only be retrieved */
+    TAI_ATTR_FLAGS_READ_ONLY           = 0x08,
+
+} tai_attr_flags_t;
+
+/**
+ * @brief How long an adapter may serve the value of an attribute from a
+ *        cache instead of reading it from the hardware
+ */
+typedef enum _tai_attr_cache_policy_t
+{
+    /** The value may change at any time, it is always read */
+    TAI_ATTR_CACHE_POLICY_NEVER,
+
+    /** The value may be cached for a time, or until it is set */
+    TAI_ATTR_CACHE_POLICY_TTL,
+
+    /** The value does not change while the module is present */
+    TAI_ATTR_CACHE_POLICY_IMMUTABLE,
+
+} tai_attr_cache_policy_t;
+
+/**
+ * @brief Is the attribute read only helper
+ */
+#define TAI_META_IS_READ_ONLY(md)       (((md)->flags & TAI_ATTR_FLAGS_READ_ONLY) != 0)
+
+/**
+ * @brief Is the attribute create only helper
+ */
+#define TAI_META_IS_CREATE_ONLY(md)     (((md)->flags & TAI_ATTR_FLAGS_CREATE_ONLY) != 0)
+
+/**
+ * @brief Is the attribute mandatory on create helper
+ */
+#define TAI_META_IS_MANDATORY(md)       (((md)->flags & TAI_ATTR_FLAGS_MANDATORY_ON_CREATE) != 0)
+
+/**
+ * @brief Is the attribute value a { count, list } structure helper
+ */
+#define TAI_META_IS_LIST(md)                                        \
+    ((((md)->attrvaluetype >= TAI_ATTR_VALUE_TYPE_OBJLIST) &&       \
+      ((md)->attrvaluetype <= TAI_ATTR_VALUE_TYPE_FLOATLIST)) ||    \
+     ((md)->attrvaluetype == TAI_ATTR_VALUE_TYPE_OBJMAPLIST))
+
+/**
+ * @brief Metadata of an enum used as attribute value
+ */
+typedef struct _tai_enum_metadata_t
+{
+    /** Enum type name, e.g. "tai_module_oper_status_t" */
+    const char *name;
+
+    /** Number of values */
+    size_t valuescount;
+
+    /** Values */
+    const int32_t *values;
+
+    /** Value names, e.g. "TAI_MODULE_OPER_STATUS_READY" */
+    const char *const *valuesnames;
+
+    /** Value short names, e.g. "ready" */
+    const char *const *valuesshortnames;
+
+    /** The values are bits of a bitmap */
+    bool containsflags;
+
+} tai_enum_metadata_t;
+
+/**
+ * @brief Metadata of an attribute
+ */
+typedef struct _tai_attr_metadata_t
+{
+    /** Object type of the attribute */
+    tai_object_type_t objecttype;
+
+    /** Attribute id */
+    tai_attr_id_t attrid;
+
+    /** Attribute id name, e.g. "TAI_MODULE_ATTR_VENDOR_NAME" */
+    const char *attridname;
+
+    /** Attribute short name, e.g. "vendor-name" */
+    const char *attridshortname;
+
+    /** Member of #tai_attribute_value_t holding the value */
+    tai_attr_value_type_t attrvaluetype;
+
+    /** Bitmap of #tai_attr_flags_t */
+    uint32_t flags;
+
+    /** Enum metadata when the value is an enum (or a list of enums) */
+    const tai_enum_metadata_t *enummetadata;
+
+    /** How long the value may be cached */
+    tai_attr_cache_policy_t cachepolicy;
+
+} tai_attr_metadata_t;
+
+/**
+ * @}
+ */
+#endif /** __TAIMETADATATYPES_H_ */
@@ -0,0 +1,125 @@
+/**
+ *  @file    stub_dump.h
+ *  @brief   Binary format of the stub TAI adapter dump
+ *
+ *  tai_dbg_generate_dump() writes a snapshot of every object and of its
+ *  attributes as fixed size records, which a reader maps and walks in place:
+ *
+ *  +--------------------+ 0
+ *  | stub_dump_header_t |
+ *  +--------------------+ objects_offset
+ *  | stub_dump_object_t | object_count records
+ *  +--------------------+ attrs_offset
+ *  | stub_dump_attr_t   | attr_count records, grouped by object
+ *  +--------------------+ logs_offset
+ *  | stub_dump_log_t    | log_count records, oldest first
+ *  +--------------------+ data_offset
+ *  | list elements and  | data_size bytes, every item 8-byte aligned
+ *  | log messages       |
+ *  +--------------------+ file_size
+ *
+ *  Offsets are from the start of the file and values use the byte order of
+ *  the host which wrote the dump. A minor version only adds fields at the end
+ *  of the records, readers use the record sizes of the header to step through
+ *  the tables; readers reject a different major version.
+ *
+ *  @copyright Copyright (C) 2018 Cumulus Networks, Inc. All rights reserved
+ *
+ *  @remark  Licensed under the Apache License, Version 2.0 (the "License"); you
+ *           may not use this file except in compliance with the License. You may
+ *           obtain a copy of the License at
+ *           http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  @remark  THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ *           CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ *           LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ *           FOR A PARTICULAR PURPOSE, MERCHANTABILITY OR NON-INFRINGEMENT.
+ *
+ *  @remark  See the Apache Version 2.0 License for specific language governing
+ *           permissions and limitations under the License.
+ */
+
+#if !defined (__STUB_DUMP_H_)
+#define __STUB_DUMP_H_
+
+#include <stdint.h>
+
+#define STUB_DUMP_MAGIC         "TAIDUMP"   /**< Including the terminating NUL */
+#define STUB_DUMP_BYTE_ORDER    0x01020304
+#define STUB_DUMP_VERSION_MAJOR 1
+#define STUB_DUMP_VERSION_MINOR 2
+
+/** @brief Items of the data section start on this boundary */
+#define STUB_DUMP_ALIGN         8
+
+/** @brief The dump header, at offset 0 */
+typedef struct _stub_dump_header_t {
+    char     magic[8];          /**< #STUB_DUMP_MAGIC */
+    uint32_t byte_order;        /**< #STUB_DUMP_BYTE_ORDER as written */
+    uint16_t version_major;     /**< #STUB_DUMP_VERSION_MAJOR */
+    uint16_t version_minor;     /**< #STUB_DUMP_VERSION_MINOR */
+    uint32_t header_size;       /**< sizeof(stub_dump_header_t) */
+    uint32_t reserved;
+    uint64_t timestamp;         /**< CLOCK_REALTIME, in nanoseconds */
+    uint64_t file_size;
+    uint64_t objects_offset;
+    uint32_t object_count;
+    uint32_t object_size;       /**< sizeof(stub_dump_object_t) */
+    uint64_t attrs_offset;
+    uint32_t attr_count;
+    uint32_t attr_size;         /**< sizeof(stub_dump_attr_t) */
+    uint64_t logs_offset;
+    uint32_t log_count;
+    uint32_t log_size;          /**< sizeof(stub_dump_log_t) */
+    uint64_t data_offset;
+    uint64_t data_size;
+    uint64_t log_written;       /**< Log records written since start */
+    uint64_t log_dropped;       /**< Log records dropped since start */
+    uint64_t cache_hits;        /**< Attributes served by the attribute cache
+                                     since start, version 1.1 */
+    uint64_t cache_misses;      /**< Cacheable attributes read from the
+                                     hardware since start, version 1.1 */
+} stub_dump_header_t;
+
+/** @brief An object */
+typedef struct _stub_dump_object_t {
+    uint64_t oid;
+    uint32_t object_type;       /**< #tai_object_type_t */
+    uint32_t first_attr;        /**< Index of its first attribute record */
+    uint32_t attr_count;
+    uint32_t reserved;
+} stub_dump_object_t;
+
+/** @brief An attribute of an object */
+typedef struct _stub_dump_attr_t {
+    uint32_t attr_id;
+    int32_t  status;            /**< Status of the attribute read, the value is
+                                     only meaningful on TAI_STATUS_SUCCESS */
+    uint32_t value_type;        /**< #tai_attr_value_type_t */
+    uint32_t count;             /**< Elements of a list, stub_dump_objmap_t
+                                     entries of an object map list (version
+                                     1.2), or bytes of chardata */
+    uint64_t value;             /**< Scalars: the first 8 bytes of the
+                                     #tai_attribute_value_t. Lists and
+                                     chardata: offset of the elements */
+} stub_dump_attr_t;
+
+/**
+ * @brief An entry of an object map list, one per value of each key. A key
+ *        without values has a single entry with a null value.
+ */
+typedef struct _stub_dump_objmap_t {
+    uint64_t key;
+    uint64_t value;
+} stub_dump_objmap_t;
+
+/** @brief A recent log record */
+typedef struct _stub_dump_log_t {
+    uint64_t timestamp;         /**< CLOCK_REALTIME, in nanoseconds */
+    uint32_t tid;
+    uint16_t api;               /**< #tai_api_t */
+    uint16_t level;             /**< #tai_log_level_t */
+    uint64_t msg_offset;        /**< Offset of the NUL terminated message */
+} stub_dump_log_t;
+
+#endif /** __STUB_DUMP_H_ */
@@ -0,0 +1,359 @@
+/**
+ *  @file    stub_log.c
+ *  @brief   Asynchronous logging for the stub TAI adapter
+ *
+ *  @copyright Copyright (C) 2018 Cumulus Networks, Inc. All rights reserved
+ *
+ *  @remark  Licensed under the Apache License, Version 2.0 (the "License"); you
+ *           may not use this file except in compliance with the License. You may
+ *           obtain a copy of the License at
+ *           http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  @remark  THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ *           CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ *           LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ *           FOR A PARTICULAR PURPOSE, MERCHANTABILITY OR NON-INFRINGEMENT.
+ *
+ *  @remark  See the Apache Version 2.0 License for specific language governing
+ *           permissions and limitations under the License.
+ */
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <syslog.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include "stub_log.h"
+
+/** @brief Records of a per-thread ring, a power of 2 */
+#define STUB_LOG_RING_SIZE      256
+
+/** @brief Maximum length of a formatted record */
+#define STUB_LOG_MSG_LEN        232
+
+/** @brief Written records kept for tai_dbg_generate_dump() */
+#define STUB_LOG_HISTORY_SIZE   1024
+
+/** @brief Interval at which the writer drains the rings */
+#define STUB_LOG_DRAIN_MS       10
+
+/** @brief A log record */
+typedef struct _stub_log_record_t {
+    uint64_t        timestamp;  /**< CLOCK_REALTIME, in nanoseconds */
+    tai_api_t       api;
+    tai_log_level_t level;
+    pid_t           tid;
+    char            msg[STUB_LOG_MSG_LEN];
+} stub_log_record_t;
+
+/**
+ * @brief A single producer, single consumer ring owned by one thread
+ *
+ * The owning thread only writes 'head' and the writer only writes 'tail', so
+ * neither side takes a lock.
+ */
+typedef struct _stub_log_ring_t {
+    struct _stub_log_ring_t *next;
+    uint32_t                 head;
+    uint32_t                 tail;
+    uint64_t                 dropped;
+    bool                     orphaned;  /**< The thread has exited */
+    pid_t                    tid;
+    stub_log_record_t        records[STUB_LOG_RING_SIZE];
+} stub_log_ring_t;
+
+tai_log_level_t stub_log_levels[TAI_API_MAX] = {
+    [0 ... TAI_API_MAX-1] = TAI_LOG_LEVEL_WARN
+};
+
+/**
+ * @brief Given a TAI logging level, convert to a syslog level.
+ */
+static const int stub_log_syslog_level[TAI_LOG_LEVEL_MAX] = {
+    [TAI_LOG_LEVEL_DEBUG]    = LOG_DEBUG,
+    [TAI_LOG_LEVEL_INFO]     = LOG_INFO,
+    [TAI_LOG_LEVEL_NOTICE]   = LOG_NOTICE,
+    [TAI_LOG_LEVEL_WARN]     = LOG_WARNING,
+    [TAI_LOG_LEVEL_ERROR]    = LOG_ERR,
+    [TAI_LOG_LEVEL_CRITICAL] = LOG_CRIT
+};
+
+static __thread stub_log_ring_t *stub_log_ring;
+static pthread_key_t             stub_log_ring_key;
+static pthread_once_t            stub_log_once = PTHREAD_ONCE_INIT;
+
+/** @brief Protects the ring list, the history and the consumer side */
+static pthread_mutex_t   stub_log_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t    stub_log_cond;
+static stub_log_ring_t  *stub_log_rings;
+static uint32_t          stub_log_ring_count;
+static pthread_t         stub_log_writer;
+static bool              stub_log_running;
+static uint64_t          stub_log_written;
+static uint64_t          stub_log_dropped;  /**< Dropped by exited threads */
+static uint64_t          stub_log_reported; /**< Drops already reported */
+static stub_log_record_t stub_log_history[STUB_LOG_HISTORY_SIZE];
+static uint64_t          stub_log_history_count;
+
+/**
+ * @brief Called when a thread which has logged exits
+ */
+static void stub_log_ring_release(_In_ void *arg)
+{
+    stub_log_ring_t *ring = arg;
+
+    __atomic_store_n(&ring->orphaned, true, __ATOMIC_RELEASE);
+}
+
+static void stub_log_once_init(void)
+{
+    pthread_condattr_t attr;
+
+    pthread_key_create(&stub_log_ring_key, stub_log_ring_release);
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&stub_log_cond, &attr);
+    pthread_condattr_destroy(&attr);
+}
+
+/**
+ * @brief Get the ring of the calling thread, creating it on first use
+ */
+static stub_log_ring_t *stub_log_get_ring(void)
+{
+    stub_log_ring_t *ring = stub_log_ring;
+
+    if (NULL != ring) {
+        return ring;
+    }
+    pthread_once(&stub_log_once, stub_log_once_init);
+    ring = calloc(1, sizeof(*ring));
+    if (NULL == ring) {
+        return NULL;
+    }
+    ring->tid = syscall(SYS_gettid);
+    pthread_setspecific(stub_log_ring_key, ring);
+
+    pthread_mutex_lock(&stub_log_lock);
+    ring->next = stub_log_rings;
+    stub_log_rings = ring;
+    stub_log_ring_count++;
+    pthread_mutex_unlock(&stub_log_lock);
+
+    stub_log_ring = ring;
+    return ring;
+}
+
+void stub_log_vwrite(
+    _In_ tai_api_t       tai_api_id,
+    _In_ tai_log_level_t log_level,
+    _In_ const char     *format,
+    _In_ va_list         ap)
+{
+    stub_log_ring_t *ring = stub_log_get_ring();
+    stub_log_record_t *rec;
+    struct timespec ts;
+    uint32_t head, tail;
+
+    if (NULL == ring) {
+        return;
+    }
+    head = ring->head;
+    tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+    if (STUB_LOG_RING_SIZE == head - tail) {
+        __atomic_fetch_add(&ring->dropped, 1, __ATOMIC_RELAXED);
+        return;
+    }
+
+    rec = &ring->records[head & (STUB_LOG_RING_SIZE - 1)];
+    clock_gettime(CLOCK_REALTIME, &ts);
+    rec->timestamp = ((uint64_t)ts.tv_sec * 1000000000UL) + ts.tv_nsec;
+    rec->api = tai_api_id;
+    rec->level = log_level;
+    rec->tid = ring->tid;
+    vsnprintf(rec->msg, sizeof(rec->msg), format, ap);
+    __atomic_store_n(&ring->head, head + 1, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief Write the records of every ring, stub_log_lock must be held
+ */
+static void stub_log_drain_locked(void)
+{
+    stub_log_ring_t **prev = &stub_log_rings;
+    stub_log_ring_t *ring;
+    stub_log_record_t *rec;
+    uint64_t dropped = stub_log_dropped;
+    uint32_t head, tail;
+
+    while (NULL != (ring = *prev)) {
+        head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+        for (tail = ring->tail; tail != head; tail++) {
+            rec = &ring->records[tail & (STUB_LOG_RING_SIZE - 1)];
+            syslog(stub_log_syslog_level[rec->level], "%s", rec->msg);
+            stub_log_history[stub_log_history_count++ % STUB_LOG_HISTORY_SIZE] = *rec;
+            stub_log_written++;
+        }
+        __atomic_store_n(&ring->tail, tail, __ATOMIC_RELEASE);
+
+        dropped += __atomic_load_n(&ring->dropped, __ATOMIC_RELAXED);
+        if (__atomic_load_n(&ring->orphaned, __ATOMIC_ACQUIRE) &&
+            (__atomic_load_n(&ring->head, __ATOMIC_ACQUIRE) == tail)) {
+            *prev = ring->next;
+            stub_log_dropped += ring->dropped;
+            stub_log_ring_count--;
+            free(ring);
+            continue;
+        }
+        prev = &ring->next;
+    }
+
+    if (dropped != stub_log_reported) {
+        syslog(LOG_WARNING, "%lu log records dropped", dropped - stub_log_reported);
+        stub_log_reported = dropped;
+    }
+}
+
+/**
+ * @brief The background writer
+ */
+static void *stub_log_writer_thread(_In_ void *arg)
+{
+    struct timespec ts;
+
+    pthread_mutex_lock(&stub_log_lock);
+    while (stub_log_running) {
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        ts.tv_nsec += STUB_LOG_DRAIN_MS * 1000000L;
+        if (ts.tv_nsec >= 1000000000L) {
+            ts.tv_sec++;
+            ts.tv_nsec -= 1000000000L;
+        }
+        pthread_cond_timedwait(&stub_log_cond, &stub_log_lock, &ts);
+        stub_log_drain_locked();
+    }
+    pthread_mutex_unlock(&stub_log_lock);
+    return NULL;
+}
+
+void stub_log_init(void)
+{
+    pthread_once(&stub_log_once, stub_log_once_init);
+    pthread_mutex_lock(&stub_log_lock);
+    if (stub_log_running) {
+        pthread_mutex_unlock(&stub_log_lock);
+        return;
+    }
+    stub_log_running = true;
+    if (0 != pthread_create(&stub_log_writer, NULL, stub_log_writer_thread, NULL)) {
+        stub_log_running = false;
+    }
+    pthread_mutex_unlock(&stub_log_lock);
+}
+
+void stub_log_fini(void)
+{
+    bool running;
+
+    pthread_mutex_lock(&stub_log_lock);
+    running = stub_log_running;
+    stub_log_running = false;
+    pthread_cond_signal(&stub_log_cond);
+    pthread_mutex_unlock(&stub_log_lock);
+    if (running) {
+        pthread_join(stub_log_writer, NULL);
+    }
+    stub_log_flush();
+}
+
+void stub_log_set_level(
+    _In_ tai_api_t       tai_api_id,
+    _In_ tai_log_level_t log_level)
+{
+    __atomic_store_n(&stub_log_levels[tai_api_id], log_level, __ATOMIC_RELAXED);
+}
+
+void stub_log_flush(void)
+{
+    pthread_once(&stub_log_once, stub_log_once_init);
+    pthread_mutex_lock(&stub_log_lock);
+    stub_log_drain_locked();
+    pthread_mutex_unlock(&stub_log_lock);
+}
+
+/**
+ * @brief Read the counters, stub_log_lock must be held
+ */
+static void stub_log_get_stats_locked(_Out_ stub_log_stats_t *stats)
+{
+    stub_log_ring_t *ring;
+
+    stats->written = stub_log_written;
+    stats->dropped = stub_log_dropped;
+    stats->rings = stub_log_ring_count;
+    for (ring = stub_log_rings; NULL != ring; ring = ring->next) {
+        stats->dropped += __atomic_load_n(&ring->dropped, __ATOMIC_RELAXED);
+    }
+}
+
+void stub_log_get_stats(_Out_ stub_log_stats_t *stats)
+{
+    pthread_mutex_lock(&stub_log_lock);
+    stub_log_get_stats_locked(stats);
+    pthread_mutex_unlock(&stub_log_lock);
+}
+
+void stub_log_read_history(
+    _In_ stub_log_history_fn  fn,
+    _In_ void                *arg,
+    _Out_ stub_log_stats_t   *stats)
+{
+    const stub_log_record_t *rec;
+    uint64_t idx, first;
+
+    pthread_once(&stub_log_once, stub_log_once_init);
+    pthread_mutex_lock(&stub_log_lock);
+    stub_log_drain_locked();
+    stub_log_get_stats_locked(stats);
+    first = (stub_log_history_count > STUB_LOG_HISTORY_SIZE) ?
+            stub_log_history_count - STUB_LOG_HISTORY_SIZE : 0;
+    for (idx = first; idx < stub_log_history_count; idx++) {
+        rec = &stub_log_history[idx % STUB_LOG_HISTORY_SIZE];
+        if (!fn(rec->timestamp, rec->tid, rec->api, rec->level, rec->msg, arg)) {
+            break;
+        }
+    }
+    pthread_mutex_unlock(&stub_log_lock);
+}
+
+/**
+ *  @brief Log a message to the syslog facility, through the calling thread's
+ *         ring. Callers normally use the TAI_SYSLOG_xxx macros, which skip
+ *         the formatting of records below the API's level.
+ *
+ *  @param [in] tai_api_id The TAI API logging this message
+ *  @param [in] log_level The TAI message priority
+ *  @param [in] format A printf-like format string
+ */
+void tai_syslog(_In_ tai_api_t tai_api_id, _In_ tai_log_level_t log_level,
+                _In_ const char *format, ...)
+{
+    va_list arglist;
+
+    if ((TAI_API_UNSPECIFIED > tai_api_id) || (TAI_API_MAX <= tai_api_id)) {
+        tai_api_id = TAI_API_UNSPECIFIED;
+    }
+    if ((TAI_LOG_LEVEL_DEBUG > log_level) || (TAI_LOG_LEVEL_MAX <= log_level)) {
+        log_level = TAI_LOG_LEVEL_ERROR;
+    }
+    if (!stub_log_enabled(tai_api_id, log_level)) {
+        return;
+    }
+    va_start(arglist, format);
+    stub_log_vwrite(tai_api_id, log_level, format, arglist);
+    va_end(arglist);
+}
@@ -0,0 +1,163 @@
+/**
+ *  @file    stub_log.h
+ *  @brief   Asynchronous logging for the stub TAI adapter
+ *
+ *  Log records are formatted by the calling thread into a per-thread
+ *  lock-free ring buffer, after the level check, and written to syslog by a
+ *  background thread. A full ring drops the record and counts it.
+ *
+ *  @copyright Copyright (C) 2018 Cumulus Networks, Inc. All rights reserved
+ *
+ *  @remark  Licensed under the Apache License, Version 2.0 (the "License"); you
+ *           may not use this file except in compliance with the License. You may
+ *           obtain a copy of the License at
+ *           http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  @remark  THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ *           CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ *           LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ *           FOR A PARTICULAR PURPOSE, MERCHANTABILITY OR NON-INFRINGEMENT.
+ *
+ *  @remark  See the Apache Version 2.0 License for specific language governing
+ *           permissions and limitations under the License.
+ */
+
+#if !defined (__STUB_LOG_H_)
+#define __STUB_LOG_H_
+
+#include <stdarg.h>
+#include <sys/types.h>
+#include "tai.h"
+
+/** @brief The level of each API, indexed by #tai_api_t */
+extern tai_log_level_t stub_log_levels[TAI_API_MAX];
+
+/**
+ * @brief Check whether a record would be logged, before any formatting
+ *
+ * @param [in] tai_api_id The TAI API logging the record
+ * @param [in] log_level The TAI record priority
+ *
+ * @return true if the record has to be logged
+ */
+static inline bool stub_log_enabled(
+    _In_ tai_api_t       tai_api_id,
+    _In_ tai_log_level_t log_level)
+{
+    if ((TAI_API_UNSPECIFIED > tai_api_id) || (TAI_API_MAX <= tai_api_id)) {
+        tai_api_id = TAI_API_UNSPECIFIED;
+    }
+    return log_level >= __atomic_load_n(&stub_log_levels[tai_api_id], __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Start the background writer
+ */
+void stub_log_init(void);
+
+/**
+ * @brief Write the buffered records and stop the background writer
+ */
+void stub_log_fini(void);
+
+/**
+ * @brief Set the level of an API
+ *
+ * @param [in] tai_api_id The TAI API
+ * @param [in] log_level Records below this level are discarded
+ */
+void stub_log_set_level(
+    _In_ tai_api_t       tai_api_id,
+    _In_ tai_log_level_t log_level);
+
+/**
+ * @brief Queue a record, without checking its level
+ *
+ * @param [in] tai_api_id The TAI API logging the record
+ * @param [in] log_level The TAI record priority
+ * @param [in] format A printf-like format string
+ * @param [in] ap The arguments of the format
+ */
+void stub_log_vwrite(
+    _In_ tai_api_t       tai_api_id,
+    _In_ tai_log_level_t log_level,
+    _In_ const char     *format,
+    _In_ va_list         ap);
+
+/**
+ * @brief Write every buffered record to syslog before returning
+ */
+void stub_log_flush(void);
+
+/**
+ * @brief Logging counters
+ */
+typedef struct _stub_log_stats_t {
+    uint64_t written;   /**< Records written to syslog */
+    uint64_t dropped;   /**< Records dropped because a ring was full */
+    uint32_t rings;     /**< Per-thread rings */
+} stub_log_stats_t;
+
+/**
+ * @brief Read the logging counters
+ *
+ * @param [out] stats The counters
+ */
+void stub_log_get_stats(_Out_ stub_log_stats_t *stats);
+
+/**
+ * @brief Called for each record by stub_log_read_history()
+ *
+ * @param [in] timestamp CLOCK_REALTIME of the record, in nanoseconds
+ * @param [in] tid The thread which logged the record
+ * @param [in] tai_api_id The TAI API which logged the record
+ * @param [in] log_level The TAI record priority
+ * @param [in] msg The formatted record
+ * @param [in] arg The argument passed to stub_log_read_history()
+ *
+ * @return false to stop the walk
+ */
+typedef bool (*stub_log_history_fn)(
+    _In_ uint64_t        timestamp,
+    _In_ pid_t           tid,
+    _In_ tai_api_t       tai_api_id,
+    _In_ tai_log_level_t log_level,
+    _In_ const char     *msg,
+    _In_ void           *arg);
+
+/**
+ * @brief Flush, then walk the most recent records, oldest first
+ *
+ * @param [in] fn Called for each record, it must not log
+ * @param [in] arg Passed to fn
+ * @param [out] stats The counters, consistent with the records walked
+ */
+void stub_log_read_history(
+    _In_ stub_log_history_fn  fn,
+    _In_ void                *arg,
+    _Out_ stub_log_stats_t   *stats);
+
+/**
+ * @brief Log a record, the TAI_SYSLOG_xxx macros check its level first
+ *
+ * @param [in] tai_api_id The TAI API logging the record
+ * @param [in] log_level The TAI record priority
+ * @param [in] format A printf-like format string
+ */
+void tai_syslog(_In_ tai_api_t tai_api_id, _In_ tai_log_level_t log_level,
+                _In_ const char *format, ...) __attribute__((format(printf, 3, 4)));
+
+#define TAI_SYSLOG(lvl, ...)                                \
+    do {                                                    \
+        if (stub_log_enabled(__TAI_MODULE__, lvl)) {        \
+            tai_syslog(__TAI_MODULE__, lvl, __VA_ARGS__);   \
+        }                                                   \
+    } while (0)
+#define TAI_SYSLOG_DEBUG(...)    TAI_SYSLOG(TAI_LOG_LEVEL_DEBUG, __VA_ARGS__)
+#define TAI_SYSLOG_INFO(...)     TAI_SYSLOG(TAI_LOG_LEVEL_INFO, __VA_ARGS__)
+#define TAI_SYSLOG_NOTICE(...)   TAI_SYSLOG(TAI_LOG_LEVEL_NOTICE, __VA_ARGS__)
+#define TAI_SYSLOG_WARN(...)     TAI_SYSLOG(TAI_LOG_LEVEL_WARN, __VA_ARGS__)
+#define TAI_SYSLOG_ERROR(...)    TAI_SYSLOG(TAI_LOG_LEVEL_ERROR, __VA_ARGS__)
+#define TAI_SYSLOG_CRITICAL(...) TAI_SYSLOG(TAI_LOG_LEVEL_CRITICAL, __VA_ARGS__)
+
+#endif /** __STUB_LOG_H_ */
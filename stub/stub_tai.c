@@ -22,15 +22,34 @@
  */
 
 
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <math.h>
+#include <pthread.h>
 #include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <syslog.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
 #include "tai.h"
+#include "mai.h"
+#include "taimetadata.h"
+#include "stub_dump.h"
+#include "stub_log.h"
 
 
 static tai_service_method_table_t adapter_host_fns;
 static bool                       initialized = false;
 
+/** @brief Set in every id returned, see #STUB_OID */
+static uint64_t                   stub_id_prefix = 0;
+
 
 /*------------------------------------------------------------------------------
 
@@ -41,13 +60,6 @@ static bool                       initialized = false;
 #undef  __TAI_MODULE__
 #define __TAI_MODULE__ TAI_API_UNSPECIFIED
 
-/** @brief The Stub TAI adapter uses the following format for object ids */
-typedef struct _stub_object_id_t {
-    uint8_t type;
-    uint8_t reserved;
-    uint32_t value;
-} stub_object_id_t;
-
 /**
  * @brief Find an attribute in a list of attributes
  * 
@@ -77,6 +89,9 @@ const tai_attribute_value_t * find_attribute_in_list(
  *
  * If the status code in 'err' is one of the codes for a list of attributes, the
  * index value is added to that code. Otherwise the 'err' code is returned.
+ * The codes are compared with the first code of each kind, the
+ * TAI_STATUS_IS_xxx() masks also match the small codes such as
+ * TAI_STATUS_BUFFER_OVERFLOW.
  *
  * @param err A TAI_STATUS_* code
  * @param idx An index into a list of attributes
@@ -85,634 +100,8294 @@ const tai_attribute_value_t * find_attribute_in_list(
  */
 tai_status_t convert_tai_error_to_list( _In_ tai_status_t err, _In_ uint32_t idx)
 {
-    if (TAI_STATUS_IS_INVALID_ATTRIBUTE(err)    || 
-        TAI_STATUS_IS_INVALID_ATTR_VALUE(err)   ||
-        TAI_STATUS_IS_ATTR_NOT_IMPLEMENTED(err) ||
-        TAI_STATUS_IS_UNKNOWN_ATTRIBUTE(err)    ||
-        TAI_STATUS_IS_ATTR_NOT_SUPPORTED(err)) {
+    if ((TAI_STATUS_INVALID_ATTRIBUTE_0 == err)    ||
+        (TAI_STATUS_INVALID_ATTR_VALUE_0 == err)   ||
+        (TAI_STATUS_ATTR_NOT_IMPLEMENTED_0 == err) ||
+        (TAI_STATUS_UNKNOWN_ATTRIBUTE_0 == err)    ||
+        (TAI_STATUS_ATTR_NOT_SUPPORTED_0 == err)) {
         return err + idx;
     }
     return err;
 }
 
-#define TAI_SYSLOG(lvl, ...)     tai_syslog(__TAI_MODULE__, lvl, __VA_ARGS__)
-#define TAI_SYSLOG_DEBUG(...)    TAI_SYSLOG(TAI_LOG_LEVEL_DEBUG, __VA_ARGS__)
-#define TAI_SYSLOG_INFO(...)     TAI_SYSLOG(TAI_LOG_LEVEL_INFO, __VA_ARGS__)
-#define TAI_SYSLOG_NOTICE(...)   TAI_SYSLOG(TAI_LOG_LEVEL_NOTICE, __VA_ARGS__)
-#define TAI_SYSLOG_WARN(...)     TAI_SYSLOG(TAI_LOG_LEVEL_WARN, __VA_ARGS__)
-#define TAI_SYSLOG_ERROR(...)    TAI_SYSLOG(TAI_LOG_LEVEL_ERROR, __VA_ARGS__)
-#define TAI_SYSLOG_CRITICAL(...) TAI_SYSLOG(TAI_LOG_LEVEL_CRITICAL, __VA_ARGS__)
-
-/**
- * @brief Given a TAI logging level, convert to a syslog level.
- */
-static int tai_to_syslog_level[TAI_LOG_LEVEL_MAX] = {
-    [TAI_LOG_LEVEL_DEBUG]    = LOG_DEBUG,
-    [TAI_LOG_LEVEL_INFO]     = LOG_INFO,
-    [TAI_LOG_LEVEL_NOTICE]   = LOG_NOTICE,
-    [TAI_LOG_LEVEL_WARN]     = LOG_WARNING,
-    [TAI_LOG_LEVEL_ERROR]    = LOG_ERR,
-    [TAI_LOG_LEVEL_CRITICAL] = LOG_CRIT
-};
-
-/**
- * @brief Given a TAI module, retrieve the syslog level for that module. This is 
- *        set by calling the #tai_log_set function. The default is WARNING.
- */
-static int api_log_level[TAI_API_MAX] = {
-    [0 ... TAI_API_MAX-1] = LOG_WARNING
-};
-
 /**
- *  @brief Log a message to the syslog facility. The message may be filtered 
- *         based on the TAI API's previously set logging level.
- * 
- *  @param [in] tai_api_id The TAI API logging this message
- *  @param [in] log_level The TAI message priority
- *  @param [in] format A printf-like format string
+ * @brief Split an indexed status code, the reverse of
+ *        convert_tai_error_to_list()
+ *
+ * The indexed codes of each kind span 0x10000 values and the last ones
+ * overlap the small codes, e.g. TAI_STATUS_FAILURE is
+ * TAI_STATUS_INVALID_ATTRIBUTE_0 plus 0xFFFF, so a status is only taken as
+ * indexed if the index falls in the list.
+ *
+ * @param [in] status A TAI_STATUS_* code
+ * @param [in] attr_count The number of attributes of the list
+ * @param [out] err The code of the first attribute, TAI_STATUS_xxx_0
+ * @param [out] idx The index of the attribute in the list
+ *
+ * @return true if the status is an indexed status code
  */
-void tai_syslog(_In_ tai_api_t tai_api_id, _In_ tai_log_level_t log_level, 
-                _In_ const char *format, ...)
+static bool stub_status_list_index(
+    _In_ tai_status_t  status,
+    _In_ uint32_t      attr_count,
+    _Out_ tai_status_t *err,
+    _Out_ uint32_t     *idx)
 {
-    va_list arglist;
+    static const tai_status_t firsts[] = {
+        TAI_STATUS_INVALID_ATTRIBUTE_0, TAI_STATUS_INVALID_ATTR_VALUE_0,
+        TAI_STATUS_ATTR_NOT_IMPLEMENTED_0, TAI_STATUS_UNKNOWN_ATTRIBUTE_0,
+        TAI_STATUS_ATTR_NOT_SUPPORTED_0,
+    };
+    int64_t offset;
+    size_t i;
 
-    if ((TAI_API_UNSPECIFIED > tai_api_id) || (TAI_API_MAX <= tai_api_id)) {
-        tai_api_id = TAI_API_UNSPECIFIED;
-    }
-    if ((TAI_LOG_LEVEL_DEBUG > log_level) || (TAI_LOG_LEVEL_MAX <= log_level)) {
-        log_level = TAI_LOG_LEVEL_ERROR;
+    for (i = 0; i < sizeof(firsts)/sizeof(firsts[0]); i++) {
+        offset = (int64_t)status - firsts[i];
+        if ((offset >= 0) && (offset < attr_count) && (offset <= 0xFFFF)) {
+            *err = firsts[i];
+            *idx = (uint32_t)offset;
+            return true;
+        }
     }
-    setlogmask(LOG_UPTO(api_log_level[tai_api_id]));
-    va_start(arglist, format);
-    vsyslog(tai_to_syslog_level[log_level], format, arglist);
-    va_end(arglist);
-
-    return;
+    return false;
 }
 
+/** @brief Object creation function used by the bulk helpers */
+typedef tai_status_t (*stub_create_object_fn)(
+    _Out_ tai_object_id_t *object_id,
+    _In_ tai_object_id_t module_id,
+    _In_ uint32_t attr_count,
+    _In_ const tai_attribute_t *attr_list);
 
-/*------------------------------------------------------------------------------
+/** @brief Object removal function used by the bulk helpers */
+typedef tai_status_t (*stub_remove_object_fn)(
+    _In_ tai_object_id_t object_id);
 
-                        Host Interface Object Functions
+/** @brief Attribute list set function used by the bulk helpers */
+typedef tai_status_t (*stub_set_attributes_fn)(
+    _In_ tai_object_id_t object_id,
+    _In_ uint32_t attr_count,
+    _In_ const tai_attribute_t *attr_list);
 
-------------------------------------------------------------------------------*/
+/** @brief Attribute list get function used by the bulk helpers */
+typedef tai_status_t (*stub_get_attributes_fn)(
+    _In_ tai_object_id_t object_id,
+    _In_ uint32_t attr_count,
+    _Inout_ tai_attribute_t *attr_list);
 
-#undef  __TAI_MODULE__
-#define __TAI_MODULE__ TAI_API_HOSTIF
+static tai_status_t stub_work_bulk(
+    _In_ stub_set_attributes_fn   set_fn,
+    _In_ stub_get_attributes_fn   get_fn,
+    _In_ uint32_t                 object_count,
+    _In_ const tai_object_id_t   *object_id,
+    _In_ const uint32_t          *attr_count,
+    _In_ const tai_attribute_t  **in_list,
+    _In_ tai_attribute_t        **inout_list,
+    _Out_ tai_status_t           *object_statuses);
 
 /**
- * @brief Retrieve the value of an attribute
+ * @brief Validate the common parameters of a bulk operation
  *
- * @param [in] host_interface_id The host interface ID handle
- * @param [in,out] attr A pointer to the attribute to be retrieved
+ * @param [in] object_count The number of objects in the bulk operation
+ * @param [in] mode The bulk operation error mode
+ * @param [in] object_statuses The per-object status array
  *
  * @return TAI_STATUS_SUCCESS on success, failure status code on error
  */
-static tai_status_t stub_get_host_interface_attribute(
-    _In_ tai_object_id_t     host_interface_id,
-    _Inout_ tai_attribute_t *attr)
+static tai_status_t stub_bulk_check_params(
+    _In_ uint32_t                 object_count,
+    _In_ tai_bulk_op_error_mode_t mode,
+    _In_ const tai_status_t      *object_statuses)
 {
-    TAI_SYSLOG_DEBUG("Retrieving host interface attribute: %d", attr->id);
-    switch (attr->id) {
-        case TAI_HOST_INTERFACE_ATTR_INDEX:
-        case TAI_HOST_INTERFACE_ATTR_LANE_FAULTS:
-        case TAI_HOST_INTERFACE_ATTR_TX_ALIGN_STATUS:
-        case TAI_HOST_INTERFACE_ATTR_FEC_TYPE:
-            return TAI_STATUS_SUCCESS;
+    if ((0 == object_count) || (NULL == object_statuses)) {
+        return TAI_STATUS_INVALID_PARAMETER;
+    }
+    if ((TAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR != mode) &&
+        (TAI_BULK_OP_ERROR_MODE_IGNORE_ERROR != mode)) {
+        return TAI_STATUS_INVALID_PARAMETER;
     }
-    return TAI_STATUS_ATTR_NOT_SUPPORTED_0;
+    return TAI_STATUS_SUCCESS;
 }
 
 /**
- * @brief Retrieve a list of attribute values
+ * @brief Record the status of one object of a bulk operation
  *
- * @param [in] host_interface_id The host interface ID handle
- * @param [in] attr_count A count of the number of elements in the attr_list
- * @param [in,out] attr_list A list of attributes to be retrieved
+ * Stores 'status' at index 'idx' of 'object_statuses'. If the operation failed
+ * and the mode is STOP_ON_ERROR, the remaining entries are marked as not
+ * executed.
  *
- * @return TAI_STATUS_SUCCESS on success, failure status code on error
+ * @return true if the bulk operation should continue with the next object
  */
-static tai_status_t stub_get_host_interface_attributes(
-    _In_ tai_object_id_t     host_interface_id,
-    _In_ uint32_t            attr_count,
-    _Inout_ tai_attribute_t *attr_list)
+static bool stub_bulk_record_status(
+    _In_ tai_status_t             status,
+    _In_ uint32_t                 idx,
+    _In_ uint32_t                 object_count,
+    _In_ tai_bulk_op_error_mode_t mode,
+    _Out_ tai_status_t           *object_statuses)
+{
+    object_statuses[idx] = status;
+    if ((TAI_STATUS_SUCCESS != status) &&
+        (TAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR == mode)) {
+        while (++idx < object_count) {
+            object_statuses[idx] = TAI_STATUS_NOT_EXECUTED;
+        }
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Create a list of host or network interfaces with a single call
+ *
+ * @param [in] create_fn The single object creation function
+ * @param [in] module_id The module on which the objects are created
+ * @param [in] object_count The number of objects to create
+ * @param [in] attr_count The number of attributes for each object
+ * @param [in] attr_list The attribute list for each object
+ * @param [in] mode The bulk operation error mode
+ * @param [out] object_id The created object ids
+ * @param [out] object_statuses The status of each object
+ *
+ * @return TAI_STATUS_SUCCESS if every object was created, TAI_STATUS_FAILURE
+ *         if any of them failed, or another failure code on invalid parameters
+ */
+static tai_status_t stub_bulk_create(
+    _In_ stub_create_object_fn    create_fn,
+    _In_ tai_object_id_t          module_id,
+    _In_ uint32_t                 object_count,
+    _In_ const uint32_t          *attr_count,
+    _In_ const tai_attribute_t  **attr_list,
+    _In_ tai_bulk_op_error_mode_t mode,
+    _Out_ tai_object_id_t        *object_id,
+    _Out_ tai_status_t           *object_statuses)
 {
+    tai_status_t ret = TAI_STATUS_SUCCESS;
+    tai_status_t status;
     uint32_t idx;
-    tai_status_t ret;
 
-    for (idx = 0; idx < attr_count; idx++) {
-        ret = stub_get_host_interface_attribute(host_interface_id, attr_list++);
-        if (ret) {
-            return convert_tai_error_to_list(ret, idx);
+    status = stub_bulk_check_params(object_count, mode, object_statuses);
+    if (TAI_STATUS_SUCCESS != status) {
+        return status;
+    }
+    if ((NULL == attr_count) || (NULL == attr_list) || (NULL == object_id)) {
+        return TAI_STATUS_INVALID_PARAMETER;
+    }
+
+    for (idx = 0; idx < object_count; idx++) {
+        object_id[idx] = TAI_NULL_OBJECT_ID;
+        status = create_fn(&object_id[idx], module_id, attr_count[idx],
+                           attr_list[idx]);
+        if (TAI_STATUS_SUCCESS != status) {
+            ret = TAI_STATUS_FAILURE;
+        }
+        if (!stub_bulk_record_status(status, idx, object_count, mode,
+                                     object_statuses)) {
+            break;
         }
     }
-    return TAI_STATUS_SUCCESS; 
+    return ret;
 }
 
 /**
- * @brief Set the value of an attribute
+ * @brief Remove a list of objects with a single call
  *
- * @param [in] host_interface_id The host interface ID handle
- * @param [in] attr A pointer to the attribute to be set
+ * @param [in] remove_fn The single object removal function
+ * @param [in] object_count The number of objects to remove
+ * @param [in] object_id The object ids
+ * @param [in] mode The bulk operation error mode
+ * @param [out] object_statuses The status of each object
  *
- * @return TAI_STATUS_SUCCESS on success, failure status code on error
+ * @return TAI_STATUS_SUCCESS if every object was removed, TAI_STATUS_FAILURE
+ *         if any of them failed, or another failure code on invalid parameters
  */
-static tai_status_t stub_set_host_interface_attribute(
-   _In_ tai_object_id_t        host_interface_id,
-   _In_ const tai_attribute_t *attr)
+static tai_status_t stub_bulk_remove(
+    _In_ stub_remove_object_fn    remove_fn,
+    _In_ uint32_t                 object_count,
+    _In_ const tai_object_id_t   *object_id,
+    _In_ tai_bulk_op_error_mode_t mode,
+    _Out_ tai_status_t           *object_statuses)
 {
-    TAI_SYSLOG_DEBUG("Setting host interface attribute: %d", attr->id);
-    switch (attr->id) {
-        case TAI_HOST_INTERFACE_ATTR_INDEX:
-        case TAI_HOST_INTERFACE_ATTR_FEC_TYPE:
-            return TAI_STATUS_SUCCESS;
-        case TAI_HOST_INTERFACE_ATTR_LANE_FAULTS:
-        case TAI_HOST_INTERFACE_ATTR_TX_ALIGN_STATUS:
-            return TAI_STATUS_INVALID_ATTRIBUTE_0;
+    tai_status_t ret = TAI_STATUS_SUCCESS;
+    tai_status_t status;
+    uint32_t idx;
+
+    status = stub_bulk_check_params(object_count, mode, object_statuses);
+    if (TAI_STATUS_SUCCESS != status) {
+        return status;
+    }
+    if (NULL == object_id) {
+        return TAI_STATUS_INVALID_PARAMETER;
     }
-    return TAI_STATUS_ATTR_NOT_SUPPORTED_0;
+
+    for (idx = 0; idx < object_count; idx++) {
+        status = remove_fn(object_id[idx]);
+        if (TAI_STATUS_SUCCESS != status) {
+            ret = TAI_STATUS_FAILURE;
+        }
+        if (!stub_bulk_record_status(status, idx, object_count, mode,
+                                     object_statuses)) {
+            break;
+        }
+    }
+    return ret;
 }
 
 /**
- * @brief Set the values from a list of attributes
+ * @brief Set attribute lists on a list of objects with a single call. In
+ *        TAI_BULK_OP_ERROR_MODE_IGNORE_ERROR mode the objects of different
+ *        modules are set in parallel, see stub_work_bulk().
  *
- * @param [in] host_interface_id The host interface ID handle
- * @param [in] attr_count A count of the number of elements in the attr_list
- * @param [in] attr_list A list of attributes to be set
+ * @param [in] set_fn The single object attribute list set function
+ * @param [in] object_count The number of objects
+ * @param [in] object_id The object ids
+ * @param [in] attr_count The number of attributes for each object
+ * @param [in] attr_list The attribute list for each object
+ * @param [in] mode The bulk operation error mode
+ * @param [out] object_statuses The status of each object
  *
- * @return TAI_STATUS_SUCCESS on success, failure status code on error
+ * @return TAI_STATUS_SUCCESS if every object was updated, TAI_STATUS_FAILURE
+ *         if any of them failed, or another failure code on invalid parameters
  */
-static tai_status_t stub_set_host_interface_attributes(
-   _In_ tai_object_id_t        host_interface_id,
-   _In_ uint32_t               attr_count,
-   _In_ const tai_attribute_t *attr_list)
+static tai_status_t stub_bulk_set(
+    _In_ stub_set_attributes_fn   set_fn,
+    _In_ uint32_t                 object_count,
+    _In_ const tai_object_id_t   *object_id,
+    _In_ const uint32_t          *attr_count,
+    _In_ const tai_attribute_t  **attr_list,
+    _In_ tai_bulk_op_error_mode_t mode,
+    _Out_ tai_status_t           *object_statuses)
 {
+    tai_status_t ret = TAI_STATUS_SUCCESS;
+    tai_status_t status;
     uint32_t idx;
-    tai_status_t ret;
 
-    for (idx = 0; idx < attr_count; idx++) {
-        ret = stub_set_host_interface_attribute(host_interface_id, attr_list++);
-        if (ret) {
-            return convert_tai_error_to_list(ret, idx);
+    status = stub_bulk_check_params(object_count, mode, object_statuses);
+    if (TAI_STATUS_SUCCESS != status) {
+        return status;
+    }
+    if ((NULL == object_id) || (NULL == attr_count) || (NULL == attr_list)) {
+        return TAI_STATUS_INVALID_PARAMETER;
+    }
+    if (TAI_BULK_OP_ERROR_MODE_IGNORE_ERROR == mode) {
+        return stub_work_bulk(set_fn, NULL, object_count, object_id, attr_count,
+                              attr_list, NULL, object_statuses);
+    }
+
+    for (idx = 0; idx < object_count; idx++) {
+        status = set_fn(object_id[idx], attr_count[idx], attr_list[idx]);
+        if (TAI_STATUS_SUCCESS != status) {
+            ret = TAI_STATUS_FAILURE;
+        }
+        if (!stub_bulk_record_status(status, idx, object_count, mode,
+                                     object_statuses)) {
+            break;
         }
     }
-    return TAI_STATUS_SUCCESS; 
+    return ret;
 }
 
 /**
- * @brief Host interface initialization. After the call the capability 
- *        attributes should be ready for retrieval via
- *        tai_get_host_interface_attribute().
+ * @brief Retrieve attribute lists from a list of objects with a single call.
+ *        In TAI_BULK_OP_ERROR_MODE_IGNORE_ERROR mode the objects of different
+ *        modules are read in parallel, see stub_work_bulk().
  *
- * @param [out] host_interface_id Handle which identifies the host interface
- * @param [in] module_id Handle which identifies the module on which the host 
- *        interface exists
- * @param [in] attr_count A count of the number of elements in the attr_list
- * @param [in] attr_list A list of attributes to set during initialization
+ * @param [in] get_fn The single object attribute list get function
+ * @param [in] object_count The number of objects
+ * @param [in] object_id The object ids
+ * @param [in] attr_count The number of attributes for each object
+ * @param [in,out] attr_list The attribute list for each object
+ * @param [in] mode The bulk operation error mode
+ * @param [out] object_statuses The status of each object
  *
- * @return TAI_STATUS_SUCCESS on success, failure status code on error
+ * @return TAI_STATUS_SUCCESS if every object was retrieved,
+ *         TAI_STATUS_FAILURE if any of them failed, or another failure code on
+ *         invalid parameters
  */
-static tai_status_t stub_create_host_interface(
-    _Out_ tai_object_id_t *host_interface_id,
-    _In_ tai_object_id_t module_id,
-    _In_ uint32_t attr_count,
-    _In_ const tai_attribute_t *attr_list)
+static tai_status_t stub_bulk_get(
+    _In_ stub_get_attributes_fn   get_fn,
+    _In_ uint32_t                 object_count,
+    _In_ const tai_object_id_t   *object_id,
+    _In_ const uint32_t          *attr_count,
+    _Inout_ tai_attribute_t     **attr_list,
+    _In_ tai_bulk_op_error_mode_t mode,
+    _Out_ tai_status_t           *object_statuses)
 {
-    tai_status_t ret;
-    const tai_attribute_value_t * hostif_addr;
+    tai_status_t ret = TAI_STATUS_SUCCESS;
+    tai_status_t status;
+    uint32_t idx;
 
-    hostif_addr = find_attribute_in_list(TAI_HOST_INTERFACE_ATTR_INDEX, attr_count, attr_list);
-    if (NULL == hostif_addr) {
-        TAI_SYSLOG_ERROR("The required TAI_HOST_INTERFACE_ATTR_INDEX attribute was not provided");
-        return TAI_STATUS_MANDATORY_ATTRIBUTE_MISSING;
+    status = stub_bulk_check_params(object_count, mode, object_statuses);
+    if (TAI_STATUS_SUCCESS != status) {
+        return status;
+    }
+    if ((NULL == object_id) || (NULL == attr_count) || (NULL == attr_list)) {
+        return TAI_STATUS_INVALID_PARAMETER;
+    }
+    if (TAI_BULK_OP_ERROR_MODE_IGNORE_ERROR == mode) {
+        return stub_work_bulk(NULL, get_fn, object_count, object_id, attr_count,
+                              NULL, attr_list, object_statuses);
     }
 
-    ret = stub_set_host_interface_attributes(*host_interface_id, attr_count, attr_list);
-    if (TAI_STATUS_SUCCESS != ret) {
-        TAI_SYSLOG_ERROR("Error setting host interface attributes");
-        return ret;
+    for (idx = 0; idx < object_count; idx++) {
+        status = get_fn(object_id[idx], attr_count[idx], attr_list[idx]);
+        if (TAI_STATUS_SUCCESS != status) {
+            ret = TAI_STATUS_FAILURE;
+        }
+        if (!stub_bulk_record_status(status, idx, object_count, mode,
+                                     object_statuses)) {
+            break;
+        }
     }
+    return ret;
+}
 
-    return TAI_STATUS_SUCCESS;
+/**
+ * @brief Check the attributes passed to a create or a set function against
+ *        their metadata, see tai_metadata_check_attr_list()
+ *
+ * @param [in] object_type The type of the object
+ * @param [in] create true for the attributes of a create, false for a set
+ * @param [in] attr_count The number of attributes in the list
+ * @param [in] attr_list A list of attributes
+ *
+ * @return TAI_STATUS_SUCCESS if the attributes can be written, failure status
+ *         code otherwise
+ */
+static tai_status_t stub_check_attributes(
+    _In_ tai_object_type_t      object_type,
+    _In_ bool                   create,
+    _In_ uint32_t               attr_count,
+    _In_ const tai_attribute_t *attr_list)
+{
+    const tai_attr_metadata_t *meta;
+    tai_status_t ret, err;
+    uint32_t idx;
+
+    ret = tai_metadata_check_attr_list(object_type, create, attr_count, attr_list);
+    if (TAI_STATUS_SUCCESS == ret) {
+        return ret;
+    }
+    if (TAI_STATUS_MANDATORY_ATTRIBUTE_MISSING == ret) {
+        TAI_SYSLOG_ERROR("A mandatory attribute was not provided");
+        return ret;
+    }
+    if (!stub_status_list_index(ret, attr_count, &err, &idx) ||
+        (NULL == (meta = tai_metadata_get_attr_metadata(object_type, attr_list[idx].id)))) {
+        return ret;
+    }
+    if (TAI_STATUS_INVALID_ATTRIBUTE_0 == err) {
+        TAI_SYSLOG_ERROR("Attribute %s can not be %s", meta->attridname,
+                         create ? "given on create" : "set");
+    } else if (TAI_STATUS_INVALID_ATTR_VALUE_0 == err) {
+        TAI_SYSLOG_ERROR("Invalid value %d of %s", attr_list[idx].value.s32, meta->attridname);
+    }
+    return ret;
 }
 
+
 /**
- * @brief Release all resources associated with previously created host 
- *        interface
+ * @brief Read a TAI_STUB_xxx variable of the environment. A module adapter
+ *        built from the stub (see inc/mai.h) reads STUB_ENV_PREFIX "xxx"
+ *        first, so that each module adapter of a platform can be configured
+ *        on its own.
  *
- * @param [in] host_interface_id The host interface ID handle being removed
+ * @param [in] name The name of the variable, starting with TAI_STUB_
  *
- * @return TAI_STATUS_SUCCESS on success, failure status code on error
+ * @return The value of the variable, NULL if it is not set
  */
-static tai_status_t stub_remove_host_interface(_In_ tai_object_id_t host_interface_id)
+static const char *stub_getenv(_In_ const char *name)
 {
-    return TAI_STATUS_SUCCESS;
+#ifdef STUB_ENV_PREFIX
+    char own[128];
+    const char *str;
+
+    snprintf(own, sizeof(own), "%s%s", STUB_ENV_PREFIX, name + strlen("TAI_STUB_"));
+    str = getenv(own);
+    if ((NULL != str) && ('\0' != *str)) {
+        return str;
+    }
+#endif
+    return getenv(name);
 }
 
 /**
- * @brief The host interface functions. This structure is retrieved via the 
- *        #tai_api_query function.
+ * @brief Read an unsigned integer from the environment
+ *
+ * @param [in] name The name of the environment variable
+ * @param [in] def The value used when the variable is not set or is invalid
+ *
+ * @return The value of the variable
  */
-tai_host_interface_api_t stub_host_interface_api = {
-    .create_host_interface         = stub_create_host_interface,
-    .remove_host_interface         = stub_remove_host_interface,
-    .set_host_interface_attribute  = stub_set_host_interface_attribute,
-    .set_host_interface_attributes = stub_set_host_interface_attributes,
-    .get_host_interface_attribute  = stub_get_host_interface_attribute,
-    .get_host_interface_attributes = stub_get_host_interface_attributes
-};
+static uint32_t stub_env_u32(
+    _In_ const char *name,
+    _In_ uint32_t    def)
+{
+    const char *str = stub_getenv(name);
+    char *end;
+    unsigned long value;
+
+    if ((NULL == str) || ('\0' == *str)) {
+        return def;
+    }
+    errno = 0;
+    value = strtoul(str, &end, 0);
+    if ((0 != errno) || ('\0' != *end) || (value > UINT32_MAX)) {
+        TAI_SYSLOG_WARN("Ignoring invalid %s value %s", name, str);
+        return def;
+    }
+    return value;
+}
 
 
 /*------------------------------------------------------------------------------
 
-                      Network Interface Object Functions
+                               Object Registry
 
 ------------------------------------------------------------------------------*/
 
-#undef  __TAI_MODULE__
-#define __TAI_MODULE__ TAI_API_NETWORKIF
+/**
+ * @brief The Stub TAI adapter uses the following format for object ids
+ *
+ *  63    56 55    48 47          32 31          16 15           0
+ * +--------+--------+--------------+--------------+--------------+
+ * |  type  | prefix |  generation  | module index |   if index   |
+ * +--------+--------+--------------+--------------+--------------+
+ *
+ * The module index is the registry slot of the module and the if index the
+ * TAI_xxx_INTERFACE_ATTR_INDEX of an interface (0 for a module). Every object
+ * carries the generation of its module, which changes each time a module is
+ * created in the slot, so the ids of a removed module and of its interfaces
+ * are rejected after the module is reinserted. The prefix is 0, unless the
+ * stub is a module adapter, see #MAI_ID_PREFIX_MASK.
+ */
+#define STUB_OID(type, module_index, if_index, generation) \
+    (((uint64_t)(type) << 56) | stub_id_prefix | ((uint64_t)(generation) << 32) | \
+     ((uint64_t)(module_index) << 16) | (uint64_t)(if_index))
+
+#define STUB_OID_TYPE(oid)          ((tai_object_type_t)(((oid) >> 56) & 0xff))
+#define STUB_OID_GENERATION(oid)    ((uint16_t)((oid) >> 32))
+#define STUB_OID_MODULE_INDEX(oid)  ((uint16_t)((oid) >> 16))
+#define STUB_OID_IF_INDEX(oid)      ((uint16_t)(oid))
+#define STUB_OID_PREFIX(oid)        ((oid) & 0x00ff000000000000ULL)
+
+/** @brief The id of the module of an object */
+#define STUB_OID_MODULE(oid) \
+    STUB_OID(TAI_OBJECT_TYPE_MODULE, STUB_OID_MODULE_INDEX(oid), 0, STUB_OID_GENERATION(oid))
+
+/** @brief The maximum number of interfaces of each type of a module */
+#define STUB_MAX_INTERFACES 32
+
+/** @brief The default number of network interfaces of a simulated module */
+#ifndef STUB_NUM_NETWORK_INTERFACES
+#define STUB_NUM_NETWORK_INTERFACES 1
+#endif
+
+/** @brief The default number of host interfaces of a simulated module */
+#ifndef STUB_NUM_HOST_INTERFACES
+#define STUB_NUM_HOST_INTERFACES    2
+#endif
 
 /**
- * @brief Retrieve the value of an attribute
+ * @brief The number of interfaces of a simulated module, set from the
+ *        TAI_STUB_NUM_HOST_INTERFACES and TAI_STUB_NUM_NETWORK_INTERFACES
+ *        environment variables, see stub_store_init()
+ */
+static uint32_t stub_num_hostifs = STUB_NUM_HOST_INTERFACES;
+static uint32_t stub_num_netifs  = STUB_NUM_NETWORK_INTERFACES;
+
+/** @brief A host interface not carried by any network interface */
+#define STUB_TRIBUTARY_NONE 0xff
+
+/** @brief A module slot of the object registry */
+typedef struct _stub_module_t {
+    uint16_t generation;        /**< Generation of the module, 0 if the slot is free */
+    uint16_t last_generation;   /**< Last generation used in the slot */
+    uint32_t hostif_mask;       /**< Created host interfaces */
+    uint32_t netif_mask;        /**< Created network interfaces */
+    bool     restored;          /**< Restored by a warm start, not created yet */
+    uint32_t hostif_restored;   /**< Restored host interfaces not created yet */
+    uint32_t netif_restored;    /**< Restored network interfaces not created yet */
+    char     location[TAI_MAX_HARDWARE_ID_LEN];
+    tai_module_notification_t notifications;    /**< Of the adapter host */
+    uint8_t  tributary[STUB_MAX_INTERFACES];    /**< Network interface carrying
+                                                     each host interface */
+} stub_module_t;
+
+/**
+ * @brief The object registry
  *
- * @param [in] network_interface_id The network interface ID handle
- * @param [in,out] attr A pointer to the attribute to be retrieved
+ * Creation and removal are serialized by stub_registry_lock. Object ids are
+ * validated without the lock: the generation and the interface masks are
+ * read atomically.
+ */
+static stub_module_t   stub_modules[TAI_MAX_MODULES];
+static pthread_mutex_t stub_registry_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static void stub_store_reset(_In_ tai_object_id_t object_id);
+static tai_status_t stub_regmap_attach(
+    _In_ uint16_t    module_index,
+    _In_ const char *location,
+    _In_ uint32_t    length,
+    _In_ bool        power_up);
+
+/**
+ * @brief Carry host interface i by network interface (i % stub_num_netifs),
+ *        the mapping of a new module
+ */
+static void stub_registry_default_tributary(_Inout_ stub_module_t *mod)
+{
+    uint32_t idx;
+
+    for (idx = 0; idx < STUB_MAX_INTERFACES; idx++) {
+        __atomic_store_n(&mod->tributary[idx], idx % stub_num_netifs, __ATOMIC_RELAXED);
+    }
+}
+
+/**
+ * @brief Check that an object id refers to a live object
  *
- * @return TAI_STATUS_SUCCESS on success, failure status code on error
+ * @param [in] object_id The object id
+ * @param [in] object_type The expected object type
+ *
+ * @return true if the object exists
  */
-static tai_status_t stub_get_network_interface_attribute(
-    _In_ tai_object_id_t     network_interface_id,
-    _Inout_ tai_attribute_t *attr)
+static bool stub_object_valid(
+    _In_ tai_object_id_t   object_id,
+    _In_ tai_object_type_t object_type)
 {
-    TAI_SYSLOG_DEBUG("Retrieving network interface attribute: %d", attr->id);
-    switch (attr->id) {
-        case TAI_NETWORK_INTERFACE_ATTR_INDEX:
-        case TAI_NETWORK_INTERFACE_ATTR_TX_ALIGN_STATUS:
-        case TAI_NETWORK_INTERFACE_ATTR_RX_ALIGN_STATUS:
-        case TAI_NETWORK_INTERFACE_ATTR_TX_ENABLE:
-        case TAI_NETWORK_INTERFACE_ATTR_TX_GRID_SPACING:
-        case TAI_NETWORK_INTERFACE_ATTR_TX_CHANNEL:
-        case TAI_NETWORK_INTERFACE_ATTR_OUTPUT_POWER:
-        case TAI_NETWORK_INTERFACE_ATTR_CURRENT_OUTPUT_POWER:
-        case TAI_NETWORK_INTERFACE_ATTR_TX_LASER_FREQ:
-        case TAI_NETWORK_INTERFACE_ATTR_TX_FINE_TUNE_LASER_FREQ:
-        case TAI_NETWORK_INTERFACE_ATTR_MODULATION_FORMAT:
-        case TAI_NETWORK_INTERFACE_ATTR_CURRENT_BER:
-        case TAI_NETWORK_INTERFACE_ATTR_CURRENT_BER_PERIOD:
-        case TAI_NETWORK_INTERFACE_ATTR_DIFFERENTIAL_ENCODING:
-        case TAI_NETWORK_INTERFACE_ATTR_OPER_STATUS:
-        case TAI_NETWORK_INTERFACE_ATTR_MIN_LASER_FREQ:
-        case TAI_NETWORK_INTERFACE_ATTR_MAX_LASER_FREQ:
-        case TAI_NETWORK_INTERFACE_ATTR_LASER_GRID_SUPPORT:
-            return TAI_STATUS_SUCCESS;
+    uint16_t module_index = STUB_OID_MODULE_INDEX(object_id);
+    uint16_t generation = STUB_OID_GENERATION(object_id);
+    uint16_t if_index = STUB_OID_IF_INDEX(object_id);
+    stub_module_t *mod;
+
+    if ((STUB_OID_TYPE(object_id) != object_type) ||
+        (STUB_OID_PREFIX(object_id) != stub_id_prefix) ||
+        (module_index >= TAI_MAX_MODULES) || (0 == generation)) {
+        return false;
+    }
+    mod = &stub_modules[module_index];
+    if (__atomic_load_n(&mod->generation, __ATOMIC_ACQUIRE) != generation) {
+        return false;
+    }
+    switch (object_type) {
+        case TAI_OBJECT_TYPE_MODULE:
+            return 0 == if_index;
+        case TAI_OBJECT_TYPE_HOSTIF:
+            return (if_index < STUB_MAX_INTERFACES) &&
+                   (__atomic_load_n(&mod->hostif_mask, __ATOMIC_ACQUIRE) & (1U << if_index));
+        case TAI_OBJECT_TYPE_NETWORKIF:
+            return (if_index < STUB_MAX_INTERFACES) &&
+                   (__atomic_load_n(&mod->netif_mask, __ATOMIC_ACQUIRE) & (1U << if_index));
+        default:
+            return false;
     }
-    return TAI_STATUS_ATTR_NOT_SUPPORTED_0;
 }
 
 /**
- * @brief Retrieve a list of attribute values
+ * @brief Register a module
  *
- * @param [in] network_interface_id The network interface ID handle
- * @param [in] attr_count A count of the number of elements in the attr_list
- * @param [in,out] attr_list A list of attributes to be retrieved
+ * A module reinserted at the same location gets its previous slot back, with
+ * a new generation. A module restored by a warm start is adopted: its id is
+ * returned as it was before the restart.
+ *
+ * @param [in] location The location of the module
+ * @param [in] notifications The notifications of the module
+ * @param [out] module_id The id of the module
  *
  * @return TAI_STATUS_SUCCESS on success, failure status code on error
  */
-static tai_status_t stub_get_network_interface_attributes(
-    _In_ tai_object_id_t     network_interface_id,
-    _In_ uint32_t            attr_count,
-    _Inout_ tai_attribute_t *attr_list)
+static tai_status_t stub_registry_add_module(
+    _In_ const tai_char_list_t           *location,
+    _In_ const tai_module_notification_t *notifications,
+    _Out_ tai_object_id_t                *module_id)
 {
+    stub_module_t *mod = NULL;
+    uint16_t generation;
     uint32_t idx;
     tai_status_t ret;
 
-    for (idx = 0; idx < attr_count; idx++) {
-        ret = stub_get_network_interface_attribute(network_interface_id, attr_list++);
-        if (ret) {
-            return convert_tai_error_to_list(ret, idx);
+    if ((0 == location->count) || (NULL == location->list) ||
+        (location->count >= TAI_MAX_HARDWARE_ID_LEN)) {
+        return TAI_STATUS_INVALID_ATTR_VALUE_0;
+    }
+
+    pthread_mutex_lock(&stub_registry_lock);
+    for (idx = 0; idx < TAI_MAX_MODULES; idx++) {
+        if ((strlen(stub_modules[idx].location) == location->count) &&
+            (0 == memcmp(stub_modules[idx].location, location->list, location->count))) {
+            mod = &stub_modules[idx];
+            break;
+        }
+    }
+    if ((NULL != mod) && (0 != mod->generation)) {
+        if (!mod->restored) {
+            pthread_mutex_unlock(&stub_registry_lock);
+            return TAI_STATUS_ITEM_ALREADY_EXISTS;
+        }
+        mod->restored = false;
+        mod->notifications = *notifications;
+        *module_id = STUB_OID(TAI_OBJECT_TYPE_MODULE, mod - stub_modules, 0, mod->generation);
+        pthread_mutex_unlock(&stub_registry_lock);
+        return TAI_STATUS_SUCCESS;
+    }
+    /* prefer slots which never held a module, so that ids stay stable */
+    for (idx = 0; (NULL == mod) && (idx < TAI_MAX_MODULES); idx++) {
+        if ('\0' == stub_modules[idx].location[0]) {
+            mod = &stub_modules[idx];
         }
     }
-    return TAI_STATUS_SUCCESS; 
+    for (idx = 0; (NULL == mod) && (idx < TAI_MAX_MODULES); idx++) {
+        if (0 == stub_modules[idx].generation) {
+            mod = &stub_modules[idx];
+        }
+    }
+    if (NULL == mod) {
+        pthread_mutex_unlock(&stub_registry_lock);
+        return TAI_STATUS_TABLE_FULL;
+    }
+    ret = stub_regmap_attach(mod - stub_modules, location->list, location->count, true);
+    if (TAI_STATUS_SUCCESS != ret) {
+        pthread_mutex_unlock(&stub_registry_lock);
+        return ret;
+    }
+
+    generation = mod->last_generation + 1;
+    if (0 == generation) {
+        generation = 1;
+    }
+    mod->last_generation = generation;
+    memcpy(mod->location, location->list, location->count);
+    mod->location[location->count] = '\0';
+    mod->notifications = *notifications;
+    stub_registry_default_tributary(mod);
+    *module_id = STUB_OID(TAI_OBJECT_TYPE_MODULE, mod - stub_modules, 0, generation);
+    stub_store_reset(*module_id);
+    __atomic_store_n(&mod->hostif_mask, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&mod->netif_mask, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&mod->generation, generation, __ATOMIC_RELEASE);
+    pthread_mutex_unlock(&stub_registry_lock);
+    return TAI_STATUS_SUCCESS;
 }
 
 /**
- * @brief Set the value of an attribute
+ * @brief Unregister a module, its interfaces become invalid as well
  *
- * @param [in] network_interface_id The network interface ID handle
- * @param [in] attr A pointer to the attribute to be set
+ * @param [in] module_id The id of the module
  *
  * @return TAI_STATUS_SUCCESS on success, failure status code on error
  */
-static tai_status_t stub_set_network_interface_attribute(
-   _In_ tai_object_id_t        network_interface_id,
-   _In_ const tai_attribute_t *attr)
+static tai_status_t stub_registry_remove_module(_In_ tai_object_id_t module_id)
 {
-    TAI_SYSLOG_DEBUG("Setting network interface attribute: %d", attr->id);
-    switch (attr->id) {
-        case TAI_NETWORK_INTERFACE_ATTR_INDEX:
-            return TAI_STATUS_SUCCESS;
-        case TAI_NETWORK_INTERFACE_ATTR_TX_ALIGN_STATUS:
-        case TAI_NETWORK_INTERFACE_ATTR_RX_ALIGN_STATUS:
-        case TAI_NETWORK_INTERFACE_ATTR_CURRENT_OUTPUT_POWER:
-        case TAI_NETWORK_INTERFACE_ATTR_TX_LASER_FREQ:
-        case TAI_NETWORK_INTERFACE_ATTR_CURRENT_BER:
-        case TAI_NETWORK_INTERFACE_ATTR_CURRENT_BER_PERIOD:
-        case TAI_NETWORK_INTERFACE_ATTR_OPER_STATUS:
-        case TAI_NETWORK_INTERFACE_ATTR_MIN_LASER_FREQ:
-        case TAI_NETWORK_INTERFACE_ATTR_MAX_LASER_FREQ:
-        case TAI_NETWORK_INTERFACE_ATTR_LASER_GRID_SUPPORT:
-            return TAI_STATUS_INVALID_ATTRIBUTE_0;
-        case TAI_NETWORK_INTERFACE_ATTR_TX_ENABLE:
-        case TAI_NETWORK_INTERFACE_ATTR_TX_GRID_SPACING:
-        case TAI_NETWORK_INTERFACE_ATTR_TX_CHANNEL:
-        case TAI_NETWORK_INTERFACE_ATTR_OUTPUT_POWER:
-        case TAI_NETWORK_INTERFACE_ATTR_TX_FINE_TUNE_LASER_FREQ:
-        case TAI_NETWORK_INTERFACE_ATTR_MODULATION_FORMAT:
-        case TAI_NETWORK_INTERFACE_ATTR_DIFFERENTIAL_ENCODING:
-            return TAI_STATUS_SUCCESS;
+    stub_module_t *mod;
+
+    pthread_mutex_lock(&stub_registry_lock);
+    if (!stub_object_valid(module_id, TAI_OBJECT_TYPE_MODULE)) {
+        pthread_mutex_unlock(&stub_registry_lock);
+        return TAI_STATUS_INVALID_OBJECT_ID;
     }
-    return TAI_STATUS_ATTR_NOT_SUPPORTED_0;
+    mod = &stub_modules[STUB_OID_MODULE_INDEX(module_id)];
+    __atomic_store_n(&mod->generation, 0, __ATOMIC_RELEASE);
+    mod->restored = false;
+    mod->hostif_restored = 0;
+    mod->netif_restored = 0;
+    pthread_mutex_unlock(&stub_registry_lock);
+    return TAI_STATUS_SUCCESS;
 }
 
 /**
- * @brief Set the values from a list of attributes
+ * @brief Register an interface of a module, or adopt it if it was restored by
+ *        a warm start. A new interface starts with the default attribute
+ *        values, an adopted one keeps the restored values.
  *
- * @param [in] network_interface_id The network interface ID handle
- * @param [in] attr_count A count of the number of elements in the attr_list
- * @param [in] attr_list A list of attributes to be set
+ * @param [in] object_type The type of the interface
+ * @param [in] module_id The id of the module
+ * @param [in] if_index The index of the interface
+ * @param [out] object_id The id of the interface
  *
  * @return TAI_STATUS_SUCCESS on success, failure status code on error
  */
-static tai_status_t stub_set_network_interface_attributes(
-   _In_ tai_object_id_t        network_interface_id,
-   _In_ uint32_t               attr_count,
-   _In_ const tai_attribute_t *attr_list)
+static tai_status_t stub_registry_add_interface(
+    _In_ tai_object_type_t  object_type,
+    _In_ tai_object_id_t    module_id,
+    _In_ uint32_t           if_index,
+    _Out_ tai_object_id_t  *object_id)
 {
-    uint32_t idx;
-    tai_status_t ret;
+    stub_module_t *mod;
+    uint32_t *mask, *restored;
+    tai_status_t ret = TAI_STATUS_SUCCESS;
 
-    for (idx = 0; idx < attr_count; idx++) {
-        ret = stub_set_network_interface_attribute(network_interface_id, attr_list++);
-        if (ret) {
-            return convert_tai_error_to_list(ret, idx);
+    if (if_index >= STUB_MAX_INTERFACES) {
+        return TAI_STATUS_INVALID_ATTR_VALUE_0;
+    }
+    pthread_mutex_lock(&stub_registry_lock);
+    if (!stub_object_valid(module_id, TAI_OBJECT_TYPE_MODULE)) {
+        ret = TAI_STATUS_INVALID_OBJECT_ID;
+    } else {
+        mod = &stub_modules[STUB_OID_MODULE_INDEX(module_id)];
+        mask = (TAI_OBJECT_TYPE_HOSTIF == object_type) ? &mod->hostif_mask : &mod->netif_mask;
+        restored = (TAI_OBJECT_TYPE_HOSTIF == object_type) ? &mod->hostif_restored : &mod->netif_restored;
+        if ((*mask & (1U << if_index)) && !(*restored & (1U << if_index))) {
+            ret = TAI_STATUS_ITEM_ALREADY_EXISTS;
+        } else {
+            *object_id = STUB_OID(object_type, STUB_OID_MODULE_INDEX(module_id),
+                                  if_index, STUB_OID_GENERATION(module_id));
+            if (!(*restored & (1U << if_index))) {
+                stub_store_reset(*object_id);
+            }
+            *restored &= ~(1U << if_index);
+            __atomic_fetch_or(mask, 1U << if_index, __ATOMIC_RELEASE);
+        }
+    }
+    pthread_mutex_unlock(&stub_registry_lock);
+    return ret;
+}
+
+/**
+ * @brief Unregister an interface
+ *
+ * @param [in] object_type The type of the interface
+ * @param [in] object_id The id of the interface
+ *
+ * @return TAI_STATUS_SUCCESS on success, failure status code on error
+ */
+static tai_status_t stub_registry_remove_interface(
+    _In_ tai_object_type_t object_type,
+    _In_ tai_object_id_t   object_id)
+{
+    stub_module_t *mod;
+    uint32_t *mask;
+
+    pthread_mutex_lock(&stub_registry_lock);
+    if (!stub_object_valid(object_id, object_type)) {
+        pthread_mutex_unlock(&stub_registry_lock);
+        return TAI_STATUS_INVALID_OBJECT_ID;
+    }
+    mod = &stub_modules[STUB_OID_MODULE_INDEX(object_id)];
+    mask = (TAI_OBJECT_TYPE_HOSTIF == object_type) ? &mod->hostif_mask : &mod->netif_mask;
+    __atomic_fetch_and(mask, ~(1U << STUB_OID_IF_INDEX(object_id)), __ATOMIC_RELEASE);
+    pthread_mutex_unlock(&stub_registry_lock);
+    return TAI_STATUS_SUCCESS;
+}
+
+/**
+ * @brief Read the location of a module
+ *
+ * @param [in] module_id The id of the module
+ * @param [in,out] location The caller provided list
+ *
+ * @return TAI_STATUS_SUCCESS on success, TAI_STATUS_BUFFER_OVERFLOW with the
+ *         count set to the required value if the list is too small
+ */
+static tai_status_t stub_registry_get_location(
+    _In_ tai_object_id_t     module_id,
+    _Inout_ tai_char_list_t *location)
+{
+    const stub_module_t *mod = &stub_modules[STUB_OID_MODULE_INDEX(module_id)];
+    tai_status_t ret = TAI_STATUS_SUCCESS;
+    uint32_t len;
+
+    pthread_mutex_lock(&stub_registry_lock);
+    len = strlen(mod->location);
+    if (location->count < len) {
+        ret = TAI_STATUS_BUFFER_OVERFLOW;
+    } else if ((0 != len) && (NULL == location->list)) {
+        ret = TAI_STATUS_INVALID_PARAMETER;
+    } else {
+        memcpy(location->list, mod->location, len);
+    }
+    location->count = len;
+    pthread_mutex_unlock(&stub_registry_lock);
+    return ret;
+}
+
+/**
+ * @brief Read the tributary mapping of a module, the created network
+ *        interfaces and the created host interfaces each of them carries
+ *
+ * @param [in] module_id The id of the module
+ * @param [in,out] map The caller provided list. Every list too small has its
+ *        count set to the required value.
+ *
+ * @return TAI_STATUS_SUCCESS on success, TAI_STATUS_BUFFER_OVERFLOW if a list
+ *         is too small
+ */
+static tai_status_t stub_registry_get_tributary_mapping(
+    _In_ tai_object_id_t           module_id,
+    _Inout_ tai_object_map_list_t *map)
+{
+    uint16_t module_index = STUB_OID_MODULE_INDEX(module_id);
+    uint16_t generation = STUB_OID_GENERATION(module_id);
+    const stub_module_t *mod = &stub_modules[module_index];
+    uint32_t netif_mask, hostif_mask, netif, hostif, count = 0, values;
+    tai_object_map_t *entry;
+    tai_status_t ret = TAI_STATUS_SUCCESS;
+
+    netif_mask = __atomic_load_n(&mod->netif_mask, __ATOMIC_ACQUIRE);
+    hostif_mask = __atomic_load_n(&mod->hostif_mask, __ATOMIC_ACQUIRE);
+    for (netif = 0; netif < STUB_MAX_INTERFACES; netif++) {
+        if (!(netif_mask & (1U << netif))) {
+            continue;
+        }
+        if ((count >= map->count) || (NULL == map->list)) {
+            ret = TAI_STATUS_BUFFER_OVERFLOW;
+            count++;
+            continue;
+        }
+        entry = &map->list[count++];
+        entry->key = STUB_OID(TAI_OBJECT_TYPE_NETWORKIF, module_index, netif, generation);
+        values = 0;
+        for (hostif = 0; hostif < STUB_MAX_INTERFACES; hostif++) {
+            if (!(hostif_mask & (1U << hostif)) ||
+                (__atomic_load_n(&mod->tributary[hostif], __ATOMIC_RELAXED) != netif)) {
+                continue;
+            }
+            if ((values < entry->value.count) && (NULL != entry->value.list)) {
+                entry->value.list[values] = STUB_OID(TAI_OBJECT_TYPE_HOSTIF, module_index,
+                                                     hostif, generation);
+            } else {
+                ret = TAI_STATUS_BUFFER_OVERFLOW;
+            }
+            values++;
+        }
+        entry->value.count = values;
+    }
+    map->count = count;
+    return ret;
+}
+
+/**
+ * @brief Change the tributary mapping of a module. The host interfaces which
+ *        are not part of the mapping are not carried by any network
+ *        interface.
+ *
+ * @param [in] module_id The id of the module
+ * @param [in] map The network interfaces and the host interfaces each of them
+ *        carries, all of the module
+ *
+ * @return TAI_STATUS_SUCCESS on success, TAI_STATUS_INVALID_ATTR_VALUE_0 if
+ *         the mapping is not valid
+ */
+static tai_status_t stub_registry_set_tributary_mapping(
+    _In_ tai_object_id_t              module_id,
+    _In_ const tai_object_map_list_t *map)
+{
+    uint8_t tributary[STUB_MAX_INTERFACES];
+    const tai_object_map_t *entry;
+    tai_object_id_t hostif;
+    stub_module_t *mod;
+    uint32_t idx, v;
+
+    if ((0 != map->count) && (NULL == map->list)) {
+        return TAI_STATUS_INVALID_PARAMETER;
+    }
+    memset(tributary, STUB_TRIBUTARY_NONE, sizeof(tributary));
+    for (idx = 0; idx < map->count; idx++) {
+        entry = &map->list[idx];
+        if ((TAI_OBJECT_TYPE_NETWORKIF != STUB_OID_TYPE(entry->key)) ||
+            (STUB_OID_MODULE(entry->key) != module_id) ||
+            (STUB_OID_IF_INDEX(entry->key) >= stub_num_netifs) ||
+            ((0 != entry->value.count) && (NULL == entry->value.list))) {
+            return TAI_STATUS_INVALID_ATTR_VALUE_0;
+        }
+        for (v = 0; v < entry->value.count; v++) {
+            hostif = entry->value.list[v];
+            if ((TAI_OBJECT_TYPE_HOSTIF != STUB_OID_TYPE(hostif)) ||
+                (STUB_OID_MODULE(hostif) != module_id) ||
+                (STUB_OID_IF_INDEX(hostif) >= stub_num_hostifs) ||
+                (STUB_TRIBUTARY_NONE != tributary[STUB_OID_IF_INDEX(hostif)])) {
+                return TAI_STATUS_INVALID_ATTR_VALUE_0;
+            }
+            tributary[STUB_OID_IF_INDEX(hostif)] = STUB_OID_IF_INDEX(entry->key);
+        }
+    }
+
+    pthread_mutex_lock(&stub_registry_lock);
+    if (!stub_object_valid(module_id, TAI_OBJECT_TYPE_MODULE)) {
+        pthread_mutex_unlock(&stub_registry_lock);
+        return TAI_STATUS_INVALID_OBJECT_ID;
+    }
+    mod = &stub_modules[STUB_OID_MODULE_INDEX(module_id)];
+    for (idx = 0; idx < STUB_MAX_INTERFACES; idx++) {
+        __atomic_store_n(&mod->tributary[idx], tributary[idx], __ATOMIC_RELAXED);
+    }
+    pthread_mutex_unlock(&stub_registry_lock);
+    return TAI_STATUS_SUCCESS;
+}
+
+/**
+ * @brief Read the notifications of a module
+ *
+ * @param [in] object_id The id of the module or of one of its interfaces
+ * @param [out] notifications The notifications given when the module was
+ *        created
+ *
+ * @return false if the module does not exist
+ */
+static bool stub_registry_get_notifications(
+    _In_ tai_object_id_t             object_id,
+    _Out_ tai_module_notification_t *notifications)
+{
+    uint16_t module_index = STUB_OID_MODULE_INDEX(object_id);
+    bool ret = false;
+
+    if (module_index >= TAI_MAX_MODULES) {
+        return false;
+    }
+    pthread_mutex_lock(&stub_registry_lock);
+    if (stub_modules[module_index].generation == STUB_OID_GENERATION(object_id)) {
+        *notifications = stub_modules[module_index].notifications;
+        ret = true;
+    }
+    pthread_mutex_unlock(&stub_registry_lock);
+    return ret;
+}
+
+/**
+ * @brief Unregister every object, called by tai_api_uninitialize()
+ *
+ * The locations and the generations used are kept, so that the ids of the
+ * objects created after a new tai_api_initialize() differ from the old ones.
+ */
+static void stub_registry_clear(void)
+{
+    uint32_t idx;
+
+    pthread_mutex_lock(&stub_registry_lock);
+    for (idx = 0; idx < TAI_MAX_MODULES; idx++) {
+        __atomic_store_n(&stub_modules[idx].generation, 0, __ATOMIC_RELEASE);
+        stub_modules[idx].restored = false;
+        stub_modules[idx].hostif_restored = 0;
+        stub_modules[idx].netif_restored = 0;
+    }
+    pthread_mutex_unlock(&stub_registry_lock);
+}
+
+/**
+ * @brief Register a module and its interfaces as they were before a restart
+ *
+ * The objects keep their ids. They are live immediately and are adopted by
+ * the adapter host when it creates them again.
+ *
+ * @param [in] module_id The id of the module before the restart
+ * @param [in] location The location of the module
+ * @param [in] hostif_mask The host interfaces of the module
+ * @param [in] netif_mask The network interfaces of the module
+ *
+ * @return TAI_STATUS_SUCCESS on success, failure status code on error
+ */
+static tai_status_t stub_registry_restore_module(
+    _In_ tai_object_id_t  module_id,
+    _In_ const char      *location,
+    _In_ uint32_t         hostif_mask,
+    _In_ uint32_t         netif_mask)
+{
+    uint16_t module_index = STUB_OID_MODULE_INDEX(module_id);
+    uint16_t generation = STUB_OID_GENERATION(module_id);
+    stub_module_t *mod;
+    uint32_t idx;
+
+    if ((TAI_OBJECT_TYPE_MODULE != STUB_OID_TYPE(module_id)) ||
+        (module_index >= TAI_MAX_MODULES) || (0 == generation) ||
+        (0 != STUB_OID_IF_INDEX(module_id)) ||
+        ('\0' == location[0]) || (strlen(location) >= TAI_MAX_HARDWARE_ID_LEN)) {
+        return TAI_STATUS_INVALID_OBJECT_ID;
+    }
+
+    pthread_mutex_lock(&stub_registry_lock);
+    for (idx = 0; idx < TAI_MAX_MODULES; idx++) {
+        if ((0 != stub_modules[idx].generation) &&
+            ((idx == module_index) || (0 == strcmp(stub_modules[idx].location, location)))) {
+            pthread_mutex_unlock(&stub_registry_lock);
+            return TAI_STATUS_ITEM_ALREADY_EXISTS;
+        }
+    }
+    if (TAI_STATUS_SUCCESS != stub_regmap_attach(module_index, location, strlen(location), false)) {
+        pthread_mutex_unlock(&stub_registry_lock);
+        return TAI_STATUS_FAILURE;
+    }
+    mod = &stub_modules[module_index];
+    strcpy(mod->location, location);
+    if (generation > mod->last_generation) {
+        mod->last_generation = generation;
+    }
+    mod->restored = true;
+    memset(&mod->notifications, 0, sizeof(mod->notifications));
+    stub_registry_default_tributary(mod);
+    stub_store_reset(module_id);
+    for (idx = 0; idx < STUB_MAX_INTERFACES; idx++) {
+        if (hostif_mask & (1U << idx)) {
+            stub_store_reset(STUB_OID(TAI_OBJECT_TYPE_HOSTIF, module_index, idx, generation));
+        }
+        if (netif_mask & (1U << idx)) {
+            stub_store_reset(STUB_OID(TAI_OBJECT_TYPE_NETWORKIF, module_index, idx, generation));
+        }
+    }
+    mod->hostif_restored = hostif_mask;
+    mod->netif_restored = netif_mask;
+    __atomic_store_n(&mod->hostif_mask, hostif_mask, __ATOMIC_RELAXED);
+    __atomic_store_n(&mod->netif_mask, netif_mask, __ATOMIC_RELAXED);
+    __atomic_store_n(&mod->generation, generation, __ATOMIC_RELEASE);
+    pthread_mutex_unlock(&stub_registry_lock);
+    return TAI_STATUS_SUCCESS;
+}
+
+/**
+ * @brief Restore the tributary mapping of a module restored by a warm start
+ *
+ * Only the host interfaces which existed before the restart are mapped as
+ * they were, the others keep the default mapping.
+ *
+ * @param [in] module_id The module id
+ * @param [in] tributary The network interface carrying each host interface,
+ *             STUB_TRIBUTARY_NONE for none
+ */
+static void stub_registry_restore_tributary(
+    _In_ tai_object_id_t module_id,
+    _In_ const uint8_t  *tributary)
+{
+    stub_module_t *mod;
+    uint32_t idx;
+
+    pthread_mutex_lock(&stub_registry_lock);
+    if (!stub_object_valid(module_id, TAI_OBJECT_TYPE_MODULE)) {
+        pthread_mutex_unlock(&stub_registry_lock);
+        return;
+    }
+    mod = &stub_modules[STUB_OID_MODULE_INDEX(module_id)];
+    for (idx = 0; idx < STUB_MAX_INTERFACES; idx++) {
+        if ((mod->hostif_restored & (1U << idx)) &&
+            ((tributary[idx] < stub_num_netifs) || (STUB_TRIBUTARY_NONE == tributary[idx]))) {
+            __atomic_store_n(&mod->tributary[idx], tributary[idx], __ATOMIC_RELAXED);
+        }
+    }
+    pthread_mutex_unlock(&stub_registry_lock);
+}
+
+
+/*------------------------------------------------------------------------------
+
+                              Simulated Telemetry
+
+------------------------------------------------------------------------------*/
+
+/**
+ * @brief The model of a simulated read-only telemetry attribute. The value is
+ *        a slow sine wave around 'base' plus a small pseudo-random jitter, the
+ *        phase being derived from the object id so that objects differ.
+ */
+typedef struct _stub_sim_attr_t {
+    tai_object_type_t object_type;
+    tai_attr_id_t     attr_id;
+    float             base;
+    float             amplitude;
+    float             period;     /**< seconds */
+    float             jitter;
+} stub_sim_attr_t;
+
+static const stub_sim_attr_t stub_sim_attrs[] = {
+    { TAI_OBJECT_TYPE_MODULE,    TAI_MODULE_ATTR_TEMP,                                          45.0,  3.0, 600.0,   0.2 },
+    { TAI_OBJECT_TYPE_MODULE,    TAI_MODULE_ATTR_POWER,                                          3.3, 0.02, 300.0, 0.005 },
+    { TAI_OBJECT_TYPE_NETWORKIF, TAI_NETWORK_INTERFACE_ATTR_CURRENT_OUTPUT_POWER,                1.0,  0.1, 120.0,  0.02 },
+    { TAI_OBJECT_TYPE_NETWORKIF, TAI_NETWORK_INTERFACE_ATTR_CURRENT_BER,                        2e-5, 1e-5,  60.0,  2e-6 },
+    { TAI_OBJECT_TYPE_NETWORKIF, TAI_NETWORK_INTERFACE_ATTR_CURRENT_INPUT_POWER,               -10.0,  0.5, 180.0,  0.05 },
+    { TAI_OBJECT_TYPE_NETWORKIF, TAI_NETWORK_INTERFACE_ATTR_CURRENT_POST_VOA_TOTAL_POWER,      -12.0,  0.5, 180.0,  0.05 },
+    { TAI_OBJECT_TYPE_NETWORKIF, TAI_NETWORK_INTERFACE_ATTR_CURRENT_PROVISIONED_CHANNEL_POWER, -13.0,  0.5, 180.0,  0.05 },
+};
+
+/** @brief The simulated hardware samples its telemetry at this period */
+#define STUB_SIM_SAMPLE_NS  100000000ULL
+
+/**
+ * @brief A read-only attribute with a fixed simulated value
+ */
+typedef struct _stub_sim_fixed_attr_t {
+    tai_object_type_t object_type;
+    tai_attr_id_t     attr_id;
+    uint32_t          value;
+} stub_sim_fixed_attr_t;
+
+static const stub_sim_fixed_attr_t stub_sim_fixed_attrs[] = {
+    { TAI_OBJECT_TYPE_NETWORKIF, TAI_NETWORK_INTERFACE_ATTR_TX_ALIGN_STATUS,     0                           },
+    { TAI_OBJECT_TYPE_NETWORKIF, TAI_NETWORK_INTERFACE_ATTR_RX_ALIGN_STATUS,     TAI_NETWORK_INTERFACE_RX_ALIGN_MODEM_SYNC |
+                                                                                 TAI_NETWORK_INTERFACE_RX_ALIGN_MODEM_LOCK   },
+    { TAI_OBJECT_TYPE_NETWORKIF, TAI_NETWORK_INTERFACE_ATTR_CURRENT_BER_PERIOD,  1000000                     },
+    { TAI_OBJECT_TYPE_HOSTIF,    TAI_HOST_INTERFACE_ATTR_TX_ALIGN_STATUS,        0                           },
+};
+
+/**
+ * @brief A read-only list attribute with a fixed simulated value
+ */
+typedef struct _stub_sim_list_attr_t {
+    tai_object_type_t object_type;
+    tai_attr_id_t     attr_id;
+    uint32_t          count;
+    size_t            elem_size;
+    const void       *list;
+} stub_sim_list_attr_t;
+
+#define STUB_SIM_STRING(str)    sizeof(str) - 1, sizeof(char), str
+#define STUB_SIM_ARRAY(array)   sizeof(array)/sizeof(array[0]), sizeof(array[0]), array
+
+static const float    stub_sim_firmware_versions[] = { 1.2, 1.1 };
+static const uint32_t stub_sim_lane_faults[]       = { 0, 0, 0, 0 };
+
+static const stub_sim_list_attr_t stub_sim_list_attrs[] = {
+    { TAI_OBJECT_TYPE_MODULE, TAI_MODULE_ATTR_VENDOR_NAME,          STUB_SIM_STRING("TAI stub")                },
+    { TAI_OBJECT_TYPE_MODULE, TAI_MODULE_ATTR_VENDOR_PART_NUMBER,   STUB_SIM_STRING("STUB-DCO-100G")           },
+    { TAI_OBJECT_TYPE_MODULE, TAI_MODULE_ATTR_VENDOR_SERIAL_NUMBER, STUB_SIM_STRING("0000000001")              },
+    { TAI_OBJECT_TYPE_MODULE, TAI_MODULE_ATTR_FIRMWARE_VERSIONS,    STUB_SIM_ARRAY(stub_sim_firmware_versions) },
+    { TAI_OBJECT_TYPE_HOSTIF, TAI_HOST_INTERFACE_ATTR_LANE_FAULTS,  STUB_SIM_ARRAY(stub_sim_lane_faults)       },
+};
+
+/** @brief The layout shared by every tai_xxx_list_t */
+typedef struct _stub_list_t {
+    uint32_t count;
+    void    *list;
+} stub_list_t;
+
+/** @brief The kind of value of a simulated attribute */
+typedef enum _stub_sim_kind_t {
+    STUB_SIM_KIND_NONE,     /**< Not a simulated attribute */
+    STUB_SIM_KIND_FLOAT,    /**< Stored in value.flt */
+    STUB_SIM_KIND_U32,      /**< Stored in value.u32 */
+} stub_sim_kind_t;
+
+/**
+ * @brief Read a clock in nanoseconds
+ */
+static uint64_t stub_clock_ns(_In_ clockid_t clock_id)
+{
+    struct timespec ts;
+
+    clock_gettime(clock_id, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000ULL) + ts.tv_nsec;
+}
+
+/**
+ * @brief A 64 bit mixing function used to derive stable per-object values
+ */
+static uint64_t stub_hash64(_In_ uint64_t x)
+{
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ULL;
+    x ^= x >> 33;
+    return x;
+}
+
+/**
+ * @brief Look up how an attribute is simulated
+ *
+ * @param [in] object_type The type of the object
+ * @param [in] attr_id The attribute id
+ * @param [out] sim The telemetry model, if the attribute is a float
+ * @param [out] fixed The fixed value, if the attribute is a u32
+ *
+ * @return The kind of value of the attribute
+ */
+static stub_sim_kind_t stub_sim_lookup(
+    _In_ tai_object_type_t             object_type,
+    _In_ tai_attr_id_t                 attr_id,
+    _Out_ const stub_sim_attr_t       **sim,
+    _Out_ const stub_sim_fixed_attr_t **fixed)
+{
+    size_t i;
+
+    for (i = 0; i < sizeof(stub_sim_attrs)/sizeof(stub_sim_attrs[0]); i++) {
+        if ((stub_sim_attrs[i].object_type == object_type) &&
+            (stub_sim_attrs[i].attr_id == attr_id)) {
+            *sim = &stub_sim_attrs[i];
+            return STUB_SIM_KIND_FLOAT;
+        }
+    }
+    for (i = 0; i < sizeof(stub_sim_fixed_attrs)/sizeof(stub_sim_fixed_attrs[0]); i++) {
+        if ((stub_sim_fixed_attrs[i].object_type == object_type) &&
+            (stub_sim_fixed_attrs[i].attr_id == attr_id)) {
+            *fixed = &stub_sim_fixed_attrs[i];
+            return STUB_SIM_KIND_U32;
+        }
+    }
+    return STUB_SIM_KIND_NONE;
+}
+
+/**
+ * @brief Evaluate a telemetry model at a given time
+ */
+static float stub_sim_eval(
+    _In_ const stub_sim_attr_t *sim,
+    _In_ tai_object_id_t        object_id,
+    _In_ uint64_t               now_ns)
+{
+    double t = (double)(now_ns - now_ns % STUB_SIM_SAMPLE_NS) / 1e9;
+    double phase, noise;
+    uint64_t h;
+
+    h = stub_hash64(object_id ^ ((uint64_t)sim->attr_id << 48));
+    phase = (double)(h & 0xffff) / 65536.0 * 2 * M_PI;
+    h = stub_hash64(h ^ (uint64_t)(t * 10));
+    noise = ((double)(h & 0xffff) / 32768.0) - 1.0;
+    return sim->base +
+           sim->amplitude * sin(2 * M_PI * t / sim->period + phase) +
+           sim->jitter * noise;
+}
+
+/**
+ * @brief Look up the simulated value of a list attribute
+ *
+ * @param [in] object_type The type of the object
+ * @param [in] attr_id The attribute id
+ *
+ * @return The simulated list, NULL if the attribute is not a simulated list
+ */
+static const stub_sim_list_attr_t *stub_sim_list_lookup(
+    _In_ tai_object_type_t object_type,
+    _In_ tai_attr_id_t     attr_id)
+{
+    size_t i;
+
+    for (i = 0; i < sizeof(stub_sim_list_attrs)/sizeof(stub_sim_list_attrs[0]); i++) {
+        if ((stub_sim_list_attrs[i].object_type == object_type) &&
+            (stub_sim_list_attrs[i].attr_id == attr_id)) {
+            return &stub_sim_list_attrs[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Copy a simulated list to a caller provided list
+ *
+ * @param [in] sim The simulated list
+ * @param [in,out] attr The attribute to be filled
+ *
+ * @return TAI_STATUS_SUCCESS on success, TAI_STATUS_BUFFER_OVERFLOW with the
+ *         count set to the required value if the list is too small
+ */
+static tai_status_t stub_get_list_attribute(
+    _In_ const stub_sim_list_attr_t *sim,
+    _Inout_ tai_attribute_t         *attr)
+{
+    stub_list_t *list = (stub_list_t *)&attr->value;
+
+    if (list->count < sim->count) {
+        list->count = sim->count;
+        return TAI_STATUS_BUFFER_OVERFLOW;
+    }
+    if ((0 != sim->count) && (NULL == list->list)) {
+        return TAI_STATUS_INVALID_PARAMETER;
+    }
+    memcpy(list->list, sim->list, sim->count * sim->elem_size);
+    list->count = sim->count;
+    return TAI_STATUS_SUCCESS;
+}
+
+static uint32_t stub_regmap_list_count(
+    _In_ tai_object_type_t object_type,
+    _In_ tai_attr_id_t     attr_id,
+    _In_ uint32_t          count);
+static size_t stub_dump_elem_size(_In_ tai_attr_value_type_t value_type);
+
+/**
+ * @brief Release the lists of an attribute list, and clear them so that a
+ *        list released twice is released once
+ */
+static void stub_release_lists(
+    _In_ tai_object_type_t object_type,
+    _In_ uint32_t          attr_count,
+    _Inout_ tai_attribute_t *attr_list)
+{
+    const tai_attr_metadata_t *meta;
+    stub_list_t *list;
+    uint32_t idx;
+
+    for (idx = 0; idx < attr_count; idx++) {
+        meta = tai_metadata_get_attr_metadata(object_type, attr_list[idx].id);
+        if ((NULL != meta) && TAI_META_IS_LIST(meta)) {
+            list = (stub_list_t *)&attr_list[idx].value;
+            free(list->list);
+            list->list = NULL;
+            list->count = 0;
+        }
+    }
+}
+
+/**
+ * @brief Lay out the keys of an object map list and their values in one
+ *        block, each key getting the number of values it was read with
+ *
+ * @param [in,out] map The list, as read into its previous block
+ * @param [in] filled The number of keys the previous block held
+ *
+ * @return TAI_STATUS_SUCCESS on success, TAI_STATUS_NO_MEMORY with the
+ *         previous block kept
+ */
+static tai_status_t stub_alloc_objmap(
+    _Inout_ tai_object_map_list_t *map,
+    _In_ uint32_t                  filled)
+{
+    tai_object_map_t *keys;
+    tai_object_id_t *values;
+    uint32_t idx, total = 0;
+
+    if (filled > map->count) {
+        filled = map->count;
+    }
+    for (idx = 0; idx < filled; idx++) {
+        total += map->list[idx].value.count;
+    }
+    if (0 == map->count) {
+        free(map->list);
+        map->list = NULL;
+        return TAI_STATUS_SUCCESS;
+    }
+    keys = calloc(1, map->count * sizeof(*keys) + total * sizeof(*values));
+    if (NULL == keys) {
+        return TAI_STATUS_NO_MEMORY;
+    }
+    values = (tai_object_id_t *)&keys[map->count];
+    for (idx = 0, total = 0; idx < filled; idx++) {
+        keys[idx].value.count = map->list[idx].value.count;
+        keys[idx].value.list = values + total;
+        total += keys[idx].value.count;
+    }
+    free(map->list);
+    map->list = keys;
+    return TAI_STATUS_SUCCESS;
+}
+
+/**
+ * @brief Get a list of attributes, the lists are allocated by the adapter
+ *
+ * Every list of the request is allocated on its own. The simulated lists are
+ * sized from their values before the attributes are read, so they are read
+ * with one call of 'get_fn'. The other lists, such as the location or the
+ * tributary mapping, are sized from the counts of a read returning
+ * TAI_STATUS_BUFFER_OVERFLOW and read again until they fit, the keys of an
+ * object map list then the values of each key. Each list owns its memory,
+ * an object map list its keys and their values, so stub_free_attributes()
+ * releases any subset of the attributes in any order.
+ *
+ * @param [in] object_type The type of the object
+ * @param [in] get_fn The function reading the attributes
+ * @param [in] object_id The object id
+ * @param [in] attr_count The number of attributes in the list
+ * @param [in,out] attr_list A list of attributes to be retrieved
+ *
+ * @return TAI_STATUS_SUCCESS on success, failure status code on error
+ */
+static tai_status_t stub_get_attributes_alloc(
+    _In_ tai_object_type_t      object_type,
+    _In_ stub_get_attributes_fn get_fn,
+    _In_ tai_object_id_t        object_id,
+    _In_ uint32_t               attr_count,
+    _Inout_ tai_attribute_t    *attr_list)
+{
+    const tai_attr_metadata_t *meta;
+    const stub_sim_list_attr_t *sim;
+    stub_list_t *list;
+    uint32_t *capacity;
+    uint32_t idx;
+    tai_status_t ret;
+
+    capacity = calloc(attr_count ? attr_count : 1, sizeof(*capacity));
+    if (NULL == capacity) {
+        return TAI_STATUS_NO_MEMORY;
+    }
+    for (idx = 0; idx < attr_count; idx++) {
+        meta = tai_metadata_get_attr_metadata(object_type, attr_list[idx].id);
+        if ((NULL == meta) || !TAI_META_IS_LIST(meta)) {
+            continue;
+        }
+        list = (stub_list_t *)&attr_list[idx].value;
+        list->list = NULL;
+        list->count = 0;
+    }
+    for (idx = 0; idx < attr_count; idx++) {
+        meta = tai_metadata_get_attr_metadata(object_type, attr_list[idx].id);
+        if ((NULL == meta) || !TAI_META_IS_LIST(meta)) {
+            continue;
+        }
+        sim = stub_sim_list_lookup(object_type, attr_list[idx].id);
+        if (NULL == sim) {
+            continue;
+        }
+        list = (stub_list_t *)&attr_list[idx].value;
+        list->count = stub_regmap_list_count(object_type, attr_list[idx].id, sim->count);
+        if (0 == list->count) {
+            continue;
+        }
+        list->list = calloc(list->count, sim->elem_size);
+        if (NULL == list->list) {
+            list->count = 0;
+            ret = TAI_STATUS_NO_MEMORY;
+            goto out;
+        }
+        capacity[idx] = list->count;
+    }
+
+    while (TAI_STATUS_BUFFER_OVERFLOW == (ret = get_fn(object_id, attr_count, attr_list))) {
+        for (idx = 0; idx < attr_count; idx++) {
+            meta = tai_metadata_get_attr_metadata(object_type, attr_list[idx].id);
+            if ((NULL == meta) || !TAI_META_IS_LIST(meta)) {
+                continue;
+            }
+            list = (stub_list_t *)&attr_list[idx].value;
+            if (TAI_ATTR_VALUE_TYPE_OBJMAPLIST == meta->attrvaluetype) {
+                /* the values of the keys read are only known now */
+                ret = stub_alloc_objmap(&attr_list[idx].value.objmaplist, capacity[idx]);
+                if (TAI_STATUS_SUCCESS != ret) {
+                    goto out;
+                }
+                capacity[idx] = list->count;
+                continue;
+            }
+            if (list->count > capacity[idx]) {
+                free(list->list);
+                list->list = calloc(list->count, stub_dump_elem_size(meta->attrvaluetype));
+                if (NULL == list->list) {
+                    list->count = 0;
+                    ret = TAI_STATUS_NO_MEMORY;
+                    goto out;
+                }
+                capacity[idx] = list->count;
+            }
+            list->count = capacity[idx];
+        }
+    }
+
+out:
+    if (TAI_STATUS_SUCCESS != ret) {
+        stub_release_lists(object_type, attr_count, attr_list);
+    }
+    free(capacity);
+    return ret;
+}
+
+/**
+ * @brief Release the lists returned by stub_get_attributes_alloc()
+ *
+ * @param [in] object_type The type of the object
+ * @param [in] attr_count The number of attributes in the list
+ * @param [in] attr_list The attributes returned by stub_get_attributes_alloc(),
+ *             or a subset of them
+ *
+ * @return TAI_STATUS_SUCCESS on success, failure status code on error
+ */
+static tai_status_t stub_free_attributes(
+    _In_ tai_object_type_t object_type,
+    _In_ uint32_t          attr_count,
+    _In_ tai_attribute_t  *attr_list)
+{
+    if ((0 != attr_count) && (NULL == attr_list)) {
+        return TAI_STATUS_INVALID_PARAMETER;
+    }
+    stub_release_lists(object_type, attr_count, attr_list);
+    return TAI_STATUS_SUCCESS;
+}
+
+
+/*------------------------------------------------------------------------------
+
+                                 Register Map
+
+------------------------------------------------------------------------------*/
+
+/*
+ * When TAI_STUB_REGMAP_DIR is set, each module slot maps a file of that
+ * directory, named after the location of its module with a ".cmis" suffix,
+ * holding the paged register space of a CMIS module. The attributes of
+ * stub_regs are then decoded from their registers and encoded to them, the
+ * way the driver of a real module does, and a test tool changes what the
+ * adapter reads by writing to the file.
+ *
+ * The file holds the lower memory (bytes 0-127), then the upper pages 00h to
+ * FFh of bank 0, then those of banks 1 to 3, 128 bytes each. Pages 00h to 0Fh
+ * are not banked. The lanes of the interfaces of a module are numbered by
+ * interface index, 8 per bank. The module refreshes its telemetry registers
+ * from the simulated telemetry at each sample, unless the telemetry is frozen
+ * by STUB_REG_SIM_FREEZE.
+ */
+
+/** @brief Bytes of the lower memory and of an upper page */
+#define STUB_REG_PAGE_SIZE      128
+
+/** @brief Banks of the banked pages, covering STUB_MAX_INTERFACES lanes */
+#define STUB_REG_BANKS          4
+#define STUB_REG_BANK_LANES     8
+
+/** @brief The first banked page */
+#define STUB_REG_BANKED_PAGE    0x10
+
+/** @brief Size of the register file of a module */
+#define STUB_REG_FILE_SIZE      (STUB_REG_PAGE_SIZE * (1 + 256 * STUB_REG_BANKS))
+
+/** @brief Registers of the lower memory */
+#define STUB_REG_IDENTIFIER     0       /**< SFF-8024 identifier */
+#define STUB_REG_REVISION       1       /**< CMIS revision */
+#define STUB_REG_BANK_SELECT    126
+#define STUB_REG_PAGE_SELECT    127
+
+/** @brief The modules identify as QSFP-DD modules of CMIS 5.0 */
+#define STUB_REG_ID_QSFP_DD     0x18
+#define STUB_REG_CMIS_5_0       0x50
+
+/** @brief The simulation control register, in a vendor specific page */
+#define STUB_REG_SIM_PAGE       0x80
+#define STUB_REG_SIM_CONTROL    128
+#define STUB_REG_SIM_FREEZE     0x01    /**< The telemetry registers are not refreshed */
+#define STUB_REG_SIM_TRANSACTIONS 132   /**< Bus transactions of the host, 32 bit */
+
+/** @brief Power read from a register at 0 */
+#define STUB_REG_NO_POWER_DBM   -40.0
+
+/** @brief How the value of an attribute is encoded in its register */
+typedef enum _stub_reg_codec_t {
+    STUB_REG_S16,           /**< Signed big endian, in units of scale */
+    STUB_REG_U16,           /**< Unsigned big endian, in units of scale */
+    STUB_REG_U32,           /**< Unsigned big endian, in units of scale */
+    STUB_REG_POWER,         /**< Unsigned big endian in mW units of scale, as dBm */
+    STUB_REG_F16,           /**< CMIS F16: 5 bit exponent with offset 24, 11 bit mantissa */
+    STUB_REG_ASCII,         /**< Padded with spaces */
+    STUB_REG_FIELD,         /**< Bit field of a byte, through the codes */
+    STUB_REG_LANE_BIT,      /**< One bit per lane, through the codes */
+} stub_reg_codec_t;
+
+/** @brief A value of an enum or bool attribute and its code */
+typedef struct _stub_reg_code_t {
+    int32_t value;
+    uint8_t raw;
+} stub_reg_code_t;
+
+/** @brief The register of an attribute */
+typedef struct _stub_reg_t {
+    tai_object_type_t      object_type;
+    tai_attr_id_t          attr_id;
+    uint8_t                page;        /**< Ignored in the lower memory */
+    uint8_t                addr;        /**< Of lane 0 */
+    uint8_t                size;        /**< Bytes */
+    uint8_t                stride;      /**< Bytes between two lanes */
+    stub_reg_codec_t       codec;
+    double                 scale;
+    uint8_t                shift;       /**< Of a bit field */
+    uint8_t                mask;
+    const stub_reg_code_t *codes;
+    uint32_t               code_count;
+    bool                   telemetry;   /**< Refreshed at each sample */
+} stub_reg_t;
+
+#define STUB_REG_CODES(codes)   codes, sizeof(codes)/sizeof(codes[0])
+
+static const stub_reg_code_t stub_reg_module_states[] = {
+    { TAI_MODULE_OPER_STATUS_INITIALIZE, 2 },   /* ModulePwrUp */
+    { TAI_MODULE_OPER_STATUS_READY,      3 },   /* ModuleReady */
+};
+
+static const stub_reg_code_t stub_reg_low_power[] = {
+    { TAI_MODULE_ADMIN_STATUS_UP,   0 },
+    { TAI_MODULE_ADMIN_STATUS_DOWN, 1 },
+};
+
+static const stub_reg_code_t stub_reg_output_disable[] = {
+    { true,  0 },
+    { false, 1 },
+};
+
+static const stub_reg_t stub_regs[] = {
+    { TAI_OBJECT_TYPE_MODULE,    TAI_MODULE_ATTR_OPER_STATUS,                    0x00,   3,  1, 0, STUB_REG_FIELD,     0,        1, 0x07, STUB_REG_CODES(stub_reg_module_states),   false },
+    { TAI_OBJECT_TYPE_MODULE,    TAI_MODULE_ATTR_TEMP,                           0x00,  14,  2, 0, STUB_REG_S16,       1.0/256,  0, 0,    NULL, 0,                                  true  },
+    { TAI_OBJECT_TYPE_MODULE,    TAI_MODULE_ATTR_POWER,                          0x00,  16,  2, 0, STUB_REG_U16,       100e-6,   0, 0,    NULL, 0,                                  true  },
+    { TAI_OBJECT_TYPE_MODULE,    TAI_MODULE_ATTR_ADMIN_STATUS,                   0x00,  26,  1, 0, STUB_REG_FIELD,     0,        4, 0x01, STUB_REG_CODES(stub_reg_low_power),       false },
+    { TAI_OBJECT_TYPE_MODULE,    TAI_MODULE_ATTR_VENDOR_NAME,                    0x00, 129, 16, 0, STUB_REG_ASCII,     0,        0, 0,    NULL, 0,                                  false },
+    { TAI_OBJECT_TYPE_MODULE,    TAI_MODULE_ATTR_VENDOR_PART_NUMBER,             0x00, 148, 16, 0, STUB_REG_ASCII,     0,        0, 0,    NULL, 0,                                  false },
+    { TAI_OBJECT_TYPE_MODULE,    TAI_MODULE_ATTR_VENDOR_SERIAL_NUMBER,           0x00, 166, 16, 0, STUB_REG_ASCII,     0,        0, 0,    NULL, 0,                                  false },
+    { TAI_OBJECT_TYPE_NETWORKIF, TAI_NETWORK_INTERFACE_ATTR_TX_ENABLE,           0x10, 130,  1, 0, STUB_REG_LANE_BIT,  0,        0, 0x01, STUB_REG_CODES(stub_reg_output_disable),  false },
+    { TAI_OBJECT_TYPE_NETWORKIF, TAI_NETWORK_INTERFACE_ATTR_CURRENT_OUTPUT_POWER, 0x11, 154,  2, 2, STUB_REG_POWER,     1e-4,     0, 0,    NULL, 0,                                  true  },
+    { TAI_OBJECT_TYPE_NETWORKIF, TAI_NETWORK_INTERFACE_ATTR_CURRENT_INPUT_POWER,  0x11, 186,  2, 2, STUB_REG_POWER,     1e-4,     0, 0,    NULL, 0,                                  true  },
+    { TAI_OBJECT_TYPE_NETWORKIF, TAI_NETWORK_INTERFACE_ATTR_TX_LASER_FREQ,        0x12, 168,  4, 4, STUB_REG_U32,       1e6,      0, 0,    NULL, 0,                                  false },
+    { TAI_OBJECT_TYPE_NETWORKIF, TAI_NETWORK_INTERFACE_ATTR_CURRENT_BER,          0x24, 128,  2, 2, STUB_REG_F16,       0,        0, 0,    NULL, 0,                                  true  },
+};
+
+/** @brief The register file of a module slot */
+typedef struct _stub_regmap_t {
+    pthread_mutex_t lock;
+    uint8_t        *base;       /**< NULL if the slot has no file */
+    uint64_t        sample;     /**< Telemetry sample held by the registers */
+} stub_regmap_t;
+
+/**
+ * @brief The register files, by module slot. The file of a slot stays mapped
+ *        until the slot takes another module or the adapter is uninitialized.
+ */
+static stub_regmap_t stub_regmaps[TAI_MAX_MODULES] = {
+    [0 ... TAI_MAX_MODULES - 1] = { .lock = PTHREAD_MUTEX_INITIALIZER }
+};
+
+/** @brief The directory of the register files, NULL without a register map */
+static const char *stub_regmap_dir = NULL;
+
+/**
+ * @brief Look up the register of an attribute
+ *
+ * @return The register, NULL if the attribute is not in the register map
+ */
+static const stub_reg_t *stub_reg_lookup(
+    _In_ tai_object_type_t object_type,
+    _In_ tai_attr_id_t     attr_id)
+{
+    size_t i;
+
+    for (i = 0; i < sizeof(stub_regs)/sizeof(stub_regs[0]); i++) {
+        if ((stub_regs[i].object_type == object_type) && (stub_regs[i].attr_id == attr_id)) {
+            return &stub_regs[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Locate a byte of the register file
+ *
+ * @param [in] base The register file
+ * @param [in] bank The bank, ignored outside of the banked pages
+ * @param [in] page The upper page, ignored in the lower memory
+ * @param [in] addr The address
+ *
+ * @return The byte
+ */
+static uint8_t *stub_reg_byte(
+    _In_ uint8_t *base,
+    _In_ uint32_t bank,
+    _In_ uint8_t  page,
+    _In_ uint8_t  addr)
+{
+    if (addr < STUB_REG_PAGE_SIZE) {
+        return base + addr;
+    }
+    if (page < STUB_REG_BANKED_PAGE) {
+        bank = 0;
+    }
+    return base + STUB_REG_PAGE_SIZE * (1 + bank * 256 + page) + addr - STUB_REG_PAGE_SIZE;
+}
+
+/**
+ * @brief Locate the register of an attribute for a lane, as the module does
+ *
+ * @param [in] base The register file
+ * @param [in] reg The register
+ * @param [in] lane The lane, the interface index
+ * @param [out] bit The bit of the lane, for STUB_REG_LANE_BIT
+ *
+ * @return The first byte of the register
+ */
+static uint8_t *stub_reg_locate(
+    _In_ uint8_t          *base,
+    _In_ const stub_reg_t *reg,
+    _In_ uint32_t          lane,
+    _Out_ uint8_t         *bit)
+{
+    uint32_t bank = lane / STUB_REG_BANK_LANES;
+
+    lane %= STUB_REG_BANK_LANES;
+    *bit = (STUB_REG_LANE_BIT == reg->codec) ? lane : reg->shift;
+    return stub_reg_byte(base, bank, reg->page, reg->addr + lane * reg->stride);
+}
+
+/**
+ * @brief Count bus transactions of the host in the simulation registers
+ *
+ * @param [in,out] base The register file
+ * @param [in] count The number of transactions
+ */
+static void stub_reg_count(
+    _Inout_ uint8_t *base,
+    _In_ uint32_t    count)
+{
+    uint8_t *raw = stub_reg_byte(base, 0, STUB_REG_SIM_PAGE, STUB_REG_SIM_TRANSACTIONS);
+
+    count += ((uint32_t)raw[0] << 24) | ((uint32_t)raw[1] << 16) | ((uint32_t)raw[2] << 8) | raw[3];
+    raw[0] = count >> 24;
+    raw[1] = count >> 16;
+    raw[2] = count >> 8;
+    raw[3] = count;
+}
+
+/**
+ * @brief Select a bank and an upper page from the host, a write of the
+ *        select bytes unless they already hold them
+ *
+ * @param [in,out] base The register file
+ * @param [in] bank The bank
+ * @param [in] page The page
+ */
+static void stub_reg_page(
+    _Inout_ uint8_t *base,
+    _In_ uint8_t     bank,
+    _In_ uint8_t     page)
+{
+    if ((base[STUB_REG_BANK_SELECT] != bank) || (base[STUB_REG_PAGE_SELECT] != page)) {
+        base[STUB_REG_BANK_SELECT] = bank;
+        base[STUB_REG_PAGE_SELECT] = page;
+        stub_reg_count(base, 1);
+    }
+}
+
+/**
+ * @brief Address the register of an attribute for a lane from the host,
+ *        selecting its bank and page first when it is in an upper page
+ *
+ * @param [in] base The register file
+ * @param [in] reg The register
+ * @param [in] lane The lane, the interface index
+ * @param [out] bit The bit of the lane, for STUB_REG_LANE_BIT
+ *
+ * @return The first byte of the register
+ */
+static uint8_t *stub_reg_select(
+    _In_ uint8_t          *base,
+    _In_ const stub_reg_t *reg,
+    _In_ uint32_t          lane,
+    _Out_ uint8_t         *bit)
+{
+    if (reg->addr >= STUB_REG_PAGE_SIZE) {
+        stub_reg_page(base, (reg->page < STUB_REG_BANKED_PAGE) ? 0 : lane / STUB_REG_BANK_LANES,
+                      reg->page);
+    }
+    return stub_reg_locate(base, reg, lane, bit);
+}
+
+/**
+ * @brief Read a numeric attribute value
+ */
+static double stub_reg_value_get(
+    _In_ const tai_attr_metadata_t   *meta,
+    _In_ const tai_attribute_value_t *value)
+{
+    switch (meta->attrvaluetype) {
+        case TAI_ATTR_VALUE_TYPE_BOOLDATA:
+            return value->booldata;
+        case TAI_ATTR_VALUE_TYPE_U16:
+            return value->u16;
+        case TAI_ATTR_VALUE_TYPE_U32:
+            return value->u32;
+        case TAI_ATTR_VALUE_TYPE_U64:
+            return value->u64;
+        case TAI_ATTR_VALUE_TYPE_FLT:
+            return value->flt;
+        default:
+            return value->s32;
+    }
+}
+
+/**
+ * @brief Write a numeric attribute value
+ */
+static void stub_reg_value_set(
+    _In_ const tai_attr_metadata_t *meta,
+    _In_ double                     number,
+    _Out_ tai_attribute_value_t    *value)
+{
+    switch (meta->attrvaluetype) {
+        case TAI_ATTR_VALUE_TYPE_BOOLDATA:
+            value->booldata = (0 != number);
+            break;
+        case TAI_ATTR_VALUE_TYPE_U16:
+            value->u16 = number;
+            break;
+        case TAI_ATTR_VALUE_TYPE_U32:
+            value->u32 = number;
+            break;
+        case TAI_ATTR_VALUE_TYPE_U64:
+            value->u64 = number;
+            break;
+        case TAI_ATTR_VALUE_TYPE_FLT:
+            value->flt = number;
+            break;
+        default:
+            value->s32 = number;
+            break;
+    }
+}
+
+/**
+ * @brief Decode a numeric register
+ *
+ * @param [in] reg The register
+ * @param [in] raw The bytes of the register
+ *
+ * @return The value
+ */
+static double stub_reg_decode(
+    _In_ const stub_reg_t *reg,
+    _In_ const uint8_t    *raw)
+{
+    uint32_t code = 0;
+    uint32_t idx;
+
+    for (idx = 0; idx < reg->size; idx++) {
+        code = (code << 8) | raw[idx];
+    }
+    switch (reg->codec) {
+        case STUB_REG_S16:
+            return (int16_t)code * reg->scale;
+        case STUB_REG_POWER:
+            return (0 == code) ? STUB_REG_NO_POWER_DBM : 10 * log10(code * reg->scale);
+        case STUB_REG_F16:
+            return (code & 0x7ff) * pow(10, (int)(code >> 11) - 24);
+        default:
+            return code * reg->scale;
+    }
+}
+
+/**
+ * @brief Encode a numeric register, out of range values are clamped
+ *
+ * @param [in] reg The register
+ * @param [in] value The value
+ * @param [out] raw The bytes of the register
+ */
+static void stub_reg_encode(
+    _In_ const stub_reg_t *reg,
+    _In_ double            value,
+    _Out_ uint8_t         *raw)
+{
+    double max = ldexp(1, 8 * reg->size) - 1;
+    double code = 0;
+    uint32_t exponent;
+    int idx;
+
+    switch (reg->codec) {
+        case STUB_REG_S16:
+            code = fmin(fmax(round(value / reg->scale), INT16_MIN), INT16_MAX);
+            code = (uint16_t)(int16_t)code;
+            break;
+        case STUB_REG_POWER:
+            code = fmin(round(pow(10, value / 10) / reg->scale), max);
+            break;
+        case STUB_REG_F16:
+            /* the smallest exponent keeps the most digits */
+            for (exponent = 0; (value > 0) && (exponent < 32); exponent++) {
+                code = round(value / pow(10, (int)exponent - 24));
+                if (code <= 0x7ff) {
+                    code += exponent << 11;
+                    break;
+                }
+            }
+            code = (exponent < 32) ? code : max;
+            break;
+        default:
+            code = fmin(fmax(round(value / reg->scale), 0), max);
+            break;
+    }
+    for (idx = reg->size - 1; idx >= 0; idx--) {
+        raw[idx] = (uint64_t)code & 0xff;
+        code = (uint64_t)code >> 8;
+    }
+}
+
+/**
+ * @brief Translate the code of an enum or bool register to its value, 0 if
+ *        the code is unknown
+ */
+static int32_t stub_reg_code_value(
+    _In_ const stub_reg_t *reg,
+    _In_ uint8_t           raw)
+{
+    uint32_t idx;
+
+    for (idx = 0; idx < reg->code_count; idx++) {
+        if (reg->codes[idx].raw == raw) {
+            return reg->codes[idx].value;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Translate the value of an enum or bool attribute to its code, 0 if
+ *        the value has none
+ */
+static uint8_t stub_reg_code_raw(
+    _In_ const stub_reg_t *reg,
+    _In_ int32_t           value)
+{
+    uint32_t idx;
+
+    for (idx = 0; idx < reg->code_count; idx++) {
+        if (reg->codes[idx].value == value) {
+            return reg->codes[idx].raw;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Refresh the telemetry registers of a module if a new sample is due,
+ *        called with the lock of the register file held
+ *
+ * @param [in,out] regmap The register file of the module
+ * @param [in] module_index The slot of the module
+ * @param [in] now_ns The sampling time in nanoseconds
+ */
+static void stub_regmap_refresh(
+    _Inout_ stub_regmap_t *regmap,
+    _In_ uint16_t          module_index,
+    _In_ uint64_t          now_ns)
+{
+    uint64_t sample = now_ns / STUB_SIM_SAMPLE_NS;
+    uint16_t generation = __atomic_load_n(&stub_modules[module_index].generation,
+                                          __ATOMIC_ACQUIRE);
+    const stub_sim_attr_t *sim;
+    const stub_sim_fixed_attr_t *fixed;
+    const stub_reg_t *reg;
+    uint32_t idx, lane, lanes;
+    uint8_t bit;
+
+    if ((sample == regmap->sample) ||
+        (*stub_reg_byte(regmap->base, 0, STUB_REG_SIM_PAGE, STUB_REG_SIM_CONTROL) &
+         STUB_REG_SIM_FREEZE)) {
+        return;
+    }
+    regmap->sample = sample;
+    for (idx = 0; idx < sizeof(stub_regs)/sizeof(stub_regs[0]); idx++) {
+        reg = &stub_regs[idx];
+        if (!reg->telemetry ||
+            (STUB_SIM_KIND_FLOAT != stub_sim_lookup(reg->object_type, reg->attr_id, &sim, &fixed))) {
+            continue;
+        }
+        lanes = (TAI_OBJECT_TYPE_MODULE == reg->object_type) ? 1 :
+                (TAI_OBJECT_TYPE_NETWORKIF == reg->object_type) ? stub_num_netifs : stub_num_hostifs;
+        for (lane = 0; lane < lanes; lane++) {
+            stub_reg_encode(reg,
+                            stub_sim_eval(sim, STUB_OID(reg->object_type, module_index, lane,
+                                                        generation), now_ns),
+                            stub_reg_locate(regmap->base, reg, lane, &bit));
+        }
+    }
+}
+
+/** @brief Unused bytes a burst read may span rather than take another transaction */
+#define STUB_REG_BURST_GAP      8
+
+/** @brief A burst read of a plan, within the lower memory and one upper page */
+typedef struct _stub_reg_burst_t {
+    uint8_t  bank;
+    uint8_t  page;
+    uint16_t addr;
+    uint16_t end;                               /**< Past the last byte read */
+    uint8_t  data[2 * STUB_REG_PAGE_SIZE];      /**< From addr */
+} stub_reg_burst_t;
+
+/**
+ * @brief The registers of the attributes of a get, read in as few bursts as
+ *        possible by stub_regmap_fetch() and decoded from them by
+ *        stub_regmap_decode()
+ */
+typedef struct _stub_reg_plan_t {
+    uint32_t         count;
+    stub_reg_burst_t bursts[sizeof(stub_regs)/sizeof(stub_regs[0])];
+} stub_reg_plan_t;
+
+/**
+ * @brief Find the bytes of the register of an attribute for a lane
+ *
+ * @param [in] reg The register
+ * @param [in] lane The lane, the interface index
+ * @param [out] burst The range of the register: its bank, page, addr and end
+ */
+static void stub_reg_range(
+    _In_ const stub_reg_t   *reg,
+    _In_ uint32_t            lane,
+    _Out_ stub_reg_burst_t  *burst)
+{
+    burst->bank = (reg->page < STUB_REG_BANKED_PAGE) ? 0 : lane / STUB_REG_BANK_LANES;
+    burst->page = reg->page;
+    burst->addr = reg->addr + (lane % STUB_REG_BANK_LANES) * reg->stride;
+    burst->end = burst->addr + reg->size;
+}
+
+/**
+ * @brief Read the registers of the attributes of a get from the host
+ *
+ * The register ranges of the attributes are sorted by bank, page and address,
+ * and the ranges of a page overlapping or close to each other are merged, so
+ * that the registers are read with one burst per group of nearby registers
+ * and one page select per page, instead of a select and a read per attribute.
+ * The registers are read at once, under the lock of the register file.
+ *
+ * @param [out] plan The bursts read
+ * @param [in] object_type The type of the object
+ * @param [in] object_id The object id, already validated
+ * @param [in] now_ns The sampling time of the simulated telemetry
+ * @param [in] attr_count The number of attributes
+ * @param [in] attr_list The attributes of the get
+ *
+ * @return TAI_STATUS_SUCCESS on success, failure status code on error
+ */
+static tai_status_t stub_regmap_fetch(
+    _Out_ stub_reg_plan_t       *plan,
+    _In_ tai_object_type_t       object_type,
+    _In_ tai_object_id_t         object_id,
+    _In_ uint64_t                now_ns,
+    _In_ uint32_t                attr_count,
+    _In_ const tai_attribute_t  *attr_list)
+{
+    uint16_t module_index = STUB_OID_MODULE_INDEX(object_id);
+    stub_regmap_t *regmap = &stub_regmaps[module_index];
+    stub_reg_burst_t range, *burst;
+    const stub_reg_t *reg;
+    bool telemetry = false;
+    uint32_t idx, pos, lower;
+
+    plan->count = 0;
+    if (NULL == stub_regmap_dir) {
+        return TAI_STATUS_SUCCESS;
+    }
+    for (idx = 0; idx < attr_count; idx++) {
+        reg = stub_reg_lookup(object_type, attr_list[idx].id);
+        if (NULL == reg) {
+            continue;
+        }
+        telemetry |= reg->telemetry;
+        stub_reg_range(reg, STUB_OID_IF_INDEX(object_id), &range);
+        for (pos = plan->count; pos > 0; pos--) {
+            burst = &plan->bursts[pos - 1];
+            if ((burst->bank < range.bank) ||
+                ((burst->bank == range.bank) && (burst->page < range.page)) ||
+                ((burst->bank == range.bank) && (burst->page == range.page) &&
+                 (burst->addr <= range.addr))) {
+                break;
+            }
+        }
+        if ((pos > 0) && (plan->bursts[pos - 1].bank == range.bank) &&
+            (plan->bursts[pos - 1].page == range.page) &&
+            (plan->bursts[pos - 1].addr == range.addr)) {
+            continue;   /* the same attribute twice */
+        }
+        memmove(&plan->bursts[pos + 1], &plan->bursts[pos],
+                (plan->count - pos) * sizeof(plan->bursts[0]));
+        plan->bursts[pos] = range;
+        plan->count++;
+    }
+    if (0 == plan->count) {
+        return TAI_STATUS_SUCCESS;
+    }
+    for (idx = 1, pos = 0; idx < plan->count; idx++) {
+        burst = &plan->bursts[pos];
+        if ((burst->bank == plan->bursts[idx].bank) && (burst->page == plan->bursts[idx].page) &&
+            (plan->bursts[idx].addr <= burst->end + STUB_REG_BURST_GAP)) {
+            if (plan->bursts[idx].end > burst->end) {
+                burst->end = plan->bursts[idx].end;
+            }
+        } else {
+            plan->bursts[++pos] = plan->bursts[idx];
+        }
+    }
+    plan->count = pos + 1;
+
+    pthread_mutex_lock(&regmap->lock);
+    if (NULL == regmap->base) {
+        pthread_mutex_unlock(&regmap->lock);
+        return TAI_STATUS_FAILURE;
+    }
+    if (telemetry) {
+        stub_regmap_refresh(regmap, module_index, now_ns);
+    }
+    for (idx = 0; idx < plan->count; idx++) {
+        burst = &plan->bursts[idx];
+        lower = (burst->addr < STUB_REG_PAGE_SIZE) ?
+                ((burst->end < STUB_REG_PAGE_SIZE) ? burst->end : STUB_REG_PAGE_SIZE) - burst->addr : 0;
+        memcpy(burst->data, regmap->base + burst->addr, lower);
+        if (burst->end > STUB_REG_PAGE_SIZE) {
+            stub_reg_page(regmap->base, burst->bank, burst->page);
+            memcpy(burst->data + lower,
+                   stub_reg_byte(regmap->base, burst->bank, burst->page, burst->addr + lower),
+                   burst->end - burst->addr - lower);
+        }
+        stub_reg_count(regmap->base, 1);
+    }
+    pthread_mutex_unlock(&regmap->lock);
+    return TAI_STATUS_SUCCESS;
+}
+
+/**
+ * @brief Decode an attribute from the bursts of a plan
+ *
+ * @param [in] plan The bursts read by stub_regmap_fetch()
+ * @param [in] reg The register of the attribute
+ * @param [in] meta The metadata of the attribute
+ * @param [in] object_id The object id
+ * @param [in,out] attr The attribute to be filled
+ *
+ * @return TAI_STATUS_SUCCESS on success, failure status code on error
+ */
+static tai_status_t stub_regmap_decode(
+    _In_ const stub_reg_plan_t     *plan,
+    _In_ const stub_reg_t          *reg,
+    _In_ const tai_attr_metadata_t *meta,
+    _In_ tai_object_id_t            object_id,
+    _Inout_ tai_attribute_t        *attr)
+{
+    uint32_t lane = STUB_OID_IF_INDEX(object_id);
+    char ascii[STUB_REG_PAGE_SIZE];
+    stub_sim_list_attr_t list = { .elem_size = sizeof(char), .list = ascii };
+    const stub_reg_burst_t *burst = NULL;
+    stub_reg_burst_t range;
+    const uint8_t *raw;
+    uint32_t idx;
+    uint8_t bit = (STUB_REG_LANE_BIT == reg->codec) ? lane % STUB_REG_BANK_LANES : reg->shift;
+
+    stub_reg_range(reg, lane, &range);
+    for (idx = 0; (idx < plan->count) && (NULL == burst); idx++) {
+        if ((plan->bursts[idx].bank == range.bank) && (plan->bursts[idx].page == range.page) &&
+            (plan->bursts[idx].addr <= range.addr) && (plan->bursts[idx].end >= range.end)) {
+            burst = &plan->bursts[idx];
+        }
+    }
+    if (NULL == burst) {
+        return TAI_STATUS_FAILURE;
+    }
+    raw = burst->data + range.addr - burst->addr;
+    switch (reg->codec) {
+        case STUB_REG_ASCII:
+            memcpy(ascii, raw, reg->size);
+            for (list.count = reg->size;
+                 (list.count > 0) && ((' ' == ascii[list.count - 1]) || ('\0' == ascii[list.count - 1]));
+                 list.count--);
+            return stub_get_list_attribute(&list, attr);
+        case STUB_REG_FIELD:
+        case STUB_REG_LANE_BIT:
+            stub_reg_value_set(meta, stub_reg_code_value(reg, (*raw >> bit) & reg->mask),
+                               &attr->value);
+            return TAI_STATUS_SUCCESS;
+        default:
+            stub_reg_value_set(meta, stub_reg_decode(reg, raw), &attr->value);
+            return TAI_STATUS_SUCCESS;
+    }
+}
+
+/**
+ * @brief Write the register of an attribute, if it has one, called by the
+ *        attribute store for every value it stores
+ *
+ * @param [in] object_id The object id
+ * @param [in] attr_id The attribute id
+ * @param [in] value The value
+ */
+static void stub_regmap_put(
+    _In_ tai_object_id_t              object_id,
+    _In_ tai_attr_id_t                attr_id,
+    _In_ const tai_attribute_value_t *value)
+{
+    tai_object_type_t object_type = STUB_OID_TYPE(object_id);
+    stub_regmap_t *regmap = &stub_regmaps[STUB_OID_MODULE_INDEX(object_id)];
+    const tai_attr_metadata_t *meta;
+    const stub_reg_t *reg;
+    uint8_t *raw;
+    uint8_t bit, code;
+
+    if (NULL == stub_regmap_dir) {
+        return;
+    }
+    reg = stub_reg_lookup(object_type, attr_id);
+    if ((NULL == reg) || reg->telemetry || (STUB_REG_ASCII == reg->codec)) {
+        return;
+    }
+    meta = tai_metadata_get_attr_metadata(object_type, attr_id);
+
+    pthread_mutex_lock(&regmap->lock);
+    if (NULL != regmap->base) {
+        raw = stub_reg_select(regmap->base, reg, STUB_OID_IF_INDEX(object_id), &bit);
+        switch (reg->codec) {
+            case STUB_REG_FIELD:
+            case STUB_REG_LANE_BIT:
+                /* read, modify, write */
+                code = stub_reg_code_raw(reg, stub_reg_value_get(meta, value));
+                *raw = (*raw & ~(reg->mask << bit)) | ((code & reg->mask) << bit);
+                stub_reg_count(regmap->base, 2);
+                break;
+            default:
+                stub_reg_encode(reg, stub_reg_value_get(meta, value), raw);
+                stub_reg_count(regmap->base, 1);
+                break;
+        }
+    }
+    pthread_mutex_unlock(&regmap->lock);
+}
+
+/**
+ * @brief The room needed by a list attribute, which may be longer in its
+ *        register than in the simulated values
+ *
+ * @param [in] object_type The type of the object
+ * @param [in] attr_id The attribute id
+ * @param [in] count The number of elements of the simulated value
+ *
+ * @return The number of elements
+ */
+static uint32_t stub_regmap_list_count(
+    _In_ tai_object_type_t object_type,
+    _In_ tai_attr_id_t     attr_id,
+    _In_ uint32_t          count)
+{
+    const stub_reg_t *reg;
+
+    if (NULL == stub_regmap_dir) {
+        return count;
+    }
+    reg = stub_reg_lookup(object_type, attr_id);
+    return ((NULL != reg) && (STUB_REG_ASCII == reg->codec) && (reg->size > count)) ?
+           reg->size : count;
+}
+
+/**
+ * @brief Power a new module up: clear its registers and write its identity
+ *
+ * @param [out] base The register file
+ */
+static void stub_regmap_power_up(_Out_ uint8_t *base)
+{
+    const stub_sim_list_attr_t *sim;
+    uint8_t *raw;
+    uint32_t idx;
+    uint8_t bit;
+
+    memset(base, 0, STUB_REG_FILE_SIZE);
+    base[STUB_REG_IDENTIFIER] = STUB_REG_ID_QSFP_DD;
+    base[STUB_REG_REVISION] = STUB_REG_CMIS_5_0;
+    for (idx = 0; idx < sizeof(stub_regs)/sizeof(stub_regs[0]); idx++) {
+        if (STUB_REG_ASCII != stub_regs[idx].codec) {
+            continue;
+        }
+        sim = stub_sim_list_lookup(stub_regs[idx].object_type, stub_regs[idx].attr_id);
+        raw = stub_reg_locate(base, &stub_regs[idx], 0, &bit);
+        memset(raw, ' ', stub_regs[idx].size);
+        if (NULL != sim) {
+            memcpy(raw, sim->list,
+                   (sim->count < stub_regs[idx].size) ? sim->count : stub_regs[idx].size);
+        }
+    }
+}
+
+/**
+ * @brief Map the register file of a module slot, called by the registry
+ *
+ * @param [in] module_index The slot
+ * @param [in] location The location of the module, names the file
+ * @param [in] length The length of the location
+ * @param [in] power_up true for a module just inserted, false to keep the
+ *                      registers of a module restored by a warm start
+ *
+ * @return TAI_STATUS_SUCCESS on success, failure status code on error
+ */
+static tai_status_t stub_regmap_attach(
+    _In_ uint16_t    module_index,
+    _In_ const char *location,
+    _In_ uint32_t    length,
+    _In_ bool        power_up)
+{
+    stub_regmap_t *regmap = &stub_regmaps[module_index];
+    char file_name[PATH_MAX];
+    struct stat st;
+    uint8_t *base;
+    size_t len;
+    uint32_t idx;
+    char c;
+    int fd;
+
+    if (NULL == stub_regmap_dir) {
+        return TAI_STATUS_SUCCESS;
+    }
+    len = snprintf(file_name, sizeof(file_name) - sizeof(".cmis"), "%s/", stub_regmap_dir);
+    for (idx = 0; (idx < length) && (len < sizeof(file_name) - sizeof(".cmis")); idx++) {
+        c = location[idx];
+        file_name[len++] = (((c >= '0') && (c <= '9')) || ((c >= 'a') && (c <= 'z')) ||
+                            ((c >= 'A') && (c <= 'Z')) || ('-' == c) || ('.' == c)) ? c : '_';
+    }
+    strcpy(file_name + len, ".cmis");
+
+    fd = open(file_name, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        TAI_SYSLOG_ERROR("Failed to open the register file %s: %s", file_name, strerror(errno));
+        return TAI_STATUS_FAILURE;
+    }
+    if ((0 != fstat(fd, &st)) || (STUB_REG_FILE_SIZE != st.st_size)) {
+        power_up = true;
+    }
+    if (power_up && (0 != ftruncate(fd, STUB_REG_FILE_SIZE))) {
+        TAI_SYSLOG_ERROR("Failed to size the register file %s: %s", file_name, strerror(errno));
+        close(fd);
+        return TAI_STATUS_FAILURE;
+    }
+    base = mmap(NULL, STUB_REG_FILE_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (MAP_FAILED == base) {
+        TAI_SYSLOG_ERROR("Failed to map the register file %s: %s", file_name, strerror(errno));
+        return TAI_STATUS_FAILURE;
+    }
+    if (power_up) {
+        stub_regmap_power_up(base);
+    }
+
+    pthread_mutex_lock(&regmap->lock);
+    if (NULL != regmap->base) {
+        munmap(regmap->base, STUB_REG_FILE_SIZE);
+    }
+    regmap->base = base;
+    regmap->sample = 0;
+    pthread_mutex_unlock(&regmap->lock);
+    return TAI_STATUS_SUCCESS;
+}
+
+/**
+ * @brief Read the directory of the register files, called by
+ *        tai_api_initialize()
+ */
+static void stub_regmap_init(void)
+{
+    stub_regmap_dir = stub_getenv("TAI_STUB_REGMAP_DIR");
+    if ((NULL != stub_regmap_dir) && ('\0' == *stub_regmap_dir)) {
+        stub_regmap_dir = NULL;
+    }
+}
+
+/**
+ * @brief Unmap every register file, called by tai_api_uninitialize()
+ */
+static void stub_regmap_close(void)
+{
+    uint32_t idx;
+
+    for (idx = 0; idx < TAI_MAX_MODULES; idx++) {
+        pthread_mutex_lock(&stub_regmaps[idx].lock);
+        if (NULL != stub_regmaps[idx].base) {
+            munmap(stub_regmaps[idx].base, STUB_REG_FILE_SIZE);
+            stub_regmaps[idx].base = NULL;
+        }
+        pthread_mutex_unlock(&stub_regmaps[idx].lock);
+    }
+    stub_regmap_dir = NULL;
+}
+
+
+/*------------------------------------------------------------------------------
+
+                                Attribute Store
+
+------------------------------------------------------------------------------*/
+
+/** @brief The attribute ids of an object type are below this bound */
+#define STUB_STORE_MAX_ATTRS    64
+
+/** @brief The maximum number of stored attributes of an object */
+#define STUB_STORE_MAX_CELLS    32
+
+/**
+ * @brief The values of the attributes which are neither simulated nor lists.
+ *
+ * Each of them has a cell of 8 bytes holding the first bytes of its
+ * #tai_attribute_value_t, which covers every scalar type. The cells of an
+ * object are contiguous, numbered in the order of the attribute ids by
+ * stub_store_init(), and the objects are indexed like the registry: the
+ * module, then its host interfaces, then its network interfaces. Cells are
+ * read and written atomically, without a lock. A value with a register in
+ * the register map is written to the register as well, from which it is read.
+ */
+static int8_t   stub_store_cell[TAI_OBJECT_TYPE_MAX][STUB_STORE_MAX_ATTRS];
+static uint64_t stub_store[TAI_MAX_MODULES][1 + 2 * STUB_MAX_INTERFACES][STUB_STORE_MAX_CELLS];
+
+/** @brief The value of a stored attribute when its object is created */
+typedef struct _stub_store_default_t {
+    tai_object_type_t     object_type;
+    tai_attr_id_t         attr_id;
+    tai_attribute_value_t value;
+} stub_store_default_t;
+
+/**
+ * @brief The values of a new object, the attributes not listed start at 0.
+ *        TAI_MODULE_ATTR_NUM_xxx_INTERFACES are set by stub_store_reset().
+ */
+static const stub_store_default_t stub_store_defaults[] = {
+    { TAI_OBJECT_TYPE_MODULE,    TAI_MODULE_ATTR_OPER_STATUS,                      { .s32 = TAI_MODULE_OPER_STATUS_READY }                    },
+    { TAI_OBJECT_TYPE_MODULE,    TAI_MODULE_ATTR_ADMIN_STATUS,                     { .s32 = TAI_MODULE_ADMIN_STATUS_UP }                      },
+    { TAI_OBJECT_TYPE_HOSTIF,    TAI_HOST_INTERFACE_ATTR_FEC_TYPE,                 { .s32 = TAI_HOST_INTERFACE_FEC_TYPE_RS }                  },
+    { TAI_OBJECT_TYPE_NETWORKIF, TAI_NETWORK_INTERFACE_ATTR_TX_GRID_SPACING,       { .s32 = TAI_NETWORK_INTERFACE_TX_GRID_SPACING_50_GHZ }    },
+    { TAI_OBJECT_TYPE_NETWORKIF, TAI_NETWORK_INTERFACE_ATTR_TX_CHANNEL,            { .u16 = 52 }                                              },
+    { TAI_OBJECT_TYPE_NETWORKIF, TAI_NETWORK_INTERFACE_ATTR_TX_LASER_FREQ,         { .u64 = 193100000000000ULL }                              },
+    { TAI_OBJECT_TYPE_NETWORKIF, TAI_NETWORK_INTERFACE_ATTR_MODULATION_FORMAT,     { .s32 = TAI_NETWORK_INTERFACE_MODULATION_FORMAT_DP_QPSK } },
+    { TAI_OBJECT_TYPE_NETWORKIF, TAI_NETWORK_INTERFACE_ATTR_OPER_STATUS,           { .s32 = TAI_NETWORK_INTERFACE_OPER_STATUS_READY }         },
+    { TAI_OBJECT_TYPE_NETWORKIF, TAI_NETWORK_INTERFACE_ATTR_MIN_LASER_FREQ,        { .u64 = 191150000000000ULL }                              },
+    { TAI_OBJECT_TYPE_NETWORKIF, TAI_NETWORK_INTERFACE_ATTR_MAX_LASER_FREQ,        { .u64 = 196100000000000ULL }                              },
+    { TAI_OBJECT_TYPE_NETWORKIF, TAI_NETWORK_INTERFACE_ATTR_LASER_GRID_SUPPORT,    { .s32 = TAI_NETWORK_INTERFACE_LASER_GRID_SPACING_100_GHZ |
+                                                                                            TAI_NETWORK_INTERFACE_LASER_GRID_SPACING_50_GHZ |
+                                                                                            TAI_NETWORK_INTERFACE_LASER_GRID_SPACING_25_GHZ |
+                                                                                            TAI_NETWORK_INTERFACE_LASER_GRID_SPACING_12_5_GHZ |
+                                                                                            TAI_NETWORK_INTERFACE_LASER_GRID_SPACING_6_25_GHZ } },
+    { TAI_OBJECT_TYPE_NETWORKIF, TAI_NETWORK_INTERFACE_ATTR_PULSE_SHAPING_TX_BETA, { .flt = 0.2 }                                             },
+    { TAI_OBJECT_TYPE_NETWORKIF, TAI_NETWORK_INTERFACE_ATTR_PULSE_SHAPING_RX_BETA, { .flt = 0.2 }                                             },
+    { TAI_OBJECT_TYPE_NETWORKIF, TAI_NETWORK_INTERFACE_ATTR_CHANNEL_FREQ,          { .flt = 193.1e12 }                                        },
+    { TAI_OBJECT_TYPE_NETWORKIF, TAI_NETWORK_INTERFACE_ATTR_CHANNEL_LAMBDA,        { .flt = 1552.52 }                                         },
+};
+
+/**
+ * @brief Number the cells of each object type and read the number of
+ *        interfaces of the simulated modules, called by tai_api_initialize()
+ */
+static void stub_store_init(void)
+{
+    static const tai_object_type_t types[] = {
+        TAI_OBJECT_TYPE_MODULE, TAI_OBJECT_TYPE_HOSTIF, TAI_OBJECT_TYPE_NETWORKIF,
+    };
+    const tai_attr_metadata_t *meta;
+    const stub_sim_attr_t *sim;
+    const stub_sim_fixed_attr_t *fixed;
+    tai_attr_id_t attr_id;
+    uint32_t idx, cells;
+
+    stub_num_hostifs = stub_env_u32("TAI_STUB_NUM_HOST_INTERFACES", STUB_NUM_HOST_INTERFACES);
+    stub_num_netifs = stub_env_u32("TAI_STUB_NUM_NETWORK_INTERFACES", STUB_NUM_NETWORK_INTERFACES);
+    if ((0 == stub_num_netifs) || (stub_num_netifs > STUB_MAX_INTERFACES) ||
+        (stub_num_hostifs > STUB_MAX_INTERFACES)) {
+        TAI_SYSLOG_WARN("Modules have 1 to %u network interfaces and up to %u host interfaces",
+                        STUB_MAX_INTERFACES, STUB_MAX_INTERFACES);
+        stub_num_hostifs = STUB_NUM_HOST_INTERFACES;
+        stub_num_netifs = STUB_NUM_NETWORK_INTERFACES;
+    }
+
+    memset(stub_store_cell, -1, sizeof(stub_store_cell));
+    for (idx = 0; idx < sizeof(types)/sizeof(types[0]); idx++) {
+        cells = 0;
+        for (attr_id = 0; attr_id < tai_metadata_attr_by_object_type_count[types[idx]]; attr_id++) {
+            meta = tai_metadata_get_attr_metadata(types[idx], attr_id);
+            if ((NULL == meta) || TAI_META_IS_LIST(meta) ||
+                (TAI_ATTR_VALUE_TYPE_CHARDATA == meta->attrvaluetype) ||
+                (STUB_SIM_KIND_NONE != stub_sim_lookup(types[idx], attr_id, &sim, &fixed))) {
+                continue;
+            }
+            if ((attr_id >= STUB_STORE_MAX_ATTRS) || (cells >= STUB_STORE_MAX_CELLS)) {
+                TAI_SYSLOG_ERROR("No room to store %s", meta->attridname);
+                continue;
+            }
+            stub_store_cell[types[idx]][attr_id] = cells++;
+        }
+    }
+}
+
+/**
+ * @brief Get the cells of an object
+ */
+static uint64_t *stub_store_cells(_In_ tai_object_id_t object_id)
+{
+    uint16_t module_index = STUB_OID_MODULE_INDEX(object_id);
+    uint16_t if_index = STUB_OID_IF_INDEX(object_id);
+
+    switch (STUB_OID_TYPE(object_id)) {
+        case TAI_OBJECT_TYPE_MODULE:
+            return stub_store[module_index][0];
+        case TAI_OBJECT_TYPE_HOSTIF:
+            return stub_store[module_index][1 + if_index];
+        case TAI_OBJECT_TYPE_NETWORKIF:
+            return stub_store[module_index][1 + STUB_MAX_INTERFACES + if_index];
+        default:
+            return NULL;
+    }
+}
+
+/**
+ * @brief Get the cell of an attribute
+ *
+ * @return The cell, NULL if the attribute is not stored
+ */
+static uint64_t *stub_store_attr_cell(
+    _In_ tai_object_id_t object_id,
+    _In_ tai_attr_id_t   attr_id)
+{
+    tai_object_type_t object_type = STUB_OID_TYPE(object_id);
+
+    if ((object_type >= TAI_OBJECT_TYPE_MAX) || (attr_id >= STUB_STORE_MAX_ATTRS) ||
+        (stub_store_cell[object_type][attr_id] < 0)) {
+        return NULL;
+    }
+    return &stub_store_cells(object_id)[stub_store_cell[object_type][attr_id]];
+}
+
+/**
+ * @brief Store the value of an attribute
+ *
+ * @return true if the attribute is stored
+ */
+static bool stub_store_put(
+    _In_ tai_object_id_t              object_id,
+    _In_ tai_attr_id_t                attr_id,
+    _In_ const tai_attribute_value_t *value)
+{
+    uint64_t *cell = stub_store_attr_cell(object_id, attr_id);
+    uint64_t raw;
+
+    if (NULL == cell) {
+        return false;
+    }
+    memcpy(&raw, value, sizeof(raw));
+    __atomic_store_n(cell, raw, __ATOMIC_RELAXED);
+    stub_regmap_put(object_id, attr_id, value);
+    return true;
+}
+
+/**
+ * @brief Read the stored value of an attribute
+ *
+ * @param [in] object_id The object id
+ * @param [in,out] attr The attribute to be filled
+ *
+ * @return true if the attribute is stored
+ */
+static bool stub_store_get(
+    _In_ tai_object_id_t     object_id,
+    _Inout_ tai_attribute_t *attr)
+{
+    uint64_t *cell = stub_store_attr_cell(object_id, attr->id);
+    uint64_t raw;
+
+    if (NULL == cell) {
+        return false;
+    }
+    raw = __atomic_load_n(cell, __ATOMIC_RELAXED);
+    memset(&attr->value, 0, sizeof(attr->value));
+    memcpy(&attr->value, &raw, sizeof(raw));
+    return true;
+}
+
+/**
+ * @brief Give the attributes of a new object their default values, called
+ *        by the registry before the object is published
+ *
+ * @param [in] object_id The object id
+ */
+static void stub_store_reset(_In_ tai_object_id_t object_id)
+{
+    tai_object_type_t object_type = STUB_OID_TYPE(object_id);
+    uint64_t *cells = stub_store_cells(object_id);
+    tai_attribute_value_t value;
+    tai_attribute_t attr;
+    size_t idx;
+
+    for (idx = 0; idx < STUB_STORE_MAX_CELLS; idx++) {
+        __atomic_store_n(&cells[idx], 0, __ATOMIC_RELAXED);
+    }
+    for (idx = 0; idx < sizeof(stub_store_defaults)/sizeof(stub_store_defaults[0]); idx++) {
+        if (stub_store_defaults[idx].object_type == object_type) {
+            stub_store_put(object_id, stub_store_defaults[idx].attr_id,
+                           &stub_store_defaults[idx].value);
+        }
+    }
+    if (TAI_OBJECT_TYPE_MODULE == object_type) {
+        memset(&value, 0, sizeof(value));
+        value.u32 = stub_num_hostifs;
+        stub_store_put(object_id, TAI_MODULE_ATTR_NUM_HOST_INTERFACES, &value);
+        value.u32 = stub_num_netifs;
+        stub_store_put(object_id, TAI_MODULE_ATTR_NUM_NETWORK_INTERFACES, &value);
+    }
+    /* the registers of the attributes left at 0 as well */
+    for (idx = 0; idx < sizeof(stub_regs)/sizeof(stub_regs[0]); idx++) {
+        if (stub_regs[idx].object_type == object_type) {
+            attr.id = stub_regs[idx].attr_id;
+            if (stub_store_get(object_id, &attr)) {
+                stub_regmap_put(object_id, attr.id, &attr.value);
+            }
+        }
+    }
+}
+
+
+/*------------------------------------------------------------------------------
+
+                              Attribute Dispatch
+
+------------------------------------------------------------------------------*/
+
+struct _stub_attr_t;
+
+/**
+ * @brief Read an attribute of an object
+ *
+ * @param [in] entry The dispatch entry of the attribute
+ * @param [in] object_id The object id, already validated
+ * @param [in] now_ns The sampling time of the simulated telemetry
+ * @param [in,out] attr The attribute to be filled
+ *
+ * @return TAI_STATUS_SUCCESS on success, failure status code on error
+ */
+typedef tai_status_t (*stub_attr_get_fn)(
+    _In_ const struct _stub_attr_t *entry,
+    _In_ tai_object_id_t            object_id,
+    _In_ uint64_t                   now_ns,
+    _Inout_ tai_attribute_t        *attr);
+
+/**
+ * @brief Write an attribute of an object, already validated
+ *
+ * @param [in] object_id The object id
+ * @param [in] attr The attribute
+ *
+ * @return TAI_STATUS_SUCCESS on success, failure status code on error
+ */
+typedef tai_status_t (*stub_attr_set_fn)(
+    _In_ tai_object_id_t        object_id,
+    _In_ const tai_attribute_t *attr);
+
+/** @brief How the stub serves an attribute */
+typedef struct _stub_attr_t {
+    const tai_attr_metadata_t *meta;    /**< Value type and flags */
+    stub_attr_get_fn           get;
+    stub_attr_set_fn           set;     /**< NULL if a write is ignored */
+    union {
+        const stub_sim_attr_t       *sim;
+        const stub_sim_fixed_attr_t *fixed;
+        const stub_sim_list_attr_t  *list;
+        const stub_reg_t            *reg;
+    } model;
+} stub_attr_t;
+
+/**
+ * @brief The dispatch table, indexed by object type and attribute id, built
+ *        from the metadata and the simulated values by stub_attr_init(). An
+ *        attribute without a get function is not supported.
+ */
+static stub_attr_t stub_attrs[TAI_OBJECT_TYPE_MAX][STUB_STORE_MAX_ATTRS];
+
+/** @brief Read a simulated telemetry attribute */
+static tai_status_t stub_attr_get_telemetry(
+    _In_ const stub_attr_t *entry,
+    _In_ tai_object_id_t    object_id,
+    _In_ uint64_t           now_ns,
+    _Inout_ tai_attribute_t *attr)
+{
+    attr->value.flt = stub_sim_eval(entry->model.sim, object_id, now_ns);
+    return TAI_STATUS_SUCCESS;
+}
+
+/** @brief Read a read-only attribute with a fixed simulated value */
+static tai_status_t stub_attr_get_fixed(
+    _In_ const stub_attr_t *entry,
+    _In_ tai_object_id_t    object_id,
+    _In_ uint64_t           now_ns,
+    _Inout_ tai_attribute_t *attr)
+{
+    attr->value.u32 = entry->model.fixed->value;
+    return TAI_STATUS_SUCCESS;
+}
+
+/** @brief Read a read-only list attribute with a fixed simulated value */
+static tai_status_t stub_attr_get_list(
+    _In_ const stub_attr_t *entry,
+    _In_ tai_object_id_t    object_id,
+    _In_ uint64_t           now_ns,
+    _Inout_ tai_attribute_t *attr)
+{
+    return stub_get_list_attribute(entry->model.list, attr);
+}
+
+/** @brief Read an attribute from the store */
+static tai_status_t stub_attr_get_stored(
+    _In_ const stub_attr_t *entry,
+    _In_ tai_object_id_t    object_id,
+    _In_ uint64_t           now_ns,
+    _Inout_ tai_attribute_t *attr)
+{
+    stub_store_get(object_id, attr);
+    return TAI_STATUS_SUCCESS;
+}
+
+/** @brief Write an attribute to the store */
+static tai_status_t stub_attr_set_stored(
+    _In_ tai_object_id_t        object_id,
+    _In_ const tai_attribute_t *attr)
+{
+    stub_store_put(object_id, attr->id, &attr->value);
+    return TAI_STATUS_SUCCESS;
+}
+
+/** @brief Read an attribute from its register, on its own */
+static tai_status_t stub_attr_get_register(
+    _In_ const stub_attr_t *entry,
+    _In_ tai_object_id_t    object_id,
+    _In_ uint64_t           now_ns,
+    _Inout_ tai_attribute_t *attr)
+{
+    stub_reg_plan_t plan;
+    tai_status_t ret;
+
+    ret = stub_regmap_fetch(&plan, entry->meta->objecttype, object_id, now_ns, 1, attr);
+    if (TAI_STATUS_SUCCESS != ret) {
+        return ret;
+    }
+    return stub_regmap_decode(&plan, entry->model.reg, entry->meta, object_id, attr);
+}
+
+/** @brief Read the location of a module from the registry */
+static tai_status_t stub_attr_get_location(
+    _In_ const stub_attr_t *entry,
+    _In_ tai_object_id_t    object_id,
+    _In_ uint64_t           now_ns,
+    _Inout_ tai_attribute_t *attr)
+{
+    return stub_registry_get_location(object_id, &attr->value.charlist);
+}
+
+/** @brief Read the tributary mapping of a module from the registry */
+static tai_status_t stub_attr_get_tributary_mapping(
+    _In_ const stub_attr_t *entry,
+    _In_ tai_object_id_t    object_id,
+    _In_ uint64_t           now_ns,
+    _Inout_ tai_attribute_t *attr)
+{
+    return stub_registry_get_tributary_mapping(object_id, &attr->value.objmaplist);
+}
+
+/** @brief Write the tributary mapping of a module to the registry */
+static tai_status_t stub_attr_set_tributary_mapping(
+    _In_ tai_object_id_t        object_id,
+    _In_ const tai_attribute_t *attr)
+{
+    return stub_registry_set_tributary_mapping(object_id, &attr->value.objmaplist);
+}
+
+/**
+ * @brief Build the dispatch table, called by tai_api_initialize() once the
+ *        store cells are numbered
+ */
+static void stub_attr_init(void)
+{
+    static const tai_object_type_t types[] = {
+        TAI_OBJECT_TYPE_MODULE, TAI_OBJECT_TYPE_HOSTIF, TAI_OBJECT_TYPE_NETWORKIF,
+    };
+    const stub_sim_attr_t *sim;
+    const stub_sim_fixed_attr_t *fixed;
+    const stub_sim_list_attr_t *list;
+    stub_attr_t *entry;
+    tai_attr_id_t attr_id;
+    uint32_t idx;
+
+    memset(stub_attrs, 0, sizeof(stub_attrs));
+    for (idx = 0; idx < sizeof(types)/sizeof(types[0]); idx++) {
+        for (attr_id = 0; attr_id < tai_metadata_attr_by_object_type_count[types[idx]]; attr_id++) {
+            if (attr_id >= STUB_STORE_MAX_ATTRS) {
+                break;
+            }
+            entry = &stub_attrs[types[idx]][attr_id];
+            entry->meta = tai_metadata_get_attr_metadata(types[idx], attr_id);
+            if (NULL == entry->meta) {
+                continue;
+            }
+            switch (stub_sim_lookup(types[idx], attr_id, &sim, &fixed)) {
+                case STUB_SIM_KIND_FLOAT:
+                    entry->get = stub_attr_get_telemetry;
+                    entry->model.sim = sim;
+                    continue;
+                case STUB_SIM_KIND_U32:
+                    entry->get = stub_attr_get_fixed;
+                    entry->model.fixed = fixed;
+                    continue;
+                default:
+                    break;
+            }
+            list = stub_sim_list_lookup(types[idx], attr_id);
+            if (NULL != list) {
+                entry->get = stub_attr_get_list;
+                entry->model.list = list;
+            } else if (stub_store_cell[types[idx]][attr_id] >= 0) {
+                entry->get = stub_attr_get_stored;
+                entry->set = stub_attr_set_stored;
+            }
+        }
+    }
+    stub_attrs[TAI_OBJECT_TYPE_MODULE][TAI_MODULE_ATTR_LOCATION].get = stub_attr_get_location;
+    stub_attrs[TAI_OBJECT_TYPE_MODULE][TAI_MODULE_ATTR_TRIBUTARY_MAPPING].get =
+        stub_attr_get_tributary_mapping;
+    stub_attrs[TAI_OBJECT_TYPE_MODULE][TAI_MODULE_ATTR_TRIBUTARY_MAPPING].set =
+        stub_attr_set_tributary_mapping;
+
+    /* the stored attributes keep their set function, see stub_store_put() */
+    if (NULL != stub_regmap_dir) {
+        for (idx = 0; idx < sizeof(stub_regs)/sizeof(stub_regs[0]); idx++) {
+            entry = &stub_attrs[stub_regs[idx].object_type][stub_regs[idx].attr_id];
+            entry->get = stub_attr_get_register;
+            entry->model.reg = &stub_regs[idx];
+        }
+    }
+}
+
+/**
+ * @brief Whether an attribute is simulated telemetry, from its model or from
+ *        its register
+ */
+static bool stub_attr_is_telemetry(_In_ const stub_attr_t *entry)
+{
+    return (stub_attr_get_telemetry == entry->get) ||
+           ((stub_attr_get_register == entry->get) && entry->model.reg->telemetry);
+}
+
+/**
+ * @brief Look up the dispatch entry of an attribute
+ *
+ * @return The entry, NULL if the attribute is not supported
+ */
+static inline const stub_attr_t *stub_attr_lookup(
+    _In_ tai_object_type_t object_type,
+    _In_ tai_attr_id_t     attr_id)
+{
+    const stub_attr_t *entry;
+
+    if ((object_type >= TAI_OBJECT_TYPE_MAX) || (attr_id >= STUB_STORE_MAX_ATTRS)) {
+        return NULL;
+    }
+    entry = &stub_attrs[object_type][attr_id];
+    return (NULL != entry->get) ? entry : NULL;
+}
+
+/**
+ * @brief Read a list of attributes of an object, the object is validated
+ *        once, the telemetry of the list is sampled at the same time and the
+ *        registers of the list are read together, see stub_regmap_fetch()
+ *
+ * @param [in] object_type The type of the object
+ * @param [in] object_id The object id
+ * @param [in] attr_count The number of attributes
+ * @param [in,out] attr_list The attributes to be filled
+ *
+ * @return TAI_STATUS_SUCCESS on success, failure status code on error
+ */
+static tai_status_t stub_get_object_attributes(
+    _In_ tai_object_type_t   object_type,
+    _In_ tai_object_id_t     object_id,
+    _In_ uint32_t            attr_count,
+    _Inout_ tai_attribute_t *attr_list)
+{
+    const stub_attr_t *entry;
+    stub_reg_plan_t plan;
+    uint64_t now_ns;
+    uint32_t idx;
+    tai_status_t ret;
+
+    if (!stub_object_valid(object_id, object_type)) {
+        return TAI_STATUS_INVALID_OBJECT_ID;
+    }
+    now_ns = stub_clock_ns(CLOCK_REALTIME);
+    ret = stub_regmap_fetch(&plan, object_type, object_id, now_ns, attr_count, attr_list);
+    if (TAI_STATUS_SUCCESS != ret) {
+        return ret;
+    }
+    for (idx = 0; idx < attr_count; idx++) {
+        entry = stub_attr_lookup(object_type, attr_list[idx].id);
+        if (NULL == entry) {
+            return convert_tai_error_to_list(TAI_STATUS_ATTR_NOT_SUPPORTED_0, idx);
+        }
+        if (stub_attr_get_register == entry->get) {
+            ret = stub_regmap_decode(&plan, entry->model.reg, entry->meta, object_id,
+                                     &attr_list[idx]);
+        } else {
+            ret = entry->get(entry, object_id, now_ns, &attr_list[idx]);
+        }
+        if (TAI_STATUS_SUCCESS != ret) {
+            return convert_tai_error_to_list(ret, idx);
+        }
+    }
+    return TAI_STATUS_SUCCESS;
+}
+
+/**
+ * @brief Write attributes of an object, the attributes are already validated
+ *        against their metadata
+ *
+ * @param [in] object_id The object id
+ * @param [in] attr_count The number of attributes
+ * @param [in] attr_list The attributes
+ *
+ * @return TAI_STATUS_SUCCESS on success, failure status code on error
+ */
+static tai_status_t stub_store_write(
+    _In_ tai_object_id_t        object_id,
+    _In_ uint32_t               attr_count,
+    _In_ const tai_attribute_t *attr_list)
+{
+    tai_object_type_t object_type = STUB_OID_TYPE(object_id);
+    const stub_attr_t *entry;
+    uint32_t idx;
+    tai_status_t ret;
+
+    for (idx = 0; idx < attr_count; idx++) {
+        entry = stub_attr_lookup(object_type, attr_list[idx].id);
+        if ((NULL == entry) || (NULL == entry->set)) {
+            continue;
+        }
+        ret = entry->set(object_id, &attr_list[idx]);
+        if (TAI_STATUS_SUCCESS != ret) {
+            return convert_tai_error_to_list(ret, idx);
+        }
+    }
+    return TAI_STATUS_SUCCESS;
+}
+
+/**
+ * @brief Produce the simulated value of a read-only attribute
+ *
+ * @param [in] object_type The type of the object
+ * @param [in] object_id The object id
+ * @param [in] now_ns The sampling time in nanoseconds
+ * @param [in,out] attr The attribute to be filled
+ *
+ * @return true if the attribute is a simulated attribute
+ */
+static bool stub_sample_attribute(
+    _In_ tai_object_type_t   object_type,
+    _In_ tai_object_id_t     object_id,
+    _In_ uint64_t            now_ns,
+    _Inout_ tai_attribute_t *attr)
+{
+    const stub_attr_t *entry = stub_attr_lookup(object_type, attr->id);
+
+    if ((NULL == entry) ||
+        (!stub_attr_is_telemetry(entry) && (stub_attr_get_fixed != entry->get))) {
+        return false;
+    }
+    entry->get(entry, object_id, now_ns, attr);
+    return true;
+}
+
+
+/*------------------------------------------------------------------------------
+
+                               Attribute Cache
+
+------------------------------------------------------------------------------*/
+
+/*
+ * Reads served from memory instead of the simulated hardware, following the
+ * cache policy of the metadata of each attribute: an IMMUTABLE value is kept
+ * until its object goes away, a TTL value for TAI_STUB_CACHE_TTL_MS
+ * milliseconds or until its object is written, and a NEVER value is always
+ * read. TTL values are not cached unless TAI_STUB_CACHE_TTL_MS is set, as
+ * how stale the telemetry may be is up to the adapter host. Entries are keyed
+ * by object id, so a new object of a reused slot never sees the values of its
+ * predecessor. TAI_STUB_CACHE=0 turns the cache off.
+ */
+
+/** @brief Entries of the cache of a module slot, a power of 2 */
+#define STUB_CACHE_ENTRIES      256
+
+/** @brief Bytes of list elements an entry holds, longer lists are not cached */
+#define STUB_CACHE_LIST_SIZE    64
+
+/** @brief A cached value */
+typedef struct _stub_cache_entry_t {
+    tai_object_id_t       object_id;    /**< TAI_NULL_OBJECT_ID if the entry is free */
+    tai_attr_id_t         attr_id;
+    uint64_t              expires_ns;   /**< CLOCK_MONOTONIC, 0 if immutable */
+    tai_attribute_value_t value;        /**< The list pointer of a list is not used */
+    uint8_t               list[STUB_CACHE_LIST_SIZE];
+} stub_cache_entry_t;
+
+/** @brief The cache of a module slot and of its interfaces, direct mapped */
+typedef struct _stub_cache_t {
+    pthread_mutex_t    lock;
+    stub_cache_entry_t entries[STUB_CACHE_ENTRIES];
+} stub_cache_t;
+
+static stub_cache_t stub_caches[TAI_MAX_MODULES] = {
+    [0 ... TAI_MAX_MODULES - 1] = { .lock = PTHREAD_MUTEX_INITIALIZER }
+};
+
+/** @brief The policy of each attribute, NEVER when the cache is off */
+static uint8_t  stub_cache_policy[TAI_OBJECT_TYPE_MAX][STUB_STORE_MAX_ATTRS];
+static uint64_t stub_cache_ttl_ns;
+static bool     stub_cache_enabled;
+static uint64_t stub_cache_hits;
+static uint64_t stub_cache_misses;
+
+static size_t stub_dump_elem_size(_In_ tai_attr_value_type_t value_type);
+
+/**
+ * @brief Empty the cache and derive the policy of the attributes from their
+ *        metadata, called by tai_api_initialize() once the dispatch table is
+ *        built
+ */
+static void stub_cache_init(void)
+{
+    const stub_attr_t *entry;
+    tai_object_type_t object_type;
+    tai_attr_id_t attr_id;
+    uint8_t policy;
+    uint32_t idx;
+
+    stub_cache_enabled = (0 != stub_env_u32("TAI_STUB_CACHE", 1));
+    stub_cache_ttl_ns = stub_env_u32("TAI_STUB_CACHE_TTL_MS", 0) * 1000000ULL;
+    __atomic_store_n(&stub_cache_hits, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&stub_cache_misses, 0, __ATOMIC_RELAXED);
+    for (idx = 0; idx < TAI_MAX_MODULES; idx++) {
+        pthread_mutex_lock(&stub_caches[idx].lock);
+        memset(stub_caches[idx].entries, 0, sizeof(stub_caches[idx].entries));
+        pthread_mutex_unlock(&stub_caches[idx].lock);
+    }
+
+    memset(stub_cache_policy, TAI_ATTR_CACHE_POLICY_NEVER, sizeof(stub_cache_policy));
+    if (!stub_cache_enabled) {
+        return;
+    }
+    for (object_type = 0; object_type < TAI_OBJECT_TYPE_MAX; object_type++) {
+        for (attr_id = 0; attr_id < STUB_STORE_MAX_ATTRS; attr_id++) {
+            entry = stub_attr_lookup(object_type, attr_id);
+            if (NULL == entry) {
+                continue;
+            }
+            policy = entry->meta->cachepolicy;
+            /* the lists of a map are not copied */
+            if (TAI_META_IS_LIST(entry->meta) &&
+                (0 == stub_dump_elem_size(entry->meta->attrvaluetype))) {
+                policy = TAI_ATTR_CACHE_POLICY_NEVER;
+            }
+            if ((TAI_ATTR_CACHE_POLICY_TTL == policy) && (0 == stub_cache_ttl_ns)) {
+                policy = TAI_ATTR_CACHE_POLICY_NEVER;
+            }
+            stub_cache_policy[object_type][attr_id] = policy;
+        }
+    }
+}
+
+/**
+ * @brief The policy of an attribute
+ */
+static inline tai_attr_cache_policy_t stub_cache_policy_of(
+    _In_ tai_object_type_t object_type,
+    _In_ tai_attr_id_t     attr_id)
+{
+    if ((object_type >= TAI_OBJECT_TYPE_MAX) || (attr_id >= STUB_STORE_MAX_ATTRS)) {
+        return TAI_ATTR_CACHE_POLICY_NEVER;
+    }
+    return stub_cache_policy[object_type][attr_id];
+}
+
+/**
+ * @brief The entry an attribute of an object maps to
+ */
+static inline stub_cache_entry_t *stub_cache_slot(
+    _In_ tai_object_id_t object_id,
+    _In_ tai_attr_id_t   attr_id)
+{
+    uint64_t hash = stub_hash64(object_id ^ ((uint64_t)attr_id * 0x9e3779b97f4a7c15ULL));
+
+    return &stub_caches[STUB_OID_MODULE_INDEX(object_id)].entries[hash & (STUB_CACHE_ENTRIES - 1)];
+}
+
+/**
+ * @brief Serve an attribute from the cache
+ *
+ * A list shorter than the cached value is not served, so that the read from
+ * the hardware reports the overflow.
+ *
+ * @param [in] object_type The type of the object
+ * @param [in] object_id The object id, already validated
+ * @param [in] now_ns The current CLOCK_MONOTONIC time
+ * @param [in,out] attr The attribute to be filled
+ *
+ * @return true if the attribute was served
+ */
+static bool stub_cache_get(
+    _In_ tai_object_type_t   object_type,
+    _In_ tai_object_id_t     object_id,
+    _In_ uint64_t            now_ns,
+    _Inout_ tai_attribute_t *attr)
+{
+    const tai_attr_metadata_t *meta;
+    stub_cache_t *cache = &stub_caches[STUB_OID_MODULE_INDEX(object_id)];
+    stub_cache_entry_t *entry;
+    stub_list_t *list, *cached;
+    bool hit = false;
+
+    if (TAI_ATTR_CACHE_POLICY_NEVER == stub_cache_policy_of(object_type, attr->id)) {
+        return false;
+    }
+    meta = stub_attrs[object_type][attr->id].meta;
+    entry = stub_cache_slot(object_id, attr->id);
+    pthread_mutex_lock(&cache->lock);
+    if ((entry->object_id == object_id) && (entry->attr_id == attr->id) &&
+        ((0 == entry->expires_ns) || (now_ns < entry->expires_ns))) {
+        if (TAI_META_IS_LIST(meta)) {
+            list = (stub_list_t *)&attr->value;
+            cached = (stub_list_t *)&entry->value;
+            if ((list->count >= cached->count) &&
+                ((NULL != list->list) || (0 == cached->count))) {
+                memcpy(list->list, entry->list,
+                       cached->count * stub_dump_elem_size(meta->attrvaluetype));
+                list->count = cached->count;
+                hit = true;
+            }
+        } else {
+            attr->value = entry->value;
+            hit = true;
+        }
+    }
+    pthread_mutex_unlock(&cache->lock);
+    __atomic_fetch_add(hit ? &stub_cache_hits : &stub_cache_misses, 1, __ATOMIC_RELAXED);
+    return hit;
+}
+
+/**
+ * @brief Keep the attributes just read from the hardware, called on the
+ *        worker of the module so that a write queued later invalidates them
+ *
+ * @param [in] object_type The type of the object
+ * @param [in] object_id The object id
+ * @param [in] attr_count The number of attributes
+ * @param [in] attr_list The attributes read
+ */
+static void stub_cache_fill(
+    _In_ tai_object_type_t      object_type,
+    _In_ tai_object_id_t        object_id,
+    _In_ uint32_t               attr_count,
+    _In_ const tai_attribute_t *attr_list)
+{
+    const tai_attr_metadata_t *meta;
+    stub_cache_t *cache = &stub_caches[STUB_OID_MODULE_INDEX(object_id)];
+    stub_cache_entry_t *entry;
+    const stub_list_t *list;
+    tai_attr_cache_policy_t policy;
+    uint64_t now_ns = 0;
+    size_t size;
+    uint32_t idx;
+
+    for (idx = 0; idx < attr_count; idx++) {
+        policy = stub_cache_policy_of(object_type, attr_list[idx].id);
+        if (TAI_ATTR_CACHE_POLICY_NEVER == policy) {
+            continue;
+        }
+        meta = stub_attrs[object_type][attr_list[idx].id].meta;
+        size = 0;
+        if (TAI_META_IS_LIST(meta)) {
+            list = (const stub_list_t *)&attr_list[idx].value;
+            size = list->count * stub_dump_elem_size(meta->attrvaluetype);
+            if (size > STUB_CACHE_LIST_SIZE) {
+                continue;
+            }
+        }
+        if ((TAI_ATTR_CACHE_POLICY_TTL == policy) && (0 == now_ns)) {
+            now_ns = stub_clock_ns(CLOCK_MONOTONIC);
+        }
+        entry = stub_cache_slot(object_id, attr_list[idx].id);
+        pthread_mutex_lock(&cache->lock);
+        entry->object_id = object_id;
+        entry->attr_id = attr_list[idx].id;
+        entry->expires_ns = (TAI_ATTR_CACHE_POLICY_TTL == policy) ? now_ns + stub_cache_ttl_ns : 0;
+        entry->value = attr_list[idx].value;
+        if (TAI_META_IS_LIST(meta)) {
+            memcpy(entry->list, list->list, size);
+            ((stub_list_t *)&entry->value)->list = NULL;
+        }
+        pthread_mutex_unlock(&cache->lock);
+    }
+}
+
+/**
+ * @brief Drop the cached values of an object
+ *
+ * @param [in] object_id The object id
+ * @param [in] immutable Drop the immutable values too, when the object goes
+ *             away, a write keeps them
+ */
+static void stub_cache_invalidate(
+    _In_ tai_object_id_t object_id,
+    _In_ bool            immutable)
+{
+    stub_cache_t *cache = &stub_caches[STUB_OID_MODULE_INDEX(object_id)];
+    stub_cache_entry_t *entry;
+    uint32_t idx;
+
+    if (!stub_cache_enabled) {
+        return;
+    }
+    pthread_mutex_lock(&cache->lock);
+    for (idx = 0; idx < STUB_CACHE_ENTRIES; idx++) {
+        entry = &cache->entries[idx];
+        if ((entry->object_id == object_id) && (immutable || (0 != entry->expires_ns))) {
+            entry->object_id = TAI_NULL_OBJECT_ID;
+        }
+    }
+    pthread_mutex_unlock(&cache->lock);
+}
+
+/**
+ * @brief Drop the cached values of a module and of its interfaces
+ *
+ * @param [in] module_id The module id
+ */
+static void stub_cache_flush(_In_ tai_object_id_t module_id)
+{
+    stub_cache_t *cache = &stub_caches[STUB_OID_MODULE_INDEX(module_id)];
+
+    if (!stub_cache_enabled) {
+        return;
+    }
+    pthread_mutex_lock(&cache->lock);
+    memset(cache->entries, 0, sizeof(cache->entries));
+    pthread_mutex_unlock(&cache->lock);
+}
+
+
+/*------------------------------------------------------------------------------
+
+                              Change Generations
+
+------------------------------------------------------------------------------*/
+
+/** @brief The change generations of an object */
+typedef struct _stub_generation_t {
+    tai_generation_t group[TAI_ATTR_GROUP_MAX];
+    uint64_t         sample;    /**< Telemetry sample the state generation covers */
+} stub_generation_t;
+
+/** @brief Groups as a bitmap */
+#define STUB_GROUP(group)   (1U << (group))
+#define STUB_GROUPS_ALL     (STUB_GROUP(TAI_ATTR_GROUP_MAX) - 1)
+
+/**
+ * @brief The generations of the objects, indexed like the registry: the
+ *        module, then its host interfaces, then its network interfaces
+ */
+static stub_generation_t stub_generations[TAI_MAX_MODULES][1 + 2 * STUB_MAX_INTERFACES];
+static tai_generation_t  stub_generation_seq = 0;
+static pthread_mutex_t   stub_generation_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/**
+ * @brief Find the generations of an object
+ *
+ * @param [in] object_id The object id, already validated
+ *
+ * @return The generations of the object
+ */
+static stub_generation_t *stub_generation_slot(_In_ tai_object_id_t object_id)
+{
+    stub_generation_t *mod = stub_generations[STUB_OID_MODULE_INDEX(object_id)];
+
+    switch (STUB_OID_TYPE(object_id)) {
+        case TAI_OBJECT_TYPE_HOSTIF:
+            return &mod[1 + STUB_OID_IF_INDEX(object_id)];
+        case TAI_OBJECT_TYPE_NETWORKIF:
+            return &mod[1 + STUB_MAX_INTERFACES + STUB_OID_IF_INDEX(object_id)];
+        default:
+            return &mod[0];
+    }
+}
+
+/**
+ * @brief Check whether an object type has simulated telemetry attributes
+ */
+static bool stub_sim_has_telemetry(_In_ tai_object_type_t object_type)
+{
+    size_t i;
+
+    for (i = 0; i < sizeof(stub_sim_attrs)/sizeof(stub_sim_attrs[0]); i++) {
+        if (stub_sim_attrs[i].object_type == object_type) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Move attribute groups of an object to a new generation
+ *
+ * @param [in] object_id The object id
+ * @param [in] groups The groups which changed, a bitmap of STUB_GROUP()
+ */
+static void stub_generation_bump(
+    _In_ tai_object_id_t object_id,
+    _In_ uint32_t        groups)
+{
+    stub_generation_t *gen;
+    uint32_t group;
+
+    if (!stub_object_valid(object_id, STUB_OID_TYPE(object_id))) {
+        return;
+    }
+    gen = stub_generation_slot(object_id);
+    pthread_mutex_lock(&stub_generation_lock);
+    stub_generation_seq++;
+    for (group = 0; group < TAI_ATTR_GROUP_MAX; group++) {
+        if (groups & STUB_GROUP(group)) {
+            gen->group[group] = stub_generation_seq;
+        }
+    }
+    if (groups & STUB_GROUP(TAI_ATTR_GROUP_STATE)) {
+        gen->sample = stub_clock_ns(CLOCK_REALTIME) / STUB_SIM_SAMPLE_NS;
+    }
+    pthread_mutex_unlock(&stub_generation_lock);
+}
+
+/**
+ * @brief Read the generations of an object
+ *
+ * The state generation of an object with telemetry moves on with each new
+ * sample of the simulated hardware, when it is read.
+ *
+ * @param [in,out] generation The object, and its generations
+ */
+static void stub_generation_read(_Inout_ tai_object_generation_t *generation)
+{
+    tai_object_id_t object_id = generation->object_id;
+    tai_object_type_t object_type = STUB_OID_TYPE(object_id);
+    stub_generation_t *gen;
+    uint64_t sample;
+    uint32_t group;
+
+    memset(generation, 0, sizeof(*generation));
+    generation->object_id = object_id;
+    if (!stub_object_valid(object_id, object_type)) {
+        return;
+    }
+    gen = stub_generation_slot(object_id);
+    sample = stub_clock_ns(CLOCK_REALTIME) / STUB_SIM_SAMPLE_NS;
+    pthread_mutex_lock(&stub_generation_lock);
+    for (group = 0; group < TAI_ATTR_GROUP_MAX; group++) {
+        /* objects restored by a warm start have no generation yet */
+        if ((0 == gen->group[group]) ||
+            ((TAI_ATTR_GROUP_STATE == group) && (sample != gen->sample) &&
+             stub_sim_has_telemetry(object_type))) {
+            gen->group[group] = ++stub_generation_seq;
+            if (TAI_ATTR_GROUP_STATE == group) {
+                gen->sample = sample;
+            }
+        }
+        generation->group_generation[group] = gen->group[group];
+        if (gen->group[group] > generation->generation) {
+            generation->generation = gen->group[group];
+        }
+    }
+    pthread_mutex_unlock(&stub_generation_lock);
+}
+
+/**
+ * @brief Read the change generations of objects
+ *
+ * @param [in] object_count Number of objects
+ * @param [in,out] generations The objects and their generations
+ *
+ * @return TAI_STATUS_SUCCESS on success, failure status code on error
+ */
+static tai_status_t stub_get_object_generations(
+    _In_ uint32_t                    object_count,
+    _Inout_ tai_object_generation_t *generations)
+{
+    uint32_t idx;
+
+    if ((0 != object_count) && (NULL == generations)) {
+        return TAI_STATUS_INVALID_PARAMETER;
+    }
+    for (idx = 0; idx < object_count; idx++) {
+        stub_generation_read(&generations[idx]);
+    }
+    return TAI_STATUS_SUCCESS;
+}
+
+/**
+ * @brief Retrieve a list of attribute values if one of their groups changed
+ *        since a generation, without accessing the hardware otherwise
+ *
+ * @param [in] object_type The type of the object
+ * @param [in] get_fn The attribute list get function of the object type
+ * @param [in] object_id The object id
+ * @param [in] generation The generation of the previous read, 0 to read
+ * @param [out] current_generation The latest generation of the groups
+ * @param [in] attr_count A count of the number of elements in the attr_list
+ * @param [in,out] attr_list A list of attributes to be retrieved
+ *
+ * @return TAI_STATUS_SUCCESS if the attributes were read,
+ *         TAI_STATUS_NOT_MODIFIED if they did not change, failure status code
+ *         on error
+ */
+static tai_status_t stub_get_attributes_if_changed(
+    _In_ tai_object_type_t       object_type,
+    _In_ stub_get_attributes_fn  get_fn,
+    _In_ tai_object_id_t         object_id,
+    _In_ tai_generation_t        generation,
+    _Out_ tai_generation_t      *current_generation,
+    _In_ uint32_t                attr_count,
+    _Inout_ tai_attribute_t     *attr_list)
+{
+    tai_object_generation_t gen = { .object_id = object_id };
+    const tai_attr_metadata_t *meta;
+    tai_generation_t latest = 0;
+    uint32_t idx, group;
+
+    if ((NULL == current_generation) || ((0 != attr_count) && (NULL == attr_list))) {
+        return TAI_STATUS_INVALID_PARAMETER;
+    }
+    if (!stub_object_valid(object_id, object_type)) {
+        return TAI_STATUS_INVALID_OBJECT_ID;
+    }
+    stub_generation_read(&gen);
+    for (idx = 0; idx < attr_count; idx++) {
+        meta = tai_metadata_get_attr_metadata(object_type, attr_list[idx].id);
+        if (NULL == meta) {
+            return convert_tai_error_to_list(TAI_STATUS_ATTR_NOT_SUPPORTED_0, idx);
+        }
+        group = TAI_META_IS_READ_ONLY(meta) ? TAI_ATTR_GROUP_STATE : TAI_ATTR_GROUP_CONFIG;
+        if (gen.group_generation[group] > latest) {
+            latest = gen.group_generation[group];
+        }
+    }
+    *current_generation = latest;
+    if ((0 != generation) && (latest <= generation)) {
+        return TAI_STATUS_NOT_MODIFIED;
+    }
+    return get_fn(object_id, attr_count, attr_list);
+}
+
+
+/*------------------------------------------------------------------------------
+
+                              Simulated Buses
+
+------------------------------------------------------------------------------*/
+
+/**
+ * @brief Sleep for a simulated hardware time
+ */
+static void stub_delay(_In_ uint32_t delay_ms)
+{
+    struct timespec ts;
+
+    if (0 == delay_ms) {
+        return;
+    }
+    ts.tv_sec = delay_ms / 1000;
+    ts.tv_nsec = (delay_ms % 1000) * 1000000L;
+    while ((0 != nanosleep(&ts, &ts)) && (EINTR == errno));
+}
+
+/** @brief The shape of a delay distribution */
+typedef enum _stub_latency_kind_t {
+    STUB_LATENCY_NONE,
+    STUB_LATENCY_FIXED,     /**< "fixed:US", always min_us */
+    STUB_LATENCY_UNIFORM,   /**< "uniform:MIN:MAX", evenly spread */
+    STUB_LATENCY_TAIL,      /**< "tail:MIN:MAX", Pareto from min_us, cut at
+                                 max_us: the median is 1.6 times min_us and
+                                 one access in a hundred takes over 20 times */
+} stub_latency_kind_t;
+
+/** @brief A delay distribution, in microseconds */
+typedef struct _stub_latency_t {
+    stub_latency_kind_t kind;
+    uint32_t            min_us;
+    uint32_t            max_us;
+} stub_latency_t;
+
+/** @brief The hardware operations */
+typedef enum _stub_latency_op_t {
+    STUB_LATENCY_GET,
+    STUB_LATENCY_SET,
+    STUB_LATENCY_CREATE,
+    STUB_LATENCY_REMOVE,
+    STUB_LATENCY_OP_MAX
+} stub_latency_op_t;
+
+#define STUB_MAX_BUSES          TAI_MAX_MODULES
+#define STUB_LATENCY_MAX_ATTRS  32
+
+/**
+ * @brief The latency model of the management buses
+ *
+ * An access of the simulated hardware takes the delay of its operation
+ * (TAI_STUB_LATENCY_GET, _SET, _CREATE and _REMOVE), plus the delay of each
+ * attribute it reads or writes (TAI_STUB_LATENCY_ATTRS), plus the delay of
+ * the bus of the module. TAI_STUB_GET_DELAY_MS and TAI_STUB_SET_DELAY_MS
+ * give a fixed delay of gets and sets in milliseconds. With TAI_STUB_NUM_BUSES
+ * buses, the module of
+ * registry slot i sits on bus (i % TAI_STUB_NUM_BUSES) and an access holds
+ * its bus for its whole duration, so that the modules sharing a bus wait for
+ * each other. TAI_STUB_LATENCY_BUS gives the delay of every bus and
+ * TAI_STUB_LATENCY_BUS<n> that of bus n. The model is read at initialization
+ * and costs nothing when no delay is given.
+ */
+static stub_latency_t  stub_latency_ops[STUB_LATENCY_OP_MAX];
+static stub_latency_t  stub_latency_buses[STUB_MAX_BUSES];
+static uint32_t        stub_num_buses = 0;
+static bool            stub_latency_enabled = false;
+static uint32_t        stub_latency_seed = 0;
+static uint32_t        stub_latency_threads = 0;
+static __thread unsigned int stub_latency_rand;
+static __thread bool   stub_latency_seeded = false;
+static pthread_mutex_t stub_bus_locks[STUB_MAX_BUSES] = {
+    [0 ... STUB_MAX_BUSES - 1] = PTHREAD_MUTEX_INITIALIZER
+};
+
+/** @brief The attributes whose access takes longer, TAI_STUB_LATENCY_ATTRS */
+static struct {
+    tai_object_type_t object_type;
+    tai_attr_id_t     attr_id;
+    stub_latency_t    latency;
+} stub_latency_attrs[STUB_LATENCY_MAX_ATTRS];
+static uint32_t stub_latency_attr_count = 0;
+
+/**
+ * @brief Parse a delay distribution, "fixed:US", "uniform:MIN:MAX" or
+ *        "tail:MIN:MAX"
+ *
+ * @param [in] str The distribution
+ * @param [out] latency The parsed distribution
+ *
+ * @return true if the distribution is valid
+ */
+static bool stub_latency_parse(
+    _In_ const char      *str,
+    _Out_ stub_latency_t *latency)
+{
+    unsigned int min, max;
+    int end = 0;
+
+    if ((1 == sscanf(str, "fixed:%u%n", &min, &end)) && ('\0' == str[end])) {
+        latency->kind = STUB_LATENCY_FIXED;
+        max = min;
+    } else if ((2 == sscanf(str, "uniform:%u:%u%n", &min, &max, &end)) &&
+               ('\0' == str[end]) && (min <= max)) {
+        latency->kind = STUB_LATENCY_UNIFORM;
+    } else if ((2 == sscanf(str, "tail:%u:%u%n", &min, &max, &end)) &&
+               ('\0' == str[end]) && (min <= max)) {
+        latency->kind = STUB_LATENCY_TAIL;
+    } else {
+        return false;
+    }
+    latency->min_us = min;
+    latency->max_us = max;
+    if (0 == max) {
+        latency->kind = STUB_LATENCY_NONE;
+    }
+    return true;
+}
+
+/**
+ * @brief Read a delay distribution from the environment
+ *
+ * @param [in] name The name of the environment variable
+ * @param [in,out] latency The distribution, unchanged if the variable is not
+ *        set or is invalid
+ */
+static void stub_latency_env(
+    _In_ const char        *name,
+    _Inout_ stub_latency_t *latency)
+{
+    const char *str = stub_getenv(name);
+
+    if ((NULL != str) && ('\0' != *str) && !stub_latency_parse(str, latency)) {
+        TAI_SYSLOG_WARN("Ignoring invalid %s value %s", name, str);
+    }
+}
+
+/**
+ * @brief Look an attribute up by its name in the environment, "TYPE.ATTR"
+ *        where TYPE is module, hostif or netif and ATTR is the short name of
+ *        the attribute
+ *
+ * @param [in] type The TYPE part
+ * @param [in] attr The ATTR part
+ *
+ * @return The metadata of the attribute, NULL if unknown
+ */
+static const tai_attr_metadata_t *stub_attr_by_name(
+    _In_ const char *type,
+    _In_ const char *attr)
+{
+    static const struct {
+        const char        *name;
+        tai_object_type_t  object_type;
+    } types[] = {
+        { "module", TAI_OBJECT_TYPE_MODULE },
+        { "hostif", TAI_OBJECT_TYPE_HOSTIF },
+        { "netif",  TAI_OBJECT_TYPE_NETWORKIF },
+    };
+    uint32_t idx;
+
+    for (idx = 0; idx < sizeof(types) / sizeof(types[0]); idx++) {
+        if (0 == strcmp(type, types[idx].name)) {
+            return tai_metadata_get_attr_metadata_by_short_name(types[idx].object_type, attr);
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Read the attribute delays, a comma separated list of
+ *        "TYPE.ATTR=DISTRIBUTION", see stub_attr_by_name(), e.g.
+ *        "netif.current-ber=tail:200:20000"
+ */
+static void stub_latency_attrs_env(void)
+{
+    const char *str = stub_getenv("TAI_STUB_LATENCY_ATTRS");
+    const tai_attr_metadata_t *meta;
+    char *list, *entry, *save = NULL, *attr, *dist;
+
+    stub_latency_attr_count = 0;
+    if ((NULL == str) || ('\0' == *str) || (NULL == (list = strdup(str)))) {
+        return;
+    }
+    for (entry = strtok_r(list, ",", &save); NULL != entry; entry = strtok_r(NULL, ",", &save)) {
+        attr = strchr(entry, '.');
+        dist = strchr(entry, '=');
+        if ((NULL == attr) || (NULL == dist) || (dist < attr)) {
+            TAI_SYSLOG_WARN("Ignoring invalid attribute delay %s", entry);
+            continue;
+        }
+        *attr++ = '\0';
+        *dist++ = '\0';
+        meta = stub_attr_by_name(entry, attr);
+        if (NULL == meta) {
+            TAI_SYSLOG_WARN("Ignoring the delay of unknown attribute %s.%s", entry, attr);
+            continue;
+        }
+        if (stub_latency_attr_count == STUB_LATENCY_MAX_ATTRS) {
+            TAI_SYSLOG_WARN("Ignoring the delays of more than %u attributes",
+                            STUB_LATENCY_MAX_ATTRS);
+            break;
+        }
+        if (!stub_latency_parse(dist, &stub_latency_attrs[stub_latency_attr_count].latency)) {
+            TAI_SYSLOG_WARN("Ignoring invalid delay %s of %s.%s", dist, entry, attr);
+            continue;
+        }
+        stub_latency_attrs[stub_latency_attr_count].object_type = meta->objecttype;
+        stub_latency_attrs[stub_latency_attr_count].attr_id = meta->attrid;
+        stub_latency_attr_count++;
+    }
+    free(list);
+}
+
+/**
+ * @brief Read the latency model from the environment, called by
+ *        tai_api_initialize()
+ */
+static void stub_latency_init(void)
+{
+    static const char *op_names[STUB_LATENCY_OP_MAX] = {
+        [STUB_LATENCY_GET]    = "TAI_STUB_LATENCY_GET",
+        [STUB_LATENCY_SET]    = "TAI_STUB_LATENCY_SET",
+        [STUB_LATENCY_CREATE] = "TAI_STUB_LATENCY_CREATE",
+        [STUB_LATENCY_REMOVE] = "TAI_STUB_LATENCY_REMOVE",
+    };
+    uint32_t get_us = stub_env_u32("TAI_STUB_GET_DELAY_MS", 0) * 1000;
+    uint32_t set_us = stub_env_u32("TAI_STUB_SET_DELAY_MS", 0) * 1000;
+    stub_latency_t bus = { STUB_LATENCY_NONE, 0, 0 };
+    char name[32];
+    uint32_t idx;
+
+    memset(stub_latency_ops, 0, sizeof(stub_latency_ops));
+    if (0 != get_us) {
+        stub_latency_ops[STUB_LATENCY_GET] = (stub_latency_t){ STUB_LATENCY_FIXED, get_us, get_us };
+    }
+    if (0 != set_us) {
+        stub_latency_ops[STUB_LATENCY_SET] = (stub_latency_t){ STUB_LATENCY_FIXED, set_us, set_us };
+    }
+    for (idx = 0; idx < STUB_LATENCY_OP_MAX; idx++) {
+        stub_latency_env(op_names[idx], &stub_latency_ops[idx]);
+    }
+    stub_latency_attrs_env();
+
+    stub_num_buses = stub_env_u32("TAI_STUB_NUM_BUSES", 0);
+    if (stub_num_buses > STUB_MAX_BUSES) {
+        TAI_SYSLOG_WARN("Limiting the simulated buses to %u", STUB_MAX_BUSES);
+        stub_num_buses = STUB_MAX_BUSES;
+    }
+    stub_latency_env("TAI_STUB_LATENCY_BUS", &bus);
+    for (idx = 0; idx < STUB_MAX_BUSES; idx++) {
+        stub_latency_buses[idx] = bus;
+        snprintf(name, sizeof(name), "TAI_STUB_LATENCY_BUS%u", idx);
+        stub_latency_env(name, &stub_latency_buses[idx]);
+    }
+    stub_latency_seed = stub_env_u32("TAI_STUB_LATENCY_SEED", 1);
+
+    stub_latency_enabled = (0 != stub_num_buses) || (0 != stub_latency_attr_count);
+    for (idx = 0; idx < STUB_LATENCY_OP_MAX; idx++) {
+        stub_latency_enabled |= (STUB_LATENCY_NONE != stub_latency_ops[idx].kind);
+    }
+}
+
+/**
+ * @brief Draw a delay from a distribution
+ *
+ * @param [in] latency The distribution
+ *
+ * @return The delay in microseconds
+ */
+static uint32_t stub_latency_sample(_In_ const stub_latency_t *latency)
+{
+    double u, us;
+
+    switch (latency->kind) {
+        case STUB_LATENCY_FIXED:
+            return latency->min_us;
+        case STUB_LATENCY_UNIFORM:
+            return latency->min_us +
+                   rand_r(&stub_latency_rand) % (latency->max_us - latency->min_us + 1);
+        case STUB_LATENCY_TAIL:
+            u = (rand_r(&stub_latency_rand) + 1.0) / (RAND_MAX + 1.0);
+            us = latency->min_us * pow(u, -1.0 / 1.5);
+            return (us < latency->max_us) ? (uint32_t)us : latency->max_us;
+        default:
+            return 0;
+    }
+}
+
+/**
+ * @brief Spend the time of a hardware access on the bus of the object
+ *
+ * @param [in] op The operation
+ * @param [in] object_id The object accessed
+ * @param [in] attr_count The number of attributes accessed
+ * @param [in] attr_list The attributes accessed
+ */
+static void stub_latency(
+    _In_ stub_latency_op_t      op,
+    _In_ tai_object_id_t        object_id,
+    _In_ uint32_t               attr_count,
+    _In_ const tai_attribute_t *attr_list)
+{
+    tai_object_type_t object_type = STUB_OID_TYPE(object_id);
+    pthread_mutex_t *bus_lock = NULL;
+    struct timespec ts;
+    uint64_t us;
+    uint32_t idx, a, bus;
+
+    if (!stub_latency_enabled) {
+        return;
+    }
+    if (!stub_latency_seeded) {
+        stub_latency_rand = stub_latency_seed +
+                            __atomic_fetch_add(&stub_latency_threads, 1, __ATOMIC_RELAXED);
+        stub_latency_seeded = true;
+    }
+    us = stub_latency_sample(&stub_latency_ops[op]);
+    for (a = 0; a < stub_latency_attr_count; a++) {
+        if (stub_latency_attrs[a].object_type != object_type) {
+            continue;
+        }
+        for (idx = 0; idx < attr_count; idx++) {
+            if (attr_list[idx].id == stub_latency_attrs[a].attr_id) {
+                us += stub_latency_sample(&stub_latency_attrs[a].latency);
+            }
+        }
+    }
+    if (0 != stub_num_buses) {
+        bus = STUB_OID_MODULE_INDEX(object_id) % stub_num_buses;
+        us += stub_latency_sample(&stub_latency_buses[bus]);
+        bus_lock = &stub_bus_locks[bus];
+        pthread_mutex_lock(bus_lock);
+    }
+    ts.tv_sec = us / 1000000;
+    ts.tv_nsec = (us % 1000000) * 1000L;
+    while ((0 != nanosleep(&ts, &ts)) && (EINTR == errno));
+    if (NULL != bus_lock) {
+        pthread_mutex_unlock(bus_lock);
+    }
+}
+
+/**
+ * @brief The attributes whose hardware writes fail, TAI_STUB_FAIL_ATTRS, a
+ *        comma separated list of "TYPE.ATTR", see stub_attr_by_name()
+ *
+ * A write of one of them fails as a whole with TAI_STATUS_FAILURE, which
+ * lets a test break a transaction commit part-way through.
+ */
+static struct {
+    tai_object_type_t object_type;
+    tai_attr_id_t     attr_id;
+} stub_fail_attrs[STUB_LATENCY_MAX_ATTRS];
+static uint32_t stub_fail_attr_count = 0;
+
+/**
+ * @brief Read the failing attributes from the environment, called by
+ *        tai_api_initialize()
+ */
+static void stub_fail_init(void)
+{
+    const char *str = stub_getenv("TAI_STUB_FAIL_ATTRS");
+    const tai_attr_metadata_t *meta;
+    char *list, *entry, *save = NULL, *attr;
+
+    stub_fail_attr_count = 0;
+    if ((NULL == str) || ('\0' == *str) || (NULL == (list = strdup(str)))) {
+        return;
+    }
+    for (entry = strtok_r(list, ",", &save); NULL != entry; entry = strtok_r(NULL, ",", &save)) {
+        attr = strchr(entry, '.');
+        meta = NULL;
+        if (NULL != attr) {
+            *attr++ = '\0';
+            meta = stub_attr_by_name(entry, attr);
+        }
+        if (NULL == meta) {
+            TAI_SYSLOG_WARN("Ignoring unknown failing attribute %s", entry);
+            continue;
+        }
+        if (stub_fail_attr_count == STUB_LATENCY_MAX_ATTRS) {
+            TAI_SYSLOG_WARN("Ignoring more than %u failing attributes", STUB_LATENCY_MAX_ATTRS);
+            break;
+        }
+        stub_fail_attrs[stub_fail_attr_count].object_type = meta->objecttype;
+        stub_fail_attrs[stub_fail_attr_count].attr_id = meta->attrid;
+        stub_fail_attr_count++;
+    }
+    free(list);
+}
+
+/**
+ * @brief Check whether a hardware write fails, see stub_fail_init()
+ *
+ * @param [in] object_type The type of the object written
+ * @param [in] attr_count The number of attributes written
+ * @param [in] attr_list The attributes written
+ *
+ * @return true if one of the attributes is a failing attribute
+ */
+static bool stub_fail_write(
+    _In_ tai_object_type_t      object_type,
+    _In_ uint32_t               attr_count,
+    _In_ const tai_attribute_t *attr_list)
+{
+    uint32_t a, idx;
+
+    for (a = 0; a < stub_fail_attr_count; a++) {
+        if (stub_fail_attrs[a].object_type != object_type) {
+            continue;
+        }
+        for (idx = 0; idx < attr_count; idx++) {
+            if (attr_list[idx].id == stub_fail_attrs[a].attr_id) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+
+/*------------------------------------------------------------------------------
+
+                                Module Workers
+
+------------------------------------------------------------------------------*/
+
+/**
+ * @brief The threading model of the adapter
+ *
+ * Each module slot has a worker thread with a queue of work, started by the
+ * first access to the slot. The hardware accesses to a module and to its
+ * interfaces, reads, writes, creation and removal, are queued to the worker
+ * of the module and run in order, the caller waiting for its own. The
+ * accesses to a module are thus serialized, like on the management interface
+ * of a real module, while the accesses to different modules run in parallel,
+ * whichever host threads make them. The asynchronous requests, and the
+ * objects of a bulk set or get in TAI_BULK_OP_ERROR_MODE_IGNORE_ERROR mode,
+ * are queued without waiting, so that a single host thread drives every
+ * module at once.
+ *
+ * The rest of the adapter, the registry, the attribute store, the
+ * generations, the transactions, the subscriptions and the thresholds, is
+ * protected by locks of its own. Every function of the method tables may
+ * thus be called from several host threads at once, between
+ * tai_api_initialize() and tai_api_uninitialize(). The samples of the
+ * subscriptions, the thresholds, the performance monitoring and the
+ * snapshots are hardware reads too, queued to the worker of their module.
+ *
+ * A worker runs the accesses it makes to its own module, from a completion
+ * callback for instance, right away, and queues those to other modules like
+ * any thread. While it waits for them it keeps running its own queue, so
+ * that two workers waiting for each other can not deadlock.
+ */
+
+typedef struct _stub_worker_t stub_worker_t;
+
+/** @brief The completion of the work a call queued, see stub_work_wait() */
+typedef struct _stub_waiter_t {
+    pthread_mutex_t lock;
+    pthread_cond_t  cond;
+    uint32_t        pending;    /**< Work queued and not completed yet */
+    stub_worker_t  *worker;     /**< The worker waiting, NULL for a host thread */
+} stub_waiter_t;
+
+#define STUB_WAITER_INIT { PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, 0, NULL }
+
+typedef struct _stub_work_t stub_work_t;
+
+/**
+ * @brief Run a work on the worker of its module
+ *
+ * @param [in,out] work The work
+ *
+ * @return The status of the work
+ */
+typedef tai_status_t (*stub_work_fn)(_Inout_ stub_work_t *work);
+
+/** @brief A work for a module worker, each function uses the fields it needs */
+struct _stub_work_t {
+    stub_work_fn            fn;
+    tai_object_type_t       object_type;
+    tai_object_id_t         object_id;      /**< Routes the work to its module */
+    stub_set_attributes_fn  set_fn;
+    stub_get_attributes_fn  get_fn;
+    uint32_t                attr_count;
+    const tai_attribute_t  *in;
+    tai_attribute_t        *inout;
+    uint64_t                now_ns;         /**< The sampling time of a sample */
+    tai_status_t            status;         /**< Set by the worker */
+    stub_waiter_t          *waiter;         /**< NULL for a work completing itself */
+    stub_work_t            *next;
+};
+
+/** @brief The worker of a module slot */
+struct _stub_worker_t {
+    pthread_t       thread;
+    bool            started;
+    bool            stopping;
+    pthread_mutex_t lock;
+    pthread_cond_t  cond;
+    stub_work_t    *head;
+    stub_work_t    *tail;
+};
+
+static stub_worker_t stub_workers[TAI_MAX_MODULES] = {
+    [0 ... TAI_MAX_MODULES - 1] = {
+        .lock = PTHREAD_MUTEX_INITIALIZER,
+        .cond = PTHREAD_COND_INITIALIZER
+    }
+};
+/** @brief The worker of the calling thread, NULL on a host thread */
+static __thread stub_worker_t *stub_current_worker = NULL;
+
+/**
+ * @brief Take the next work of a worker's queue, with the worker locked
+ *
+ * @param [in,out] worker The worker
+ *
+ * @return The work, NULL if the queue is empty
+ */
+static stub_work_t *stub_worker_pop(_Inout_ stub_worker_t *worker)
+{
+    stub_work_t *work = worker->head;
+
+    if ((NULL != work) && (NULL == (worker->head = work->next))) {
+        worker->tail = NULL;
+    }
+    return work;
+}
+
+/**
+ * @brief Run a work of the queue and complete it in its waiter
+ *
+ * @param [in,out] work The work
+ */
+static void stub_worker_run(_Inout_ stub_work_t *work)
+{
+    /* a work completing itself may be freed by its function */
+    stub_waiter_t *waiter = work->waiter;
+    stub_worker_t *waiting = NULL;
+    tai_status_t status;
+
+    status = work->fn(work);
+    if (NULL == waiter) {
+        return;
+    }
+    pthread_mutex_lock(&waiter->lock);
+    work->status = status;
+    if (0 == --waiter->pending) {
+        pthread_cond_signal(&waiter->cond);
+        waiting = waiter->worker;
+    }
+    pthread_mutex_unlock(&waiter->lock);
+
+    /* a waiting worker sleeps on its queue, see stub_work_wait() */
+    if (NULL != waiting) {
+        pthread_mutex_lock(&waiting->lock);
+        pthread_cond_signal(&waiting->cond);
+        pthread_mutex_unlock(&waiting->lock);
+    }
+}
+
+/**
+ * @brief The worker of a module slot, runs its queue in order
+ *
+ * @param [in] arg The worker
+ *
+ * @return NULL
+ */
+static void *stub_worker_main(_In_ void *arg)
+{
+    stub_worker_t *worker = arg;
+    stub_work_t *work;
+
+    stub_current_worker = worker;
+    pthread_mutex_lock(&worker->lock);
+    for (;;) {
+        while ((NULL == worker->head) && !worker->stopping) {
+            pthread_cond_wait(&worker->cond, &worker->lock);
+        }
+        if (NULL == (work = stub_worker_pop(worker))) {
+            break;
+        }
+        pthread_mutex_unlock(&worker->lock);
+        stub_worker_run(work);
+        pthread_mutex_lock(&worker->lock);
+    }
+    pthread_mutex_unlock(&worker->lock);
+    return NULL;
+}
+
+/**
+ * @brief Tell whether a work is for the module of the calling worker, which
+ *        runs it right away instead of queuing it to itself
+ *
+ * @param [in] work The work
+ *
+ * @return true if the calling thread is the worker of the module of the work
+ */
+static bool stub_work_is_local(_In_ const stub_work_t *work)
+{
+    return (NULL != stub_current_worker) &&
+           (STUB_OID_PREFIX(work->object_id) == stub_id_prefix) &&
+           (STUB_OID_MODULE_INDEX(work->object_id) < TAI_MAX_MODULES) &&
+           (&stub_workers[STUB_OID_MODULE_INDEX(work->object_id)] == stub_current_worker);
+}
+
+/**
+ * @brief Queue a work to the worker of its module, starting the worker if
+ *        needed
+ *
+ * @param [in,out] work The work, valid until completed
+ *
+ * @return TAI_STATUS_SUCCESS if the work was queued, failure status code on
+ *         error
+ */
+static tai_status_t stub_work_queue(_Inout_ stub_work_t *work)
+{
+    uint16_t module_index = STUB_OID_MODULE_INDEX(work->object_id);
+    stub_worker_t *worker;
+    int err;
+
+    if ((STUB_OID_PREFIX(work->object_id) != stub_id_prefix) ||
+        (module_index >= TAI_MAX_MODULES)) {
+        return TAI_STATUS_INVALID_OBJECT_ID;
+    }
+    worker = &stub_workers[module_index];
+    work->next = NULL;
+    pthread_mutex_lock(&worker->lock);
+    if (!worker->started) {
+        worker->stopping = false;
+        err = pthread_create(&worker->thread, NULL, stub_worker_main, worker);
+        if (0 != err) {
+            pthread_mutex_unlock(&worker->lock);
+            TAI_SYSLOG_ERROR("Failed to start the worker of module %u: %s", module_index,
+                             strerror(err));
+            return TAI_STATUS_INSUFFICIENT_RESOURCES;
+        }
+        worker->started = true;
+    }
+    if (NULL == worker->tail) {
+        worker->head = work;
+    } else {
+        worker->tail->next = work;
+    }
+    worker->tail = work;
+    pthread_cond_signal(&worker->cond);
+    pthread_mutex_unlock(&worker->lock);
+    return TAI_STATUS_SUCCESS;
+}
+
+/**
+ * @brief Queue a work completed in a waiter, see stub_work_wait()
+ *
+ * @param [in,out] waiter The waiter of the caller
+ * @param [in,out] work The work, valid until completed
+ *
+ * @return TAI_STATUS_SUCCESS if the work was queued, failure status code on
+ *         error
+ */
+static tai_status_t stub_work_submit(
+    _Inout_ stub_waiter_t *waiter,
+    _Inout_ stub_work_t   *work)
+{
+    tai_status_t ret;
+
+    work->waiter = waiter;
+    pthread_mutex_lock(&waiter->lock);
+    waiter->worker = stub_current_worker;
+    waiter->pending++;
+    pthread_mutex_unlock(&waiter->lock);
+    ret = stub_work_queue(work);
+    if (TAI_STATUS_SUCCESS != ret) {
+        pthread_mutex_lock(&waiter->lock);
+        waiter->pending--;
+        pthread_mutex_unlock(&waiter->lock);
+    }
+    return ret;
+}
+
+/**
+ * @brief Tell whether a waiter still has work pending
+ */
+static bool stub_work_pending(_In_ stub_waiter_t *waiter)
+{
+    bool pending;
+
+    pthread_mutex_lock(&waiter->lock);
+    pending = (0 != waiter->pending);
+    pthread_mutex_unlock(&waiter->lock);
+    return pending;
+}
+
+/**
+ * @brief Wait for every work submitted in a waiter, then release the waiter
+ *
+ * A worker keeps running its own queue meanwhile, the works it waits for may
+ * be waiting for it. It sleeps on its queue, locked before the waiter, and
+ * stub_worker_run() wakes it up once the waiter completes.
+ *
+ * @param [in,out] waiter The waiter of the caller
+ */
+static void stub_work_wait(_Inout_ stub_waiter_t *waiter)
+{
+    stub_worker_t *worker = stub_current_worker;
+    stub_work_t *work;
+
+    if (NULL == worker) {
+        pthread_mutex_lock(&waiter->lock);
+        while (0 != waiter->pending) {
+            pthread_cond_wait(&waiter->cond, &waiter->lock);
+        }
+        pthread_mutex_unlock(&waiter->lock);
+    } else {
+        pthread_mutex_lock(&worker->lock);
+        while (stub_work_pending(waiter)) {
+            if (NULL != (work = stub_worker_pop(worker))) {
+                pthread_mutex_unlock(&worker->lock);
+                stub_worker_run(work);
+                pthread_mutex_lock(&worker->lock);
+            } else {
+                pthread_cond_wait(&worker->cond, &worker->lock);
+            }
+        }
+        pthread_mutex_unlock(&worker->lock);
+    }
+    pthread_mutex_destroy(&waiter->lock);
+    pthread_cond_destroy(&waiter->cond);
+}
+
+/**
+ * @brief Run a work on the worker of its module and wait for it, or right
+ *        away when called from that worker
+ *
+ * @param [in,out] work The work
+ *
+ * @return The status of the work
+ */
+static tai_status_t stub_work_run(_Inout_ stub_work_t *work)
+{
+    stub_waiter_t waiter = STUB_WAITER_INIT;
+    tai_status_t ret;
+
+    if (stub_work_is_local(work)) {
+        return work->fn(work);
+    }
+    ret = stub_work_submit(&waiter, work);
+    stub_work_wait(&waiter);
+    if (TAI_STATUS_SUCCESS != ret) {
+        return ret;
+    }
+    return work->status;
+}
+
+/**
+ * @brief Set or get the attributes of a work, with its set or get function
+ */
+static tai_status_t stub_work_attributes(_Inout_ stub_work_t *work)
+{
+    if (NULL != work->set_fn) {
+        return work->set_fn(work->object_id, work->attr_count, work->in);
+    }
+    return work->get_fn(work->object_id, work->attr_count, work->inout);
+}
+
+/**
+ * @brief Sample the simulated value of an attribute of a work
+ */
+static tai_status_t stub_work_sample_attribute(_Inout_ stub_work_t *work)
+{
+    if (!stub_sample_attribute(work->object_type, work->object_id, work->now_ns,
+                               work->inout)) {
+        return TAI_STATUS_ATTR_NOT_SUPPORTED_0;
+    }
+    return TAI_STATUS_SUCCESS;
+}
+
+/**
+ * @brief Sample the simulated value of a read-only attribute on the worker of
+ *        its module, see stub_sample_attribute()
+ *
+ * @param [in] object_type The type of the object
+ * @param [in] object_id The object id
+ * @param [in] now_ns The sampling time in nanoseconds
+ * @param [in,out] attr The attribute to be filled, zeroed on failure
+ *
+ * @return true if the attribute was sampled
+ */
+static bool stub_work_sample(
+    _In_ tai_object_type_t   object_type,
+    _In_ tai_object_id_t     object_id,
+    _In_ uint64_t            now_ns,
+    _Inout_ tai_attribute_t *attr)
+{
+    stub_work_t work = {
+        .fn = stub_work_sample_attribute,
+        .object_type = object_type,
+        .object_id = object_id,
+        .inout = attr,
+        .now_ns = now_ns
+    };
+
+    if (TAI_STATUS_SUCCESS != stub_work_run(&work)) {
+        memset(&attr->value, 0, sizeof(attr->value));
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Set or get attribute lists on a list of objects, each on the worker
+ *        of its module, so that the modules are accessed in parallel
+ *
+ * @param [in] set_fn The single object attribute list set function, NULL for
+ *             a get
+ * @param [in] get_fn The single object attribute list get function, NULL for
+ *             a set
+ * @param [in] object_count The number of objects
+ * @param [in] object_id The object ids
+ * @param [in] attr_count The number of attributes for each object
+ * @param [in] in_list The attribute list for each object, for a set
+ * @param [in,out] inout_list The attribute list for each object, for a get
+ * @param [out] object_statuses The status of each object
+ *
+ * @return TAI_STATUS_SUCCESS if every object succeeded, TAI_STATUS_FAILURE if
+ *         any of them failed
+ */
+static tai_status_t stub_work_bulk(
+    _In_ stub_set_attributes_fn   set_fn,
+    _In_ stub_get_attributes_fn   get_fn,
+    _In_ uint32_t                 object_count,
+    _In_ const tai_object_id_t   *object_id,
+    _In_ const uint32_t          *attr_count,
+    _In_ const tai_attribute_t  **in_list,
+    _In_ tai_attribute_t        **inout_list,
+    _Out_ tai_status_t           *object_statuses)
+{
+    stub_waiter_t waiter = STUB_WAITER_INIT;
+    tai_status_t ret = TAI_STATUS_SUCCESS;
+    tai_status_t status;
+    stub_work_t *works;
+    uint32_t idx;
+
+    works = calloc(object_count, sizeof(*works));
+    if (NULL == works) {
+        return TAI_STATUS_NO_MEMORY;
+    }
+    for (idx = 0; idx < object_count; idx++) {
+        works[idx].fn = stub_work_attributes;
+        works[idx].object_id = object_id[idx];
+        works[idx].set_fn = set_fn;
+        works[idx].get_fn = get_fn;
+        works[idx].attr_count = attr_count[idx];
+        works[idx].in = (NULL != in_list) ? in_list[idx] : NULL;
+        works[idx].inout = (NULL != inout_list) ? inout_list[idx] : NULL;
+        if (stub_work_is_local(&works[idx])) {
+            works[idx].status = stub_work_attributes(&works[idx]);
+            continue;
+        }
+        /* once queued, the status belongs to the worker until completed */
+        status = stub_work_submit(&waiter, &works[idx]);
+        if (TAI_STATUS_SUCCESS != status) {
+            works[idx].status = status;
+        }
+    }
+    stub_work_wait(&waiter);
+    for (idx = 0; idx < object_count; idx++) {
+        object_statuses[idx] = works[idx].status;
+        if (TAI_STATUS_SUCCESS != works[idx].status) {
+            ret = TAI_STATUS_FAILURE;
+        }
+    }
+    free(works);
+    return ret;
+}
+
+/**
+ * @brief Stop the workers, once their queues are empty
+ */
+static void stub_workers_stop(void)
+{
+    stub_worker_t *worker;
+    uint32_t idx;
+
+    for (idx = 0; idx < TAI_MAX_MODULES; idx++) {
+        worker = &stub_workers[idx];
+        pthread_mutex_lock(&worker->lock);
+        if (!worker->started) {
+            pthread_mutex_unlock(&worker->lock);
+            continue;
+        }
+        worker->stopping = true;
+        pthread_cond_signal(&worker->cond);
+        pthread_mutex_unlock(&worker->lock);
+        pthread_join(worker->thread, NULL);
+        worker->started = false;
+    }
+}
+
+
+/*------------------------------------------------------------------------------
+
+                           Asynchronous Operations
+
+------------------------------------------------------------------------------*/
+
+/**
+ * @brief Tell the adapter host that the tributary mapping of a module may have
+ *        changed
+ *
+ * The mapping is derived from the interfaces of the module as well, so its
+ * configuration moves to a new generation on an interface create or remove.
+ *
+ * @param [in] object_id The module or one of its interfaces
+ */
+static void stub_notify_tributary_mapping_change(_In_ tai_object_id_t object_id)
+{
+    /* the interface may be removed already, which tai_module_id_query() refuses */
+    tai_object_id_t module_id = STUB_OID(TAI_OBJECT_TYPE_MODULE, STUB_OID_MODULE_INDEX(object_id),
+                                         0, STUB_OID_GENERATION(object_id));
+    tai_module_notification_t notifications;
+
+    stub_generation_bump(module_id, STUB_GROUP(TAI_ATTR_GROUP_CONFIG));
+    if (stub_registry_get_notifications(object_id, &notifications) &&
+        (NULL != notifications.tributary_mapping_change)) {
+        notifications.tributary_mapping_change(module_id);
+    }
+}
+
+/** @brief Worker side of stub_hw_write() */
+static tai_status_t stub_hw_write_work(_Inout_ stub_work_t *work)
+{
+    tai_object_type_t object_type = work->object_type;
+    tai_object_id_t object_id = work->object_id;
+    uint32_t attr_count = work->attr_count;
+    const tai_attribute_t *attr_list = work->in;
+    uint32_t idx;
+    tai_status_t ret;
+
+    stub_latency(STUB_LATENCY_SET, object_id, attr_count, attr_list);
+    /* the object may have been removed meanwhile */
+    if (!stub_object_valid(object_id, object_type)) {
+        return TAI_STATUS_INVALID_OBJECT_ID;
+    }
+    if (stub_fail_write(object_type, attr_count, attr_list)) {
+        return TAI_STATUS_FAILURE;
+    }
+    /* a write may change other attributes of the object, as the modulation
+     * format does the tributary mapping */
+    stub_cache_invalidate(object_id, false);
+    ret = stub_store_write(object_id, attr_count, attr_list);
+    if (TAI_STATUS_SUCCESS != ret) {
+        return ret;
+    }
+    /* a new configuration may change the state of the object as well */
+    stub_generation_bump(object_id, STUB_GROUPS_ALL);
+    for (idx = 0; idx < attr_count; idx++) {
+        if (((TAI_OBJECT_TYPE_NETWORKIF == object_type) &&
+             (TAI_NETWORK_INTERFACE_ATTR_MODULATION_FORMAT == attr_list[idx].id)) ||
+            ((TAI_OBJECT_TYPE_MODULE == object_type) &&
+             (TAI_MODULE_ATTR_TRIBUTARY_MAPPING == attr_list[idx].id))) {
+            stub_notify_tributary_mapping_change(object_id);
+            break;
+        }
+    }
+    return TAI_STATUS_SUCCESS;
+}
+
+/**
+ * @brief Write attributes of an object to the simulated hardware, as a single
+ *        hardware operation on the worker of its module, see stub_latency()
+ *
+ * @param [in] object_type The type of the object
+ * @param [in] object_id The object id
+ * @param [in] attr_count The number of attributes written together
+ * @param [in] attr_list The attributes, already validated
+ *
+ * @return TAI_STATUS_SUCCESS on success, failure status code on error
+ */
+static tai_status_t stub_hw_write(
+    _In_ tai_object_type_t      object_type,
+    _In_ tai_object_id_t        object_id,
+    _In_ uint32_t               attr_count,
+    _In_ const tai_attribute_t *attr_list)
+{
+    stub_work_t work = {
+        .fn = stub_hw_write_work, .object_type = object_type, .object_id = object_id,
+        .attr_count = attr_count, .in = attr_list
+    };
+
+    return stub_work_run(&work);
+}
+
+/** @brief Worker side of stub_hw_read() */
+static tai_status_t stub_hw_read_work(_Inout_ stub_work_t *work)
+{
+    tai_status_t ret;
+
+    stub_latency(STUB_LATENCY_GET, work->object_id, work->attr_count, work->inout);
+    ret = stub_get_object_attributes(work->object_type, work->object_id,
+                                     work->attr_count, work->inout);
+    if (TAI_STATUS_SUCCESS == ret) {
+        stub_cache_fill(work->object_type, work->object_id, work->attr_count, work->inout);
+    }
+    return ret;
+}
+
+/**
+ * @brief Read attributes of an object from the simulated hardware, as a
+ *        single hardware operation on the worker of its module. The
+ *        attributes found in the cache are served by the calling thread and
+ *        only the others are read, see stub_cache_get().
+ *
+ * @param [in] object_type The type of the object
+ * @param [in] object_id The object id
+ * @param [in] attr_count The number of attributes read together
+ * @param [in,out] attr_list The attributes to be retrieved
+ *
+ * @return TAI_STATUS_SUCCESS on success, failure status code on error
+ */
+static tai_status_t stub_hw_read(
+    _In_ tai_object_type_t   object_type,
+    _In_ tai_object_id_t     object_id,
+    _In_ uint32_t            attr_count,
+    _Inout_ tai_attribute_t *attr_list)
+{
+    stub_work_t work = {
+        .fn = stub_hw_read_work, .object_type = object_type, .object_id = object_id,
+        .attr_count = attr_count, .inout = attr_list
+    };
+    tai_attribute_t *misses = NULL;
+    uint32_t *index = NULL;
+    uint32_t idx, pos, count = 0;
+    uint64_t now_ns;
+    tai_status_t ret, err;
+
+    if (!stub_cache_enabled || !stub_object_valid(object_id, object_type)) {
+        return stub_work_run(&work);
+    }
+    if (attr_count > 1) {
+        misses = malloc(attr_count * (sizeof(*misses) + sizeof(*index)));
+        if (NULL == misses) {
+            return stub_work_run(&work);
+        }
+        index = (uint32_t *)&misses[attr_count];
+    }
+    now_ns = stub_clock_ns(CLOCK_MONOTONIC);
+    for (idx = 0; idx < attr_count; idx++) {
+        if (stub_cache_get(object_type, object_id, now_ns, &attr_list[idx])) {
+            continue;
+        }
+        if (NULL != misses) {
+            misses[count] = attr_list[idx];
+            index[count] = idx;
+        }
+        count++;
+    }
+    if ((0 == count) || (attr_count == count)) {
+        free(misses);
+        return count ? stub_work_run(&work) : TAI_STATUS_SUCCESS;
+    }
+
+    work.attr_count = count;
+    work.inout = misses;
+    ret = stub_work_run(&work);
+    for (idx = 0; idx < count; idx++) {
+        attr_list[index[idx]] = misses[idx];
+    }
+    /* the status of an attribute gives its index in the list of the misses */
+    if (stub_status_list_index(ret, count, &err, &pos)) {
+        ret = convert_tai_error_to_list(err, index[pos]);
+    }
+    free(misses);
+    return ret;
+}
+
+/** @brief Worker side of stub_hw_create() */
+static tai_status_t stub_hw_create_work(_Inout_ stub_work_t *work)
+{
+    stub_latency(STUB_LATENCY_CREATE, work->object_id, work->attr_count, work->in);
+    return stub_store_write(work->object_id, work->attr_count, work->in);
+}
+
+/**
+ * @brief Initialize a new object of the registry in the simulated hardware,
+ *        on the worker of its module
+ *
+ * @param [in] object_id The new object
+ * @param [in] attr_count The number of attributes given on create
+ * @param [in] attr_list The attributes given on create, already validated
+ *
+ * @return TAI_STATUS_SUCCESS on success, failure status code on error
+ */
+static tai_status_t stub_hw_create(
+    _In_ tai_object_id_t        object_id,
+    _In_ uint32_t               attr_count,
+    _In_ const tai_attribute_t *attr_list)
+{
+    stub_work_t work = {
+        .fn = stub_hw_create_work, .object_id = object_id, .attr_count = attr_count,
+        .in = attr_list
+    };
+
+    return stub_work_run(&work);
+}
+
+/** @brief Worker side of stub_hw_remove() */
+static tai_status_t stub_hw_remove_work(_Inout_ stub_work_t *work)
+{
+    tai_status_t ret;
+
+    stub_latency(STUB_LATENCY_REMOVE, work->object_id, 0, NULL);
+    if (TAI_OBJECT_TYPE_MODULE == work->object_type) {
+        ret = stub_registry_remove_module(work->object_id);
+        if (TAI_STATUS_SUCCESS == ret) {
+            stub_cache_flush(work->object_id);
+        }
+        return ret;
+    }
+    ret = stub_registry_remove_interface(work->object_type, work->object_id);
+    if (TAI_STATUS_SUCCESS == ret) {
+        stub_cache_invalidate(work->object_id, true);
+    }
+    return ret;
+}
+
+/**
+ * @brief Shut an object down in the simulated hardware and remove it from
+ *        the registry, on the worker of its module, after the accesses
+ *        queued before
+ *
+ * @param [in] object_type The type of the object
+ * @param [in] object_id The object id
+ *
+ * @return TAI_STATUS_SUCCESS on success, failure status code on error
+ */
+static tai_status_t stub_hw_remove(
+    _In_ tai_object_type_t object_type,
+    _In_ tai_object_id_t   object_id)
+{
+    stub_work_t work = {
+        .fn = stub_hw_remove_work, .object_type = object_type, .object_id = object_id
+    };
+
+    return stub_work_run(&work);
+}
+
+/**
+ * @brief A queued asynchronous set or get, a work completing itself whose
+ *        set_fn or get_fn is NULL for a get or a set
+ */
+typedef struct _stub_async_request_t {
+    stub_work_t             work;       /**< First, see stub_async_run() */
+    tai_async_request_id_t  id;
+    tai_async_completion_fn completion;
+    void                   *context;
+} stub_async_request_t;
+
+static pthread_mutex_t        stub_async_lock    = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t         stub_async_idle    = PTHREAD_COND_INITIALIZER;
+static uint32_t               stub_async_pending = 0;
+static tai_async_request_id_t stub_async_seq     = 0;
+
+/**
+ * @brief Run an asynchronous request and report its completion
+ *
+ * Each request runs on the worker of its module, after the accesses queued
+ * before, so requests to different modules proceed in parallel like
+ * independent hardware would.
+ *
+ * @param [in,out] work The request, freed
+ *
+ * @return The status of the request
+ */
+static tai_status_t stub_async_run(_Inout_ stub_work_t *work)
+{
+    stub_async_request_t *req = (stub_async_request_t *)work;
+    tai_status_t status;
+
+    status = stub_work_attributes(work);
+    req->completion(req->id, req->context, status, work->attr_count,
+                    (NULL != work->set_fn) ? work->in : work->inout);
+    free(req);
+
+    pthread_mutex_lock(&stub_async_lock);
+    if (0 == --stub_async_pending) {
+        pthread_cond_broadcast(&stub_async_idle);
+    }
+    pthread_mutex_unlock(&stub_async_lock);
+    return status;
+}
+
+/**
+ * @brief Queue an asynchronous set or get
+ *
+ * @param [in] set_fn The set function, NULL for a get
+ * @param [in] get_fn The get function, NULL for a set
+ * @param [in] object_id The object id
+ * @param [in] attr_count The number of attributes in the list
+ * @param [in] attr_list The attributes, valid until the completion
+ * @param [in] completion The completion callback
+ * @param [in] context The context passed to the completion callback
+ * @param [out] request_id The request id
+ *
+ * @return TAI_STATUS_SUCCESS if the request was queued, failure status code on
+ *         error
+ */
+static tai_status_t stub_async_submit(
+    _In_ stub_set_attributes_fn   set_fn,
+    _In_ stub_get_attributes_fn   get_fn,
+    _In_ tai_object_id_t          object_id,
+    _In_ uint32_t                 attr_count,
+    _In_ tai_attribute_t         *attr_list,
+    _In_ tai_async_completion_fn  completion,
+    _In_ void                    *context,
+    _Out_ tai_async_request_id_t *request_id)
+{
+    stub_async_request_t *req;
+    tai_status_t ret;
+
+    if ((0 == attr_count) || (NULL == attr_list) ||
+        (NULL == completion) || (NULL == request_id)) {
+        return TAI_STATUS_INVALID_PARAMETER;
+    }
+    req = calloc(1, sizeof(*req));
+    if (NULL == req) {
+        return TAI_STATUS_NO_MEMORY;
+    }
+    req->work.fn         = stub_async_run;
+    req->work.object_id  = object_id;
+    req->work.set_fn     = set_fn;
+    req->work.get_fn     = get_fn;
+    req->work.attr_count = attr_count;
+    req->work.in         = attr_list;
+    req->work.inout      = attr_list;
+    req->completion      = completion;
+    req->context         = context;
+
+    pthread_mutex_lock(&stub_async_lock);
+    req->id = stub_id_prefix | ++stub_async_seq;
+    stub_async_pending++;
+    pthread_mutex_unlock(&stub_async_lock);
+    *request_id = req->id;
+
+    ret = stub_work_queue(&req->work);
+    if (TAI_STATUS_SUCCESS != ret) {
+        free(req);
+        pthread_mutex_lock(&stub_async_lock);
+        if (0 == --stub_async_pending) {
+            pthread_cond_broadcast(&stub_async_idle);
+        }
+        pthread_mutex_unlock(&stub_async_lock);
+    }
+    return ret;
+}
+
+/**
+ * @brief Wait until every asynchronous request has completed
+ */
+static void stub_async_wait_all(void)
+{
+    pthread_mutex_lock(&stub_async_lock);
+    while (0 != stub_async_pending) {
+        pthread_cond_wait(&stub_async_idle, &stub_async_lock);
+    }
+    pthread_mutex_unlock(&stub_async_lock);
+}
+
+
+/*------------------------------------------------------------------------------
+
+                                Module Presence
+
+------------------------------------------------------------------------------*/
+
+/**
+ * @brief The simulated chassis: TAI_STUB_CHASSIS_SLOTS slots at locations "1"
+ *        to "N" (TAI_STUB_PRESENCE_BURST slots by default, at most
+ *        TAI_MAX_MODULES). Modules are found in the first
+ *        TAI_STUB_PRESENCE_BURST slots at boot, each taking
+ *        TAI_STUB_ENUM_DELAY_MS to be detected. The stub announces no module
+ *        by default. A module adapter numbers its slots after the location
+ *        base given by the platform adapter.
+ *
+ * After the boot burst the chassis keeps changing when asked to, from the
+ * presence thread like the interrupts of real hardware:
+ * - every TAI_STUB_CHURN_MS on average, a module is inserted into or removed
+ *   from a random slot. The slots are drawn from TAI_STUB_CHASSIS_SEED, so
+ *   that a run can be reproduced.
+ * - every TAI_STUB_FLAP_MS (100 by default), the modules of the last
+ *   TAI_STUB_FLAP_SLOTS slots are all removed, or inserted again, and
+ *   announced together: a presence storm.
+ *
+ * A removed module stays registered until the adapter host removes it.
+ */
+static uint32_t  stub_chassis_slots = 0;
+static uint32_t  stub_location_base = 0;
+static uint32_t  stub_presence_burst = 0;
+static uint32_t  stub_presence_enum_ms = 0;
+static uint32_t  stub_presence_churn_ms = 0;
+static uint32_t  stub_presence_flap_slots = 0;
+static uint32_t  stub_presence_flap_ms = 0;
+static uint32_t  stub_presence_seed = 0;
+static pthread_t stub_presence_thread;
+static bool      stub_presence_started = false;
+static bool      stub_presence_stopping = false;
+static pthread_mutex_t stub_presence_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t  stub_presence_cond = PTHREAD_COND_INITIALIZER;
+
+/** @brief The registry was restored by a warm start, see stub_warm_restore() */
+static bool      stub_presence_warm = false;
+
+/** @brief Locations of the slots, "1" to "TAI_MAX_MODULES" after the base */
+static char stub_presence_locations[TAI_MAX_MODULES][12];
+
+/** @brief The slots holding a module, owned by the presence thread */
+static bool stub_presence_present[TAI_MAX_MODULES];
+
+/**
+ * @brief Report presence changes to the adapter host, with a single call of
+ *        module_presence_batch if the host provides it
+ *
+ * @param [in] count The number of events
+ * @param [in] events The events
+ */
+static void stub_presence_notify(
+    _In_ uint32_t                           count,
+    _In_ const tai_module_presence_event_t *events)
+{
+    uint32_t idx;
+
+    if (0 == count) {
+        return;
+    }
+    if (NULL != adapter_host_fns.module_presence_batch) {
+        adapter_host_fns.module_presence_batch(count, events);
+        return;
+    }
+    if (NULL != adapter_host_fns.module_presence) {
+        for (idx = 0; idx < count; idx++) {
+            adapter_host_fns.module_presence(events[idx].present,
+                                             events[idx].module_location);
+        }
+    }
+}
+
+/**
+ * @brief Insert a module into a slot, or remove the module of a slot
+ *
+ * @param [in] slot The slot
+ * @param [out] event The presence change
+ */
+static void stub_presence_toggle(
+    _In_ uint32_t                      slot,
+    _Out_ tai_module_presence_event_t *event)
+{
+    stub_presence_present[slot] = !stub_presence_present[slot];
+    event->present = stub_presence_present[slot];
+    event->module_location = stub_presence_locations[slot];
+}
+
+/**
+ * @brief Change the chassis on the schedule of TAI_STUB_CHURN_MS and
+ *        TAI_STUB_FLAP_MS, until the adapter is uninitialized
+ */
+static void stub_presence_churn(void)
+{
+    tai_module_presence_event_t events[2 * TAI_MAX_MODULES];
+    uint64_t now_ns, churn_ns = UINT64_MAX, flap_ns = UINT64_MAX, next_ns;
+    uint64_t flap_period_ns = (uint64_t)stub_presence_flap_ms * 1000000ULL;
+    unsigned int seed = stub_presence_seed;
+    struct timespec next;
+    uint32_t slot, count;
+
+    if ((0 == stub_presence_churn_ms) && (0 == stub_presence_flap_slots)) {
+        return;
+    }
+    now_ns = stub_clock_ns(CLOCK_REALTIME);
+    if (0 != stub_presence_churn_ms) {
+        churn_ns = now_ns + (1 + rand_r(&seed) % (2 * stub_presence_churn_ms)) * 1000000ULL;
+    }
+    if (0 != stub_presence_flap_slots) {
+        flap_ns = now_ns + flap_period_ns;
+    }
+
+    pthread_mutex_lock(&stub_presence_lock);
+    while (!stub_presence_stopping) {
+        next_ns = (churn_ns < flap_ns) ? churn_ns : flap_ns;
+        next.tv_sec = next_ns / 1000000000UL;
+        next.tv_nsec = next_ns % 1000000000UL;
+        if (ETIMEDOUT != pthread_cond_timedwait(&stub_presence_cond, &stub_presence_lock, &next)) {
+            continue;
+        }
+
+        now_ns = stub_clock_ns(CLOCK_REALTIME);
+        count = 0;
+        if (now_ns >= churn_ns) {
+            slot = rand_r(&seed) % stub_chassis_slots;
+            stub_presence_toggle(slot, &events[count++]);
+            churn_ns = now_ns + (1 + rand_r(&seed) % (2 * stub_presence_churn_ms)) * 1000000ULL;
+        }
+        if (now_ns >= flap_ns) {
+            for (slot = stub_chassis_slots - stub_presence_flap_slots;
+                 slot < stub_chassis_slots; slot++) {
+                stub_presence_toggle(slot, &events[count++]);
+            }
+            /* a late host skips flaps rather than receiving them back to back */
+            flap_ns += flap_period_ns;
+            if (flap_ns <= now_ns) {
+                flap_ns = now_ns + flap_period_ns;
+            }
+        }
+        pthread_mutex_unlock(&stub_presence_lock);
+        stub_presence_notify(count, events);
+        pthread_mutex_lock(&stub_presence_lock);
+    }
+    pthread_mutex_unlock(&stub_presence_lock);
+}
+
+/**
+ * @brief Announce the modules detected by the enumeration of the simulated
+ *        hardware, together, like a chassis in which every module is found at
+ *        once, then keep changing the chassis if a schedule was given
+ *
+ * After a warm start the restored modules are announced first, without
+ * waiting for the enumeration, so that the adapter host adopts them right
+ * away. The enumeration then reconciles the registry with the hardware in the
+ * background: new modules are announced and restored modules which are gone
+ * are removed and announced absent.
+ */
+static void *stub_presence_generator(_In_ void *arg)
+{
+    static char gone[TAI_MAX_MODULES][TAI_MAX_HARDWARE_ID_LEN];
+    tai_module_presence_event_t events[TAI_MAX_MODULES];
+    bool found[TAI_MAX_MODULES] = { false };
+    uint32_t idx, hw, count = 0;
+    stub_module_t *mod;
+
+    if (stub_presence_warm) {
+        pthread_mutex_lock(&stub_registry_lock);
+        for (idx = 0; idx < TAI_MAX_MODULES; idx++) {
+            if (stub_modules[idx].restored) {
+                strcpy(gone[count], stub_modules[idx].location);
+                events[count].present = true;
+                events[count].module_location = gone[count];
+                count++;
+            }
+        }
+        pthread_mutex_unlock(&stub_registry_lock);
+        TAI_SYSLOG_INFO("Announcing %u restored modules", count);
+        stub_presence_notify(count, events);
+        count = 0;
+    }
+
+    for (hw = 0; hw < stub_presence_burst; hw++) {
+        if (__atomic_load_n(&stub_presence_stopping, __ATOMIC_RELAXED)) {
+            return NULL;
+        }
+        stub_delay(stub_presence_enum_ms);
+        stub_presence_present[hw] = true;
+    }
+
+    pthread_mutex_lock(&stub_registry_lock);
+    for (idx = 0; idx < TAI_MAX_MODULES; idx++) {
+        mod = &stub_modules[idx];
+        if (!stub_presence_warm || (0 == mod->generation)) {
+            continue;
+        }
+        for (hw = 0; hw < stub_presence_burst; hw++) {
+            if (0 == strcmp(mod->location, stub_presence_locations[hw])) {
+                found[hw] = true;
+                break;
+            }
+        }
+        if (hw == stub_presence_burst) {
+            strcpy(gone[count], mod->location);
+            events[count].present = false;
+            events[count].module_location = gone[count];
+            count++;
+            __atomic_store_n(&mod->generation, 0, __ATOMIC_RELEASE);
+            mod->restored = false;
+            mod->hostif_restored = 0;
+            mod->netif_restored = 0;
+        }
+    }
+    pthread_mutex_unlock(&stub_registry_lock);
+    for (hw = 0; hw < stub_presence_burst; hw++) {
+        if (!found[hw]) {
+            events[count].present = true;
+            events[count].module_location = stub_presence_locations[hw];
+            count++;
+        }
+    }
+    TAI_SYSLOG_INFO("Enumerated %u modules, announcing %u changes",
+                    stub_presence_burst, count);
+    stub_presence_notify(count, events);
+
+    stub_presence_churn();
+    return NULL;
+}
+
+/**
+ * @brief Start announcing modules, called by tai_api_initialize()
+ */
+static void stub_presence_start(void)
+{
+    uint32_t slot;
+
+    stub_presence_burst = stub_env_u32("TAI_STUB_PRESENCE_BURST", 0);
+    stub_chassis_slots = stub_env_u32("TAI_STUB_CHASSIS_SLOTS", stub_presence_burst);
+    stub_presence_enum_ms = stub_env_u32("TAI_STUB_ENUM_DELAY_MS", 0);
+    stub_presence_churn_ms = stub_env_u32("TAI_STUB_CHURN_MS", 0);
+    stub_presence_flap_slots = stub_env_u32("TAI_STUB_FLAP_SLOTS", 0);
+    stub_presence_flap_ms = stub_env_u32("TAI_STUB_FLAP_MS", 100);
+    stub_presence_seed = stub_env_u32("TAI_STUB_CHASSIS_SEED", 1);
+    if (stub_chassis_slots > TAI_MAX_MODULES) {
+        TAI_SYSLOG_WARN("Limiting the chassis to %u slots", TAI_MAX_MODULES);
+        stub_chassis_slots = TAI_MAX_MODULES;
+    }
+    if (stub_presence_burst > stub_chassis_slots) {
+        TAI_SYSLOG_WARN("Limiting the presence burst to %u modules", stub_chassis_slots);
+        stub_presence_burst = stub_chassis_slots;
+    }
+    if (stub_presence_flap_slots > stub_chassis_slots) {
+        stub_presence_flap_slots = stub_chassis_slots;
+    }
+    if ((0 == stub_presence_flap_ms) || (0 == stub_chassis_slots)) {
+        stub_presence_flap_slots = 0;
+    }
+    if (0 == stub_chassis_slots) {
+        stub_presence_churn_ms = 0;
+    }
+    for (slot = 0; slot < TAI_MAX_MODULES; slot++) {
+        snprintf(stub_presence_locations[slot], sizeof(stub_presence_locations[slot]),
+                 "%u", stub_location_base + slot + 1);
+        stub_presence_present[slot] = false;
+    }
+    if ((0 == stub_presence_burst) && (0 == stub_presence_churn_ms) &&
+        (0 == stub_presence_flap_slots) && !stub_presence_warm) {
+        return;
+    }
+    stub_presence_stopping = false;
+    stub_presence_started = (0 == pthread_create(&stub_presence_thread, NULL,
+                                                 stub_presence_generator, NULL));
+    if (!stub_presence_started) {
+        TAI_SYSLOG_ERROR("Failed to start the presence thread");
+    }
+}
+
+/**
+ * @brief Stop the enumeration and the changes of the chassis, and wait for
+ *        the announcements to complete, called by tai_api_uninitialize()
+ */
+static void stub_presence_stop(void)
+{
+    if (stub_presence_started) {
+        pthread_mutex_lock(&stub_presence_lock);
+        __atomic_store_n(&stub_presence_stopping, true, __ATOMIC_RELAXED);
+        pthread_cond_signal(&stub_presence_cond);
+        pthread_mutex_unlock(&stub_presence_lock);
+        pthread_join(stub_presence_thread, NULL);
+        stub_presence_started = false;
+        stub_presence_stopping = false;
+    }
+}
+
+
+/*------------------------------------------------------------------------------
+
+                        Host Interface Object Functions
+
+------------------------------------------------------------------------------*/
+
+#undef  __TAI_MODULE__
+#define __TAI_MODULE__ TAI_API_HOSTIF
+
+/**
+ * @brief Retrieve the value of an attribute
+ *
+ * @param [in] host_interface_id The host interface ID handle
+ * @param [in,out] attr A pointer to the attribute to be retrieved
+ *
+ * @return TAI_STATUS_SUCCESS on success, failure status code on error
+ */
+static tai_status_t stub_get_host_interface_attribute(
+    _In_ tai_object_id_t     host_interface_id,
+    _Inout_ tai_attribute_t *attr)
+{
+    TAI_SYSLOG_DEBUG("Retrieving host interface attribute: %d", attr->id);
+    return stub_get_object_attributes(TAI_OBJECT_TYPE_HOSTIF, host_interface_id, 1, attr);
+}
+
+/**
+ * @brief Retrieve an attribute value, as a hardware access of its own
+ *
+ * @param [in] host_interface_id The host interface ID handle
+ * @param [in,out] attr A pointer to the attribute to be retrieved
+ *
+ * @return TAI_STATUS_SUCCESS on success, failure status code on error
+ */
+static tai_status_t stub_read_host_interface_attribute(
+    _In_ tai_object_id_t     host_interface_id,
+    _Inout_ tai_attribute_t *attr)
+{
+    TAI_SYSLOG_DEBUG("Reading host interface attribute: %d", attr->id);
+    return stub_hw_read(TAI_OBJECT_TYPE_HOSTIF, host_interface_id, 1, attr);
+}
+
+/**
+ * @brief Retrieve a list of attribute values
+ *
+ * @param [in] host_interface_id The host interface ID handle
+ * @param [in] attr_count A count of the number of elements in the attr_list
+ * @param [in,out] attr_list A list of attributes to be retrieved
+ *
+ * @return TAI_STATUS_SUCCESS on success, failure status code on error
+ */
+static tai_status_t stub_get_host_interface_attributes(
+    _In_ tai_object_id_t     host_interface_id,
+    _In_ uint32_t            attr_count,
+    _Inout_ tai_attribute_t *attr_list)
+{
+    return stub_hw_read(TAI_OBJECT_TYPE_HOSTIF, host_interface_id, attr_count, attr_list);
+}
+
+/**
+ * @brief Retrieve a list of attribute values, the lists are allocated by the
+ *        adapter
+ *
+ * @param [in] host_interface_id The host interface ID handle
+ * @param [in] attr_count A count of the number of elements in the attr_list
+ * @param [in,out] attr_list A list of attributes to be retrieved
+ *
+ * @return TAI_STATUS_SUCCESS on success, failure status code on error
+ */
+static tai_status_t stub_get_host_interface_attributes_alloc(
+    _In_ tai_object_id_t     host_interface_id,
+    _In_ uint32_t            attr_count,
+    _Inout_ tai_attribute_t *attr_list)
+{
+    return stub_get_attributes_alloc(TAI_OBJECT_TYPE_HOSTIF,
+                                     stub_get_host_interface_attributes,
+                                     host_interface_id, attr_count, attr_list);
+}
+
+/**
+ * @brief Release the lists returned by stub_get_host_interface_attributes_alloc()
+ *
+ * @param [in] attr_count A count of the number of elements in the attr_list
+ * @param [in] attr_list A list of retrieved attributes
+ *
+ * @return TAI_STATUS_SUCCESS on success, failure status code on error
+ */
+static tai_status_t stub_free_host_interface_attributes(
+    _In_ uint32_t         attr_count,
+    _In_ tai_attribute_t *attr_list)
+{
+    return stub_free_attributes(TAI_OBJECT_TYPE_HOSTIF, attr_count, attr_list);
+}
+
+/**
+ * @brief Set the value of an attribute
+ *
+ * @param [in] host_interface_id The host interface ID handle
+ * @param [in] attr A pointer to the attribute to be set
+ *
+ * @return TAI_STATUS_SUCCESS on success, failure status code on error
+ */
+static tai_status_t stub_set_host_interface_attribute(
+   _In_ tai_object_id_t        host_interface_id,
+   _In_ const tai_attribute_t *attr)
+{
+    TAI_SYSLOG_DEBUG("Setting host interface attribute: %d", attr->id);
+    tai_status_t ret;
+
+    if (!stub_object_valid(host_interface_id, TAI_OBJECT_TYPE_HOSTIF)) {
+        return TAI_STATUS_INVALID_OBJECT_ID;
+    }
+    ret = stub_check_attributes(TAI_OBJECT_TYPE_HOSTIF, false, 1, attr);
+    if (TAI_STATUS_SUCCESS != ret) {
+        return ret;
+    }
+    return stub_hw_write(TAI_OBJECT_TYPE_HOSTIF, host_interface_id, 1, attr);
+}
+
+/**
+ * @brief Set the values from a list of attributes, as a single hardware
+ *        operation
+ *
+ * @param [in] host_interface_id The host interface ID handle
+ * @param [in] attr_count A count of the number of elements in the attr_list
+ * @param [in] attr_list A list of attributes to be set
+ *
+ * @return TAI_STATUS_SUCCESS on success, failure status code on error
+ */
+static tai_status_t stub_set_host_interface_attributes(
+   _In_ tai_object_id_t        host_interface_id,
+   _In_ uint32_t               attr_count,
+   _In_ const tai_attribute_t *attr_list)
+{
+    tai_status_t ret;
+
+    if (!stub_object_valid(host_interface_id, TAI_OBJECT_TYPE_HOSTIF)) {
+        return TAI_STATUS_INVALID_OBJECT_ID;
+    }
+    ret = stub_check_attributes(TAI_OBJECT_TYPE_HOSTIF, false, attr_count, attr_list);
+    if (TAI_STATUS_SUCCESS != ret) {
+        return ret;
+    }
+    return stub_hw_write(TAI_OBJECT_TYPE_HOSTIF, host_interface_id, attr_count, attr_list);
+}
+
+/**
+ * @brief Set the values from a list of attributes asynchronously
+ *
+ * @param [in] host_interface_id The host interface ID handle
+ * @param [in] attr_count A count of the number of elements in the attr_list
+ * @param [in] attr_list A list of attributes to be set
+ * @param [in] completion The completion callback
+ * @param [in] context The context passed to the completion callback
+ * @param [out] request_id The request id
+ *
+ * @return TAI_STATUS_SUCCESS if the request was queued, failure status code on
+ *         error
+ */
+static tai_status_t stub_set_host_interface_attributes_async(
+    _In_ tai_object_id_t          host_interface_id,
+    _In_ uint32_t                 attr_count,
+    _In_ const tai_attribute_t   *attr_list,
+    _In_ tai_async_completion_fn  completion,
+    _In_ void                    *context,
+    _Out_ tai_async_request_id_t *request_id)
+{
+    return stub_async_submit(stub_set_host_interface_attributes, NULL, host_interface_id,
+                             attr_count, (tai_attribute_t *)attr_list,
+                             completion, context, request_id);
+}
+
+/**
+ * @brief Retrieve a list of attribute values asynchronously
+ *
+ * @param [in] host_interface_id The host interface ID handle
+ * @param [in] attr_count A count of the number of elements in the attr_list
+ * @param [in,out] attr_list A list of attributes to be retrieved
+ * @param [in] completion The completion callback
+ * @param [in] context The context passed to the completion callback
+ * @param [out] request_id The request id
+ *
+ * @return TAI_STATUS_SUCCESS if the request was queued, failure status code on
+ *         error
+ */
+static tai_status_t stub_get_host_interface_attributes_async(
+    _In_ tai_object_id_t          host_interface_id,
+    _In_ uint32_t                 attr_count,
+    _Inout_ tai_attribute_t      *attr_list,
+    _In_ tai_async_completion_fn  completion,
+    _In_ void                    *context,
+    _Out_ tai_async_request_id_t *request_id)
+{
+    return stub_async_submit(NULL, stub_get_host_interface_attributes, host_interface_id,
+                             attr_count, attr_list, completion, context,
+                             request_id);
+}
+
+/**
+ * @brief Host interface initialization. After the call the capability 
+ *        attributes should be ready for retrieval via
+ *        tai_get_host_interface_attribute().
+ *
+ * @param [out] host_interface_id Handle which identifies the host interface
+ * @param [in] module_id Handle which identifies the module on which the host 
+ *        interface exists
+ * @param [in] attr_count A count of the number of elements in the attr_list
+ * @param [in] attr_list A list of attributes to set during initialization
+ *
+ * @return TAI_STATUS_SUCCESS on success, failure status code on error
+ */
+static tai_status_t stub_create_host_interface(
+    _Out_ tai_object_id_t *host_interface_id,
+    _In_ tai_object_id_t module_id,
+    _In_ uint32_t attr_count,
+    _In_ const tai_attribute_t *attr_list)
+{
+    tai_status_t ret;
+    const tai_attribute_value_t *index;
+
+    ret = stub_check_attributes(TAI_OBJECT_TYPE_HOSTIF, true, attr_count, attr_list);
+    if (TAI_STATUS_SUCCESS != ret) {
+        TAI_SYSLOG_ERROR("Error setting host interface attributes");
+        return ret;
+    }
+
+    index = find_attribute_in_list(TAI_HOST_INTERFACE_ATTR_INDEX, attr_count, attr_list);
+    if (index->u32 >= stub_num_hostifs) {
+        TAI_SYSLOG_ERROR("There is no host interface %u", index->u32);
+        return TAI_STATUS_INVALID_ATTR_VALUE_0;
+    }
+    ret = stub_registry_add_interface(TAI_OBJECT_TYPE_HOSTIF, module_id, index->u32,
+                                      host_interface_id);
+    if (TAI_STATUS_SUCCESS != ret) {
+        TAI_SYSLOG_ERROR("Error creating host interface %u: %d", index->u32, ret);
+        return ret;
+    }
+    ret = stub_hw_create(*host_interface_id, attr_count, attr_list);
+    if (TAI_STATUS_SUCCESS != ret) {
+        TAI_SYSLOG_ERROR("Error setting host interface attributes: %d", ret);
+        stub_registry_remove_interface(TAI_OBJECT_TYPE_HOSTIF, *host_interface_id);
+        return ret;
+    }
+    stub_generation_bump(*host_interface_id, STUB_GROUPS_ALL);
+    stub_notify_tributary_mapping_change(*host_interface_id);
+
+    return TAI_STATUS_SUCCESS;
+}
+
+/**
+ * @brief Release all resources associated with previously created host 
+ *        interface
+ *
+ * @param [in] host_interface_id The host interface ID handle being removed
+ *
+ * @return TAI_STATUS_SUCCESS on success, failure status code on error
+ */
+static tai_status_t stub_remove_host_interface(_In_ tai_object_id_t host_interface_id)
+{
+    tai_status_t ret;
+
+    ret = stub_hw_remove(TAI_OBJECT_TYPE_HOSTIF, host_interface_id);
+    if (TAI_STATUS_SUCCESS == ret) {
+        stub_notify_tributary_mapping_change(host_interface_id);
+    }
+    return ret;
+}
+
+/**
+ * @brief Create a list of host interfaces with a single call
+ *
+ * @param [in] module_id Module id on which the host interfaces exist
+ * @param [in] object_count The number of host interfaces to create
+ * @param [in] attr_count The number of attributes for each host interface
+ * @param [in] attr_list The attribute list for each host interface
+ * @param [in] mode The bulk operation error mode
+ * @param [out] object_id The created host interface ids
+ * @param [out] object_statuses The status of each host interface
+ *
+ * @return TAI_STATUS_SUCCESS on success, failure status code on error
+ */
+static tai_status_t stub_bulk_create_host_interface(
+    _In_ tai_object_id_t          module_id,
+    _In_ uint32_t                 object_count,
+    _In_ const uint32_t          *attr_count,
+    _In_ const tai_attribute_t  **attr_list,
+    _In_ tai_bulk_op_error_mode_t mode,
+    _Out_ tai_object_id_t        *object_id,
+    _Out_ tai_status_t           *object_statuses)
+{
+    return stub_bulk_create(stub_create_host_interface, module_id, object_count,
+                            attr_count, attr_list, mode, object_id,
+                            object_statuses);
+}
+
+/**
+ * @brief Remove a list of host interfaces with a single call
+ *
+ * @param [in] object_count The number of host interfaces to remove
+ * @param [in] object_id The host interface ids
+ * @param [in] mode The bulk operation error mode
+ * @param [out] object_statuses The status of each host interface
+ *
+ * @return TAI_STATUS_SUCCESS on success, failure status code on error
+ */
+static tai_status_t stub_bulk_remove_host_interface(
+    _In_ uint32_t                 object_count,
+    _In_ const tai_object_id_t   *object_id,
+    _In_ tai_bulk_op_error_mode_t mode,
+    _Out_ tai_status_t           *object_statuses)
+{
+    return stub_bulk_remove(stub_remove_host_interface, object_count, object_id, mode,
+                            object_statuses);
+}
+
+/**
+ * @brief Set attribute lists on a list of host interfaces
+ *
+ * @param [in] object_count The number of host interfaces
+ * @param [in] object_id The host interface ids
+ * @param [in] attr_count The number of attributes for each host interface
+ * @param [in] attr_list The attribute list for each host interface
+ * @param [in] mode The bulk operation error mode
+ * @param [out] object_statuses The status of each host interface
+ *
+ * @return TAI_STATUS_SUCCESS on success, failure status code on error
+ */
+static tai_status_t stub_bulk_set_host_interface_attributes(
+    _In_ uint32_t                 object_count,
+    _In_ const tai_object_id_t   *object_id,
+    _In_ const uint32_t          *attr_count,
+    _In_ const tai_attribute_t  **attr_list,
+    _In_ tai_bulk_op_error_mode_t mode,
+    _Out_ tai_status_t           *object_statuses)
+{
+    return stub_bulk_set(stub_set_host_interface_attributes, object_count, object_id,
+                         attr_count, attr_list, mode, object_statuses);
+}
+
+/**
+ * @brief Retrieve attribute lists from a list of host interfaces
+ *
+ * @param [in] object_count The number of host interfaces
+ * @param [in] object_id The host interface ids
+ * @param [in] attr_count The number of attributes for each host interface
+ * @param [in,out] attr_list The attribute list for each host interface
+ * @param [in] mode The bulk operation error mode
+ * @param [out] object_statuses The status of each host interface
+ *
+ * @return TAI_STATUS_SUCCESS on success, failure status code on error
+ */
+static tai_status_t stub_bulk_get_host_interface_attributes(
+    _In_ uint32_t                 object_count,
+    _In_ const tai_object_id_t   *object_id,
+    _In_ const uint32_t          *attr_count,
+    _Inout_ tai_attribute_t     **attr_list,
+    _In_ tai_bulk_op_error_mode_t mode,
+    _Out_ tai_status_t           *object_statuses)
+{
+    return stub_bulk_get(stub_get_host_interface_attributes, object_count, object_id,
+                         attr_count, attr_list, mode, object_statuses);
+}
+
+/**
+ * @brief The host interface functions. This structure is retrieved via the 
+ *        #tai_api_query function.
+ */
+tai_host_interface_api_t stub_host_interface_api = {
+    .create_host_interface               = stub_create_host_interface,
+    .remove_host_interface               = stub_remove_host_interface,
+    .set_host_interface_attribute        = stub_set_host_interface_attribute,
+    .set_host_interface_attributes       = stub_set_host_interface_attributes,
+    .get_host_interface_attribute        = stub_read_host_interface_attribute,
+    .get_host_interface_attributes       = stub_get_host_interface_attributes,
+    .bulk_create_host_interface          = stub_bulk_create_host_interface,
+    .bulk_remove_host_interface          = stub_bulk_remove_host_interface,
+    .bulk_set_host_interface_attributes  = stub_bulk_set_host_interface_attributes,
+    .bulk_get_host_interface_attributes  = stub_bulk_get_host_interface_attributes,
+    .get_host_interface_attributes_alloc = stub_get_host_interface_attributes_alloc,
+    .free_host_interface_attributes      = stub_free_host_interface_attributes,
+    .set_host_interface_attributes_async = stub_set_host_interface_attributes_async,
+    .get_host_interface_attributes_async = stub_get_host_interface_attributes_async
+};
+
+
+/*------------------------------------------------------------------------------
+
+                      Network Interface Object Functions
+
+------------------------------------------------------------------------------*/
+
+#undef  __TAI_MODULE__
+#define __TAI_MODULE__ TAI_API_NETWORKIF
+
+/**
+ * @brief Retrieve the value of an attribute
+ *
+ * @param [in] network_interface_id The network interface ID handle
+ * @param [in,out] attr A pointer to the attribute to be retrieved
+ *
+ * @return TAI_STATUS_SUCCESS on success, failure status code on error
+ */
+static tai_status_t stub_get_network_interface_attribute(
+    _In_ tai_object_id_t     network_interface_id,
+    _Inout_ tai_attribute_t *attr)
+{
+    TAI_SYSLOG_DEBUG("Retrieving network interface attribute: %d", attr->id);
+    return stub_get_object_attributes(TAI_OBJECT_TYPE_NETWORKIF, network_interface_id, 1, attr);
+}
+
+/**
+ * @brief Retrieve an attribute value, as a hardware access of its own
+ *
+ * @param [in] network_interface_id The network interface ID handle
+ * @param [in,out] attr A pointer to the attribute to be retrieved
+ *
+ * @return TAI_STATUS_SUCCESS on success, failure status code on error
+ */
+static tai_status_t stub_read_network_interface_attribute(
+    _In_ tai_object_id_t     network_interface_id,
+    _Inout_ tai_attribute_t *attr)
+{
+    TAI_SYSLOG_DEBUG("Reading network interface attribute: %d", attr->id);
+    return stub_hw_read(TAI_OBJECT_TYPE_NETWORKIF, network_interface_id, 1, attr);
+}
+
+/**
+ * @brief Retrieve a list of attribute values
+ *
+ * @param [in] network_interface_id The network interface ID handle
+ * @param [in] attr_count A count of the number of elements in the attr_list
+ * @param [in,out] attr_list A list of attributes to be retrieved
+ *
+ * @return TAI_STATUS_SUCCESS on success, failure status code on error
+ */
+static tai_status_t stub_get_network_interface_attributes(
+    _In_ tai_object_id_t     network_interface_id,
+    _In_ uint32_t            attr_count,
+    _Inout_ tai_attribute_t *attr_list)
+{
+    return stub_hw_read(TAI_OBJECT_TYPE_NETWORKIF, network_interface_id, attr_count, attr_list);
+}
+
+/**
+ * @brief Retrieve a list of attribute values, the lists are allocated by the
+ *        adapter
+ *
+ * @param [in] network_interface_id The network interface ID handle
+ * @param [in] attr_count A count of the number of elements in the attr_list
+ * @param [in,out] attr_list A list of attributes to be retrieved
+ *
+ * @return TAI_STATUS_SUCCESS on success, failure status code on error
+ */
+static tai_status_t stub_get_network_interface_attributes_alloc(
+    _In_ tai_object_id_t     network_interface_id,
+    _In_ uint32_t            attr_count,
+    _Inout_ tai_attribute_t *attr_list)
+{
+    return stub_get_attributes_alloc(TAI_OBJECT_TYPE_NETWORKIF,
+                                     stub_get_network_interface_attributes,
+                                     network_interface_id, attr_count, attr_list);
+}
+
+/**
+ * @brief Release the lists returned by stub_get_network_interface_attributes_alloc()
+ *
+ * @param [in] attr_count A count of the number of elements in the attr_list
+ * @param [in] attr_list A list of retrieved attributes
+ *
+ * @return TAI_STATUS_SUCCESS on success, failure status code on error
+ */
+static tai_status_t stub_free_network_interface_attributes(
+    _In_ uint32_t         attr_count,
+    _In_ tai_attribute_t *attr_list)
+{
+    return stub_free_attributes(TAI_OBJECT_TYPE_NETWORKIF, attr_count, attr_list);
+}
+
+/**
+ * @brief Set the value of an attribute
+ *
+ * @param [in] network_interface_id The network interface ID handle
+ * @param [in] attr A pointer to the attribute to be set
+ *
+ * @return TAI_STATUS_SUCCESS on success, failure status code on error
+ */
+static tai_status_t stub_set_network_interface_attribute(
+   _In_ tai_object_id_t        network_interface_id,
+   _In_ const tai_attribute_t *attr)
+{
+    TAI_SYSLOG_DEBUG("Setting network interface attribute: %d", attr->id);
+    tai_status_t ret;
+
+    if (!stub_object_valid(network_interface_id, TAI_OBJECT_TYPE_NETWORKIF)) {
+        return TAI_STATUS_INVALID_OBJECT_ID;
+    }
+    ret = stub_check_attributes(TAI_OBJECT_TYPE_NETWORKIF, false, 1, attr);
+    if (TAI_STATUS_SUCCESS != ret) {
+        return ret;
+    }
+    return stub_hw_write(TAI_OBJECT_TYPE_NETWORKIF, network_interface_id, 1, attr);
+}
+
+/**
+ * @brief Set the values from a list of attributes, as a single hardware
+ *        operation
+ *
+ * @param [in] network_interface_id The network interface ID handle
+ * @param [in] attr_count A count of the number of elements in the attr_list
+ * @param [in] attr_list A list of attributes to be set
+ *
+ * @return TAI_STATUS_SUCCESS on success, failure status code on error
+ */
+static tai_status_t stub_set_network_interface_attributes(
+   _In_ tai_object_id_t        network_interface_id,
+   _In_ uint32_t               attr_count,
+   _In_ const tai_attribute_t *attr_list)
+{
+    tai_status_t ret;
+
+    if (!stub_object_valid(network_interface_id, TAI_OBJECT_TYPE_NETWORKIF)) {
+        return TAI_STATUS_INVALID_OBJECT_ID;
+    }
+    ret = stub_check_attributes(TAI_OBJECT_TYPE_NETWORKIF, false, attr_count, attr_list);
+    if (TAI_STATUS_SUCCESS != ret) {
+        return ret;
+    }
+    return stub_hw_write(TAI_OBJECT_TYPE_NETWORKIF, network_interface_id, attr_count, attr_list);
+}
+
+/**
+ * @brief Set the values from a list of attributes asynchronously
+ *
+ * @param [in] network_interface_id The network interface ID handle
+ * @param [in] attr_count A count of the number of elements in the attr_list
+ * @param [in] attr_list A list of attributes to be set
+ * @param [in] completion The completion callback
+ * @param [in] context The context passed to the completion callback
+ * @param [out] request_id The request id
+ *
+ * @return TAI_STATUS_SUCCESS if the request was queued, failure status code on
+ *         error
+ */
+static tai_status_t stub_set_network_interface_attributes_async(
+    _In_ tai_object_id_t          network_interface_id,
+    _In_ uint32_t                 attr_count,
+    _In_ const tai_attribute_t   *attr_list,
+    _In_ tai_async_completion_fn  completion,
+    _In_ void                    *context,
+    _Out_ tai_async_request_id_t *request_id)
+{
+    return stub_async_submit(stub_set_network_interface_attributes, NULL, network_interface_id,
+                             attr_count, (tai_attribute_t *)attr_list,
+                             completion, context, request_id);
+}
+
+/**
+ * @brief Retrieve a list of attribute values asynchronously
+ *
+ * @param [in] network_interface_id The network interface ID handle
+ * @param [in] attr_count A count of the number of elements in the attr_list
+ * @param [in,out] attr_list A list of attributes to be retrieved
+ * @param [in] completion The completion callback
+ * @param [in] context The context passed to the completion callback
+ * @param [out] request_id The request id
+ *
+ * @return TAI_STATUS_SUCCESS if the request was queued, failure status code on
+ *         error
+ */
+static tai_status_t stub_get_network_interface_attributes_async(
+    _In_ tai_object_id_t          network_interface_id,
+    _In_ uint32_t                 attr_count,
+    _Inout_ tai_attribute_t      *attr_list,
+    _In_ tai_async_completion_fn  completion,
+    _In_ void                    *context,
+    _Out_ tai_async_request_id_t *request_id)
+{
+    return stub_async_submit(NULL, stub_get_network_interface_attributes, network_interface_id,
+                             attr_count, attr_list, completion, context,
+                             request_id);
+}
+
+/**
+ * @brief Retrieve a list of attribute values if they changed since a
+ *        generation
+ *
+ * @param [in] network_interface_id The network interface ID handle
+ * @param [in] generation The generation of the previous read, 0 to read
+ * @param [out] current_generation The latest generation of the attributes
+ * @param [in] attr_count A count of the number of elements in the attr_list
+ * @param [in,out] attr_list A list of attributes to be retrieved
+ *
+ * @return TAI_STATUS_SUCCESS if the attributes were read,
+ *         TAI_STATUS_NOT_MODIFIED if they did not change, failure status code
+ *         on error
+ */
+static tai_status_t stub_get_network_interface_attributes_if_changed(
+    _In_ tai_object_id_t     network_interface_id,
+    _In_ tai_generation_t    generation,
+    _Out_ tai_generation_t  *current_generation,
+    _In_ uint32_t            attr_count,
+    _Inout_ tai_attribute_t *attr_list)
+{
+    return stub_get_attributes_if_changed(TAI_OBJECT_TYPE_NETWORKIF, stub_get_network_interface_attributes,
+                                          network_interface_id, generation, current_generation,
+                                          attr_count, attr_list);
+}
+
+/**
+ * @brief Network interface initialization. After the call the capability 
+ *        attributes should be ready for retrieval via
+ *        tai_get_network_interface_attribute().
+ *
+ * @param [out] network_interface_id Handle which identifies the network 
+ *        interface
+ * @param [in] module_id Module id on which the network interface exists
+ * @param [in] attr_count A count of the number of elements in the attr_list
+ * @param [in] attr_list A list of attributes to set during initialization
+ *
+ * @return TAI_STATUS_SUCCESS on success, failure status code on error
+ */
+static tai_status_t stub_create_network_interface(
+    _Out_ tai_object_id_t *network_interface_id,
+    _In_ tai_object_id_t module_id,
+    _In_ uint32_t attr_count,
+    _In_ const tai_attribute_t *attr_list)
+{
+    tai_status_t ret;
+    const tai_attribute_value_t *index;
+
+    ret = stub_check_attributes(TAI_OBJECT_TYPE_NETWORKIF, true, attr_count, attr_list);
+    if (TAI_STATUS_SUCCESS != ret) {
+        TAI_SYSLOG_ERROR("Error setting network interface attributes");
+        return ret;
+    }
+
+    index = find_attribute_in_list(TAI_NETWORK_INTERFACE_ATTR_INDEX, attr_count, attr_list);
+    if (index->u32 >= stub_num_netifs) {
+        TAI_SYSLOG_ERROR("There is no network interface %u", index->u32);
+        return TAI_STATUS_INVALID_ATTR_VALUE_0;
+    }
+    ret = stub_registry_add_interface(TAI_OBJECT_TYPE_NETWORKIF, module_id, index->u32,
+                                      network_interface_id);
+    if (TAI_STATUS_SUCCESS != ret) {
+        TAI_SYSLOG_ERROR("Error creating network interface %u: %d", index->u32, ret);
+        return ret;
+    }
+    ret = stub_hw_create(*network_interface_id, attr_count, attr_list);
+    if (TAI_STATUS_SUCCESS != ret) {
+        TAI_SYSLOG_ERROR("Error setting network interface attributes: %d", ret);
+        stub_registry_remove_interface(TAI_OBJECT_TYPE_NETWORKIF, *network_interface_id);
+        return ret;
+    }
+    stub_generation_bump(*network_interface_id, STUB_GROUPS_ALL);
+    stub_notify_tributary_mapping_change(*network_interface_id);
+
+    return TAI_STATUS_SUCCESS;
+}
+
+/**
+ * @brief Release all resources associated with previously created network 
+ *        interface
+ *
+ * @param [in] network_interface_id The network interface ID handle being 
+ *        removed
+ *
+ * @return TAI_STATUS_SUCCESS on success, failure status code on error
+ */
+static tai_status_t stub_remove_network_interface(_In_ tai_object_id_t network_interface_id)
+{
+    tai_status_t ret;
+
+    ret = stub_hw_remove(TAI_OBJECT_TYPE_NETWORKIF, network_interface_id);
+    if (TAI_STATUS_SUCCESS == ret) {
+        stub_notify_tributary_mapping_change(network_interface_id);
+    }
+    return ret;
+}
+
+/**
+ * @brief Create a list of network interfaces with a single call
+ *
+ * @param [in] module_id Module id on which the network interfaces exist
+ * @param [in] object_count The number of network interfaces to create
+ * @param [in] attr_count The number of attributes for each network interface
+ * @param [in] attr_list The attribute list for each network interface
+ * @param [in] mode The bulk operation error mode
+ * @param [out] object_id The created network interface ids
+ * @param [out] object_statuses The status of each network interface
+ *
+ * @return TAI_STATUS_SUCCESS on success, failure status code on error
+ */
+static tai_status_t stub_bulk_create_network_interface(
+    _In_ tai_object_id_t          module_id,
+    _In_ uint32_t                 object_count,
+    _In_ const uint32_t          *attr_count,
+    _In_ const tai_attribute_t  **attr_list,
+    _In_ tai_bulk_op_error_mode_t mode,
+    _Out_ tai_object_id_t        *object_id,
+    _Out_ tai_status_t           *object_statuses)
+{
+    return stub_bulk_create(stub_create_network_interface, module_id, object_count,
+                            attr_count, attr_list, mode, object_id,
+                            object_statuses);
+}
+
+/**
+ * @brief Remove a list of network interfaces with a single call
+ *
+ * @param [in] object_count The number of network interfaces to remove
+ * @param [in] object_id The network interface ids
+ * @param [in] mode The bulk operation error mode
+ * @param [out] object_statuses The status of each network interface
+ *
+ * @return TAI_STATUS_SUCCESS on success, failure status code on error
+ */
+static tai_status_t stub_bulk_remove_network_interface(
+    _In_ uint32_t                 object_count,
+    _In_ const tai_object_id_t   *object_id,
+    _In_ tai_bulk_op_error_mode_t mode,
+    _Out_ tai_status_t           *object_statuses)
+{
+    return stub_bulk_remove(stub_remove_network_interface, object_count, object_id, mode,
+                            object_statuses);
+}
+
+/**
+ * @brief Set attribute lists on a list of network interfaces
+ *
+ * @param [in] object_count The number of network interfaces
+ * @param [in] object_id The network interface ids
+ * @param [in] attr_count The number of attributes for each network interface
+ * @param [in] attr_list The attribute list for each network interface
+ * @param [in] mode The bulk operation error mode
+ * @param [out] object_statuses The status of each network interface
+ *
+ * @return TAI_STATUS_SUCCESS on success, failure status code on error
+ */
+static tai_status_t stub_bulk_set_network_interface_attributes(
+    _In_ uint32_t                 object_count,
+    _In_ const tai_object_id_t   *object_id,
+    _In_ const uint32_t          *attr_count,
+    _In_ const tai_attribute_t  **attr_list,
+    _In_ tai_bulk_op_error_mode_t mode,
+    _Out_ tai_status_t           *object_statuses)
+{
+    return stub_bulk_set(stub_set_network_interface_attributes, object_count, object_id,
+                         attr_count, attr_list, mode, object_statuses);
+}
+
+/**
+ * @brief Retrieve attribute lists from a list of network interfaces
+ *
+ * @param [in] object_count The number of network interfaces
+ * @param [in] object_id The network interface ids
+ * @param [in] attr_count The number of attributes for each network interface
+ * @param [in,out] attr_list The attribute list for each network interface
+ * @param [in] mode The bulk operation error mode
+ * @param [out] object_statuses The status of each network interface
+ *
+ * @return TAI_STATUS_SUCCESS on success, failure status code on error
+ */
+static tai_status_t stub_bulk_get_network_interface_attributes(
+    _In_ uint32_t                 object_count,
+    _In_ const tai_object_id_t   *object_id,
+    _In_ const uint32_t          *attr_count,
+    _Inout_ tai_attribute_t     **attr_list,
+    _In_ tai_bulk_op_error_mode_t mode,
+    _Out_ tai_status_t           *object_statuses)
+{
+    return stub_bulk_get(stub_get_network_interface_attributes, object_count, object_id,
+                         attr_count, attr_list, mode, object_statuses);
+}
+
+/**
+ * @brief The network interface functions. This structure is retrieved via the 
+ *        #tai_api_query function.
+ */
+tai_network_interface_api_t stub_network_interface_api = {
+    .create_network_interface                    = stub_create_network_interface,
+    .remove_network_interface                    = stub_remove_network_interface,
+    .set_network_interface_attribute             = stub_set_network_interface_attribute,
+    .set_network_interface_attributes            = stub_set_network_interface_attributes,
+    .get_network_interface_attribute             = stub_read_network_interface_attribute,
+    .get_network_interface_attributes            = stub_get_network_interface_attributes,
+    .bulk_create_network_interface               = stub_bulk_create_network_interface,
+    .bulk_remove_network_interface               = stub_bulk_remove_network_interface,
+    .bulk_set_network_interface_attributes       = stub_bulk_set_network_interface_attributes,
+    .bulk_get_network_interface_attributes       = stub_bulk_get_network_interface_attributes,
+    .get_network_interface_attributes_alloc      = stub_get_network_interface_attributes_alloc,
+    .free_network_interface_attributes           = stub_free_network_interface_attributes,
+    .set_network_interface_attributes_async      = stub_set_network_interface_attributes_async,
+    .get_network_interface_attributes_async      = stub_get_network_interface_attributes_async,
+    .get_network_interface_attributes_if_changed = stub_get_network_interface_attributes_if_changed
+};
+
+
+/*------------------------------------------------------------------------------
+
+                                  Transactions
+
+------------------------------------------------------------------------------*/
+
+#undef  __TAI_MODULE__
+#define __TAI_MODULE__ TAI_API_MODULE
+
+static tai_status_t stub_get_module_attribute(
+    _In_ tai_object_id_t     module_id,
+    _Inout_ tai_attribute_t *attr);
+
+/** @brief Single attribute get function of each object type */
+static tai_status_t (*const stub_get_attribute_fns[TAI_OBJECT_TYPE_MAX])(
+    _In_ tai_object_id_t     object_id,
+    _Inout_ tai_attribute_t *attr) = {
+    [TAI_OBJECT_TYPE_MODULE]    = stub_get_module_attribute,
+    [TAI_OBJECT_TYPE_HOSTIF]    = stub_get_host_interface_attribute,
+    [TAI_OBJECT_TYPE_NETWORKIF] = stub_get_network_interface_attribute,
+};
+
+/**
+ * @brief The operations of the simulated hardware, in the order in which a
+ *        commit applies them to an object. The staged attributes of an object
+ *        which need the same operation are written together.
+ */
+typedef enum _stub_hw_op_t {
+    STUB_HW_OP_RETUNE,  /**< Laser and modulation, a single retune */
+    STUB_HW_OP_POWER,   /**< Output power, once the laser is tuned */
+    STUB_HW_OP_CONFIG,  /**< Any other attribute */
+    STUB_HW_OP_ENABLE,  /**< Transmitter and admin state, last */
+} stub_hw_op_t;
+
+/** @brief The maximum number of open transactions */
+#define STUB_MAX_TRANSACTIONS 16
+
+/** @brief A staged attribute set */
+typedef struct _stub_staged_t {
+    tai_object_id_t object_id;
+    stub_hw_op_t    op;
+    tai_attribute_t attr;
+} stub_staged_t;
+
+/** @brief An open transaction, free if id is 0 */
+typedef struct _stub_transaction_t {
+    tai_transaction_id_t id;
+    tai_object_id_t      module_id;
+    uint32_t             count;
+    uint32_t             alloc;
+    stub_staged_t       *staged;
+} stub_transaction_t;
+
+static stub_transaction_t   stub_transactions[STUB_MAX_TRANSACTIONS];
+static tai_transaction_id_t stub_transaction_seq = 0;
+static pthread_mutex_t      stub_transactions_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/**
+ * @brief Get the hardware operation applying an attribute
+ *
+ * @param [in] object_type The type of the object
+ * @param [in] attr_id The attribute id
+ *
+ * @return The operation
+ */
+static stub_hw_op_t stub_hw_op(
+    _In_ tai_object_type_t object_type,
+    _In_ tai_attr_id_t     attr_id)
+{
+    if (TAI_OBJECT_TYPE_NETWORKIF == object_type) {
+        switch (attr_id) {
+            case TAI_NETWORK_INTERFACE_ATTR_TX_GRID_SPACING:
+            case TAI_NETWORK_INTERFACE_ATTR_TX_CHANNEL:
+            case TAI_NETWORK_INTERFACE_ATTR_TX_LASER_FREQ:
+            case TAI_NETWORK_INTERFACE_ATTR_TX_FINE_TUNE_LASER_FREQ:
+            case TAI_NETWORK_INTERFACE_ATTR_MODULATION_FORMAT:
+            case TAI_NETWORK_INTERFACE_ATTR_CHANNEL_FREQ:
+            case TAI_NETWORK_INTERFACE_ATTR_CHANNEL_LAMBDA:
+                return STUB_HW_OP_RETUNE;
+            case TAI_NETWORK_INTERFACE_ATTR_OUTPUT_POWER:
+                return STUB_HW_OP_POWER;
+            case TAI_NETWORK_INTERFACE_ATTR_TX_ENABLE:
+                return STUB_HW_OP_ENABLE;
+        }
+    } else if ((TAI_OBJECT_TYPE_MODULE == object_type) &&
+               (TAI_MODULE_ATTR_ADMIN_STATUS == attr_id)) {
+        return STUB_HW_OP_ENABLE;
+    }
+    return STUB_HW_OP_CONFIG;
+}
+
+/**
+ * @brief Find an open transaction, stub_transactions_lock must be held
+ *
+ * @param [in] transaction_id The transaction id
+ *
+ * @return The transaction, NULL if there is no such transaction
+ */
+static stub_transaction_t *stub_find_transaction(_In_ tai_transaction_id_t transaction_id)
+{
+    uint32_t idx;
+
+    if (0 == transaction_id) {
+        return NULL;
+    }
+    for (idx = 0; idx < STUB_MAX_TRANSACTIONS; idx++) {
+        if (stub_transactions[idx].id == transaction_id) {
+            return &stub_transactions[idx];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Begin a transaction on a module
+ *
+ * @param [out] transaction_id The transaction id
+ * @param [in] module_id The module ID handle
+ *
+ * @return TAI_STATUS_SUCCESS on success, failure status code on error
+ */
+static tai_status_t stub_begin_transaction(
+    _Out_ tai_transaction_id_t *transaction_id,
+    _In_ tai_object_id_t        module_id)
+{
+    stub_transaction_t *txn;
+
+    if (NULL == transaction_id) {
+        return TAI_STATUS_INVALID_PARAMETER;
+    }
+    if (!stub_object_valid(module_id, TAI_OBJECT_TYPE_MODULE)) {
+        return TAI_STATUS_INVALID_OBJECT_ID;
+    }
+    pthread_mutex_lock(&stub_transactions_lock);
+    for (txn = stub_transactions; txn < &stub_transactions[STUB_MAX_TRANSACTIONS]; txn++) {
+        if (0 == txn->id) {
+            break;
+        }
+    }
+    if (txn == &stub_transactions[STUB_MAX_TRANSACTIONS]) {
+        pthread_mutex_unlock(&stub_transactions_lock);
+        TAI_SYSLOG_ERROR("Too many open transactions");
+        return TAI_STATUS_TABLE_FULL;
+    }
+    txn->id = stub_id_prefix | ++stub_transaction_seq;
+    txn->module_id = module_id;
+    txn->count = 0;
+    *transaction_id = txn->id;
+    pthread_mutex_unlock(&stub_transactions_lock);
+    return TAI_STATUS_SUCCESS;
+}
+
+/**
+ * @brief Stage attribute sets in a transaction
+ *
+ * @param [in] transaction_id The transaction id
+ * @param [in] object_id The module of the transaction or one of its interfaces
+ * @param [in] attr_count A count of the number of elements in the attr_list
+ * @param [in] attr_list A list of attribute values to be staged
+ *
+ * @return TAI_STATUS_SUCCESS on success, failure status code on error
+ */
+static tai_status_t stub_stage_attributes(
+    _In_ tai_transaction_id_t   transaction_id,
+    _In_ tai_object_id_t        object_id,
+    _In_ uint32_t               attr_count,
+    _In_ const tai_attribute_t *attr_list)
+{
+    tai_object_type_t object_type = STUB_OID_TYPE(object_id);
+    const tai_attr_metadata_t *meta;
+    stub_transaction_t *txn;
+    stub_staged_t *staged;
+    uint32_t idx, s, alloc;
+    tai_status_t ret;
+
+    if ((0 != attr_count) && (NULL == attr_list)) {
+        return TAI_STATUS_INVALID_PARAMETER;
+    }
+    if ((TAI_OBJECT_TYPE_MAX <= object_type) || !stub_object_valid(object_id, object_type)) {
+        return TAI_STATUS_INVALID_OBJECT_ID;
+    }
+    ret = stub_check_attributes(object_type, false, attr_count, attr_list);
+    if (TAI_STATUS_SUCCESS != ret) {
+        return ret;
+    }
+    for (idx = 0; idx < attr_count; idx++) {
+        meta = tai_metadata_get_attr_metadata(object_type, attr_list[idx].id);
+        if (TAI_META_IS_LIST(meta)) {
+            TAI_SYSLOG_ERROR("List attribute %s can not be staged", meta->attridname);
+            return convert_tai_error_to_list(TAI_STATUS_ATTR_NOT_SUPPORTED_0, idx);
+        }
+    }
+
+    pthread_mutex_lock(&stub_transactions_lock);
+    txn = stub_find_transaction(transaction_id);
+    if (NULL == txn) {
+        pthread_mutex_unlock(&stub_transactions_lock);
+        return TAI_STATUS_ITEM_NOT_FOUND;
+    }
+    if ((STUB_OID_MODULE_INDEX(object_id) != STUB_OID_MODULE_INDEX(txn->module_id)) ||
+        (STUB_OID_GENERATION(object_id) != STUB_OID_GENERATION(txn->module_id))) {
+        pthread_mutex_unlock(&stub_transactions_lock);
+        TAI_SYSLOG_ERROR("Object 0x%lx is not part of module 0x%lx", object_id, txn->module_id);
+        return TAI_STATUS_INVALID_OBJECT_ID;
+    }
+    if (txn->count + attr_count > txn->alloc) {
+        alloc = txn->alloc ? txn->alloc : 16;
+        while (txn->count + attr_count > alloc) {
+            alloc *= 2;
+        }
+        staged = realloc(txn->staged, alloc * sizeof(*staged));
+        if (NULL == staged) {
+            pthread_mutex_unlock(&stub_transactions_lock);
+            return TAI_STATUS_NO_MEMORY;
+        }
+        txn->staged = staged;
+        txn->alloc = alloc;
+    }
+    for (idx = 0; idx < attr_count; idx++) {
+        /* the last value staged for an attribute wins */
+        for (s = 0; s < txn->count; s++) {
+            if ((txn->staged[s].object_id == object_id) &&
+                (txn->staged[s].attr.id == attr_list[idx].id)) {
+                break;
+            }
+        }
+        if (s == txn->count) {
+            txn->count++;
+        }
+        txn->staged[s].object_id = object_id;
+        txn->staged[s].op = stub_hw_op(object_type, attr_list[idx].id);
+        txn->staged[s].attr = attr_list[idx];
+    }
+    pthread_mutex_unlock(&stub_transactions_lock);
+    return TAI_STATUS_SUCCESS;
+}
+
+/**
+ * @brief Order staged sets by object, then by hardware operation
+ */
+static int stub_staged_cmp(_In_ const void *a, _In_ const void *b)
+{
+    const stub_staged_t *sa = a, *sb = b;
+
+    if (sa->object_id != sb->object_id) {
+        return (sa->object_id < sb->object_id) ? -1 : 1;
+    }
+    if (sa->op != sb->op) {
+        return (sa->op < sb->op) ? -1 : 1;
+    }
+    return (sa->attr.id < sb->attr.id) ? -1 : (sa->attr.id > sb->attr.id);
+}
+
+/**
+ * @brief Remove a transaction from the table, stub_transactions_lock must be
+ *        held. The caller frees the staged sets.
+ */
+static void stub_release_transaction(_Inout_ stub_transaction_t *txn)
+{
+    txn->id = 0;
+    txn->count = 0;
+    txn->alloc = 0;
+    txn->staged = NULL;
+}
+
+/**
+ * @brief Apply the sets staged in a transaction, all or none
+ *
+ * The staged sets are sorted by object and by hardware operation, and each
+ * run of sets sharing an object and an operation is written as one hardware
+ * operation. The previous values are read first, and nothing is applied if
+ * one of them can not be read. If a hardware operation fails, the operations
+ * already done are undone in reverse order.
+ *
+ * @param [in] transaction_id The transaction id
+ *
+ * @return TAI_STATUS_SUCCESS on success, failure status code on error
+ */
+static tai_status_t stub_commit_transaction(_In_ tai_transaction_id_t transaction_id)
+{
+    stub_transaction_t *txn;
+    stub_staged_t *staged;
+    tai_attribute_t *attrs = NULL, *prev = NULL;
+    tai_object_type_t object_type;
+    uint32_t count, idx, run, *runs = NULL, nruns = 0;
+    tai_status_t ret = TAI_STATUS_SUCCESS;
+
+    pthread_mutex_lock(&stub_transactions_lock);
+    txn = stub_find_transaction(transaction_id);
+    if (NULL == txn) {
+        pthread_mutex_unlock(&stub_transactions_lock);
+        return TAI_STATUS_ITEM_NOT_FOUND;
+    }
+    staged = txn->staged;
+    count = txn->count;
+    stub_release_transaction(txn);
+    pthread_mutex_unlock(&stub_transactions_lock);
+
+    if (0 == count) {
+        free(staged);
+        return TAI_STATUS_SUCCESS;
+    }
+    qsort(staged, count, sizeof(*staged), stub_staged_cmp);
+    for (idx = 0; idx < count; idx++) {
+        if (!stub_object_valid(staged[idx].object_id, STUB_OID_TYPE(staged[idx].object_id))) {
+            TAI_SYSLOG_ERROR("Object 0x%lx was removed, nothing applied", staged[idx].object_id);
+            ret = TAI_STATUS_INVALID_OBJECT_ID;
+            goto out;
+        }
+    }
+
+    attrs = calloc(count, sizeof(*attrs));
+    prev = calloc(count, sizeof(*prev));
+    runs = calloc(count + 1, sizeof(*runs));
+    if ((NULL == attrs) || (NULL == prev) || (NULL == runs)) {
+        ret = TAI_STATUS_NO_MEMORY;
+        goto out;
+    }
+    for (idx = 0; idx < count; idx++) {
+        object_type = STUB_OID_TYPE(staged[idx].object_id);
+        attrs[idx] = staged[idx].attr;
+        prev[idx].id = staged[idx].attr.id;
+        ret = stub_get_attribute_fns[object_type](staged[idx].object_id, &prev[idx]);
+        if (TAI_STATUS_SUCCESS != ret) {
+            TAI_SYSLOG_ERROR("Failed to read %s of object 0x%lx: %d, nothing applied",
+                             tai_metadata_get_attr_metadata(object_type, prev[idx].id)->attridname,
+                             staged[idx].object_id, ret);
+            goto out;
+        }
+        if ((0 == idx) || (staged[idx].object_id != staged[idx - 1].object_id) ||
+            (staged[idx].op != staged[idx - 1].op)) {
+            runs[nruns++] = idx;
+        }
+    }
+    runs[nruns] = count;
+
+    for (run = 0; run < nruns; run++) {
+        idx = runs[run];
+        object_type = STUB_OID_TYPE(staged[idx].object_id);
+        ret = stub_hw_write(object_type, staged[idx].object_id,
+                            runs[run + 1] - idx, &attrs[idx]);
+        if (TAI_STATUS_SUCCESS != ret) {
+            TAI_SYSLOG_ERROR("Failed to apply transaction %lu: %d, rolling back",
+                             transaction_id, ret);
+            break;
+        }
+    }
+    while ((TAI_STATUS_SUCCESS != ret) && (run-- > 0)) {
+        idx = runs[run];
+        object_type = STUB_OID_TYPE(staged[idx].object_id);
+        if (TAI_STATUS_SUCCESS != stub_hw_write(object_type, staged[idx].object_id,
+                                                runs[run + 1] - idx, &prev[idx])) {
+            TAI_SYSLOG_ERROR("Failed to roll back object 0x%lx", staged[idx].object_id);
+        }
+    }
+    TAI_SYSLOG_DEBUG("Transaction %lu: %u sets in %u hardware operations",
+                     transaction_id, count, nruns);
+
+out:
+    free(runs);
+    free(prev);
+    free(attrs);
+    free(staged);
+    return ret;
+}
+
+/**
+ * @brief Discard the sets staged in a transaction
+ *
+ * @param [in] transaction_id The transaction id
+ *
+ * @return TAI_STATUS_SUCCESS on success, failure status code on error
+ */
+static tai_status_t stub_abort_transaction(_In_ tai_transaction_id_t transaction_id)
+{
+    stub_transaction_t *txn;
+    stub_staged_t *staged;
+
+    pthread_mutex_lock(&stub_transactions_lock);
+    txn = stub_find_transaction(transaction_id);
+    if (NULL == txn) {
+        pthread_mutex_unlock(&stub_transactions_lock);
+        return TAI_STATUS_ITEM_NOT_FOUND;
+    }
+    staged = txn->staged;
+    stub_release_transaction(txn);
+    pthread_mutex_unlock(&stub_transactions_lock);
+    free(staged);
+    return TAI_STATUS_SUCCESS;
+}
+
+/**
+ * @brief Discard every open transaction, called by tai_api_uninitialize()
+ */
+static void stub_abort_all_transactions(void)
+{
+    uint32_t idx;
+
+    pthread_mutex_lock(&stub_transactions_lock);
+    for (idx = 0; idx < STUB_MAX_TRANSACTIONS; idx++) {
+        free(stub_transactions[idx].staged);
+        stub_release_transaction(&stub_transactions[idx]);
+    }
+    pthread_mutex_unlock(&stub_transactions_lock);
+}
+
+
+/*------------------------------------------------------------------------------
+
+                                Threshold Alarms
+
+------------------------------------------------------------------------------*/
+
+#undef  __TAI_MODULE__
+#define __TAI_MODULE__ TAI_API_MODULE
+
+/** @brief The maximum number of monitored attributes */
+#define STUB_MAX_THRESHOLDS 64
+
+/** @brief A monitored attribute, free if object_id is TAI_NULL_OBJECT_ID */
+typedef struct _stub_threshold_t {
+    tai_attribute_threshold_t threshold;
+    bool                      high_raised;
+    bool                      low_raised;
+} stub_threshold_t;
+
+static stub_threshold_t stub_thresholds[STUB_MAX_THRESHOLDS];
+static uint32_t         stub_threshold_count = 0;
+static pthread_t        stub_threshold_thread;
+static bool             stub_threshold_started = false;
+static bool             stub_threshold_stopping = false;
+static pthread_mutex_t  stub_threshold_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t   stub_threshold_cond = PTHREAD_COND_INITIALIZER;
+
+/**
+ * @brief Compare a sample against the thresholds of its attribute
+ *
+ * @param [in,out] thr The monitored attribute and its alarm state
+ * @param [in] value The sampled value
+ * @param [out] alarms The crossings, at most two
+ *
+ * @return The number of crossings
+ */
+static uint32_t stub_threshold_eval(
+    _Inout_ stub_threshold_t     *thr,
+    _In_ float                    value,
+    _Out_ tai_threshold_alarm_t  *alarms)
+{
+    const tai_attribute_threshold_t *t = &thr->threshold;
+    uint32_t count = 0;
+
+    if (t->high_enabled &&
+        (thr->high_raised ? (value < t->high - t->hysteresis) : (value > t->high))) {
+        thr->high_raised = !thr->high_raised;
+        alarms[count].type = TAI_THRESHOLD_ALARM_TYPE_HIGH;
+        alarms[count++].raised = thr->high_raised;
+    }
+    if (t->low_enabled &&
+        (thr->low_raised ? (value > t->low + t->hysteresis) : (value < t->low))) {
+        thr->low_raised = !thr->low_raised;
+        alarms[count].type = TAI_THRESHOLD_ALARM_TYPE_LOW;
+        alarms[count++].raised = thr->low_raised;
+    }
+    return count;
+}
+
+/**
+ * @brief The monitoring thread, it evaluates the thresholds on each sample of
+ *        the simulated hardware
+ */
+static void *stub_threshold_monitor(_In_ void *arg)
+{
+    tai_threshold_alarm_t alarms[2 * STUB_MAX_THRESHOLDS];
+    tai_module_notification_t notifications;
+    tai_object_id_t object_id;
+    tai_attribute_t attr;
+    stub_threshold_t *thr;
+    struct timespec next;
+    uint64_t now_ns;
+    uint32_t idx, count, n;
+
+    pthread_mutex_lock(&stub_threshold_lock);
+    while (!stub_threshold_stopping) {
+        if (0 == stub_threshold_count) {
+            pthread_cond_wait(&stub_threshold_cond, &stub_threshold_lock);
+            continue;
+        }
+        /* wake up right after the next sample */
+        now_ns = stub_clock_ns(CLOCK_REALTIME);
+        now_ns += STUB_SIM_SAMPLE_NS - now_ns % STUB_SIM_SAMPLE_NS;
+        next.tv_sec = now_ns / 1000000000UL;
+        next.tv_nsec = now_ns % 1000000000UL;
+        if (ETIMEDOUT != pthread_cond_timedwait(&stub_threshold_cond, &stub_threshold_lock, &next)) {
+            continue;
+        }
+
+        now_ns = stub_clock_ns(CLOCK_REALTIME);
+        count = 0;
+        for (idx = 0; idx < STUB_MAX_THRESHOLDS; idx++) {
+            thr = &stub_thresholds[idx];
+            if (TAI_NULL_OBJECT_ID == thr->threshold.object_id) {
+                continue;
+            }
+            if (!stub_object_valid(thr->threshold.object_id,
+                                   STUB_OID_TYPE(thr->threshold.object_id))) {
+                memset(thr, 0, sizeof(*thr));
+                stub_threshold_count--;
+                continue;
+            }
+            /* the worker may be running a callback setting a threshold */
+            object_id = thr->threshold.object_id;
+            attr.id = thr->threshold.attr_id;
+            pthread_mutex_unlock(&stub_threshold_lock);
+            stub_work_sample(STUB_OID_TYPE(object_id), object_id, now_ns, &attr);
+            pthread_mutex_lock(&stub_threshold_lock);
+            if ((thr->threshold.object_id != object_id) ||
+                (thr->threshold.attr_id != attr.id)) {
+                continue;
+            }
+            n = stub_threshold_eval(thr, attr.value.flt, &alarms[count]);
+            for (; n > 0; n--, count++) {
+                alarms[count].object_id = thr->threshold.object_id;
+                alarms[count].attr_id = attr.id;
+                alarms[count].value = attr.value.flt;
+                alarms[count].timestamp = now_ns;
+            }
+        }
+        pthread_mutex_unlock(&stub_threshold_lock);
+
+        for (idx = 0; idx < count; idx++) {
+            if (stub_registry_get_notifications(alarms[idx].object_id, &notifications) &&
+                (NULL != notifications.threshold_alarm)) {
+                notifications.threshold_alarm(tai_module_id_query(alarms[idx].object_id),
+                                              &alarms[idx]);
+            }
+        }
+
+        pthread_mutex_lock(&stub_threshold_lock);
+    }
+    pthread_mutex_unlock(&stub_threshold_lock);
+    return NULL;
+}
+
+/**
+ * @brief Start the monitoring thread, called by tai_api_initialize()
+ */
+static void stub_threshold_start(void)
+{
+    stub_threshold_stopping = false;
+    if (0 != pthread_create(&stub_threshold_thread, NULL, stub_threshold_monitor, NULL)) {
+        TAI_SYSLOG_ERROR("Failed to start the threshold monitor");
+        return;
+    }
+    stub_threshold_started = true;
+}
+
+/**
+ * @brief Stop the monitoring thread and drop every threshold, called by
+ *        tai_api_uninitialize()
+ */
+static void stub_threshold_stop(void)
+{
+    pthread_mutex_lock(&stub_threshold_lock);
+    stub_threshold_stopping = true;
+    pthread_cond_signal(&stub_threshold_cond);
+    pthread_mutex_unlock(&stub_threshold_lock);
+    if (stub_threshold_started) {
+        pthread_join(stub_threshold_thread, NULL);
+        stub_threshold_started = false;
+    }
+    memset(stub_thresholds, 0, sizeof(stub_thresholds));
+    stub_threshold_count = 0;
+}
+
+/**
+ * @brief Set the thresholds of an attribute
+ *
+ * @param [in] threshold The attribute and its thresholds
+ *
+ * @return TAI_STATUS_SUCCESS on success, failure status code on error
+ */
+static tai_status_t stub_set_attribute_threshold(
+    _In_ const tai_attribute_threshold_t *threshold)
+{
+    const stub_attr_t *entry;
+    tai_object_type_t object_type;
+    stub_threshold_t *thr = NULL, *free_thr = NULL;
+    uint32_t idx;
+
+    if ((NULL == threshold) || !(threshold->hysteresis >= 0)) {
+        return TAI_STATUS_INVALID_PARAMETER;
+    }
+    object_type = STUB_OID_TYPE(threshold->object_id);
+    if (!stub_object_valid(threshold->object_id, object_type)) {
+        return TAI_STATUS_INVALID_OBJECT_ID;
+    }
+    entry = stub_attr_lookup(object_type, threshold->attr_id);
+    if ((NULL == entry) || !stub_attr_is_telemetry(entry)) {
+        TAI_SYSLOG_ERROR("Attribute %d can not be monitored", threshold->attr_id);
+        return TAI_STATUS_ATTR_NOT_SUPPORTED_0;
+    }
+    if (threshold->high_enabled && threshold->low_enabled &&
+        (threshold->low >= threshold->high)) {
+        return TAI_STATUS_INVALID_PARAMETER;
+    }
+
+    pthread_mutex_lock(&stub_threshold_lock);
+    for (idx = 0; idx < STUB_MAX_THRESHOLDS; idx++) {
+        if ((stub_thresholds[idx].threshold.object_id == threshold->object_id) &&
+            (stub_thresholds[idx].threshold.attr_id == threshold->attr_id)) {
+            thr = &stub_thresholds[idx];
+        } else if ((NULL == free_thr) &&
+                   (TAI_NULL_OBJECT_ID == stub_thresholds[idx].threshold.object_id)) {
+            free_thr = &stub_thresholds[idx];
+        }
+    }
+    if (!threshold->high_enabled && !threshold->low_enabled) {
+        if (NULL != thr) {
+            memset(thr, 0, sizeof(*thr));
+            stub_threshold_count--;
+        }
+        pthread_mutex_unlock(&stub_threshold_lock);
+        return TAI_STATUS_SUCCESS;
+    }
+    if (NULL == thr) {
+        if (NULL == free_thr) {
+            pthread_mutex_unlock(&stub_threshold_lock);
+            TAI_SYSLOG_ERROR("Too many monitored attributes");
+            return TAI_STATUS_TABLE_FULL;
+        }
+        thr = free_thr;
+        stub_threshold_count++;
+    }
+    thr->threshold = *threshold;
+    thr->high_raised = false;
+    thr->low_raised = false;
+    pthread_cond_signal(&stub_threshold_cond);
+    pthread_mutex_unlock(&stub_threshold_lock);
+    return TAI_STATUS_SUCCESS;
+}
+
+
+/*------------------------------------------------------------------------------
+
+                            Performance Monitoring
+
+------------------------------------------------------------------------------*/
+
+#undef  __TAI_MODULE__
+#define __TAI_MODULE__ TAI_API_MODULE
+
+/** @brief The attributes binned by the performance monitoring */
+static const struct {
+    tai_object_type_t object_type;
+    tai_attr_id_t     attr_id;
+} stub_pm_attrs[] = {
+    { TAI_OBJECT_TYPE_MODULE,    TAI_MODULE_ATTR_TEMP                             },
+    { TAI_OBJECT_TYPE_NETWORKIF, TAI_NETWORK_INTERFACE_ATTR_CURRENT_BER           },
+    { TAI_OBJECT_TYPE_NETWORKIF, TAI_NETWORK_INTERFACE_ATTR_CURRENT_INPUT_POWER   },
+    { TAI_OBJECT_TYPE_NETWORKIF, TAI_NETWORK_INTERFACE_ATTR_CURRENT_OUTPUT_POWER  },
+};
+
+#define STUB_PM_NUM_ATTRS       (sizeof(stub_pm_attrs)/sizeof(stub_pm_attrs[0]))
+
+/** @brief The number of completed bins kept, a day of 15 minute bins and a
+ *         week of 24 hour bins */
+#define STUB_PM_BINS_15_MIN     96
+#define STUB_PM_BINS_24_HOUR    7
+
+/** @brief The statistics of a bin */
+typedef struct _stub_pm_accum_t {
+    uint64_t start;     /**< ns since the Epoch */
+    uint32_t count;
+    float    min;
+    float    max;
+    double   sum;
+} stub_pm_accum_t;
+
+/** @brief The bins of an interval, completed bins form a ring */
+typedef struct _stub_pm_ring_t {
+    stub_pm_accum_t  current;
+    stub_pm_accum_t *bins;
+    uint32_t         size;
+    uint32_t         head;      /**< Next bin written */
+    uint32_t         count;     /**< Completed bins kept */
+} stub_pm_ring_t;
+
+/** @brief The bins of an attribute of an object */
+typedef struct _stub_pm_series_t {
+    tai_object_id_t object_id;  /**< TAI_NULL_OBJECT_ID if unused */
+    stub_pm_ring_t  ring[TAI_PM_INTERVAL_MAX];
+    stub_pm_accum_t bins_15_min[STUB_PM_BINS_15_MIN];
+    stub_pm_accum_t bins_24_hour[STUB_PM_BINS_24_HOUR];
+} stub_pm_series_t;
+
+/**
+ * @brief The series of each module slot, stub_num_netifs per attribute,
+ *        allocated by stub_pm_start(). A module attribute only uses the first
+ *        series of its row, a network interface attribute the series of the
+ *        interface index.
+ */
+static stub_pm_series_t *stub_pm_series = NULL;
+
+#define STUB_PM_SERIES(mi, idx, ifi) \
+    (&stub_pm_series[((mi) * STUB_PM_NUM_ATTRS + (idx)) * stub_num_netifs + (ifi)])
+
+/**
+ * @brief Divides the bin durations, set from the TAI_STUB_PM_SPEEDUP
+ *        environment variable to produce bins quickly
+ */
+static uint32_t        stub_pm_speedup = 1;
+static pthread_t       stub_pm_thread;
+static bool            stub_pm_started = false;
+static bool            stub_pm_stopping = false;
+static pthread_mutex_t stub_pm_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t  stub_pm_cond = PTHREAD_COND_INITIALIZER;
+
+/**
+ * @brief Get the duration of the bins of an interval
+ */
+static uint64_t stub_pm_duration_ns(_In_ tai_pm_interval_t interval)
+{
+    uint64_t duration = (TAI_PM_INTERVAL_15_MIN == interval) ? 15 * 60 : 24 * 60 * 60;
+
+    return duration * 1000000000UL / stub_pm_speedup;
+}
+
+/**
+ * @brief Start the series of an object, dropping the bins of a previous one
+ */
+static void stub_pm_series_reset(
+    _Inout_ stub_pm_series_t *series,
+    _In_ tai_object_id_t      object_id)
+{
+    memset(series, 0, sizeof(*series));
+    series->object_id = object_id;
+    series->ring[TAI_PM_INTERVAL_15_MIN].bins = series->bins_15_min;
+    series->ring[TAI_PM_INTERVAL_15_MIN].size = STUB_PM_BINS_15_MIN;
+    series->ring[TAI_PM_INTERVAL_24_HOUR].bins = series->bins_24_hour;
+    series->ring[TAI_PM_INTERVAL_24_HOUR].size = STUB_PM_BINS_24_HOUR;
+}
+
+/**
+ * @brief Add a sample to the current bin of each interval, completing the bins
+ *        which ended
+ */
+static void stub_pm_series_add(
+    _Inout_ stub_pm_series_t *series,
+    _In_ uint64_t             now_ns,
+    _In_ float                value)
+{
+    stub_pm_ring_t *ring;
+    uint64_t start;
+    uint32_t interval;
+
+    for (interval = 0; interval < TAI_PM_INTERVAL_MAX; interval++) {
+        ring = &series->ring[interval];
+        start = now_ns - now_ns % stub_pm_duration_ns(interval);
+        if (start != ring->current.start) {
+            if (0 != ring->current.count) {
+                ring->bins[ring->head] = ring->current;
+                ring->head = (ring->head + 1) % ring->size;
+                if (ring->count < ring->size) {
+                    ring->count++;
+                }
+            }
+            memset(&ring->current, 0, sizeof(ring->current));
+            ring->current.start = start;
+            ring->current.min = value;
+            ring->current.max = value;
+        }
+        if (value < ring->current.min) {
+            ring->current.min = value;
+        }
+        if (value > ring->current.max) {
+            ring->current.max = value;
+        }
+        ring->current.sum += value;
+        ring->current.count++;
+    }
+}
+
+/**
+ * @brief Sample the monitored attributes of every object, called with
+ *        stub_pm_lock held, released while each sample is read
+ *
+ * @param [in] now_ns The sampling time
+ */
+static void stub_pm_sample(_In_ uint64_t now_ns)
+{
+    stub_pm_series_t *series;
+    tai_object_type_t object_type;
+    tai_object_id_t object_id;
+    tai_attribute_t attr;
+    uint16_t generation;
+    uint32_t mi, idx, ifi, if_count;
+
+    for (mi = 0; mi < TAI_MAX_MODULES; mi++) {
+        generation = __atomic_load_n(&stub_modules[mi].generation, __ATOMIC_ACQUIRE);
+        for (idx = 0; idx < STUB_PM_NUM_ATTRS; idx++) {
+            object_type = stub_pm_attrs[idx].object_type;
+            if_count = (TAI_OBJECT_TYPE_MODULE == object_type) ? 1 : stub_num_netifs;
+            for (ifi = 0; ifi < if_count; ifi++) {
+                series = STUB_PM_SERIES(mi, idx, ifi);
+                object_id = STUB_OID(object_type, mi, ifi, generation);
+                if ((0 == generation) || !stub_object_valid(object_id, object_type)) {
+                    if (TAI_NULL_OBJECT_ID != series->object_id) {
+                        stub_pm_series_reset(series, TAI_NULL_OBJECT_ID);
+                    }
+                    continue;
+                }
+                if (series->object_id != object_id) {
+                    stub_pm_series_reset(series, object_id);
+                }
+                /* the worker may be running a callback reading the bins */
+                attr.id = stub_pm_attrs[idx].attr_id;
+                pthread_mutex_unlock(&stub_pm_lock);
+                stub_work_sample(object_type, object_id, now_ns, &attr);
+                pthread_mutex_lock(&stub_pm_lock);
+                if (series->object_id == object_id) {
+                    stub_pm_series_add(series, now_ns, attr.value.flt);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief The performance monitoring thread, it samples the monitored
+ *        attributes on each sample of the simulated hardware
+ */
+static void *stub_pm_collector(_In_ void *arg)
+{
+    struct timespec next;
+    uint64_t now_ns;
+
+    pthread_mutex_lock(&stub_pm_lock);
+    while (!stub_pm_stopping) {
+        now_ns = stub_clock_ns(CLOCK_REALTIME);
+        now_ns += STUB_SIM_SAMPLE_NS - now_ns % STUB_SIM_SAMPLE_NS;
+        next.tv_sec = now_ns / 1000000000UL;
+        next.tv_nsec = now_ns % 1000000000UL;
+        if (ETIMEDOUT == pthread_cond_timedwait(&stub_pm_cond, &stub_pm_lock, &next)) {
+            stub_pm_sample(stub_clock_ns(CLOCK_REALTIME));
+        }
+    }
+    pthread_mutex_unlock(&stub_pm_lock);
+    return NULL;
+}
+
+/**
+ * @brief Start the performance monitoring thread, called by
+ *        tai_api_initialize()
+ */
+static void stub_pm_start(void)
+{
+    stub_pm_speedup = stub_env_u32("TAI_STUB_PM_SPEEDUP", 1);
+    if (0 == stub_pm_speedup) {
+        stub_pm_speedup = 1;
+    }
+    stub_pm_stopping = false;
+    stub_pm_series = calloc(TAI_MAX_MODULES * STUB_PM_NUM_ATTRS * stub_num_netifs,
+                            sizeof(stub_pm_series_t));
+    if ((NULL == stub_pm_series) ||
+        (0 != pthread_create(&stub_pm_thread, NULL, stub_pm_collector, NULL))) {
+        TAI_SYSLOG_ERROR("Failed to start the performance monitoring");
+        free(stub_pm_series);
+        stub_pm_series = NULL;
+        return;
+    }
+    stub_pm_started = true;
+}
+
+/**
+ * @brief Stop the performance monitoring thread and drop every bin, called by
+ *        tai_api_uninitialize()
+ */
+static void stub_pm_stop(void)
+{
+    pthread_mutex_lock(&stub_pm_lock);
+    stub_pm_stopping = true;
+    pthread_cond_signal(&stub_pm_cond);
+    pthread_mutex_unlock(&stub_pm_lock);
+    if (stub_pm_started) {
+        pthread_join(stub_pm_thread, NULL);
+        stub_pm_started = false;
+    }
+    pthread_mutex_lock(&stub_pm_lock);
+    free(stub_pm_series);
+    stub_pm_series = NULL;
+    pthread_mutex_unlock(&stub_pm_lock);
+}
+
+/**
+ * @brief Read the completed performance monitoring bins of a module
+ *
+ * @param [in] module_id The module ID handle
+ * @param [in] interval The duration of the bins
+ * @param [in] since Only return the bins starting at or after this time
+ * @param [in,out] bin_count Size of bins, set to the number of bins returned
+ * @param [out] bins The completed bins
+ *
+ * @return TAI_STATUS_SUCCESS on success, failure status code on error
+ */
+static tai_status_t stub_get_pm_bins(
+    _In_ tai_object_id_t    module_id,
+    _In_ tai_pm_interval_t  interval,
+    _In_ uint64_t           since,
+    _Inout_ uint32_t       *bin_count,
+    _Out_ tai_pm_bin_t     *bins)
+{
+    uint16_t mi = STUB_OID_MODULE_INDEX(module_id);
+    const stub_pm_series_t *series;
+    const stub_pm_ring_t *ring;
+    const stub_pm_accum_t *bin;
+    uint32_t idx, ifi, b, count = 0;
+    tai_status_t ret = TAI_STATUS_SUCCESS;
+
+    if ((NULL == bin_count) || (interval >= TAI_PM_INTERVAL_MAX)) {
+        return TAI_STATUS_INVALID_PARAMETER;
+    }
+    if (!stub_object_valid(module_id, TAI_OBJECT_TYPE_MODULE)) {
+        return TAI_STATUS_INVALID_OBJECT_ID;
+    }
+
+    pthread_mutex_lock(&stub_pm_lock);
+    for (idx = 0; idx < STUB_PM_NUM_ATTRS; idx++) {
+        for (ifi = 0; (NULL != stub_pm_series) && (ifi < stub_num_netifs); ifi++) {
+            series = STUB_PM_SERIES(mi, idx, ifi);
+            /* bins of a previous module in the slot are never returned */
+            if ((TAI_NULL_OBJECT_ID == series->object_id) ||
+                (STUB_OID_GENERATION(series->object_id) != STUB_OID_GENERATION(module_id))) {
+                continue;
+            }
+            ring = &series->ring[interval];
+            for (b = 0; b < ring->count; b++) {
+                bin = &ring->bins[(ring->head + ring->size - ring->count + b) % ring->size];
+                if (bin->start < since) {
+                    continue;
+                }
+                if ((count < *bin_count) && (NULL != bins)) {
+                    bins[count].object_id = series->object_id;
+                    bins[count].attr_id = stub_pm_attrs[idx].attr_id;
+                    bins[count].sample_count = bin->count;
+                    bins[count].start = bin->start;
+                    bins[count].min = bin->min;
+                    bins[count].max = bin->max;
+                    bins[count].avg = bin->sum / bin->count;
+                } else {
+                    ret = TAI_STATUS_BUFFER_OVERFLOW;
+                }
+                count++;
+            }
+        }
+    }
+    pthread_mutex_unlock(&stub_pm_lock);
+    *bin_count = count;
+    return ret;
+}
+
+
+/*------------------------------------------------------------------------------
+
+                             Module Object Functions
+
+------------------------------------------------------------------------------*/
+
+#undef  __TAI_MODULE__
+#define __TAI_MODULE__ TAI_API_MODULE
+
+/**
+ * @brief Retrieve the value of an attribute
+ *
+ * @param [in] module_id The module ID handle
+ * @param [in,out] attr A pointer to the attribute to be retrieved
+ *
+ * @return TAI_STATUS_SUCCESS on success, failure status code on error
+ */
+static tai_status_t stub_get_module_attribute(
+    _In_ tai_object_id_t     module_id,
+    _Inout_ tai_attribute_t *attr)
+{
+    TAI_SYSLOG_DEBUG("Retrieving module attribute: %d", attr->id);
+    return stub_get_object_attributes(TAI_OBJECT_TYPE_MODULE, module_id, 1, attr);
+}
+
+/**
+ * @brief Retrieve an attribute value, as a hardware access of its own
+ *
+ * @param [in] module_id The module ID handle
+ * @param [in,out] attr A pointer to the attribute to be retrieved
+ *
+ * @return TAI_STATUS_SUCCESS on success, failure status code on error
+ */
+static tai_status_t stub_read_module_attribute(
+    _In_ tai_object_id_t     module_id,
+    _Inout_ tai_attribute_t *attr)
+{
+    TAI_SYSLOG_DEBUG("Reading module attribute: %d", attr->id);
+    return stub_hw_read(TAI_OBJECT_TYPE_MODULE, module_id, 1, attr);
+}
+
+/**
+ * @brief Retrieve a list of attribute values
+ *
+ * @param [in] module_id The module ID handle
+ * @param [in] attr_count A count of the number of elements in the attr_list
+ * @param [in,out] attr_list A list of attributes to be retrieved
+ *
+ * @return TAI_STATUS_SUCCESS on success, failure status code on error
+ */
+static tai_status_t stub_get_module_attributes(
+    _In_ tai_object_id_t     module_id,
+    _In_ uint32_t            attr_count,
+    _Inout_ tai_attribute_t *attr_list)
+{
+    return stub_hw_read(TAI_OBJECT_TYPE_MODULE, module_id, attr_count, attr_list);
+}
+
+/**
+ * @brief Retrieve a list of attribute values, the lists are allocated by the
+ *        adapter
+ *
+ * @param [in] module_id The module ID handle
+ * @param [in] attr_count A count of the number of elements in the attr_list
+ * @param [in,out] attr_list A list of attributes to be retrieved
+ *
+ * @return TAI_STATUS_SUCCESS on success, failure status code on error
+ */
+static tai_status_t stub_get_module_attributes_alloc(
+    _In_ tai_object_id_t     module_id,
+    _In_ uint32_t            attr_count,
+    _Inout_ tai_attribute_t *attr_list)
+{
+    return stub_get_attributes_alloc(TAI_OBJECT_TYPE_MODULE,
+                                     stub_get_module_attributes,
+                                     module_id, attr_count, attr_list);
+}
+
+/**
+ * @brief Release the lists returned by stub_get_module_attributes_alloc()
+ *
+ * @param [in] attr_count A count of the number of elements in the attr_list
+ * @param [in] attr_list A list of retrieved attributes
+ *
+ * @return TAI_STATUS_SUCCESS on success, failure status code on error
+ */
+static tai_status_t stub_free_module_attributes(
+    _In_ uint32_t         attr_count,
+    _In_ tai_attribute_t *attr_list)
+{
+    return stub_free_attributes(TAI_OBJECT_TYPE_MODULE, attr_count, attr_list);
+}
+
+/**
+ * @brief Set the value of an attribute
+ *
+ * @param [in] module_id The module ID handle
+ * @param [in] attr A pointer to the attribute to be set
+ *
+ * @return TAI_STATUS_SUCCESS on success, failure status code on error
+ */
+static tai_status_t stub_set_module_attribute(
+   _In_ tai_object_id_t        module_id,
+   _In_ const tai_attribute_t *attr)
+{
+    TAI_SYSLOG_DEBUG("Setting module attribute: %d", attr->id);
+    tai_status_t ret;
+
+    if (!stub_object_valid(module_id, TAI_OBJECT_TYPE_MODULE)) {
+        return TAI_STATUS_INVALID_OBJECT_ID;
+    }
+    ret = stub_check_attributes(TAI_OBJECT_TYPE_MODULE, false, 1, attr);
+    if (TAI_STATUS_SUCCESS != ret) {
+        return ret;
+    }
+    return stub_hw_write(TAI_OBJECT_TYPE_MODULE, module_id, 1, attr);
+}
+
+/**
+ * @brief Set the values from a list of attributes, as a single hardware
+ *        operation
+ *
+ * @param [in] module_id The module ID handle
+ * @param [in] attr_count A count of the number of elements in the attr_list
+ * @param [in] attr_list A list of attributes to be set
+ *
+ * @return TAI_STATUS_SUCCESS on success, failure status code on error
+ */
+static tai_status_t stub_set_module_attributes(
+   _In_ tai_object_id_t        module_id,
+   _In_ uint32_t               attr_count,
+   _In_ const tai_attribute_t *attr_list)
+{
+    tai_status_t ret;
+
+    if (!stub_object_valid(module_id, TAI_OBJECT_TYPE_MODULE)) {
+        return TAI_STATUS_INVALID_OBJECT_ID;
+    }
+    ret = stub_check_attributes(TAI_OBJECT_TYPE_MODULE, false, attr_count, attr_list);
+    if (TAI_STATUS_SUCCESS != ret) {
+        return ret;
+    }
+    return stub_hw_write(TAI_OBJECT_TYPE_MODULE, module_id, attr_count, attr_list);
+}
+
+/**
+ * @brief Set the values from a list of attributes asynchronously
+ *
+ * @param [in] module_id The module ID handle
+ * @param [in] attr_count A count of the number of elements in the attr_list
+ * @param [in] attr_list A list of attributes to be set
+ * @param [in] completion The completion callback
+ * @param [in] context The context passed to the completion callback
+ * @param [out] request_id The request id
+ *
+ * @return TAI_STATUS_SUCCESS if the request was queued, failure status code on
+ *         error
+ */
+static tai_status_t stub_set_module_attributes_async(
+    _In_ tai_object_id_t          module_id,
+    _In_ uint32_t                 attr_count,
+    _In_ const tai_attribute_t   *attr_list,
+    _In_ tai_async_completion_fn  completion,
+    _In_ void                    *context,
+    _Out_ tai_async_request_id_t *request_id)
+{
+    return stub_async_submit(stub_set_module_attributes, NULL, module_id,
+                             attr_count, (tai_attribute_t *)attr_list,
+                             completion, context, request_id);
+}
+
+/**
+ * @brief Retrieve a list of attribute values asynchronously
+ *
+ * @param [in] module_id The module ID handle
+ * @param [in] attr_count A count of the number of elements in the attr_list
+ * @param [in,out] attr_list A list of attributes to be retrieved
+ * @param [in] completion The completion callback
+ * @param [in] context The context passed to the completion callback
+ * @param [out] request_id The request id
+ *
+ * @return TAI_STATUS_SUCCESS if the request was queued, failure status code on
+ *         error
+ */
+static tai_status_t stub_get_module_attributes_async(
+    _In_ tai_object_id_t          module_id,
+    _In_ uint32_t                 attr_count,
+    _Inout_ tai_attribute_t      *attr_list,
+    _In_ tai_async_completion_fn  completion,
+    _In_ void                    *context,
+    _Out_ tai_async_request_id_t *request_id)
+{
+    return stub_async_submit(NULL, stub_get_module_attributes, module_id,
+                             attr_count, attr_list, completion, context,
+                             request_id);
+}
+
+/**
+ * @brief Retrieve a list of attribute values if they changed since a
+ *        generation
+ *
+ * @param [in] module_id The module ID handle
+ * @param [in] generation The generation of the previous read, 0 to read
+ * @param [out] current_generation The latest generation of the attributes
+ * @param [in] attr_count A count of the number of elements in the attr_list
+ * @param [in,out] attr_list A list of attributes to be retrieved
+ *
+ * @return TAI_STATUS_SUCCESS if the attributes were read,
+ *         TAI_STATUS_NOT_MODIFIED if they did not change, failure status code
+ *         on error
+ */
+static tai_status_t stub_get_module_attributes_if_changed(
+    _In_ tai_object_id_t     module_id,
+    _In_ tai_generation_t    generation,
+    _Out_ tai_generation_t  *current_generation,
+    _In_ uint32_t            attr_count,
+    _Inout_ tai_attribute_t *attr_list)
+{
+    return stub_get_attributes_if_changed(TAI_OBJECT_TYPE_MODULE, stub_get_module_attributes,
+                                          module_id, generation, current_generation,
+                                          attr_count, attr_list);
+}
+
+/**
+ * @brief Module initialization. After the call the capability attributes should
+ *        be ready for retrieval via tai_get_module_attribute().
+ *
+ * @param [out] module_id Handle which identifies the module
+ * @param [in] attr_count A count of the number of elements in the attr_list
+ * @param [in] attr_list A list of attributes to set during initialization
+ * @param [in] notifications Function pointers for adapter host notifications
+ *
+ * @return TAI_STATUS_SUCCESS on success, failure status code on error
+ */
+static tai_status_t stub_create_module(
+    _Out_ tai_object_id_t          *module_id,
+    _In_ uint32_t                   attr_count,
+    _In_ const tai_attribute_t     *attr_list,
+    _In_ tai_module_notification_t *notifications)
+{
+    tai_status_t ret;
+    const tai_attribute_value_t *location;
+
+    if (NULL == notifications) {
+        TAI_SYSLOG_ERROR("NULL module notifications passed to TAI switch initialize");
+        return TAI_STATUS_INVALID_PARAMETER;
+    }
+
+    ret = stub_check_attributes(TAI_OBJECT_TYPE_MODULE, true, attr_count, attr_list);
+    if (TAI_STATUS_SUCCESS != ret) {
+        TAI_SYSLOG_ERROR("Error setting module attributes");
+        return ret;
+    }
+
+    location = find_attribute_in_list(TAI_MODULE_ATTR_LOCATION, attr_count, attr_list);
+    ret = stub_registry_add_module(&location->charlist, notifications, module_id);
+    if (TAI_STATUS_SUCCESS != ret) {
+        TAI_SYSLOG_ERROR("Error creating module: %d", ret);
+        return ret;
+    }
+    ret = stub_hw_create(*module_id, attr_count, attr_list);
+    if (TAI_STATUS_SUCCESS != ret) {
+        TAI_SYSLOG_ERROR("Error setting module attributes: %d", ret);
+        stub_registry_remove_module(*module_id);
+        return ret;
+    }
+    stub_generation_bump(*module_id, STUB_GROUPS_ALL);
+
+    return TAI_STATUS_SUCCESS;
+}
+
+/**
+ * @brief Release all resources associated with previously created module
+ *
+ * @param [in] module_id The module ID handle being removed
+ *
+ * @return TAI_STATUS_SUCCESS on success, failure status code on error
+ */
+static tai_status_t stub_remove_module(_In_ tai_object_id_t module_id)
+{
+    return stub_hw_remove(TAI_OBJECT_TYPE_MODULE, module_id);
+}
+
+/**
+ * @brief Create a list of modules with a single call
+ *
+ * @param [in] object_count The number of modules to create
+ * @param [in] attr_count The number of attributes for each module
+ * @param [in] attr_list The attribute list for each module
+ * @param [in] notifications Function pointers for adapter host notifications,
+ *        shared by every module
+ * @param [in] mode The bulk operation error mode
+ * @param [out] object_id The created module ids
+ * @param [out] object_statuses The status of each module
+ *
+ * @return TAI_STATUS_SUCCESS on success, failure status code on error
+ */
+static tai_status_t stub_bulk_create_module(
+    _In_ uint32_t                   object_count,
+    _In_ const uint32_t            *attr_count,
+    _In_ const tai_attribute_t    **attr_list,
+    _In_ tai_module_notification_t *notifications,
+    _In_ tai_bulk_op_error_mode_t   mode,
+    _Out_ tai_object_id_t          *object_id,
+    _Out_ tai_status_t             *object_statuses)
+{
+    tai_status_t ret = TAI_STATUS_SUCCESS;
+    tai_status_t status;
+    uint32_t idx;
+
+    status = stub_bulk_check_params(object_count, mode, object_statuses);
+    if (TAI_STATUS_SUCCESS != status) {
+        return status;
+    }
+    if ((NULL == attr_count) || (NULL == attr_list) || (NULL == object_id)) {
+        return TAI_STATUS_INVALID_PARAMETER;
+    }
+
+    for (idx = 0; idx < object_count; idx++) {
+        object_id[idx] = TAI_NULL_OBJECT_ID;
+        status = stub_create_module(&object_id[idx], attr_count[idx],
+                                    attr_list[idx], notifications);
+        if (TAI_STATUS_SUCCESS != status) {
+            ret = TAI_STATUS_FAILURE;
+        }
+        if (!stub_bulk_record_status(status, idx, object_count, mode,
+                                     object_statuses)) {
+            break;
+        }
+    }
+    return ret;
+}
+
+/**
+ * @brief Remove a list of modules with a single call
+ *
+ * @param [in] object_count The number of modules to remove
+ * @param [in] object_id The module ids
+ * @param [in] mode The bulk operation error mode
+ * @param [out] object_statuses The status of each module
+ *
+ * @return TAI_STATUS_SUCCESS on success, failure status code on error
+ */
+static tai_status_t stub_bulk_remove_module(
+    _In_ uint32_t                 object_count,
+    _In_ const tai_object_id_t   *object_id,
+    _In_ tai_bulk_op_error_mode_t mode,
+    _Out_ tai_status_t           *object_statuses)
+{
+    return stub_bulk_remove(stub_remove_module, object_count, object_id, mode,
+                            object_statuses);
+}
+
+/**
+ * @brief Set attribute lists on a list of modules
+ *
+ * @param [in] object_count The number of modules
+ * @param [in] object_id The module ids
+ * @param [in] attr_count The number of attributes for each module
+ * @param [in] attr_list The attribute list for each module
+ * @param [in] mode The bulk operation error mode
+ * @param [out] object_statuses The status of each module
+ *
+ * @return TAI_STATUS_SUCCESS on success, failure status code on error
+ */
+static tai_status_t stub_bulk_set_module_attributes(
+    _In_ uint32_t                 object_count,
+    _In_ const tai_object_id_t   *object_id,
+    _In_ const uint32_t          *attr_count,
+    _In_ const tai_attribute_t  **attr_list,
+    _In_ tai_bulk_op_error_mode_t mode,
+    _Out_ tai_status_t           *object_statuses)
+{
+    return stub_bulk_set(stub_set_module_attributes, object_count, object_id,
+                         attr_count, attr_list, mode, object_statuses);
+}
+
+/**
+ * @brief Retrieve attribute lists from a list of modules
+ *
+ * @param [in] object_count The number of modules
+ * @param [in] object_id The module ids
+ * @param [in] attr_count The number of attributes for each module
+ * @param [in,out] attr_list The attribute list for each module
+ * @param [in] mode The bulk operation error mode
+ * @param [out] object_statuses The status of each module
+ *
+ * @return TAI_STATUS_SUCCESS on success, failure status code on error
+ */
+static tai_status_t stub_bulk_get_module_attributes(
+    _In_ uint32_t                 object_count,
+    _In_ const tai_object_id_t   *object_id,
+    _In_ const uint32_t          *attr_count,
+    _Inout_ tai_attribute_t     **attr_list,
+    _In_ tai_bulk_op_error_mode_t mode,
+    _Out_ tai_status_t           *object_statuses)
+{
+    return stub_bulk_get(stub_get_module_attributes, object_count, object_id,
+                         attr_count, attr_list, mode, object_statuses);
+}
+
+/** @brief The maximum number of concurrent attribute subscriptions */
+#define STUB_MAX_SUBSCRIPTIONS 64
+
+/**
+ * @brief An attribute subscription. Each subscription is served by its own
+ *        sampler thread which wakes up every interval, samples the subscribed
+ *        attributes and delivers them to the adapter host in one batch.
+ */
+typedef struct _stub_subscription_t {
+    bool                                       in_use;
+    bool                                       stop;
+    bool                                       removing;    /**< Being removed, under
+                                                                 stub_subscriptions_lock */
+    tai_subscription_id_t                      id;          /**< Constant once created */
+    tai_object_type_t                          object_type;
+    uint32_t                                   object_count;
+    tai_object_id_t                           *object_list;
+    uint32_t                                   attr_count;
+    tai_attr_id_t                             *attr_list;
+    uint32_t                                   interval_us;
+    tai_attribute_subscription_notification_fn notify;
+    void                                      *context;
+    tai_attribute_sample_t                    *samples;
+    pthread_t                                  thread;
+    pthread_mutex_t                            lock;
+    pthread_cond_t                             cond;
+} stub_subscription_t;
+
+static stub_subscription_t   stub_subscriptions[STUB_MAX_SUBSCRIPTIONS];
+static tai_subscription_id_t stub_subscription_seq = 0;
+static pthread_mutex_t       stub_subscriptions_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/**
+ * @brief The sampler thread of an attribute subscription
+ *
+ * @param [in] arg The subscription
+ */
+static void * stub_subscription_sampler(void *arg)
+{
+    stub_subscription_t *sub = arg;
+    tai_subscription_id_t id = sub->id;
+    struct timespec next, now;
+    uint64_t now_ns;
+    uint32_t obj, idx, count;
+
+    clock_gettime(CLOCK_MONOTONIC, &next);
+    pthread_mutex_lock(&sub->lock);
+    while (!sub->stop) {
+        next.tv_nsec += (long)(sub->interval_us % 1000000) * 1000;
+        next.tv_sec  += sub->interval_us / 1000000 + next.tv_nsec / 1000000000;
+        next.tv_nsec %= 1000000000;
+
+        /* Skip the missed intervals if the host is slower than the sampler */
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        if ((now.tv_sec > next.tv_sec) ||
+            ((now.tv_sec == next.tv_sec) && (now.tv_nsec > next.tv_nsec))) {
+            next = now;
+        }
+
+        while (!sub->stop &&
+               (ETIMEDOUT != pthread_cond_timedwait(&sub->cond, &sub->lock, &next))) {
+        }
+        if (sub->stop) {
+            break;
+        }
+        pthread_mutex_unlock(&sub->lock);
+
+        now_ns = stub_clock_ns(CLOCK_REALTIME);
+        count = 0;
+        for (obj = 0; obj < sub->object_count; obj++) {
+            /* a removed object is no longer sampled */
+            if (!stub_object_valid(sub->object_list[obj], sub->object_type)) {
+                continue;
+            }
+            for (idx = 0; idx < sub->attr_count; idx++) {
+                tai_attribute_sample_t *sample = &sub->samples[count++];
+
+                sample->object_id = sub->object_list[obj];
+                sample->timestamp = now_ns;
+                sample->attr.id = sub->attr_list[idx];
+                stub_work_sample(sub->object_type, sample->object_id,
+                                 now_ns, &sample->attr);
+            }
+        }
+        if (0 != count) {
+            sub->notify(id, sub->context, count, sub->samples);
+        }
+
+        pthread_mutex_lock(&sub->lock);
+    }
+    pthread_mutex_unlock(&sub->lock);
+    return NULL;
+}
+
+/**
+ * @brief Release the resources of a subscription slot
+ */
+static void stub_free_subscription(_Inout_ stub_subscription_t *sub)
+{
+    free(sub->object_list);
+    free(sub->attr_list);
+    free(sub->samples);
+    memset(sub, 0, sizeof(*sub));
+}
+
+/**
+ * @brief Subscribe to periodic attribute samples
+ *
+ * @param [out] subscription_id The subscription id
+ * @param [in] module_id The module on which the subscribed objects exist
+ * @param [in] subscription The subscription parameters
+ *
+ * @return TAI_STATUS_SUCCESS on success, failure status code on error
+ */
+static tai_status_t stub_create_attribute_subscription(
+    _Out_ tai_subscription_id_t              *subscription_id,
+    _In_ tai_object_id_t                      module_id,
+    _In_ const tai_attribute_subscription_t  *subscription)
+{
+    stub_subscription_t *sub = NULL;
+    pthread_condattr_t condattr;
+    tai_attribute_t attr;
+    uint32_t idx;
+
+    if ((NULL == subscription_id) || (NULL == subscription) ||
+        (0 == subscription->object_count) || (NULL == subscription->object_list) ||
+        (0 == subscription->attr_count) || (NULL == subscription->attr_list) ||
+        (0 == subscription->interval_us) || (NULL == subscription->notify)) {
+        TAI_SYSLOG_ERROR("Invalid attribute subscription parameters");
+        return TAI_STATUS_INVALID_PARAMETER;
+    }
+
+    for (idx = 0; idx < subscription->object_count; idx++) {
+        if (!stub_object_valid(subscription->object_list[idx], subscription->object_type) ||
+            (tai_module_id_query(subscription->object_list[idx]) != module_id)) {
+            TAI_SYSLOG_ERROR("Invalid object 0x%lx in attribute subscription",
+                             subscription->object_list[idx]);
+            return TAI_STATUS_INVALID_OBJECT_ID;
+        }
+    }
+
+    for (idx = 0; idx < subscription->attr_count; idx++) {
+        attr.id = subscription->attr_list[idx];
+        if (!stub_sample_attribute(subscription->object_type, TAI_NULL_OBJECT_ID,
+                                   0, &attr)) {
+            TAI_SYSLOG_ERROR("Attribute %d can not be subscribed", attr.id);
+            return convert_tai_error_to_list(TAI_STATUS_ATTR_NOT_SUPPORTED_0, idx);
+        }
+    }
+
+    pthread_mutex_lock(&stub_subscriptions_lock);
+    for (idx = 0; idx < STUB_MAX_SUBSCRIPTIONS; idx++) {
+        if (!stub_subscriptions[idx].in_use) {
+            sub = &stub_subscriptions[idx];
+            sub->in_use = true;
+            sub->id = stub_id_prefix | ++stub_subscription_seq;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&stub_subscriptions_lock);
+    if (NULL == sub) {
+        TAI_SYSLOG_ERROR("Too many attribute subscriptions");
+        return TAI_STATUS_TABLE_FULL;
+    }
+
+    sub->object_type  = subscription->object_type;
+    sub->object_count = subscription->object_count;
+    sub->attr_count   = subscription->attr_count;
+    sub->interval_us  = subscription->interval_us;
+    sub->notify       = subscription->notify;
+    sub->context      = subscription->context;
+    sub->object_list  = calloc(sub->object_count, sizeof(tai_object_id_t));
+    sub->attr_list    = calloc(sub->attr_count, sizeof(tai_attr_id_t));
+    sub->samples      = calloc((size_t)sub->object_count * sub->attr_count,
+                               sizeof(tai_attribute_sample_t));
+    if ((NULL == sub->object_list) || (NULL == sub->attr_list) ||
+        (NULL == sub->samples)) {
+        pthread_mutex_lock(&stub_subscriptions_lock);
+        stub_free_subscription(sub);
+        pthread_mutex_unlock(&stub_subscriptions_lock);
+        return TAI_STATUS_NO_MEMORY;
+    }
+    memcpy(sub->object_list, subscription->object_list,
+           sub->object_count * sizeof(tai_object_id_t));
+    memcpy(sub->attr_list, subscription->attr_list,
+           sub->attr_count * sizeof(tai_attr_id_t));
+
+    pthread_mutex_init(&sub->lock, NULL);
+    pthread_condattr_init(&condattr);
+    pthread_condattr_setclock(&condattr, CLOCK_MONOTONIC);
+    pthread_cond_init(&sub->cond, &condattr);
+    pthread_condattr_destroy(&condattr);
+
+    if (0 != pthread_create(&sub->thread, NULL, stub_subscription_sampler, sub)) {
+        TAI_SYSLOG_ERROR("Failed to start the subscription sampler");
+        pthread_cond_destroy(&sub->cond);
+        pthread_mutex_destroy(&sub->lock);
+        pthread_mutex_lock(&stub_subscriptions_lock);
+        stub_free_subscription(sub);
+        pthread_mutex_unlock(&stub_subscriptions_lock);
+        return TAI_STATUS_INSUFFICIENT_RESOURCES;
+    }
+
+    *subscription_id = sub->id;
+    return TAI_STATUS_SUCCESS;
+}
+
+/**
+ * @brief Stop the sampler of a subscription and release it
+ */
+static void stub_stop_subscription(_Inout_ stub_subscription_t *sub)
+{
+    pthread_mutex_lock(&sub->lock);
+    sub->stop = true;
+    pthread_cond_signal(&sub->cond);
+    pthread_mutex_unlock(&sub->lock);
+    pthread_join(sub->thread, NULL);
+    pthread_cond_destroy(&sub->cond);
+    pthread_mutex_destroy(&sub->lock);
+
+    pthread_mutex_lock(&stub_subscriptions_lock);
+    stub_free_subscription(sub);
+    pthread_mutex_unlock(&stub_subscriptions_lock);
+}
+
+/**
+ * @brief Remove an attribute subscription
+ *
+ * @param [in] subscription_id The subscription id
+ *
+ * @return TAI_STATUS_SUCCESS on success, failure status code on error
+ */
+static tai_status_t stub_remove_attribute_subscription(
+    _In_ tai_subscription_id_t subscription_id)
+{
+    stub_subscription_t *sub = NULL;
+    uint32_t idx;
+
+    pthread_mutex_lock(&stub_subscriptions_lock);
+    for (idx = 0; idx < STUB_MAX_SUBSCRIPTIONS; idx++) {
+        if (stub_subscriptions[idx].in_use && !stub_subscriptions[idx].removing &&
+            (stub_subscriptions[idx].id == subscription_id) &&
+            (NULL != stub_subscriptions[idx].samples)) {
+            sub = &stub_subscriptions[idx];
+            /* Hide the subscription from concurrent removals */
+            sub->removing = true;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&stub_subscriptions_lock);
+    if (NULL == sub) {
+        return TAI_STATUS_ITEM_NOT_FOUND;
+    }
+
+    stub_stop_subscription(sub);
+    return TAI_STATUS_SUCCESS;
+}
+
+/**
+ * @brief Remove every attribute subscription
+ */
+static void stub_remove_all_subscriptions(void)
+{
+    tai_subscription_id_t id;
+    uint32_t idx;
+
+    for (idx = 0; idx < STUB_MAX_SUBSCRIPTIONS; idx++) {
+        pthread_mutex_lock(&stub_subscriptions_lock);
+        id = (stub_subscriptions[idx].in_use && !stub_subscriptions[idx].removing) ?
+             stub_subscriptions[idx].id : 0;
+        pthread_mutex_unlock(&stub_subscriptions_lock);
+        if (0 != id) {
+            stub_remove_attribute_subscription(id);
+        }
+    }
+}
+
+/**
+ * @brief Fill the columns of one object type of a telemetry snapshot
+ *
+ * The rows of the interfaces which are not created are zeroed and left out
+ * of the valid mask.
+ *
+ * @param [in] object_type The type of the rows
+ * @param [in] module_id The module on which the interfaces exist
+ * @param [in] attr_mask The selected attributes
+ * @param [in] rows The number of rows to fill
+ * @param [in,out] columns The caller provided columns
+ * @param [in] now_ns The sampling time in nanoseconds
+ * @param [out] valid_mask The rows holding the values of a created interface
+ *
+ * @return TAI_STATUS_SUCCESS on success, failure status code on error
+ */
+static tai_status_t stub_fill_snapshot_columns(
+    _In_ tai_object_type_t          object_type,
+    _In_ tai_object_id_t            module_id,
+    _In_ uint64_t                   attr_mask,
+    _In_ uint32_t                   rows,
+    _Inout_ tai_telemetry_column_t *columns,
+    _In_ uint64_t                   now_ns,
+    _Out_ uint64_t                 *valid_mask)
+{
+    const stub_sim_attr_t *sim;
+    const stub_sim_fixed_attr_t *fixed;
+    stub_sim_kind_t kind;
+    tai_attribute_t attr;
+    tai_attr_id_t attr_id;
+    tai_object_id_t object_id;
+    uint64_t valid = 0;
+    uint32_t col = 0;
+    uint32_t row;
+
+    for (row = 0; row < rows; row++) {
+        object_id = STUB_OID(object_type, STUB_OID_MODULE_INDEX(module_id), row,
+                             STUB_OID_GENERATION(module_id));
+        if (stub_object_valid(object_id, object_type)) {
+            valid |= 1ULL << row;
+        }
+    }
+    *valid_mask = valid;
+    if (0 == attr_mask) {
+        return TAI_STATUS_SUCCESS;
+    }
+    if (NULL == columns) {
+        return TAI_STATUS_INVALID_PARAMETER;
+    }
+
+    for (attr_id = 0; attr_id < 64; attr_id++) {
+        if (0 == (attr_mask & TAI_TELEMETRY_ATTR_MASK(attr_id))) {
+            continue;
+        }
+        kind = stub_sim_lookup(object_type, attr_id, &sim, &fixed);
+        if (STUB_SIM_KIND_NONE == kind) {
+            TAI_SYSLOG_ERROR("Attribute %d can not be part of a snapshot", attr_id);
+            return convert_tai_error_to_list(TAI_STATUS_ATTR_NOT_SUPPORTED_0, col);
+        }
+        if (NULL == columns[col].data.flt) {
+            return TAI_STATUS_INVALID_PARAMETER;
+        }
+        columns[col].attr_id = attr_id;
+        if (STUB_SIM_KIND_FLOAT == kind) {
+            for (row = 0; row < rows; row++) {
+                attr.id = attr_id;
+                attr.value.flt = 0;
+                if (valid & (1ULL << row)) {
+                    stub_work_sample(object_type,
+                        STUB_OID(object_type, STUB_OID_MODULE_INDEX(module_id), row,
+                                 STUB_OID_GENERATION(module_id)),
+                        now_ns, &attr);
+                }
+                columns[col].data.flt[row] = attr.value.flt;
+            }
+        } else {
+            for (row = 0; row < rows; row++) {
+                columns[col].data.u32[row] = (valid & (1ULL << row)) ? fixed->value : 0;
+            }
+        }
+        col++;
+    }
+    return TAI_STATUS_SUCCESS;
+}
+
+/**
+ * @brief Read a telemetry snapshot of every interface of a module
+ *
+ * @param [in] module_id The module ID handle
+ * @param [in,out] snapshot The snapshot request and buffers
+ *
+ * @return TAI_STATUS_SUCCESS on success, failure status code on error
+ */
+static tai_status_t stub_get_module_telemetry_snapshot(
+    _In_ tai_object_id_t               module_id,
+    _Inout_ tai_telemetry_snapshot_t  *snapshot)
+{
+    tai_status_t ret;
+
+    if (NULL == snapshot) {
+        return TAI_STATUS_INVALID_PARAMETER;
+    }
+    if (!stub_object_valid(module_id, TAI_OBJECT_TYPE_MODULE)) {
+        return TAI_STATUS_INVALID_OBJECT_ID;
+    }
+
+    if (((0 != snapshot->netif_attr_mask) &&
+         (snapshot->netif_count < stub_num_netifs)) ||
+        ((0 != snapshot->hostif_attr_mask) &&
+         (snapshot->hostif_count < stub_num_hostifs))) {
+        snapshot->netif_count = stub_num_netifs;
+        snapshot->hostif_count = stub_num_hostifs;
+        return TAI_STATUS_BUFFER_OVERFLOW;
+    }
+    snapshot->netif_count = stub_num_netifs;
+    snapshot->hostif_count = stub_num_hostifs;
+    snapshot->timestamp = stub_clock_ns(CLOCK_REALTIME);
+
+    ret = stub_fill_snapshot_columns(TAI_OBJECT_TYPE_NETWORKIF, module_id,
+                                     snapshot->netif_attr_mask,
+                                     snapshot->netif_count,
+                                     snapshot->netif_columns,
+                                     snapshot->timestamp,
+                                     &snapshot->netif_valid_mask);
+    if (TAI_STATUS_SUCCESS != ret) {
+        return ret;
+    }
+    return stub_fill_snapshot_columns(TAI_OBJECT_TYPE_HOSTIF, module_id,
+                                      snapshot->hostif_attr_mask,
+                                      snapshot->hostif_count,
+                                      snapshot->hostif_columns,
+                                      snapshot->timestamp,
+                                      &snapshot->hostif_valid_mask);
+}
+
+/**
+ * @brief The module interface functions. This structure is retrieved via the 
+ *        #tai_api_query function.
+ */
+tai_module_api_t stub_module_api = {
+    .create_module                    = stub_create_module,
+    .remove_module                    = stub_remove_module,
+    .set_module_attribute             = stub_set_module_attribute,
+    .set_module_attributes            = stub_set_module_attributes,
+    .get_module_attribute             = stub_read_module_attribute,
+    .get_module_attributes            = stub_get_module_attributes,
+    .bulk_create_module               = stub_bulk_create_module,
+    .bulk_remove_module               = stub_bulk_remove_module,
+    .bulk_set_module_attributes       = stub_bulk_set_module_attributes,
+    .bulk_get_module_attributes       = stub_bulk_get_module_attributes,
+    .create_attribute_subscription    = stub_create_attribute_subscription,
+    .remove_attribute_subscription    = stub_remove_attribute_subscription,
+    .get_module_telemetry_snapshot    = stub_get_module_telemetry_snapshot,
+    .get_module_attributes_alloc      = stub_get_module_attributes_alloc,
+    .free_module_attributes           = stub_free_module_attributes,
+    .set_module_attributes_async      = stub_set_module_attributes_async,
+    .get_module_attributes_async      = stub_get_module_attributes_async,
+    .begin_transaction                = stub_begin_transaction,
+    .stage_attributes                 = stub_stage_attributes,
+    .commit_transaction               = stub_commit_transaction,
+    .abort_transaction                = stub_abort_transaction,
+    .get_object_generations           = stub_get_object_generations,
+    .get_module_attributes_if_changed = stub_get_module_attributes_if_changed,
+    .set_attribute_threshold          = stub_set_attribute_threshold,
+    .get_pm_bins                      = stub_get_pm_bins
+};
+
+
+/*------------------------------------------------------------------------------
+
+                                  Debug Dump
+
+------------------------------------------------------------------------------*/
+
+#undef  __TAI_MODULE__
+#define __TAI_MODULE__ TAI_API_UNSPECIFIED
+
+/** @brief A growing section of the dump */
+typedef struct _stub_dump_buf_t {
+    char   *buf;
+    size_t  size;
+    size_t  alloc;
+} stub_dump_buf_t;
+
+/** @brief The sections of the dump being built */
+typedef struct _stub_dump_t {
+    stub_dump_buf_t objects;
+    stub_dump_buf_t attrs;
+    stub_dump_buf_t logs;
+    stub_dump_buf_t data;
+    bool            failed;     /**< An allocation failed */
+} stub_dump_t;
+
+/**
+ * @brief Append to a section of the dump
+ *
+ * @param [in,out] dump The dump, marked as failed if memory is short
+ * @param [in,out] buf The section
+ * @param [in] data The bytes to append, NULL to append zeroes
+ * @param [in] len The number of bytes
+ * @param [in] align The start of the bytes is aligned on this boundary
+ *
+ * @return The offset of the bytes in the section
+ */
+static size_t stub_dump_append(
+    _Inout_ stub_dump_t     *dump,
+    _Inout_ stub_dump_buf_t *buf,
+    _In_ const void         *data,
+    _In_ size_t              len,
+    _In_ size_t              align)
+{
+    size_t offset = (buf->size + align - 1) & ~(align - 1);
+    size_t alloc = buf->alloc ? buf->alloc : 4096;
+    char *p;
+
+    while (offset + len > alloc) {
+        alloc *= 2;
+    }
+    if (alloc != buf->alloc) {
+        p = realloc(buf->buf, alloc);
+        if (NULL == p) {
+            dump->failed = true;
+            return 0;
+        }
+        buf->buf = p;
+        buf->alloc = alloc;
+    }
+    memset(buf->buf + buf->size, 0, offset - buf->size);
+    if (NULL != data) {
+        memcpy(buf->buf + offset, data, len);
+    } else {
+        memset(buf->buf + offset, 0, len);
+    }
+    buf->size = offset + len;
+    return offset;
+}
+
+/**
+ * @brief The size of an element of a list attribute
+ *
+ * @param [in] value_type The type of the attribute value
+ *
+ * @return The size in bytes, 0 if the list can not be dumped
+ */
+static size_t stub_dump_elem_size(_In_ tai_attr_value_type_t value_type)
+{
+    switch (value_type) {
+        case TAI_ATTR_VALUE_TYPE_OBJLIST:   return sizeof(tai_object_id_t);
+        case TAI_ATTR_VALUE_TYPE_CHARLIST:  return sizeof(char);
+        case TAI_ATTR_VALUE_TYPE_U8LIST:    return sizeof(uint8_t);
+        case TAI_ATTR_VALUE_TYPE_S8LIST:    return sizeof(int8_t);
+        case TAI_ATTR_VALUE_TYPE_U16LIST:   return sizeof(uint16_t);
+        case TAI_ATTR_VALUE_TYPE_S16LIST:   return sizeof(int16_t);
+        case TAI_ATTR_VALUE_TYPE_U32LIST:   return sizeof(uint32_t);
+        case TAI_ATTR_VALUE_TYPE_S32LIST:   return sizeof(int32_t);
+        case TAI_ATTR_VALUE_TYPE_FLOATLIST: return sizeof(tai_float_t);
+        default:                            return 0;
+    }
+}
+
+/**
+ * @brief Read an object map list attribute into a dump record, as
+ *        stub_dump_objmap_t entries in the data section
+ *
+ * The keys are read first to learn their number, then the number of values
+ * of each key, then the values.
+ *
+ * @param [in,out] dump The dump
+ * @param [in] object_id The object id
+ * @param [in] meta The attribute metadata
+ * @param [in,out] rec The attribute record
+ */
+static void stub_dump_objmap_attribute(
+    _Inout_ stub_dump_t            *dump,
+    _In_ tai_object_id_t            object_id,
+    _In_ const tai_attr_metadata_t *meta,
+    _Inout_ stub_dump_attr_t       *rec)
+{
+    tai_status_t (*get_fn)(tai_object_id_t, tai_attribute_t *) =
+        stub_get_attribute_fns[meta->objecttype];
+    tai_attribute_t attr = { .id = meta->attrid };
+    tai_object_map_list_t *map = &attr.value.objmaplist;
+    tai_object_map_t *keys = NULL;
+    tai_object_id_t *values = NULL;
+    stub_dump_objmap_t *entry;
+    uint32_t idx, v, total = 0, count = 0;
+    size_t offset;
+
+    rec->status = get_fn(object_id, &attr);
+    if (TAI_STATUS_BUFFER_OVERFLOW == rec->status) {
+        keys = calloc(map->count, sizeof(*keys));
+        if (NULL == keys) {
+            rec->status = TAI_STATUS_NO_MEMORY;
+            return;
         }
+        map->list = keys;
+        rec->status = get_fn(object_id, &attr);
     }
-    return TAI_STATUS_SUCCESS; 
+    if (TAI_STATUS_BUFFER_OVERFLOW == rec->status) {
+        for (idx = 0; idx < map->count; idx++) {
+            total += keys[idx].value.count;
+        }
+        values = calloc(total ? total : 1, sizeof(*values));
+        if (NULL == values) {
+            rec->status = TAI_STATUS_NO_MEMORY;
+            goto out;
+        }
+        for (idx = 0, total = 0; idx < map->count; idx++) {
+            keys[idx].value.list = values + total;
+            total += keys[idx].value.count;
+        }
+        rec->status = get_fn(object_id, &attr);
+    }
+    if (TAI_STATUS_SUCCESS != rec->status) {
+        goto out;
+    }
+    for (idx = 0; idx < map->count; idx++) {
+        count += map->list[idx].value.count ? map->list[idx].value.count : 1;
+    }
+    offset = stub_dump_append(dump, &dump->data, NULL, count * sizeof(*entry), STUB_DUMP_ALIGN);
+    if (dump->failed) {
+        rec->status = TAI_STATUS_NO_MEMORY;
+        goto out;
+    }
+    entry = (stub_dump_objmap_t *)(dump->data.buf + offset);
+    for (idx = 0; idx < map->count; idx++) {
+        if (0 == map->list[idx].value.count) {
+            /* a key without values keeps a single entry */
+            entry->key = map->list[idx].key;
+            entry->value = TAI_NULL_OBJECT_ID;
+            entry++;
+        }
+        for (v = 0; v < map->list[idx].value.count; v++) {
+            entry->key = map->list[idx].key;
+            entry->value = map->list[idx].value.list[v];
+            entry++;
+        }
+    }
+    rec->count = count;
+    rec->value = offset;
+out:
+    free(values);
+    free(keys);
 }
 
 /**
- * @brief Network interface initialization. After the call the capability 
- *        attributes should be ready for retrieval via
- *        tai_get_network_interface_attribute().
+ * @brief Read an attribute of an object into a dump record
  *
- * @param [out] network_interface_id Handle which identifies the network 
- *        interface
- * @param [in] module_id Module id on which the network interface exists
- * @param [in] attr_count A count of the number of elements in the attr_list
- * @param [in] attr_list A list of attributes to set during initialization
+ * List elements are read into the data section directly: the list is first
+ * read with a zero count to learn its length.
  *
- * @return TAI_STATUS_SUCCESS on success, failure status code on error
+ * @param [in,out] dump The dump
+ * @param [in] object_id The object id
+ * @param [in] meta The attribute metadata
+ * @param [out] rec The attribute record
  */
-static tai_status_t stub_create_network_interface(
-    _Out_ tai_object_id_t *network_interface_id,
-    _In_ tai_object_id_t module_id,
-    _In_ uint32_t attr_count,
-    _In_ const tai_attribute_t *attr_list)
+static void stub_dump_attribute(
+    _Inout_ stub_dump_t            *dump,
+    _In_ tai_object_id_t            object_id,
+    _In_ const tai_attr_metadata_t *meta,
+    _Out_ stub_dump_attr_t         *rec)
 {
-    tai_status_t ret;
-    const tai_attribute_value_t * netif_addr;
+    tai_status_t (*get_fn)(tai_object_id_t, tai_attribute_t *) =
+        stub_get_attribute_fns[meta->objecttype];
+    size_t elem_size = stub_dump_elem_size(meta->attrvaluetype);
+    tai_attribute_t attr;
+    stub_list_t *list = (stub_list_t *)&attr.value;
+    size_t offset;
 
-    netif_addr = find_attribute_in_list(TAI_NETWORK_INTERFACE_ATTR_INDEX, attr_count, attr_list);
-    if (NULL == netif_addr) {
-        TAI_SYSLOG_ERROR("The required TAI_NETWORK_INTERFACE_ATTR_INDEX attribute was not provided");
-        return TAI_STATUS_MANDATORY_ATTRIBUTE_MISSING;
-    }
+    memset(rec, 0, sizeof(*rec));
+    rec->attr_id = meta->attrid;
+    rec->value_type = meta->attrvaluetype;
+    memset(&attr, 0, sizeof(attr));
+    attr.id = meta->attrid;
 
-    ret = stub_set_network_interface_attributes(*network_interface_id, attr_count, attr_list);
-    if (TAI_STATUS_SUCCESS != ret) {
-        TAI_SYSLOG_ERROR("Error setting network interface attributes");
-        return ret;
+    if (!TAI_META_IS_LIST(meta)) {
+        rec->status = get_fn(object_id, &attr);
+        if (TAI_ATTR_VALUE_TYPE_CHARDATA == meta->attrvaluetype) {
+            rec->count = strnlen(attr.value.chardata, sizeof(attr.value.chardata));
+            rec->value = stub_dump_append(dump, &dump->data, attr.value.chardata,
+                                          rec->count, STUB_DUMP_ALIGN);
+        } else {
+            memcpy(&rec->value, &attr.value, sizeof(rec->value));
+        }
+        return;
+    }
+    if (TAI_ATTR_VALUE_TYPE_OBJMAPLIST == meta->attrvaluetype) {
+        stub_dump_objmap_attribute(dump, object_id, meta, rec);
+        return;
+    }
+    if (0 == elem_size) {
+        rec->status = TAI_STATUS_NOT_SUPPORTED;
+        return;
+    }
+    rec->status = get_fn(object_id, &attr);
+    if (TAI_STATUS_BUFFER_OVERFLOW == rec->status) {
+        rec->count = list->count;
+        offset = stub_dump_append(dump, &dump->data, NULL, rec->count * elem_size,
+                                  STUB_DUMP_ALIGN);
+        if (dump->failed) {
+            rec->status = TAI_STATUS_NO_MEMORY;
+            return;
+        }
+        /* the section does not move while the list is read */
+        list->list = dump->data.buf + offset;
+        rec->status = get_fn(object_id, &attr);
+        rec->value = offset;
+    }
+    if (TAI_STATUS_SUCCESS != rec->status) {
+        rec->count = 0;
+    } else {
+        rec->count = list->count;
     }
-
-    return TAI_STATUS_SUCCESS;
 }
 
 /**
- * @brief Release all resources associated with previously created network 
- *        interface
+ * @brief Add an object and all of its attributes to the dump
  *
- * @param [in] network_interface_id The network interface ID handle being 
- *        removed
- *
- * @return TAI_STATUS_SUCCESS on success, failure status code on error
+ * @param [in,out] dump The dump
+ * @param [in] object_type The object type
+ * @param [in] object_id The object id
  */
-static tai_status_t stub_remove_network_interface(_In_ tai_object_id_t network_interface_id)
+static void stub_dump_object(
+    _Inout_ stub_dump_t     *dump,
+    _In_ tai_object_type_t   object_type,
+    _In_ tai_object_id_t     object_id)
 {
-    return TAI_STATUS_SUCCESS;
+    const tai_attr_metadata_t *meta;
+    stub_dump_object_t obj = {
+        .oid         = object_id,
+        .object_type = object_type,
+        .first_attr  = dump->attrs.size / sizeof(stub_dump_attr_t),
+    };
+    stub_dump_attr_t rec;
+    tai_attr_id_t attr_id;
+
+    for (attr_id = 0; attr_id < tai_metadata_attr_by_object_type_count[object_type]; attr_id++) {
+        meta = tai_metadata_get_attr_metadata(object_type, attr_id);
+        if (NULL == meta) {
+            continue;
+        }
+        stub_dump_attribute(dump, object_id, meta, &rec);
+        stub_dump_append(dump, &dump->attrs, &rec, sizeof(rec), 1);
+        obj.attr_count++;
+    }
+    stub_dump_append(dump, &dump->objects, &obj, sizeof(obj), 1);
 }
 
 /**
- * @brief The network interface functions. This structure is retrieved via the 
- *        #tai_api_query function.
+ * @brief Add a log record to the dump, see #stub_log_history_fn
  */
-tai_network_interface_api_t stub_network_interface_api = {
-    .create_network_interface         = stub_create_network_interface,
-    .remove_network_interface         = stub_remove_network_interface,
-    .set_network_interface_attribute  = stub_set_network_interface_attribute,
-    .set_network_interface_attributes = stub_set_network_interface_attributes,
-    .get_network_interface_attribute  = stub_get_network_interface_attribute,
-    .get_network_interface_attributes = stub_get_network_interface_attributes
-};
-
-
-/*------------------------------------------------------------------------------
-
-                             Module Object Functions
-
-------------------------------------------------------------------------------*/
+static bool stub_dump_log_record(
+    _In_ uint64_t        timestamp,
+    _In_ pid_t           tid,
+    _In_ tai_api_t       tai_api_id,
+    _In_ tai_log_level_t log_level,
+    _In_ const char     *msg,
+    _In_ void           *arg)
+{
+    stub_dump_t *dump = arg;
+    stub_dump_log_t rec = {
+        .timestamp = timestamp,
+        .tid       = tid,
+        .api       = tai_api_id,
+        .level     = log_level,
+    };
 
-#undef  __TAI_MODULE__
-#define __TAI_MODULE__ TAI_API_MODULE
+    rec.msg_offset = stub_dump_append(dump, &dump->data, msg, strlen(msg) + 1,
+                                      STUB_DUMP_ALIGN);
+    stub_dump_append(dump, &dump->logs, &rec, sizeof(rec), 1);
+    return !dump->failed;
+}
 
 /**
- * @brief Retrieve the value of an attribute
+ * @brief Write the dump
  *
- * @param [in] module_id The module ID handle
- * @param [in,out] attr A pointer to the attribute to be retrieved
+ * The sections are written with a single writev() to a temporary file which
+ * then replaces 'file_name', so a reader never maps a partial dump.
+ *
+ * @param [in] dump The dump
+ * @param [in,out] hdr The header, the offsets are filled in
+ * @param [in] file_name The dump file
  *
  * @return TAI_STATUS_SUCCESS on success, failure status code on error
  */
-static tai_status_t stub_get_module_attribute(
-    _In_ tai_object_id_t     module_id,
-    _Inout_ tai_attribute_t *attr)
+static tai_status_t stub_dump_write(
+    _In_ const stub_dump_t     *dump,
+    _Inout_ stub_dump_header_t *hdr,
+    _In_ const char            *file_name)
 {
-    TAI_SYSLOG_DEBUG("Retrieving module attribute: %d", attr->id);
-    switch (attr->id) {
-        case TAI_MODULE_ATTR_LOCATION:
-        case TAI_MODULE_ATTR_VENDOR_NAME:
-        case TAI_MODULE_ATTR_VENDOR_PART_NUMBER:
-        case TAI_MODULE_ATTR_VENDOR_SERIAL_NUMBER:
-        case TAI_MODULE_ATTR_FIRMWARE_VERSIONS:
-        case TAI_MODULE_ATTR_OPER_STATUS:
-        case TAI_MODULE_ATTR_ADMIN_STATUS:
-        case TAI_MODULE_ATTR_TEMP:
-        case TAI_MODULE_ATTR_POWER:
-        case TAI_MODULE_ATTR_NUM_HOST_INTERFACES:
-        case TAI_MODULE_ATTR_NUM_NETWORK_INTERFACES:
-            return TAI_STATUS_SUCCESS;
+    static const char pad[STUB_DUMP_ALIGN];
+    struct iovec iov[6];
+    char tmp_name[PATH_MAX];
+    size_t data_pad;
+    ssize_t len;
+    int name_len;
+    int fd;
+
+    hdr->objects_offset = sizeof(*hdr);
+    hdr->attrs_offset = hdr->objects_offset + dump->objects.size;
+    hdr->logs_offset = hdr->attrs_offset + dump->attrs.size;
+    data_pad = -(hdr->logs_offset + dump->logs.size) & (STUB_DUMP_ALIGN - 1);
+    hdr->data_offset = hdr->logs_offset + dump->logs.size + data_pad;
+    hdr->data_size = dump->data.size;
+    hdr->file_size = hdr->data_offset + hdr->data_size;
+
+    iov[0] = (struct iovec){ hdr, sizeof(*hdr) };
+    iov[1] = (struct iovec){ dump->objects.buf, dump->objects.size };
+    iov[2] = (struct iovec){ dump->attrs.buf, dump->attrs.size };
+    iov[3] = (struct iovec){ dump->logs.buf, dump->logs.size };
+    iov[4] = (struct iovec){ (void *)pad, data_pad };
+    iov[5] = (struct iovec){ dump->data.buf, dump->data.size };
+
+    name_len = snprintf(tmp_name, sizeof(tmp_name), "%s.tmp", file_name);
+    if ((name_len < 0) || ((size_t)name_len >= sizeof(tmp_name))) {
+        return TAI_STATUS_INVALID_PARAMETER;
+    }
+    fd = open(tmp_name, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        TAI_SYSLOG_ERROR("Failed to open %s: %s", tmp_name, strerror(errno));
+        return TAI_STATUS_FAILURE;
+    }
+    len = writev(fd, iov, sizeof(iov)/sizeof(iov[0]));
+    if ((0 != close(fd)) || (len != (ssize_t)hdr->file_size)) {
+        TAI_SYSLOG_ERROR("Failed to write %s", tmp_name);
+        unlink(tmp_name);
+        return TAI_STATUS_FAILURE;
+    }
+    if (0 != rename(tmp_name, file_name)) {
+        TAI_SYSLOG_ERROR("Failed to rename %s: %s", tmp_name, strerror(errno));
+        unlink(tmp_name);
+        return TAI_STATUS_FAILURE;
     }
-    return TAI_STATUS_ATTR_NOT_SUPPORTED_0;
+    return TAI_STATUS_SUCCESS;
 }
 
 /**
- * @brief Retrieve a list of attribute values
+ * @brief Dump every object of the registry, its attributes and the recent
+ *        log records
  *
- * @param [in] module_id The module ID handle
- * @param [in] attr_count A count of the number of elements in the attr_list
- * @param [in,out] attr_list A list of attributes to be retrieved
+ * The registry is walked without its lock, like any attribute get, so the
+ * dump does not hold up object creation or removal.
+ *
+ * @param [in] file_name The dump file
  *
  * @return TAI_STATUS_SUCCESS on success, failure status code on error
  */
-static tai_status_t stub_get_module_attributes(
-    _In_ tai_object_id_t     module_id,
-    _In_ uint32_t            attr_count,
-    _Inout_ tai_attribute_t *attr_list)
+static tai_status_t stub_dump(_In_ const char *file_name)
 {
-    uint32_t idx;
+    stub_dump_header_t hdr = {
+        .magic         = STUB_DUMP_MAGIC,
+        .byte_order    = STUB_DUMP_BYTE_ORDER,
+        .version_major = STUB_DUMP_VERSION_MAJOR,
+        .version_minor = STUB_DUMP_VERSION_MINOR,
+        .header_size   = sizeof(stub_dump_header_t),
+        .object_size   = sizeof(stub_dump_object_t),
+        .attr_size     = sizeof(stub_dump_attr_t),
+        .log_size      = sizeof(stub_dump_log_t),
+    };
+    stub_dump_t dump;
+    stub_log_stats_t stats;
+    stub_module_t *mod;
+    uint32_t module_index, if_index, mask;
+    uint16_t generation;
     tai_status_t ret;
 
-    for (idx = 0; idx < attr_count; idx++) {
-        ret = stub_get_module_attribute(module_id, attr_list++);
-        if (ret) {
-            return convert_tai_error_to_list(ret, idx);
+    memset(&dump, 0, sizeof(dump));
+    hdr.timestamp = stub_clock_ns(CLOCK_REALTIME);
+    for (module_index = 0; module_index < TAI_MAX_MODULES; module_index++) {
+        mod = &stub_modules[module_index];
+        generation = __atomic_load_n(&mod->generation, __ATOMIC_ACQUIRE);
+        if (0 == generation) {
+            continue;
+        }
+        stub_dump_object(&dump, TAI_OBJECT_TYPE_MODULE,
+                         STUB_OID(TAI_OBJECT_TYPE_MODULE, module_index, 0, generation));
+        mask = __atomic_load_n(&mod->hostif_mask, __ATOMIC_ACQUIRE);
+        for (if_index = 0; if_index < STUB_MAX_INTERFACES; if_index++) {
+            if (mask & (1U << if_index)) {
+                stub_dump_object(&dump, TAI_OBJECT_TYPE_HOSTIF,
+                                 STUB_OID(TAI_OBJECT_TYPE_HOSTIF, module_index,
+                                          if_index, generation));
+            }
         }
+        mask = __atomic_load_n(&mod->netif_mask, __ATOMIC_ACQUIRE);
+        for (if_index = 0; if_index < STUB_MAX_INTERFACES; if_index++) {
+            if (mask & (1U << if_index)) {
+                stub_dump_object(&dump, TAI_OBJECT_TYPE_NETWORKIF,
+                                 STUB_OID(TAI_OBJECT_TYPE_NETWORKIF, module_index,
+                                          if_index, generation));
+            }
+        }
+    }
+    stub_log_read_history(stub_dump_log_record, &dump, &stats);
+
+    hdr.object_count = dump.objects.size / sizeof(stub_dump_object_t);
+    hdr.attr_count = dump.attrs.size / sizeof(stub_dump_attr_t);
+    hdr.log_count = dump.logs.size / sizeof(stub_dump_log_t);
+    hdr.log_written = stats.written;
+    hdr.log_dropped = stats.dropped;
+    hdr.cache_hits = __atomic_load_n(&stub_cache_hits, __ATOMIC_RELAXED);
+    hdr.cache_misses = __atomic_load_n(&stub_cache_misses, __ATOMIC_RELAXED);
+
+    if (dump.failed) {
+        ret = TAI_STATUS_NO_MEMORY;
+    } else {
+        ret = stub_dump_write(&dump, &hdr, file_name);
     }
-    return TAI_STATUS_SUCCESS; 
+    free(dump.objects.buf);
+    free(dump.attrs.buf);
+    free(dump.logs.buf);
+    free(dump.data.buf);
+    return ret;
 }
 
+
+/*------------------------------------------------------------------------------
+
+                                 Warm Restart
+
+------------------------------------------------------------------------------*/
+
 /**
- * @brief Set the value of an attribute
- *
- * @param [in] module_id The module ID handle
- * @param [in] attr A pointer to the attribute to be set
+ * @brief The snapshot used by a warm start, set from the TAI_STUB_WARM_FILE
+ *        environment variable. tai_api_uninitialize() writes it, so does
+ *        tai_dbg_generate_dump() when given the same file.
+ */
+static const char *stub_warm_file = NULL;
+
+/**
+ * @brief Restore the tributary mapping of a restored module from a dump
  *
- * @return TAI_STATUS_SUCCESS on success, failure status code on error
+ * @param [in] base The dump
+ * @param [in] module_id The module
+ * @param [in] attr The record of its tributary mapping
  */
-static tai_status_t stub_set_module_attribute(
-   _In_ tai_object_id_t        module_id,
-   _In_ const tai_attribute_t *attr)
+static void stub_warm_restore_tributary(
+    _In_ const char             *base,
+    _In_ tai_object_id_t         module_id,
+    _In_ const stub_dump_attr_t *attr)
 {
-    TAI_SYSLOG_DEBUG("Setting module attribute: %d", attr->id);
-    switch (attr->id) {
-        case TAI_MODULE_ATTR_LOCATION:
-            return TAI_STATUS_SUCCESS;
-        case TAI_MODULE_ATTR_VENDOR_NAME:
-        case TAI_MODULE_ATTR_VENDOR_PART_NUMBER:
-        case TAI_MODULE_ATTR_VENDOR_SERIAL_NUMBER:
-        case TAI_MODULE_ATTR_FIRMWARE_VERSIONS:
-        case TAI_MODULE_ATTR_TEMP:
-        case TAI_MODULE_ATTR_POWER:
-        case TAI_MODULE_ATTR_NUM_HOST_INTERFACES:
-        case TAI_MODULE_ATTR_NUM_NETWORK_INTERFACES:
-        case TAI_MODULE_ATTR_OPER_STATUS:
-            return TAI_STATUS_INVALID_ATTRIBUTE_0;
-        case TAI_MODULE_ATTR_ADMIN_STATUS:
-            return TAI_STATUS_SUCCESS;
+    const stub_dump_header_t *hdr = (const stub_dump_header_t *)base;
+    uint8_t tributary[STUB_MAX_INTERFACES];
+    stub_dump_objmap_t entry;
+    uint32_t idx;
+
+    if ((attr->value > hdr->data_size) ||
+        (attr->count > (hdr->data_size - attr->value) / sizeof(entry))) {
+        return;
+    }
+    memset(tributary, STUB_TRIBUTARY_NONE, sizeof(tributary));
+    for (idx = 0; idx < attr->count; idx++) {
+        memcpy(&entry, base + hdr->data_offset + attr->value + idx * sizeof(entry),
+               sizeof(entry));
+        if ((TAI_OBJECT_TYPE_NETWORKIF != STUB_OID_TYPE(entry.key)) ||
+            (STUB_OID_MODULE(entry.key) != module_id) ||
+            (STUB_OID_IF_INDEX(entry.key) >= STUB_MAX_INTERFACES) ||
+            (TAI_OBJECT_TYPE_HOSTIF != STUB_OID_TYPE(entry.value)) ||
+            (STUB_OID_MODULE(entry.value) != module_id) ||
+            (STUB_OID_IF_INDEX(entry.value) >= STUB_MAX_INTERFACES)) {
+            continue;
+        }
+        tributary[STUB_OID_IF_INDEX(entry.value)] = STUB_OID_IF_INDEX(entry.key);
     }
-    return TAI_STATUS_ATTR_NOT_SUPPORTED_0;
+    stub_registry_restore_tributary(module_id, tributary);
 }
 
 /**
- * @brief Set the values from a list of attributes
- *
- * @param [in] module_id The module ID handle
- * @param [in] attr_count A count of the number of elements in the attr_list
- * @param [in] attr_list A list of attributes to be set
+ * @brief Restore the stored attributes of the restored objects from a dump,
+ *        and the tributary mapping of the modules
  *
- * @return TAI_STATUS_SUCCESS on success, failure status code on error
+ * @param [in] base The dump
  */
-static tai_status_t stub_set_module_attributes(
-   _In_ tai_object_id_t        module_id,
-   _In_ uint32_t               attr_count,
-   _In_ const tai_attribute_t *attr_list)
+static void stub_warm_restore_values(_In_ const char *base)
 {
-    uint32_t idx;
-    tai_status_t ret;
+    const stub_dump_header_t *hdr = (const stub_dump_header_t *)base;
+    const tai_attr_metadata_t *meta;
+    const stub_dump_object_t *obj;
+    const stub_dump_attr_t *attr;
+    tai_attribute_value_t value;
+    uint32_t idx, a;
 
-    for (idx = 0; idx < attr_count; idx++) {
-        ret = stub_set_module_attribute(module_id, attr_list++);
-        if (ret) {
-            return convert_tai_error_to_list(ret, idx);
+    for (idx = 0; idx < hdr->object_count; idx++) {
+        obj = (const void *)(base + hdr->objects_offset + (uint64_t)idx * hdr->object_size);
+        if ((obj->object_type >= TAI_OBJECT_TYPE_MAX) ||
+            !stub_object_valid(obj->oid, obj->object_type) ||
+            (obj->first_attr > hdr->attr_count) ||
+            (obj->attr_count > hdr->attr_count - obj->first_attr)) {
+            continue;
+        }
+        for (a = 0; a < obj->attr_count; a++) {
+            attr = (const void *)(base + hdr->attrs_offset +
+                                  (uint64_t)(obj->first_attr + a) * hdr->attr_size);
+            meta = tai_metadata_get_attr_metadata(obj->object_type, attr->attr_id);
+            if ((TAI_STATUS_SUCCESS != attr->status) || (NULL == meta) ||
+                (meta->attrvaluetype != attr->value_type)) {
+                continue;
+            }
+            if ((TAI_OBJECT_TYPE_MODULE == obj->object_type) &&
+                (TAI_MODULE_ATTR_TRIBUTARY_MAPPING == attr->attr_id)) {
+                stub_warm_restore_tributary(base, obj->oid, attr);
+                continue;
+            }
+            memset(&value, 0, sizeof(value));
+            memcpy(&value, &attr->value, sizeof(attr->value));
+            stub_store_put(obj->oid, attr->attr_id, &value);
         }
     }
-    return TAI_STATUS_SUCCESS; 
 }
 
 /**
- * @brief Module initialization. After the call the capability attributes should
- *        be ready for retrieval via tai_get_module_attribute().
+ * @brief Restore the object registry from a dump, see stub_dump.h
  *
- * @param [out] module_id Handle which identifies the module
- * @param [in] attr_count A count of the number of elements in the attr_list
- * @param [in] attr_list A list of attributes to set during initialization
- * @param [in] notifications Function pointers for adapter host notifications
+ * The objects are restored with their ids, the module locations and the
+ * interfaces of each module, and so are the values of the stored attributes
+ * and the tributary mappings, whether derived or set by the adapter host.
+ *
+ * @param [in] file_name The dump file
  *
  * @return TAI_STATUS_SUCCESS on success, failure status code on error
  */
-static tai_status_t stub_create_module(
-    _Out_ tai_object_id_t          *module_id,
-    _In_ uint32_t                   attr_count,
-    _In_ const tai_attribute_t     *attr_list,
-    _In_ tai_module_notification_t *notifications)
+static tai_status_t stub_warm_restore(_In_ const char *file_name)
 {
-    tai_status_t ret;
-    const tai_attribute_value_t * mod_addr;
+    const stub_dump_header_t *hdr;
+    const stub_dump_object_t *obj;
+    const stub_dump_attr_t *attr;
+    uint32_t hostif_mask[TAI_MAX_MODULES] = { 0 };
+    uint32_t netif_mask[TAI_MAX_MODULES] = { 0 };
+    tai_object_id_t modules[TAI_MAX_MODULES] = { 0 };
+    char (*locations)[TAI_MAX_HARDWARE_ID_LEN];
+    const char *base;
+    struct stat st;
+    uint32_t idx, a, restored = 0;
+    uint16_t module_index;
+    tai_status_t ret = TAI_STATUS_SUCCESS;
+    int fd;
 
-    if (NULL == notifications) {
-        TAI_SYSLOG_ERROR("NULL module notifications passed to TAI switch initialize");
-        return TAI_STATUS_INVALID_PARAMETER;
+    fd = open(file_name, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        TAI_SYSLOG_NOTICE("No warm start snapshot %s: %s", file_name, strerror(errno));
+        return TAI_STATUS_ITEM_NOT_FOUND;
+    }
+    if ((0 != fstat(fd, &st)) || (st.st_size < (off_t)sizeof(*hdr))) {
+        close(fd);
+        return TAI_STATUS_FAILURE;
+    }
+    base = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (MAP_FAILED == base) {
+        return TAI_STATUS_FAILURE;
+    }
+    hdr = (const stub_dump_header_t *)base;
+    if ((0 != memcmp(hdr->magic, STUB_DUMP_MAGIC, sizeof(hdr->magic))) ||
+        (STUB_DUMP_BYTE_ORDER != hdr->byte_order) ||
+        (STUB_DUMP_VERSION_MAJOR != hdr->version_major) ||
+        (hdr->file_size != (uint64_t)st.st_size) ||
+        (hdr->object_size < sizeof(stub_dump_object_t)) ||
+        (hdr->attr_size < sizeof(stub_dump_attr_t)) ||
+        (hdr->objects_offset > hdr->file_size) ||
+        (hdr->object_count > (hdr->file_size - hdr->objects_offset) / hdr->object_size) ||
+        (hdr->attrs_offset > hdr->file_size) ||
+        (hdr->attr_count > (hdr->file_size - hdr->attrs_offset) / hdr->attr_size) ||
+        (hdr->data_offset > hdr->file_size) ||
+        (hdr->data_size > hdr->file_size - hdr->data_offset)) {
+        TAI_SYSLOG_ERROR("Invalid warm start snapshot %s", file_name);
+        munmap((void *)base, st.st_size);
+        return TAI_STATUS_FAILURE;
     }
 
-    mod_addr = find_attribute_in_list(TAI_MODULE_ATTR_LOCATION, attr_count, attr_list);
-    if (NULL == mod_addr) {
-        TAI_SYSLOG_ERROR("The required TAI_MODULE_ATTR_LOCATION attribute was not provided");
-        return TAI_STATUS_MANDATORY_ATTRIBUTE_MISSING;
+    locations = calloc(TAI_MAX_MODULES, sizeof(*locations));
+    if (NULL == locations) {
+        munmap((void *)base, st.st_size);
+        return TAI_STATUS_NO_MEMORY;
+    }
+    for (idx = 0; idx < hdr->object_count; idx++) {
+        obj = (const void *)(base + hdr->objects_offset + (uint64_t)idx * hdr->object_size);
+        module_index = STUB_OID_MODULE_INDEX(obj->oid);
+        if (module_index >= TAI_MAX_MODULES) {
+            continue;
+        }
+        switch (obj->object_type) {
+            case TAI_OBJECT_TYPE_MODULE:
+                modules[module_index] = obj->oid;
+                break;
+            case TAI_OBJECT_TYPE_HOSTIF:
+            case TAI_OBJECT_TYPE_NETWORKIF:
+                if ((STUB_OID_GENERATION(obj->oid) != STUB_OID_GENERATION(modules[module_index])) ||
+                    (STUB_OID_IF_INDEX(obj->oid) >= STUB_MAX_INTERFACES)) {
+                    continue;
+                }
+                if (TAI_OBJECT_TYPE_HOSTIF == obj->object_type) {
+                    hostif_mask[module_index] |= 1U << STUB_OID_IF_INDEX(obj->oid);
+                } else {
+                    netif_mask[module_index] |= 1U << STUB_OID_IF_INDEX(obj->oid);
+                }
+                continue;
+            default:
+                continue;
+        }
+        if ((obj->first_attr > hdr->attr_count) ||
+            (obj->attr_count > hdr->attr_count - obj->first_attr)) {
+            continue;
+        }
+        for (a = 0; a < obj->attr_count; a++) {
+            attr = (const void *)(base + hdr->attrs_offset +
+                                  (uint64_t)(obj->first_attr + a) * hdr->attr_size);
+            if ((TAI_MODULE_ATTR_LOCATION == attr->attr_id) &&
+                (TAI_STATUS_SUCCESS == attr->status) &&
+                (attr->count < TAI_MAX_HARDWARE_ID_LEN) &&
+                (attr->value <= hdr->data_size) &&
+                (attr->count <= hdr->data_size - attr->value)) {
+                memcpy(locations[module_index], base + hdr->data_offset + attr->value,
+                       attr->count);
+                locations[module_index][attr->count] = '\0';
+            }
+        }
     }
 
-    ret = stub_set_module_attributes(*module_id, attr_count, attr_list);
+    for (idx = 0; idx < TAI_MAX_MODULES; idx++) {
+        if (TAI_NULL_OBJECT_ID == modules[idx]) {
+            continue;
+        }
+        ret = stub_registry_restore_module(modules[idx], locations[idx],
+                                           hostif_mask[idx], netif_mask[idx]);
+        if (TAI_STATUS_SUCCESS != ret) {
+            TAI_SYSLOG_ERROR("Failed to restore module 0x%lx: %d", modules[idx], ret);
+            break;
+        }
+        restored++;
+    }
+    free(locations);
     if (TAI_STATUS_SUCCESS != ret) {
-        TAI_SYSLOG_ERROR("Error setting module attributes");
+        munmap((void *)base, st.st_size);
+        stub_registry_clear();
         return ret;
     }
-
-    return TAI_STATUS_SUCCESS;
-}
-
-/**
- * @brief Release all resources associated with previously created module
- *
- * @param [in] module_id The module ID handle being removed
- *
- * @return TAI_STATUS_SUCCESS on success, failure status code on error
- */
-static tai_status_t stub_remove_module(_In_ tai_object_id_t module_id)
-{
+    stub_warm_restore_values(base);
+    munmap((void *)base, st.st_size);
+    TAI_SYSLOG_NOTICE("Restored %u modules from %s", restored, file_name);
     return TAI_STATUS_SUCCESS;
 }
 
-/**
- * @brief The module interface functions. This structure is retrieved via the 
- *        #tai_api_query function.
- */
-tai_module_api_t stub_module_api = {
-    .create_module         = stub_create_module,
-    .remove_module         = stub_remove_module,
-    .set_module_attribute  = stub_set_module_attribute,
-    .set_module_attributes = stub_set_module_attributes,
-    .get_module_attribute  = stub_get_module_attribute,
-    .get_module_attributes = stub_get_module_attributes
-};
-
 
 /*------------------------------------------------------------------------------
 
@@ -724,7 +8399,8 @@ tai_module_api_t stub_module_api = {
  *  @brief  Adapter module initialization call. This is NOT for SDK
  *          initialization.
  *
- *  @param [in] flags Reserved for future use, must be zero
+ *  @param [in] flags Bitmap of TAI_API_INITIALIZE_FLAG_xxx, other bits must be
+ *         zero
  *  @param [in] services Methods table with services provided by adapter host
  *
  *  @return #TAI_STATUS_SUCCESS on success, failure status code on error
@@ -733,7 +8409,8 @@ tai_status_t tai_api_initialize(_In_ uint64_t flags,
                                 _In_ const tai_service_method_table_t* services)
 {
     openlog("stub_tai_adapter", LOG_PID, LOG_USER);
-    if (0 != flags) {
+    stub_log_init();
+    if (0 != (flags & ~TAI_API_INITIALIZE_FLAG_WARM_START)) {
         TAI_SYSLOG_ERROR("Invalid flags passed to TAI API initialize");
         return TAI_STATUS_INVALID_PARAMETER;
     }
@@ -744,7 +8421,26 @@ tai_status_t tai_api_initialize(_In_ uint64_t flags,
     }
 
     memcpy(&adapter_host_fns, services, sizeof(adapter_host_fns));
+    stub_latency_init();
+    stub_fail_init();
+    stub_warm_file = stub_getenv("TAI_STUB_WARM_FILE");
+    stub_regmap_init();
+    stub_store_init();
+    stub_attr_init();
+    stub_cache_init();
+    stub_presence_warm = false;
+    if (flags & TAI_API_INITIALIZE_FLAG_WARM_START) {
+        if ((NULL != stub_warm_file) &&
+            (TAI_STATUS_SUCCESS == stub_warm_restore(stub_warm_file))) {
+            stub_presence_warm = true;
+        } else {
+            TAI_SYSLOG_NOTICE("Warm start not possible, starting cold");
+        }
+    }
     initialized = true; 
+    stub_presence_start();
+    stub_threshold_start();
+    stub_pm_start();
 
     return TAI_STATUS_SUCCESS;
 }
@@ -799,8 +8495,21 @@ tai_status_t tai_api_query(_In_ tai_api_t tai_api_id,
  */
 tai_status_t tai_api_uninitialize(void)
 {
+    stub_presence_stop();
+    stub_threshold_stop();
+    stub_pm_stop();
+    stub_remove_all_subscriptions();
+    stub_async_wait_all();
+    stub_workers_stop();
+    stub_abort_all_transactions();
+    if ((NULL != stub_warm_file) && (TAI_STATUS_SUCCESS != stub_dump(stub_warm_file))) {
+        TAI_SYSLOG_ERROR("Failed to write the warm start snapshot %s", stub_warm_file);
+    }
+    stub_registry_clear();
+    stub_regmap_close();
     initialized = false;
     memset(&adapter_host_fns, 0, sizeof(adapter_host_fns));
+    stub_log_fini();
     closelog();
 
     return TAI_STATUS_SUCCESS;
@@ -816,16 +8525,37 @@ tai_status_t tai_api_uninitialize(void)
  */
 tai_object_type_t tai_object_type_query(_In_ tai_object_id_t tai_object_id)
 {
-    tai_object_type_t type = ((stub_object_id_t*)&tai_object_id)->type;
-  
-    if (TAI_OBJECT_TYPE_MAX > type) {
+    tai_object_type_t type = STUB_OID_TYPE(tai_object_id);
+
+    if ((TAI_OBJECT_TYPE_MAX > type) && stub_object_valid(tai_object_id, type)) {
         return type;
     } else {
-        TAI_SYSLOG_ERROR("Unknown type %d", type);
+        TAI_SYSLOG_ERROR("Unknown object id 0x%lx", tai_object_id);
         return TAI_OBJECT_TYPE_NULL;
     }
 }
 
+/**
+ * @brief Query tai module id.
+ *
+ * @param [in] tai_object_id
+ *
+ * @return Return #TAI_NULL_OBJECT_ID when tai_object_id is not valid.
+ *         Otherwise, return the module id of the object, or the object itself
+ *         if it is a module
+ */
+tai_object_id_t tai_module_id_query(_In_ tai_object_id_t tai_object_id)
+{
+    tai_object_type_t type = STUB_OID_TYPE(tai_object_id);
+
+    if ((TAI_OBJECT_TYPE_MAX <= type) || !stub_object_valid(tai_object_id, type)) {
+        TAI_SYSLOG_ERROR("Unknown object id 0x%lx", tai_object_id);
+        return TAI_NULL_OBJECT_ID;
+    }
+    return STUB_OID(TAI_OBJECT_TYPE_MODULE, STUB_OID_MODULE_INDEX(tai_object_id),
+                    0, STUB_OID_GENERATION(tai_object_id));
+}
+
 /**
  * @brief Set log level for a tai api module. The default log level is 
  *        TAI_LOG_WARN.
@@ -848,7 +8578,130 @@ tai_status_t tai_log_set(_In_ tai_api_t tai_api_id,
         return TAI_STATUS_INVALID_PARAMETER;
     }
 
-    api_log_level[tai_api_id] = tai_to_syslog_level[log_level];
+    stub_log_set_level(tai_api_id, log_level);
     return TAI_STATUS_SUCCESS;
 }
 
+/**
+ * @brief Generate dump file. The stub writes a binary snapshot of every object
+ *        and of its attributes, see stub_dump.h.
+ *
+ * @param [in] dump_file_name Full path for dump file
+ *
+ * @return #TAI_STATUS_SUCCESS on success, failure status code on error
+ */
+tai_status_t tai_dbg_generate_dump(_In_ const char *dump_file_name)
+{
+    if (NULL == dump_file_name) {
+        TAI_SYSLOG_ERROR("NULL dump file name passed");
+        return TAI_STATUS_INVALID_PARAMETER;
+    }
+    return stub_dump(dump_file_name);
+}
+
+
+
+/*------------------------------------------------------------------------------
+
+                          Module Adapter Interface
+
+------------------------------------------------------------------------------*/
+
+#ifdef STUB_MAI
+
+/*
+ * Built with -DSTUB_MAI and -fvisibility=hidden, the stub is a module adapter
+ * of the platform adapter (see inc/mai.h): only the mai_xxx functions are
+ * exported, and the tai_xxx ones stay private so that they do not clash with
+ * those of the platform adapter.
+ */
+#define STUB_MAI_EXPORT __attribute__((visibility("default")))
+
+static mai_service_method_table_t stub_mai_services;
+
+/** @brief Forward a presence change to the platform adapter */
+static void stub_mai_module_presence(
+    _In_ bool  present,
+    _In_ char *module_location)
+{
+    stub_mai_services.module_presence(stub_mai_services.context, present, module_location);
+}
+
+/** @brief Forward a batch of presence changes to the platform adapter */
+static void stub_mai_module_presence_batch(
+    _In_ uint32_t                           count,
+    _In_ const tai_module_presence_event_t *events)
+{
+    stub_mai_services.module_presence_batch(stub_mai_services.context, count, events);
+}
+
+/**
+ * @brief Module adapter initialization call
+ *
+ * @param [in] flags Bitmap of TAI_API_INITIALIZE_FLAG_xxx
+ * @param [in] services Methods table with services provided by the platform
+ *             adapter, and the namespace of the module adapter
+ *
+ * @return #TAI_STATUS_SUCCESS on success, failure status code on error
+ */
+STUB_MAI_EXPORT tai_status_t mai_api_initialize(
+    _In_ uint64_t                          flags,
+    _In_ const mai_service_method_table_t *services)
+{
+    tai_service_method_table_t tai_services = { 0 };
+
+    if ((NULL == services) || (NULL == services->module_presence) ||
+        (0 != (services->id_prefix & ~MAI_ID_PREFIX_MASK))) {
+        return TAI_STATUS_INVALID_PARAMETER;
+    }
+    stub_mai_services = *services;
+    stub_id_prefix = services->id_prefix;
+    stub_location_base = services->location_base;
+    tai_services.module_presence = stub_mai_module_presence;
+    if (NULL != services->module_presence_batch) {
+        tai_services.module_presence_batch = stub_mai_module_presence_batch;
+    }
+    return tai_api_initialize(flags, &tai_services);
+}
+
+/** @brief See tai_api_query() */
+STUB_MAI_EXPORT tai_status_t mai_api_query(
+    _In_ tai_api_t tai_api_id,
+    _Out_ void   **api_method_table)
+{
+    return tai_api_query(tai_api_id, api_method_table);
+}
+
+/** @brief See tai_api_uninitialize() */
+STUB_MAI_EXPORT tai_status_t mai_api_uninitialize(void)
+{
+    return tai_api_uninitialize();
+}
+
+/** @brief See tai_log_set() */
+STUB_MAI_EXPORT tai_status_t mai_log_set(
+    _In_ tai_api_t       tai_api_id,
+    _In_ tai_log_level_t log_level)
+{
+    return tai_log_set(tai_api_id, log_level);
+}
+
+/** @brief See tai_object_type_query() */
+STUB_MAI_EXPORT tai_object_type_t mai_object_type_query(_In_ tai_object_id_t tai_object_id)
+{
+    return tai_object_type_query(tai_object_id);
+}
+
+/** @brief See tai_module_id_query() */
+STUB_MAI_EXPORT tai_object_id_t mai_module_id_query(_In_ tai_object_id_t tai_object_id)
+{
+    return tai_module_id_query(tai_object_id);
+}
+
+/** @brief See tai_dbg_generate_dump() */
+STUB_MAI_EXPORT tai_status_t mai_dbg_generate_dump(_In_ const char *dump_file_name)
+{
+    return tai_dbg_generate_dump(dump_file_name);
+}
+
+#endif /* STUB_MAI */
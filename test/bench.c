@@ -0,0 +1,902 @@
+#include <tai.h>
+#include <taimetadata.h>
+#include <stub_dump.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/*
+ * Compares applying a configuration change to the network interfaces of a
+ * module with one set per attribute against a single transaction. The stub
+ * simulates the hardware write latency with TAI_STUB_SET_DELAY_MS, a fixed
+ * delay per write whatever its attributes, so the transaction gains only the
+ * writes it merges: the channel, grid and modulation format share a retune,
+ * and the output power is written on its own. A bulk set
+ * of the interfaces of every module is timed as well, the modules one after
+ * the other (STOP_ON_ERROR) and in parallel on their workers (IGNORE_ERROR).
+ *
+ * Then compares the CPU time spent by a host polling telemetry attributes to
+ * detect threshold crossings against thresholds evaluated by the adapter, and
+ * measures the latency of the threshold alarms. The same attributes are then
+ * subscribed to at the polling interval, the host detecting the crossings in
+ * the batches the adapter delivers, to measure the samples ingested per second
+ * and the CPU time of the host against polling.
+ *
+ * Finally brings up a simulated chassis from the presence events of the stub,
+ * the way an adapter host does at boot, and handles a presence storm: some
+ * of the modules are pulled out and inserted again every few milliseconds.
+ *
+ * At last backs the modules with register files (TAI_STUB_REGMAP_DIR) and
+ * counts the bus transactions of reading attributes one get at a time and
+ * with a single get per object, whose registers the stub reads in bursts.
+ */
+
+#define BENCH_MODULES       4
+#define BENCH_ITERATIONS    5
+#define BENCH_SET_DELAY_MS  "2"
+#define BENCH_ATTRS         4
+#define BENCH_TRANSACTION_WRITES 2  /* a retune, then the output power */
+#define BENCH_ALARM_MS      2000
+#define BENCH_POLL_MS       100
+#define BENCH_SLOTS         32
+#define BENCH_NUM_HOSTIFS   8
+#define BENCH_NUM_NETIFS    2
+#define BENCH_FLAP_SLOTS    8
+#define BENCH_FLAP_MS       20
+#define BENCH_STORM_MS      2000
+#define BENCH_QUEUE         1024
+#define BENCH_CACHE_TTL_MS  1000
+
+#define XSTR(x)             #x
+#define STR(x)              XSTR(x)
+
+tai_module_api_t *module_api;
+tai_network_interface_api_t *network_interface_api;
+tai_host_interface_api_t *host_interface_api;
+
+tai_object_id_t g_module_ids[BENCH_MODULES];
+tai_object_id_t g_netif_ids[BENCH_MODULES];
+
+void module_event(bool present, char * module_location)
+{
+}
+
+tai_service_method_table_t g_service_table = {
+    .module_presence = module_event
+};
+
+uint64_t g_alarm_count;
+uint64_t g_alarm_latency_ns;
+
+void module_threshold_alarm(tai_object_id_t module_id, const tai_threshold_alarm_t *alarm)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_REALTIME, &ts);
+    __atomic_add_fetch(&g_alarm_latency_ns,
+                       ts.tv_sec * 1000000000ULL + ts.tv_nsec - alarm->timestamp,
+                       __ATOMIC_RELAXED);
+    __atomic_add_fetch(&g_alarm_count, 1, __ATOMIC_RELAXED);
+}
+
+tai_module_notification_t g_module_notifications = {
+    .threshold_alarm = module_threshold_alarm
+};
+
+/* The monitored attributes, their object is the module or its netif */
+struct {
+    tai_object_type_t object_type;
+    tai_attr_id_t attr_id;
+} g_monitored[] = {
+    { TAI_OBJECT_TYPE_MODULE,    TAI_MODULE_ATTR_TEMP },
+    { TAI_OBJECT_TYPE_MODULE,    TAI_MODULE_ATTR_POWER },
+    { TAI_OBJECT_TYPE_NETWORKIF, TAI_NETWORK_INTERFACE_ATTR_CURRENT_BER },
+    { TAI_OBJECT_TYPE_NETWORKIF, TAI_NETWORK_INTERFACE_ATTR_CURRENT_INPUT_POWER },
+};
+
+#define BENCH_MONITORED     (sizeof(g_monitored)/sizeof(g_monitored[0]))
+
+float g_thresholds[BENCH_MODULES][BENCH_MONITORED];
+
+/* The presence events, queued by the presence thread of the adapter for the
+ * main thread, with the batch they came in and the time they were queued */
+struct {
+    bool present;
+    char location[TAI_MAX_HARDWARE_ID_LEN];
+    uint32_t batch;
+    double queued;
+} g_presence[BENCH_QUEUE];
+uint32_t g_presence_head, g_presence_tail, g_presence_batches;
+pthread_mutex_t g_presence_lock = PTHREAD_MUTEX_INITIALIZER;
+pthread_cond_t g_presence_cond = PTHREAD_COND_INITIALIZER;
+
+/* The objects of the modules in the chassis, by slot */
+struct {
+    tai_object_id_t module_id;
+    tai_object_id_t netif_ids[BENCH_NUM_NETIFS];
+    tai_object_id_t hostif_ids[BENCH_NUM_HOSTIFS];
+} g_chassis[BENCH_SLOTS];
+
+double clock_ms(clockid_t clock_id)
+{
+    struct timespec ts;
+
+    clock_gettime(clock_id, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+double now_ms()
+{
+    return clock_ms(CLOCK_MONOTONIC);
+}
+
+void sleep_ms(double ms)
+{
+    struct timespec ts;
+
+    ts.tv_sec = ms / 1000;
+    ts.tv_nsec = (ms - ts.tv_sec * 1000) * 1000000;
+    nanosleep(&ts, NULL);
+}
+
+void fill_attrs(tai_attribute_t *attr, int iteration)
+{
+    attr[0].id = TAI_NETWORK_INTERFACE_ATTR_TX_GRID_SPACING;
+    attr[0].value.u32 = TAI_NETWORK_INTERFACE_TX_GRID_SPACING_50_GHZ;
+    attr[1].id = TAI_NETWORK_INTERFACE_ATTR_TX_CHANNEL;
+    attr[1].value.u16 = 1 + iteration;
+    attr[2].id = TAI_NETWORK_INTERFACE_ATTR_OUTPUT_POWER;
+    attr[2].value.flt = -1.0 - iteration;
+    attr[3].id = TAI_NETWORK_INTERFACE_ATTR_MODULATION_FORMAT;
+    attr[3].value.u32 = (iteration % 2) ? TAI_NETWORK_INTERFACE_MODULATION_FORMAT_DP_16_QAM :
+                                          TAI_NETWORK_INTERFACE_MODULATION_FORMAT_DP_QPSK;
+}
+
+tai_status_t create_objects()
+{
+    tai_status_t status;
+    tai_attribute_t attr;
+    char location[8];
+    int i;
+
+    for (i = 0; i < BENCH_MODULES; i++) {
+        snprintf(location, sizeof(location), "%d", i + 1);
+        attr.id = TAI_MODULE_ATTR_LOCATION;
+        attr.value.charlist.count = strlen(location);
+        attr.value.charlist.list = location;
+        status = module_api->create_module(&g_module_ids[i], 1, &attr,
+                                           &g_module_notifications);
+        if ( status != TAI_STATUS_SUCCESS ) {
+            return status;
+        }
+        attr.id = TAI_NETWORK_INTERFACE_ATTR_INDEX;
+        attr.value.u32 = 0;
+        status = network_interface_api->create_network_interface(
+           &g_netif_ids[i], g_module_ids[i], 1, &attr);
+        if ( status != TAI_STATUS_SUCCESS ) {
+            return status;
+        }
+    }
+    return TAI_STATUS_SUCCESS;
+}
+
+tai_status_t bench_sets(double *elapsed)
+{
+    tai_status_t status;
+    tai_attribute_t attr[BENCH_ATTRS];
+    double start;
+    int n, i, a;
+
+    start = now_ms();
+    for (n = 0; n < BENCH_ITERATIONS; n++) {
+        fill_attrs(attr, n);
+        for (i = 0; i < BENCH_MODULES; i++) {
+            for (a = 0; a < BENCH_ATTRS; a++) {
+                status = network_interface_api->set_network_interface_attribute(
+                   g_netif_ids[i], &attr[a]);
+                if ( status != TAI_STATUS_SUCCESS ) {
+                    return status;
+                }
+            }
+        }
+    }
+    *elapsed = (now_ms() - start) / (BENCH_ITERATIONS * BENCH_MODULES);
+    return TAI_STATUS_SUCCESS;
+}
+
+tai_status_t bench_transactions(double *elapsed)
+{
+    tai_status_t status;
+    tai_transaction_id_t txn;
+    tai_attribute_t attr[BENCH_ATTRS];
+    double start;
+    int n, i;
+
+    start = now_ms();
+    for (n = 0; n < BENCH_ITERATIONS; n++) {
+        fill_attrs(attr, n);
+        for (i = 0; i < BENCH_MODULES; i++) {
+            status = module_api->begin_transaction(&txn, g_module_ids[i]);
+            if ( status != TAI_STATUS_SUCCESS ) {
+                return status;
+            }
+            status = module_api->stage_attributes(txn, g_netif_ids[i], BENCH_ATTRS, attr);
+            if ( status != TAI_STATUS_SUCCESS ) {
+                module_api->abort_transaction(txn);
+                return status;
+            }
+            status = module_api->commit_transaction(txn);
+            if ( status != TAI_STATUS_SUCCESS ) {
+                return status;
+            }
+        }
+    }
+    *elapsed = (now_ms() - start) / (BENCH_ITERATIONS * BENCH_MODULES);
+    return TAI_STATUS_SUCCESS;
+}
+
+tai_status_t bench_bulk(tai_bulk_op_error_mode_t mode, double *elapsed)
+{
+    tai_status_t status;
+    tai_status_t statuses[BENCH_MODULES];
+    tai_attribute_t attr[BENCH_ATTRS];
+    const tai_attribute_t *attr_list[BENCH_MODULES];
+    uint32_t attr_count[BENCH_MODULES];
+    double start;
+    int n, i;
+
+    for (i = 0; i < BENCH_MODULES; i++) {
+        attr_list[i] = attr;
+        attr_count[i] = BENCH_ATTRS;
+    }
+    start = now_ms();
+    for (n = 0; n < BENCH_ITERATIONS; n++) {
+        fill_attrs(attr, n);
+        status = network_interface_api->bulk_set_network_interface_attributes(
+           BENCH_MODULES, g_netif_ids, attr_count, attr_list, mode, statuses);
+        if ( status != TAI_STATUS_SUCCESS ) {
+            return status;
+        }
+    }
+    *elapsed = (now_ms() - start) / BENCH_ITERATIONS;
+    return TAI_STATUS_SUCCESS;
+}
+
+tai_status_t read_monitored(int module, int monitored, float *value)
+{
+    tai_status_t status;
+    tai_attribute_t attr;
+
+    attr.id = g_monitored[monitored].attr_id;
+    if (g_monitored[monitored].object_type == TAI_OBJECT_TYPE_MODULE) {
+        status = module_api->get_module_attribute(g_module_ids[module], &attr);
+    } else {
+        status = network_interface_api->get_network_interface_attribute(
+           g_netif_ids[module], &attr);
+    }
+    *value = attr.value.flt;
+    return status;
+}
+
+/* The thresholds are set to the current values, so that the jitter of the
+ * simulated telemetry crosses them often */
+tai_status_t init_thresholds()
+{
+    tai_status_t status;
+    int i, m;
+
+    for (i = 0; i < BENCH_MODULES; i++) {
+        for (m = 0; m < BENCH_MONITORED; m++) {
+            status = read_monitored(i, m, &g_thresholds[i][m]);
+            if ( status != TAI_STATUS_SUCCESS ) {
+                return status;
+            }
+        }
+    }
+    return TAI_STATUS_SUCCESS;
+}
+
+tai_status_t bench_polling(double *cpu_ms, double *host_cpu_ms, uint64_t *crossings)
+{
+    tai_status_t status;
+    bool above[BENCH_MODULES][BENCH_MONITORED] = {{ false }};
+    double start, cpu, host_cpu, next;
+    float value;
+    int i, m;
+
+    *crossings = 0;
+    cpu = clock_ms(CLOCK_PROCESS_CPUTIME_ID);
+    host_cpu = clock_ms(CLOCK_THREAD_CPUTIME_ID);
+    start = now_ms();
+    for (next = start; next < start + BENCH_ALARM_MS; next += BENCH_POLL_MS) {
+        for (i = 0; i < BENCH_MODULES; i++) {
+            for (m = 0; m < BENCH_MONITORED; m++) {
+                status = read_monitored(i, m, &value);
+                if ( status != TAI_STATUS_SUCCESS ) {
+                    return status;
+                }
+                if ((value > g_thresholds[i][m]) != above[i][m]) {
+                    above[i][m] = !above[i][m];
+                    (*crossings)++;
+                }
+            }
+        }
+        sleep_ms(next + BENCH_POLL_MS - now_ms());
+    }
+    *cpu_ms = clock_ms(CLOCK_PROCESS_CPUTIME_ID) - cpu;
+    *host_cpu_ms = clock_ms(CLOCK_THREAD_CPUTIME_ID) - host_cpu;
+    return TAI_STATUS_SUCCESS;
+}
+
+tai_status_t set_thresholds(bool enabled)
+{
+    tai_status_t status;
+    tai_attribute_threshold_t threshold;
+    int i, m;
+
+    for (i = 0; i < BENCH_MODULES; i++) {
+        for (m = 0; m < BENCH_MONITORED; m++) {
+            memset(&threshold, 0, sizeof(threshold));
+            threshold.object_id = (g_monitored[m].object_type == TAI_OBJECT_TYPE_MODULE) ?
+                                  g_module_ids[i] : g_netif_ids[i];
+            threshold.attr_id = g_monitored[m].attr_id;
+            threshold.high_enabled = enabled;
+            threshold.high = g_thresholds[i][m];
+            status = module_api->set_attribute_threshold(&threshold);
+            if ( status != TAI_STATUS_SUCCESS ) {
+                return status;
+            }
+        }
+    }
+    return TAI_STATUS_SUCCESS;
+}
+
+/* A subscription to the monitored attributes of one object of a module, the
+ * module or its netif, the samples coming in the order of g_monitored */
+struct {
+    int module;
+    int first;          /* the first monitored attribute of the object */
+    int count;
+} g_subscribed[BENCH_MODULES * 2];
+
+bool g_sub_above[BENCH_MODULES][BENCH_MONITORED];
+uint64_t g_sub_samples, g_sub_batches, g_sub_crossings;
+
+void subscription_batch(tai_subscription_id_t subscription_id, void *context,
+                        uint32_t sample_count, const tai_attribute_sample_t *samples)
+{
+    int s = (int)(intptr_t)context;
+    int i = g_subscribed[s].module;
+    int m;
+    uint32_t n, crossings = 0;
+
+    for (n = 0; n < sample_count; n++) {
+        m = g_subscribed[s].first + n % g_subscribed[s].count;
+        if ((samples[n].attr.value.flt > g_thresholds[i][m]) != g_sub_above[i][m]) {
+            g_sub_above[i][m] = !g_sub_above[i][m];
+            crossings++;
+        }
+    }
+    __atomic_add_fetch(&g_sub_samples, sample_count, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&g_sub_batches, 1, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&g_sub_crossings, crossings, __ATOMIC_RELAXED);
+}
+
+tai_status_t bench_subscriptions(double *cpu_ms, double *host_cpu_ms)
+{
+    tai_status_t status = TAI_STATUS_SUCCESS;
+    tai_subscription_id_t ids[BENCH_MODULES * 2];
+    tai_attribute_subscription_t sub;
+    tai_attr_id_t attr_ids[BENCH_MONITORED];
+    tai_object_id_t object_id;
+    double cpu, host_cpu;
+    int created = 0;
+    int i, m, s;
+
+    cpu = clock_ms(CLOCK_PROCESS_CPUTIME_ID);
+    host_cpu = clock_ms(CLOCK_THREAD_CPUTIME_ID);
+    /* g_monitored lists the attributes of the module, then those of the netif */
+    for (i = 0; i < BENCH_MODULES && status == TAI_STATUS_SUCCESS; i++) {
+        for (m = 0; m < BENCH_MONITORED && status == TAI_STATUS_SUCCESS; created++) {
+            s = created;
+            g_subscribed[s].module = i;
+            g_subscribed[s].first = m;
+            g_subscribed[s].count = 0;
+            memset(&sub, 0, sizeof(sub));
+            sub.object_type = g_monitored[m].object_type;
+            for (; m < BENCH_MONITORED && g_monitored[m].object_type == sub.object_type; m++) {
+                attr_ids[g_subscribed[s].count++] = g_monitored[m].attr_id;
+            }
+            object_id = (sub.object_type == TAI_OBJECT_TYPE_MODULE) ?
+                        g_module_ids[i] : g_netif_ids[i];
+            sub.object_count = 1;
+            sub.object_list = &object_id;
+            sub.attr_count = g_subscribed[s].count;
+            sub.attr_list = attr_ids;
+            sub.interval_us = BENCH_POLL_MS * 1000;
+            sub.notify = subscription_batch;
+            sub.context = (void *)(intptr_t)s;
+            status = module_api->create_attribute_subscription(&ids[s], g_module_ids[i], &sub);
+        }
+    }
+    if ( status == TAI_STATUS_SUCCESS ) {
+        sleep_ms(BENCH_ALARM_MS);
+    } else {
+        created--;      /* the last one was not created */
+    }
+    for (s = 0; s < created; s++) {
+        module_api->remove_attribute_subscription(ids[s]);
+    }
+    *cpu_ms = clock_ms(CLOCK_PROCESS_CPUTIME_ID) - cpu;
+    *host_cpu_ms = clock_ms(CLOCK_THREAD_CPUTIME_ID) - host_cpu;
+    return status;
+}
+
+tai_status_t bench_alarms(double *cpu_ms, double *host_cpu_ms)
+{
+    tai_status_t status;
+    double cpu, host_cpu;
+
+    status = set_thresholds(true);
+    if ( status != TAI_STATUS_SUCCESS ) {
+        return status;
+    }
+    cpu = clock_ms(CLOCK_PROCESS_CPUTIME_ID);
+    host_cpu = clock_ms(CLOCK_THREAD_CPUTIME_ID);
+    sleep_ms(BENCH_ALARM_MS);
+    *cpu_ms = clock_ms(CLOCK_PROCESS_CPUTIME_ID) - cpu;
+    *host_cpu_ms = clock_ms(CLOCK_THREAD_CPUTIME_ID) - host_cpu;
+    return set_thresholds(false);
+}
+
+void module_presence_batch(uint32_t count, const tai_module_presence_event_t *events)
+{
+    double queued = now_ms();
+    uint32_t i;
+
+    pthread_mutex_lock(&g_presence_lock);
+    g_presence_batches++;
+    for (i = 0; i < count; i++) {
+        if ((g_presence_head + 1) % BENCH_QUEUE == g_presence_tail) {
+            printf("presence queue full, event dropped\n");
+            break;
+        }
+        g_presence[g_presence_head].present = events[i].present;
+        strncpy(g_presence[g_presence_head].location, events[i].module_location,
+                TAI_MAX_HARDWARE_ID_LEN - 1);
+        g_presence[g_presence_head].batch = g_presence_batches;
+        g_presence[g_presence_head].queued = queued;
+        g_presence_head = (g_presence_head + 1) % BENCH_QUEUE;
+    }
+    pthread_cond_signal(&g_presence_cond);
+    pthread_mutex_unlock(&g_presence_lock);
+}
+
+tai_service_method_table_t g_chassis_service_table = {
+    .module_presence_batch = module_presence_batch
+};
+
+/* Create a module found in a slot with all of its interfaces */
+tai_status_t insert_module(int slot, char *location)
+{
+    tai_status_t status;
+    tai_attribute_t attr;
+    int i;
+
+    attr.id = TAI_MODULE_ATTR_LOCATION;
+    attr.value.charlist.count = strlen(location);
+    attr.value.charlist.list = location;
+    status = module_api->create_module(&g_chassis[slot].module_id, 1, &attr,
+                                       &g_module_notifications);
+    if ( status != TAI_STATUS_SUCCESS ) {
+        return status;
+    }
+    for (i = 0; i < BENCH_NUM_NETIFS; i++) {
+        attr.id = TAI_NETWORK_INTERFACE_ATTR_INDEX;
+        attr.value.u32 = i;
+        status = network_interface_api->create_network_interface(
+           &g_chassis[slot].netif_ids[i], g_chassis[slot].module_id, 1, &attr);
+        if ( status != TAI_STATUS_SUCCESS ) {
+            return status;
+        }
+    }
+    for (i = 0; i < BENCH_NUM_HOSTIFS; i++) {
+        attr.id = TAI_HOST_INTERFACE_ATTR_INDEX;
+        attr.value.u32 = i;
+        status = host_interface_api->create_host_interface(
+           &g_chassis[slot].hostif_ids[i], g_chassis[slot].module_id, 1, &attr);
+        if ( status != TAI_STATUS_SUCCESS ) {
+            return status;
+        }
+    }
+    return TAI_STATUS_SUCCESS;
+}
+
+/* Remove a module pulled out of its slot, its interfaces first */
+tai_status_t remove_module(int slot)
+{
+    tai_status_t status;
+    int i;
+
+    for (i = 0; i < BENCH_NUM_HOSTIFS; i++) {
+        status = host_interface_api->remove_host_interface(g_chassis[slot].hostif_ids[i]);
+        if ( status != TAI_STATUS_SUCCESS ) {
+            return status;
+        }
+    }
+    for (i = 0; i < BENCH_NUM_NETIFS; i++) {
+        status = network_interface_api->remove_network_interface(g_chassis[slot].netif_ids[i]);
+        if ( status != TAI_STATUS_SUCCESS ) {
+            return status;
+        }
+    }
+    status = module_api->remove_module(g_chassis[slot].module_id);
+    g_chassis[slot].module_id = TAI_NULL_OBJECT_ID;
+    return status;
+}
+
+/* Handle the presence events on the main thread until the storm is over:
+ * the bring-up time is the time until the boot burst, the first batch, is
+ * handled, the latency of an event the time it waited in the queue */
+tai_status_t bench_chassis(double *bringup_ms, uint64_t *events, double *latency_ms,
+                           double *max_latency_ms, double *host_cpu_ms)
+{
+    tai_status_t status = TAI_STATUS_SUCCESS;
+    struct timespec ts;
+    double start, end, cpu, latency;
+    bool present;
+    char location[TAI_MAX_HARDWARE_ID_LEN];
+    uint32_t batch;
+    int slot;
+
+    *bringup_ms = 0;
+    *events = 0;
+    *latency_ms = 0;
+    *max_latency_ms = 0;
+    start = now_ms();
+    end = start + BENCH_STORM_MS;
+    cpu = clock_ms(CLOCK_THREAD_CPUTIME_ID);
+    status = tai_api_initialize(0, &g_chassis_service_table);
+    if ( status != TAI_STATUS_SUCCESS ) {
+        return status;
+    }
+    if ( (tai_api_query(TAI_API_MODULE, (void**)&module_api) != TAI_STATUS_SUCCESS) ||
+         (tai_api_query(TAI_API_NETWORKIF, (void**)&network_interface_api) != TAI_STATUS_SUCCESS) ||
+         (tai_api_query(TAI_API_HOSTIF, (void**)&host_interface_api) != TAI_STATUS_SUCCESS) ) {
+        return TAI_STATUS_FAILURE;
+    }
+
+    pthread_mutex_lock(&g_presence_lock);
+    while ( now_ms() < end ) {
+        if (g_presence_head == g_presence_tail) {
+            clock_gettime(CLOCK_REALTIME, &ts);
+            ts.tv_nsec += 10000000;
+            if (ts.tv_nsec >= 1000000000) {
+                ts.tv_sec++;
+                ts.tv_nsec -= 1000000000;
+            }
+            pthread_cond_timedwait(&g_presence_cond, &g_presence_lock, &ts);
+            continue;
+        }
+        present = g_presence[g_presence_tail].present;
+        strcpy(location, g_presence[g_presence_tail].location);
+        batch = g_presence[g_presence_tail].batch;
+        latency = now_ms() - g_presence[g_presence_tail].queued;
+        g_presence_tail = (g_presence_tail + 1) % BENCH_QUEUE;
+        pthread_mutex_unlock(&g_presence_lock);
+
+        slot = atoi(location) - 1;
+        if ((slot < 0) || (slot >= BENCH_SLOTS)) {
+            status = TAI_STATUS_FAILURE;
+        } else if (present && (g_chassis[slot].module_id == TAI_NULL_OBJECT_ID)) {
+            status = insert_module(slot, location);
+        } else if (!present && (g_chassis[slot].module_id != TAI_NULL_OBJECT_ID)) {
+            status = remove_module(slot);
+        }
+        if ( status != TAI_STATUS_SUCCESS ) {
+            tai_api_uninitialize();
+            return status;
+        }
+        (*events)++;
+        *latency_ms += latency;
+        if (latency > *max_latency_ms) {
+            *max_latency_ms = latency;
+        }
+        if ((batch == 1) && (g_presence_head == g_presence_tail ||
+                             g_presence[g_presence_tail].batch != 1)) {
+            *bringup_ms = now_ms() - start;
+        }
+        pthread_mutex_lock(&g_presence_lock);
+    }
+    pthread_mutex_unlock(&g_presence_lock);
+    *host_cpu_ms = clock_ms(CLOCK_THREAD_CPUTIME_ID) - cpu;
+    if (*events != 0) {
+        *latency_ms /= *events;
+    }
+    return tai_api_uninitialize();
+}
+
+/* The attributes of a module and of its network interface backed by the
+ * register map of the stub */
+tai_attr_id_t g_register_module_attrs[] = {
+    TAI_MODULE_ATTR_OPER_STATUS,
+    TAI_MODULE_ATTR_TEMP,
+    TAI_MODULE_ATTR_POWER,
+    TAI_MODULE_ATTR_ADMIN_STATUS,
+    TAI_MODULE_ATTR_VENDOR_NAME,
+    TAI_MODULE_ATTR_VENDOR_PART_NUMBER,
+    TAI_MODULE_ATTR_VENDOR_SERIAL_NUMBER,
+};
+tai_attr_id_t g_register_netif_attrs[] = {
+    TAI_NETWORK_INTERFACE_ATTR_TX_ENABLE,
+    TAI_NETWORK_INTERFACE_ATTR_CURRENT_OUTPUT_POWER,
+    TAI_NETWORK_INTERFACE_ATTR_CURRENT_INPUT_POWER,
+    TAI_NETWORK_INTERFACE_ATTR_TX_LASER_FREQ,
+    TAI_NETWORK_INTERFACE_ATTR_CURRENT_BER,
+};
+
+#define BENCH_MODULE_REGS   (sizeof(g_register_module_attrs)/sizeof(g_register_module_attrs[0]))
+#define BENCH_NETIF_REGS    (sizeof(g_register_netif_attrs)/sizeof(g_register_netif_attrs[0]))
+#define BENCH_REGS          (BENCH_MODULE_REGS + BENCH_NETIF_REGS)
+
+/* The bus transaction counter of the stub, in byte 132 of page 80h of the
+ * register file of a module */
+#define BENCH_TRANSACTIONS_OFFSET   (128 + 0x80 * 128 + 4)
+
+uint32_t read_transactions(int fd)
+{
+    unsigned char raw[4] = { 0 };
+
+    if (pread(fd, raw, sizeof(raw), BENCH_TRANSACTIONS_OFFSET) != sizeof(raw)) {
+        return 0;
+    }
+    return ((uint32_t)raw[0] << 24) | (raw[1] << 16) | (raw[2] << 8) | raw[3];
+}
+
+void fill_register_attrs(tai_attribute_t *attr, char (*lists)[32])
+{
+    int i;
+
+    for (i = 0; i < BENCH_REGS; i++) {
+        attr[i].id = (i < BENCH_MODULE_REGS) ? g_register_module_attrs[i] :
+                                               g_register_netif_attrs[i - BENCH_MODULE_REGS];
+        attr[i].value.charlist.count = sizeof(lists[i]);
+        attr[i].value.charlist.list = lists[i];
+    }
+}
+
+/* Read the register backed attributes of a module and its network interface
+ * one get per attribute, then with one get per object, and count the bus
+ * transactions of the stub */
+tai_status_t bench_registers(const char *file, uint32_t *single, uint32_t *planned)
+{
+    tai_status_t status = TAI_STATUS_SUCCESS;
+    tai_attribute_t attr[BENCH_REGS];
+    char lists[BENCH_REGS][32];
+    uint32_t start;
+    int fd, n, i;
+
+    fd = open(file, O_RDONLY);
+    if (fd < 0) {
+        return TAI_STATUS_FAILURE;
+    }
+    start = read_transactions(fd);
+    for (n = 0; (n < BENCH_ITERATIONS) && (status == TAI_STATUS_SUCCESS); n++) {
+        fill_register_attrs(attr, lists);
+        for (i = 0; (i < BENCH_MODULE_REGS) && (status == TAI_STATUS_SUCCESS); i++) {
+            status = module_api->get_module_attribute(g_module_ids[0], &attr[i]);
+        }
+        for (; (i < BENCH_REGS) && (status == TAI_STATUS_SUCCESS); i++) {
+            status = network_interface_api->get_network_interface_attribute(
+               g_netif_ids[0], &attr[i]);
+        }
+    }
+    *single = (read_transactions(fd) - start) / BENCH_ITERATIONS;
+    start = read_transactions(fd);
+    for (n = 0; (n < BENCH_ITERATIONS) && (status == TAI_STATUS_SUCCESS); n++) {
+        fill_register_attrs(attr, lists);
+        status = module_api->get_module_attributes(g_module_ids[0], BENCH_MODULE_REGS, attr);
+        if ( status == TAI_STATUS_SUCCESS ) {
+            status = network_interface_api->get_network_interface_attributes(
+               g_netif_ids[0], BENCH_NETIF_REGS, &attr[BENCH_MODULE_REGS]);
+        }
+    }
+    *planned = (read_transactions(fd) - start) / BENCH_ITERATIONS;
+    close(fd);
+    return status;
+}
+
+/* Bring the modules up with their register files in 'dir', read their
+ * registers, then read the attribute cache counters of the stub from a dump */
+tai_status_t bench_register_run(const char *dir, uint32_t *single, uint32_t *planned,
+                                uint64_t *hits, uint64_t *misses)
+{
+    stub_dump_header_t hdr;
+    char file[64];
+    tai_status_t status;
+    int fd;
+
+    status = tai_api_initialize(0, &g_service_table);
+    if ( status == TAI_STATUS_SUCCESS ) {
+        status = create_objects();
+    }
+    if ( status == TAI_STATUS_SUCCESS ) {
+        snprintf(file, sizeof(file), "%s/1.cmis", dir);
+        status = bench_registers(file, single, planned);
+    }
+    if ( status == TAI_STATUS_SUCCESS ) {
+        snprintf(file, sizeof(file), "%s/dump", dir);
+        status = tai_dbg_generate_dump(file);
+    }
+    if ( status == TAI_STATUS_SUCCESS ) {
+        fd = open(file, O_RDONLY);
+        if ( (fd < 0) || (pread(fd, &hdr, sizeof(hdr), 0) != sizeof(hdr)) ) {
+            status = TAI_STATUS_FAILURE;
+        } else {
+            *hits = hdr.cache_hits;
+            *misses = hdr.cache_misses;
+        }
+        if ( fd >= 0 ) {
+            close(fd);
+        }
+        unlink(file);
+    }
+    tai_api_uninitialize();
+    return status;
+}
+
+int main() {
+    tai_status_t status;
+    double sets, transactions, bulk_sequential, bulk_parallel;
+    double polling_cpu, polling_host_cpu, alarms_cpu, alarms_host_cpu;
+    double subscriptions_cpu, subscriptions_host_cpu;
+    uint64_t crossings, alarms;
+    double bringup, latency, max_latency, chassis_host_cpu;
+    uint64_t events;
+    char regmap_dir[] = "/tmp/tai-bench-XXXXXX";
+    char regmap_file[sizeof(regmap_dir) + 16];
+    uint32_t single, planned;
+    uint32_t immutable_single, immutable_planned, ttl_single, ttl_planned;
+    uint64_t hits, misses, immutable_hits, immutable_misses;
+    int i;
+
+    setenv("TAI_STUB_SET_DELAY_MS", BENCH_SET_DELAY_MS, 1);
+    status = tai_api_initialize(0, &g_service_table);
+    if ( status != TAI_STATUS_SUCCESS ) {
+        printf("failed to initialize TAI\n");
+        return 1;
+    }
+    if ( (tai_api_query(TAI_API_MODULE, (void**)&module_api) != TAI_STATUS_SUCCESS) ||
+         (tai_api_query(TAI_API_NETWORKIF, (void**)&network_interface_api) != TAI_STATUS_SUCCESS) ) {
+        printf("failed to query the TAI APIs\n");
+        return 1;
+    }
+    status = create_objects();
+    if ( status != TAI_STATUS_SUCCESS ) {
+        printf("failed to create the objects: %d\n", status);
+        return 1;
+    }
+
+    status = bench_sets(&sets);
+    if ( status != TAI_STATUS_SUCCESS ) {
+        printf("per-attribute sets failed: %d\n", status);
+        return 1;
+    }
+    status = bench_transactions(&transactions);
+    if ( status != TAI_STATUS_SUCCESS ) {
+        printf("transactions failed: %d\n", status);
+        return 1;
+    }
+    status = bench_bulk(TAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR, &bulk_sequential);
+    if ( status == TAI_STATUS_SUCCESS ) {
+        status = bench_bulk(TAI_BULK_OP_ERROR_MODE_IGNORE_ERROR, &bulk_parallel);
+    }
+    if ( status != TAI_STATUS_SUCCESS ) {
+        printf("bulk sets failed: %d\n", status);
+        return 1;
+    }
+    printf("%d attributes per interface, %s ms per hardware write whatever its attributes, "
+           "%d writes one set per attribute against %d for a transaction\n",
+           BENCH_ATTRS, BENCH_SET_DELAY_MS, BENCH_ATTRS, BENCH_TRANSACTION_WRITES);
+    printf("per-attribute sets: %8.3f ms per interface\n", sets);
+    printf("transaction commit: %8.3f ms per interface\n", transactions);
+    printf("bulk set:           %8.3f ms for %d modules one after the other, "
+           "%.3f ms in parallel\n", bulk_sequential, BENCH_MODULES, bulk_parallel);
+
+    status = init_thresholds();
+    if ( status == TAI_STATUS_SUCCESS ) {
+        status = bench_polling(&polling_cpu, &polling_host_cpu, &crossings);
+    }
+    if ( status != TAI_STATUS_SUCCESS ) {
+        printf("polling failed: %d\n", status);
+        return 1;
+    }
+    status = bench_alarms(&alarms_cpu, &alarms_host_cpu);
+    if ( status != TAI_STATUS_SUCCESS ) {
+        printf("threshold alarms failed: %d\n", status);
+        return 1;
+    }
+    status = bench_subscriptions(&subscriptions_cpu, &subscriptions_host_cpu);
+    if ( status != TAI_STATUS_SUCCESS ) {
+        printf("subscriptions failed: %d\n", status);
+        return 1;
+    }
+    alarms = __atomic_load_n(&g_alarm_count, __ATOMIC_RELAXED);
+    printf("%d attributes monitored for %d ms\n",
+           (int)(BENCH_MODULES * BENCH_MONITORED), BENCH_ALARM_MS);
+    printf("host polling:       %8.3f ms of CPU, %8.3f ms in the host thread, %lu crossings\n",
+           polling_cpu, polling_host_cpu, crossings);
+    printf("adapter alarms:     %8.3f ms of CPU, %8.3f ms in the host thread, %lu crossings, "
+           "%.3f ms mean latency\n", alarms_cpu, alarms_host_cpu, alarms,
+           alarms ? __atomic_load_n(&g_alarm_latency_ns, __ATOMIC_RELAXED) / 1e6 / alarms : 0.0);
+    printf("subscriptions:      %8.3f ms of CPU, %8.3f ms in the host thread, %lu crossings, "
+           "%.0f samples per second in %lu batches\n", subscriptions_cpu,
+           subscriptions_host_cpu, g_sub_crossings, g_sub_samples * 1000.0 / BENCH_ALARM_MS,
+           g_sub_batches);
+
+    status = tai_api_uninitialize();
+    if ( status != TAI_STATUS_SUCCESS ) {
+        printf("failed to uninitialize TAI\n");
+        return 1;
+    }
+
+    setenv("TAI_STUB_SET_DELAY_MS", "0", 1);
+    setenv("TAI_STUB_PRESENCE_BURST", STR(BENCH_SLOTS), 1);
+    setenv("TAI_STUB_NUM_HOST_INTERFACES", STR(BENCH_NUM_HOSTIFS), 1);
+    setenv("TAI_STUB_NUM_NETWORK_INTERFACES", STR(BENCH_NUM_NETIFS), 1);
+    setenv("TAI_STUB_FLAP_SLOTS", STR(BENCH_FLAP_SLOTS), 1);
+    setenv("TAI_STUB_FLAP_MS", STR(BENCH_FLAP_MS), 1);
+    status = bench_chassis(&bringup, &events, &latency, &max_latency, &chassis_host_cpu);
+    if ( status != TAI_STATUS_SUCCESS ) {
+        printf("chassis failed: %d\n", status);
+        return 1;
+    }
+    printf("chassis bring-up:   %8.3f ms for %d modules of %d objects\n",
+           bringup, BENCH_SLOTS, 1 + BENCH_NUM_NETIFS + BENCH_NUM_HOSTIFS);
+    printf("presence storm:     %d slots flapping every %d ms for %d ms, %lu events, "
+           "%.3f ms mean latency, %.3f ms max, %.3f ms of CPU per event in the host thread\n",
+           BENCH_FLAP_SLOTS, BENCH_FLAP_MS, BENCH_STORM_MS, events, latency, max_latency,
+           events ? chassis_host_cpu / events : 0.0);
+
+    if ( mkdtemp(regmap_dir) == NULL ) {
+        printf("failed to create the register files directory\n");
+        return 1;
+    }
+    setenv("TAI_STUB_REGMAP_DIR", regmap_dir, 1);
+    setenv("TAI_STUB_PRESENCE_BURST", "0", 1);
+    setenv("TAI_STUB_FLAP_SLOTS", "0", 1);
+    setenv("TAI_STUB_CACHE", "0", 1);
+    status = bench_register_run(regmap_dir, &single, &planned, &hits, &misses);
+    setenv("TAI_STUB_CACHE", "1", 1);
+    if ( status == TAI_STATUS_SUCCESS ) {
+        status = bench_register_run(regmap_dir, &immutable_single, &immutable_planned,
+                                    &immutable_hits, &immutable_misses);
+    }
+    setenv("TAI_STUB_CACHE_TTL_MS", STR(BENCH_CACHE_TTL_MS), 1);
+    if ( status == TAI_STATUS_SUCCESS ) {
+        status = bench_register_run(regmap_dir, &ttl_single, &ttl_planned, &hits, &misses);
+    }
+    for (i = 0; i < BENCH_MODULES; i++) {
+        snprintf(regmap_file, sizeof(regmap_file), "%s/%d.cmis", regmap_dir, i + 1);
+        unlink(regmap_file);
+    }
+    rmdir(regmap_dir);
+    if ( status != TAI_STATUS_SUCCESS ) {
+        printf("register reads failed: %d\n", status);
+        return 1;
+    }
+    printf("register reads:     %d attributes of a module and its interface, "
+           "%u bus transactions one get at a time, %u with one get per object\n",
+           (int)BENCH_REGS, single, planned);
+    printf("attribute cache:    %u and %u bus transactions with the immutable attributes "
+           "cached (%lu hits, %lu misses), %u and %u with a %d ms TTL as well "
+           "(%lu hits, %lu misses)\n",
+           immutable_single, immutable_planned, immutable_hits, immutable_misses,
+           ttl_single, ttl_planned, BENCH_CACHE_TTL_MS, hits, misses);
+    return 0;
+}
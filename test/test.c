@@ -1,5 +1,8 @@
 #include <tai.h>
+#include <mai.h>
+#include <taimetadata.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
 
@@ -117,11 +120,698 @@ tai_status_t create_modules() {
             return status;
         }
 
+        attr[0].id = TAI_MODULE_ATTR_OPER_STATUS;
+        attr[0].value.s32 = TAI_MODULE_OPER_STATUS_READY;
+
+        status = module_api->set_module_attribute(
+           g_module_ids[g_module_location_tail], &attr[0]);
+        if ( status == TAI_STATUS_SUCCESS ) {
+            printf("%s is read-only but could be set\n",
+                   tai_metadata_get_attr_metadata(TAI_OBJECT_TYPE_MODULE,
+                                                  attr[0].id)->attridname);
+            return TAI_STATUS_FAILURE;
+        }
+        status = TAI_STATUS_SUCCESS;
+
         g_module_location_tail = (g_module_location_tail + 1) % (TAI_MAX_MODULES+1);
     }
     return status;
 }
 
+tai_status_t test_alloc_lists(int module) {
+    tai_status_t status;
+    tai_object_id_t module_id = g_module_ids[module];
+    tai_object_map_t maps[TAI_MAX_NET_IFS];
+    tai_object_id_t oids[TAI_MAX_NET_IFS][TAI_MAX_HOST_IFS];
+    tai_object_map_list_t *mapping;
+    tai_attribute_t attr[5], fixed;
+    int i;
+
+    attr[0].id = TAI_MODULE_ATTR_VENDOR_NAME;
+    attr[1].id = TAI_MODULE_ATTR_FIRMWARE_VERSIONS;
+    attr[2].id = TAI_MODULE_ATTR_VENDOR_PART_NUMBER;
+    attr[3].id = TAI_MODULE_ATTR_LOCATION;
+    attr[4].id = TAI_MODULE_ATTR_TRIBUTARY_MAPPING;
+    status = module_api->get_module_attributes_alloc(module_id, 5, &attr[0]);
+    if ( status != TAI_STATUS_SUCCESS ) {
+        printf("failed to get the allocated lists: %d\n", status);
+        return status;
+    }
+    if ( attr[0].value.charlist.count == 0 || attr[0].value.charlist.list == NULL ) {
+        printf("%s was not allocated\n",
+               tai_metadata_get_attr_metadata(TAI_OBJECT_TYPE_MODULE,
+                                              attr[0].id)->attridname);
+        return TAI_STATUS_FAILURE;
+    }
+    if ( attr[3].value.charlist.count != strlen(g_module_locations[module]) ||
+         memcmp(attr[3].value.charlist.list, g_module_locations[module],
+                attr[3].value.charlist.count) != 0 ) {
+        printf("allocated location has %u characters instead of %zu\n",
+               attr[3].value.charlist.count, strlen(g_module_locations[module]));
+        return TAI_STATUS_FAILURE;
+    }
+
+    /* the allocated mapping matches one read into caller buffers */
+    for (i = 0; i < TAI_MAX_NET_IFS; i++) {
+        maps[i].value.count = TAI_MAX_HOST_IFS;
+        maps[i].value.list = oids[i];
+    }
+    fixed.id = TAI_MODULE_ATTR_TRIBUTARY_MAPPING;
+    fixed.value.objmaplist.count = TAI_MAX_NET_IFS;
+    fixed.value.objmaplist.list = maps;
+    status = module_api->get_module_attribute(module_id, &fixed);
+    if ( status != TAI_STATUS_SUCCESS ) {
+        printf("failed to get the tributary mapping: %d\n", status);
+        return status;
+    }
+    mapping = &attr[4].value.objmaplist;
+    if ( mapping->count == 0 || mapping->count != fixed.value.objmaplist.count ) {
+        printf("allocated tributary mapping has %u keys instead of %u\n",
+               mapping->count, fixed.value.objmaplist.count);
+        return TAI_STATUS_FAILURE;
+    }
+    for (i = 0; i < mapping->count; i++) {
+        if ( mapping->list[i].key != maps[i].key ||
+             mapping->list[i].value.count != maps[i].value.count ||
+             memcmp(mapping->list[i].value.list, maps[i].value.list,
+                    maps[i].value.count * sizeof(tai_object_id_t)) != 0 ) {
+            printf("allocated tributary mapping differs for key %d\n", i);
+            return TAI_STATUS_FAILURE;
+        }
+    }
+
+    /* the lists are released a part at a time, the last ones first */
+    status = module_api->free_module_attributes(3, &attr[2]);
+    if ( status != TAI_STATUS_SUCCESS ) {
+        printf("failed to free the last lists: %d\n", status);
+        return status;
+    }
+    status = module_api->free_module_attributes(2, &attr[0]);
+    if ( status != TAI_STATUS_SUCCESS ) {
+        printf("failed to free the first lists: %d\n", status);
+        return status;
+    }
+    return TAI_STATUS_SUCCESS;
+}
+
+/* a snapshot of every interface, the removed ones left out of the valid masks */
+tai_status_t test_telemetry_snapshot(int module) {
+    tai_status_t status;
+    tai_telemetry_snapshot_t snapshot;
+    tai_telemetry_column_t netif_columns[2], hostif_columns[1];
+    tai_float_t power[TAI_MAX_NET_IFS], ber[TAI_MAX_NET_IFS];
+    tai_uint32_t align[TAI_MAX_HOST_IFS];
+    tai_attribute_t attr[2];
+    tai_attr_id_t first, second;
+    int i;
+
+    attr[0].id = TAI_MODULE_ATTR_NUM_NETWORK_INTERFACES;
+    attr[1].id = TAI_MODULE_ATTR_NUM_HOST_INTERFACES;
+    status = module_api->get_module_attributes(g_module_ids[module], 2, &attr[0]);
+    if ( status != TAI_STATUS_SUCCESS ) {
+        printf("failed to get the number of interfaces: %d\n", status);
+        return status;
+    }
+
+    /* the host interface 0 is removed, its row is zero and not valid */
+    status = host_interface_api->remove_host_interface(g_hostif_ids[module][0]);
+    if ( status != TAI_STATUS_SUCCESS ) {
+        printf("failed to remove a host interface: %d\n", status);
+        return status;
+    }
+
+    memset(&snapshot, 0, sizeof(snapshot));
+    snapshot.netif_attr_mask = TAI_TELEMETRY_ATTR_MASK(TAI_NETWORK_INTERFACE_ATTR_CURRENT_OUTPUT_POWER) |
+                               TAI_TELEMETRY_ATTR_MASK(TAI_NETWORK_INTERFACE_ATTR_CURRENT_BER);
+    snapshot.hostif_attr_mask = TAI_TELEMETRY_ATTR_MASK(TAI_HOST_INTERFACE_ATTR_TX_ALIGN_STATUS);
+    snapshot.netif_count = 0;
+    snapshot.hostif_count = TAI_MAX_HOST_IFS;
+    status = module_api->get_module_telemetry_snapshot(g_module_ids[module], &snapshot);
+    if ( status != TAI_STATUS_BUFFER_OVERFLOW || snapshot.netif_count != attr[0].value.u32 ) {
+        printf("snapshot without network interface rows: %d, %u rows required\n",
+               status, snapshot.netif_count);
+        return TAI_STATUS_FAILURE;
+    }
+
+    netif_columns[0].data.flt = power;
+    netif_columns[1].data.flt = ber;
+    hostif_columns[0].data.u32 = align;
+    snapshot.netif_columns = netif_columns;
+    snapshot.hostif_columns = hostif_columns;
+    snapshot.netif_count = TAI_MAX_NET_IFS;
+    snapshot.hostif_count = TAI_MAX_HOST_IFS;
+    status = module_api->get_module_telemetry_snapshot(g_module_ids[module], &snapshot);
+    if ( status != TAI_STATUS_SUCCESS ) {
+        printf("failed to read a snapshot: %d\n", status);
+        return status;
+    }
+    first = TAI_NETWORK_INTERFACE_ATTR_CURRENT_OUTPUT_POWER;
+    second = TAI_NETWORK_INTERFACE_ATTR_CURRENT_BER;
+    if ( first > second ) {
+        first = TAI_NETWORK_INTERFACE_ATTR_CURRENT_BER;
+        second = TAI_NETWORK_INTERFACE_ATTR_CURRENT_OUTPUT_POWER;
+    }
+    if ( netif_columns[0].attr_id != first || netif_columns[1].attr_id != second ||
+         hostif_columns[0].attr_id != TAI_HOST_INTERFACE_ATTR_TX_ALIGN_STATUS ) {
+        printf("snapshot columns out of order: %d %d %d\n", netif_columns[0].attr_id,
+               netif_columns[1].attr_id, hostif_columns[0].attr_id);
+        return TAI_STATUS_FAILURE;
+    }
+    if ( snapshot.netif_count != attr[0].value.u32 || snapshot.hostif_count != attr[1].value.u32 ) {
+        printf("snapshot has %u and %u rows instead of %u and %u\n", snapshot.netif_count,
+               snapshot.hostif_count, attr[0].value.u32, attr[1].value.u32);
+        return TAI_STATUS_FAILURE;
+    }
+    for (i = 0; i < snapshot.netif_count; i++) {
+        if ( !(snapshot.netif_valid_mask & (1ULL << i)) || power[i] == 0 ) {
+            printf("snapshot row %d of a network interface not valid\n", i);
+            return TAI_STATUS_FAILURE;
+        }
+    }
+    if ( (snapshot.hostif_valid_mask & 1) || align[0] != 0 ||
+         snapshot.hostif_valid_mask != (((1ULL << snapshot.hostif_count) - 1) & ~1ULL) ) {
+        printf("snapshot host interface rows valid: 0x%lx\n", snapshot.hostif_valid_mask);
+        return TAI_STATUS_FAILURE;
+    }
+
+    attr[0].id = TAI_HOST_INTERFACE_ATTR_INDEX;
+    attr[0].value.u32 = 0;
+    status = host_interface_api->create_host_interface(&g_hostif_ids[module][0],
+                                                       g_module_ids[module], 1, &attr[0]);
+    if ( status != TAI_STATUS_SUCCESS ) {
+        printf("failed to create a host interface: %d\n", status);
+        return status;
+    }
+    return TAI_STATUS_SUCCESS;
+}
+
+/* the bins completed meanwhile, with bins shortened by TAI_STUB_PM_SPEEDUP */
+tai_status_t test_pm_bins(int module) {
+    tai_status_t status;
+    tai_pm_bin_t *bins;
+    uint32_t count, all, i;
+    uint64_t since;
+
+    /* 300 ms bins of 3 samples, wait for a few to complete */
+    for (i = 0; i < 30; i++) {
+        count = 0;
+        status = module_api->get_pm_bins(g_module_ids[module], TAI_PM_INTERVAL_15_MIN, 0,
+                                         &count, NULL);
+        /* three bins of the temperature and of the 3 attributes of a network interface */
+        if ( count >= 4 * 3 ) {
+            break;
+        }
+        usleep(100000);
+    }
+    if ( status != TAI_STATUS_BUFFER_OVERFLOW || count == 0 ) {
+        printf("no performance monitoring bin completed: %d, %u bins\n", status, count);
+        return TAI_STATUS_FAILURE;
+    }
+    /* more bins may complete between the two calls */
+    count += 64;
+    bins = calloc(count, sizeof(*bins));
+    if ( bins == NULL ) {
+        return TAI_STATUS_NO_MEMORY;
+    }
+    status = module_api->get_pm_bins(g_module_ids[module], TAI_PM_INTERVAL_15_MIN, 0,
+                                     &count, bins);
+    if ( status != TAI_STATUS_SUCCESS ) {
+        printf("failed to get the performance monitoring bins: %d\n", status);
+        free(bins);
+        return status;
+    }
+    since = 0;
+    for (i = 0; i < count; i++) {
+        if ( bins[i].sample_count == 0 || !(bins[i].min <= bins[i].avg) ||
+             !(bins[i].avg <= bins[i].max) ) {
+            printf("bin %u of attribute %d: %u samples, min %f avg %f max %f\n", i,
+                   bins[i].attr_id, bins[i].sample_count, bins[i].min, bins[i].avg,
+                   bins[i].max);
+            free(bins);
+            return TAI_STATUS_FAILURE;
+        }
+        if ( bins[i].start > since ) {
+            since = bins[i].start;
+        }
+    }
+
+    /* a buffer too small reports the number of bins required */
+    all = count;
+    count = 1;
+    status = module_api->get_pm_bins(g_module_ids[module], TAI_PM_INTERVAL_15_MIN, 0,
+                                     &count, bins);
+    if ( status != TAI_STATUS_BUFFER_OVERFLOW || count < all ) {
+        printf("one bin buffer for %u bins: %d, %u bins required\n", all, status, count);
+        free(bins);
+        return TAI_STATUS_FAILURE;
+    }
+
+    /* the most recent bins only */
+    count = all;
+    status = module_api->get_pm_bins(g_module_ids[module], TAI_PM_INTERVAL_15_MIN, since,
+                                     &count, bins);
+    if ( status != TAI_STATUS_SUCCESS || count == 0 || count >= all ) {
+        printf("bins since the most recent one: %d, %u bins of %u\n", status, count, all);
+        free(bins);
+        return TAI_STATUS_FAILURE;
+    }
+    for (i = 0; i < count; i++) {
+        if ( bins[i].start < since ) {
+            printf("bin %u starts before %lu\n", i, since);
+            free(bins);
+            return TAI_STATUS_FAILURE;
+        }
+    }
+    free(bins);
+    return TAI_STATUS_SUCCESS;
+}
+
+int g_subscription_batches;
+int g_subscription_bad;
+
+void subscription_batch(tai_subscription_id_t subscription_id, void *context,
+                        uint32_t sample_count, const tai_attribute_sample_t *samples) {
+    uint32_t i;
+
+    for (i = 0; i < sample_count; i++) {
+        if ( samples[i].object_id != *(tai_object_id_t *)context ||
+             samples[i].attr.id != (i % 2 == 0 ? TAI_MODULE_ATTR_TEMP : TAI_MODULE_ATTR_POWER) ) {
+            __atomic_store_n(&g_subscription_bad, 1, __ATOMIC_RELAXED);
+        }
+    }
+    if ( sample_count == 2 ) {
+        __atomic_add_fetch(&g_subscription_batches, 1, __ATOMIC_RELAXED);
+    }
+}
+
+/* a subscription delivers batches of samples until it is removed */
+tai_status_t test_subscription(int module) {
+    tai_status_t status;
+    tai_subscription_id_t id;
+    tai_attribute_subscription_t sub;
+    tai_attr_id_t attr_ids[2] = { TAI_MODULE_ATTR_TEMP, TAI_MODULE_ATTR_POWER };
+    int i, batches;
+
+    __atomic_store_n(&g_subscription_batches, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&g_subscription_bad, 0, __ATOMIC_RELAXED);
+    memset(&sub, 0, sizeof(sub));
+    sub.object_type = TAI_OBJECT_TYPE_MODULE;
+    sub.object_count = 1;
+    sub.object_list = &g_module_ids[module];
+    sub.attr_count = 2;
+    sub.attr_list = attr_ids;
+    sub.interval_us = 10000;
+    sub.notify = subscription_batch;
+    sub.context = &g_module_ids[module];
+    status = module_api->create_attribute_subscription(&id, g_module_ids[module], &sub);
+    if ( status != TAI_STATUS_SUCCESS ) {
+        printf("failed to create an attribute subscription: %d\n", status);
+        return status;
+    }
+    for (i = 0; i < 500 && __atomic_load_n(&g_subscription_batches, __ATOMIC_RELAXED) == 0; i++) {
+        usleep(10000);
+    }
+    status = module_api->remove_attribute_subscription(id);
+    if ( status != TAI_STATUS_SUCCESS ) {
+        printf("failed to remove an attribute subscription: %d\n", status);
+        return status;
+    }
+    batches = __atomic_load_n(&g_subscription_batches, __ATOMIC_RELAXED);
+    if ( batches == 0 || __atomic_load_n(&g_subscription_bad, __ATOMIC_RELAXED) ) {
+        printf("subscription delivered %d batches of the module temperature and power\n",
+               batches);
+        return TAI_STATUS_FAILURE;
+    }
+
+    /* no batch once removed */
+    usleep(50000);
+    if ( __atomic_load_n(&g_subscription_batches, __ATOMIC_RELAXED) != batches ) {
+        printf("subscription delivered batches once removed\n");
+        return TAI_STATUS_FAILURE;
+    }
+    return TAI_STATUS_SUCCESS;
+}
+
+tai_status_t get_tributary_mapping(tai_object_id_t module_id,
+                                   tai_generation_t generation,
+                                   tai_generation_t *current_generation) {
+    static tai_object_map_t maps[TAI_MAX_NET_IFS];
+    static tai_object_id_t oids[TAI_MAX_NET_IFS][TAI_MAX_HOST_IFS];
+    tai_attribute_t attr;
+    int i;
+
+    for (i = 0; i < TAI_MAX_NET_IFS; i++) {
+        maps[i].value.count = TAI_MAX_HOST_IFS;
+        maps[i].value.list = oids[i];
+    }
+    attr.id = TAI_MODULE_ATTR_TRIBUTARY_MAPPING;
+    attr.value.objmaplist.count = TAI_MAX_NET_IFS;
+    attr.value.objmaplist.list = maps;
+    return module_api->get_module_attributes_if_changed(module_id, generation,
+                                                        current_generation, 1, &attr);
+}
+
+tai_status_t test_tributary_mapping_generation(int module) {
+    tai_status_t status;
+    tai_attribute_t attr;
+    tai_generation_t generation;
+
+    status = get_tributary_mapping(g_module_ids[module], 0, &generation);
+    if ( status != TAI_STATUS_SUCCESS ) {
+        printf("failed to get the tributary mapping: %d\n", status);
+        return status;
+    }
+
+    /* the mapping is derived from the interfaces, which change it as well */
+    status = host_interface_api->remove_host_interface(g_hostif_ids[module][0]);
+    if ( status != TAI_STATUS_SUCCESS ) {
+        printf("failed to remove a host interface: %d\n", status);
+        return status;
+    }
+    status = get_tributary_mapping(g_module_ids[module], generation, &generation);
+    if ( status != TAI_STATUS_SUCCESS ) {
+        printf("tributary mapping not read after a host interface remove: %d\n", status);
+        return TAI_STATUS_FAILURE;
+    }
+
+    attr.id = TAI_HOST_INTERFACE_ATTR_INDEX;
+    attr.value.u32 = 0;
+    status = host_interface_api->create_host_interface(&g_hostif_ids[module][0],
+                                                       g_module_ids[module], 1, &attr);
+    if ( status != TAI_STATUS_SUCCESS ) {
+        printf("failed to create a host interface: %d\n", status);
+        return status;
+    }
+    status = get_tributary_mapping(g_module_ids[module], generation, &generation);
+    if ( status != TAI_STATUS_SUCCESS ) {
+        printf("tributary mapping not read after a host interface create: %d\n", status);
+        return TAI_STATUS_FAILURE;
+    }
+    return TAI_STATUS_SUCCESS;
+}
+
+tai_status_t test_if_changed(int module) {
+    tai_status_t status;
+    tai_attribute_t attr[5];
+    tai_generation_t generation, current;
+    tai_object_id_t netif_id = g_netif_ids[module][0];
+
+    attr[0].id = TAI_NETWORK_INTERFACE_ATTR_TX_CHANNEL;
+    status = network_interface_api->get_network_interface_attributes_if_changed(
+       netif_id, 0, &generation, 1, &attr[0]);
+    if ( status != TAI_STATUS_SUCCESS ) {
+        printf("failed to get the attributes if changed: %d\n", status);
+        return status;
+    }
+    status = network_interface_api->get_network_interface_attributes_if_changed(
+       netif_id, generation, &current, 1, &attr[0]);
+    if ( status != TAI_STATUS_NOT_MODIFIED || current != generation ) {
+        printf("attributes read again without a change: %d\n", status);
+        return TAI_STATUS_FAILURE;
+    }
+
+    attr[0].value.u16 = 53;
+    status = network_interface_api->set_network_interface_attribute(netif_id, &attr[0]);
+    if ( status != TAI_STATUS_SUCCESS ) {
+        printf("failed to set the tx channel: %d\n", status);
+        return status;
+    }
+    attr[0].value.u16 = 0;
+    status = network_interface_api->get_network_interface_attributes_if_changed(
+       netif_id, generation, &generation, 1, &attr[0]);
+    if ( status != TAI_STATUS_SUCCESS || attr[0].value.u16 != 53 ) {
+        printf("attributes not read after a set: %d\n", status);
+        return TAI_STATUS_FAILURE;
+    }
+
+    /* a new object is newer than anything read from the one it replaces */
+    status = network_interface_api->remove_network_interface(netif_id);
+    if ( status != TAI_STATUS_SUCCESS ) {
+        printf("failed to remove a network interface: %d\n", status);
+        return status;
+    }
+    status = network_interface_api->get_network_interface_attributes_if_changed(
+       netif_id, generation, &current, 1, &attr[0]);
+    if ( status != TAI_STATUS_INVALID_OBJECT_ID ) {
+        printf("attributes of a removed object read: %d\n", status);
+        return TAI_STATUS_FAILURE;
+    }
+    attr[0].id = TAI_NETWORK_INTERFACE_ATTR_INDEX;
+    attr[0].value.u32 = 0;
+    attr[1].id = TAI_NETWORK_INTERFACE_ATTR_TX_ENABLE;
+    attr[1].value.booldata = true;
+    attr[2].id = TAI_NETWORK_INTERFACE_ATTR_TX_GRID_SPACING;
+    attr[2].value.u32 = TAI_NETWORK_INTERFACE_TX_GRID_SPACING_50_GHZ;
+    attr[3].id = TAI_NETWORK_INTERFACE_ATTR_TX_CHANNEL;
+    attr[3].value.u16 = 52;
+    attr[4].id = TAI_NETWORK_INTERFACE_ATTR_OUTPUT_POWER;
+    attr[4].value.flt = 1.0;
+    status = network_interface_api->create_network_interface(
+       &g_netif_ids[module][0], g_module_ids[module], 5, &attr[0]);
+    if ( status != TAI_STATUS_SUCCESS ) {
+        printf("failed to create a network interface: %d\n", status);
+        return status;
+    }
+    attr[0].id = TAI_NETWORK_INTERFACE_ATTR_TX_CHANNEL;
+    status = network_interface_api->get_network_interface_attributes_if_changed(
+       g_netif_ids[module][0], generation, &current, 1, &attr[0]);
+    if ( status != TAI_STATUS_SUCCESS || attr[0].value.u16 != 52 ) {
+        printf("attributes not read after a create: %d\n", status);
+        return TAI_STATUS_FAILURE;
+    }
+    return TAI_STATUS_SUCCESS;
+}
+
+tai_status_t test_transaction_rollback(int module) {
+    tai_status_t status;
+    tai_transaction_id_t txn;
+    tai_attribute_t prev[2], attr[3];
+    tai_object_id_t netif_id = g_netif_ids[module][0];
+
+    prev[0].id = TAI_NETWORK_INTERFACE_ATTR_TX_CHANNEL;
+    prev[1].id = TAI_NETWORK_INTERFACE_ATTR_OUTPUT_POWER;
+    status = network_interface_api->get_network_interface_attributes(netif_id, 2, &prev[0]);
+    if ( status != TAI_STATUS_SUCCESS ) {
+        printf("failed to get the network interface attributes: %d\n", status);
+        return status;
+    }
+
+    /* the retune and the output power are applied before the differential
+     * encoding, whose write fails, see TAI_STUB_FAIL_ATTRS */
+    attr[0].id = TAI_NETWORK_INTERFACE_ATTR_TX_CHANNEL;
+    attr[0].value.u16 = prev[0].value.u16 + 1;
+    attr[1].id = TAI_NETWORK_INTERFACE_ATTR_OUTPUT_POWER;
+    attr[1].value.flt = prev[1].value.flt - 1.0;
+    attr[2].id = TAI_NETWORK_INTERFACE_ATTR_DIFFERENTIAL_ENCODING;
+    attr[2].value.booldata = true;
+    status = module_api->begin_transaction(&txn, g_module_ids[module]);
+    if ( status != TAI_STATUS_SUCCESS ) {
+        printf("failed to begin a transaction: %d\n", status);
+        return status;
+    }
+    status = module_api->stage_attributes(txn, netif_id, 3, &attr[0]);
+    if ( status != TAI_STATUS_SUCCESS ) {
+        printf("failed to stage the attributes: %d\n", status);
+        module_api->abort_transaction(txn);
+        return status;
+    }
+    status = module_api->commit_transaction(txn);
+    if ( status == TAI_STATUS_SUCCESS ) {
+        printf("transaction with a failing write committed\n");
+        return TAI_STATUS_FAILURE;
+    }
+
+    status = network_interface_api->get_network_interface_attributes(netif_id, 2, &attr[0]);
+    if ( status != TAI_STATUS_SUCCESS ) {
+        printf("failed to get the network interface attributes: %d\n", status);
+        return status;
+    }
+    if ( attr[0].value.u16 != prev[0].value.u16 || attr[1].value.flt != prev[1].value.flt ) {
+        printf("transaction not rolled back: channel %u, output power %f\n",
+               attr[0].value.u16, attr[1].value.flt);
+        return TAI_STATUS_FAILURE;
+    }
+    return TAI_STATUS_SUCCESS;
+}
+
+typedef struct {
+    tai_object_id_t other_id;   /* the module read from the completion */
+    int            *started;    /* the completions running */
+    tai_status_t    status;
+    int             done;
+} cross_read_t;
+
+void cross_read_completion(tai_async_request_id_t request_id, void *context,
+                           tai_status_t status, uint32_t attr_count,
+                           const tai_attribute_t *attr_list) {
+    cross_read_t *read = context;
+    tai_attribute_t attr;
+    int wait;
+
+    /* both completions run before either reads */
+    __atomic_add_fetch(read->started, 1, __ATOMIC_ACQ_REL);
+    for (wait = 0; __atomic_load_n(read->started, __ATOMIC_ACQUIRE) < 2 && wait < 1000; wait++) {
+        usleep(1000);
+    }
+    attr.id = TAI_MODULE_ATTR_TEMP;
+    if ( status == TAI_STATUS_SUCCESS ) {
+        status = module_api->get_module_attribute(read->other_id, &attr);
+    }
+    read->status = status;
+    __atomic_store_n(&read->done, 1, __ATOMIC_RELEASE);
+}
+
+/* the completions of two modules read each other's module at the same time */
+tai_status_t test_cross_module_completion() {
+    tai_status_t status;
+    tai_attribute_t attr[2];
+    tai_async_request_id_t request_id;
+    cross_read_t read[2];
+    int started = 0;
+    int i, wait;
+
+    /* the MAI runs the calls to a module adapter one at a time, a completion
+     * waiting for another one of the same module adapter would wait forever */
+    if ( g_module_location_tail < 2 || (g_module_ids[0] & MAI_ID_PREFIX_MASK) != 0 ) {
+        return TAI_STATUS_SUCCESS;
+    }
+    for (i = 0; i < 2; i++) {
+        read[i].other_id = g_module_ids[1 - i];
+        read[i].started = &started;
+        read[i].status = TAI_STATUS_FAILURE;
+        read[i].done = 0;
+    }
+    for (i = 0; i < 2; i++) {
+        attr[i].id = TAI_MODULE_ATTR_NUM_NETWORK_INTERFACES;
+        status = module_api->get_module_attributes_async(g_module_ids[i], 1, &attr[i],
+                                                         cross_read_completion, &read[i],
+                                                         &request_id);
+        if ( status != TAI_STATUS_SUCCESS ) {
+            printf("failed to get the module attributes asynchronously: %d\n", status);
+            return status;
+        }
+    }
+    for (i = 0; i < 2; i++) {
+        for (wait = 0; !__atomic_load_n(&read[i].done, __ATOMIC_ACQUIRE); wait++) {
+            if ( wait == 5000 ) {
+                printf("completion reading another module never returned\n");
+                return TAI_STATUS_FAILURE;
+            }
+            usleep(1000);
+        }
+        if ( read[i].status != TAI_STATUS_SUCCESS ) {
+            printf("failed to read another module from a completion: %d\n", read[i].status);
+            return read[i].status;
+        }
+    }
+    return TAI_STATUS_SUCCESS;
+}
+
+tai_status_t query_apis() {
+    if ( tai_api_query(TAI_API_MODULE, (void**)&module_api) != TAI_STATUS_SUCCESS ||
+         tai_api_query(TAI_API_NETWORKIF, (void**)&network_interface_api) != TAI_STATUS_SUCCESS ||
+         tai_api_query(TAI_API_HOSTIF, (void**)&host_interface_api) != TAI_STATUS_SUCCESS ) {
+        return TAI_STATUS_FAILURE;
+    }
+    return TAI_STATUS_SUCCESS;
+}
+
+/* the objects and their attributes survive a restart with the warm flag */
+tai_status_t test_warm_restart(tai_service_method_table_t *services) {
+    tai_status_t status;
+    tai_attribute_t attr;
+    tai_object_id_t module_ids[TAI_MAX_MODULES];
+    tai_object_id_t netif_ids[TAI_MAX_MODULES];
+    tai_object_id_t hostif_ids[TAI_MAX_NET_IFS][TAI_MAX_HOST_IFS];
+    tai_object_map_t map, maps[TAI_MAX_NET_IFS];
+    int modules = g_module_location_tail;
+    int i, j;
+
+    for (i = 0; i < modules; i++) {
+        module_ids[i] = g_module_ids[i];
+        netif_ids[i] = g_netif_ids[i][0];
+        attr.id = TAI_NETWORK_INTERFACE_ATTR_PULSE_SHAPING_TX_BETA;
+        attr.value.flt = 0.25 + i;
+        status = network_interface_api->set_network_interface_attribute(netif_ids[i], &attr);
+        if ( status != TAI_STATUS_SUCCESS ) {
+            printf("failed to set the pulse shaping beta: %d\n", status);
+            return status;
+        }
+
+        /* a mapping of the adapter host, unlike the default one */
+        map.key = netif_ids[i];
+        map.value.count = 1;
+        map.value.list = &g_hostif_ids[i][0];
+        attr.id = TAI_MODULE_ATTR_TRIBUTARY_MAPPING;
+        attr.value.objmaplist.count = 1;
+        attr.value.objmaplist.list = &map;
+        status = module_api->set_module_attribute(module_ids[i], &attr);
+        if ( status != TAI_STATUS_SUCCESS ) {
+            printf("failed to set the tributary mapping: %d\n", status);
+            return status;
+        }
+    }
+
+    /* tai_api_uninitialize() writes the snapshot, see TAI_STUB_WARM_FILE */
+    status = tai_api_uninitialize();
+    if ( status != TAI_STATUS_SUCCESS ) {
+        printf("failed to uninitialize TAI\n");
+        return status;
+    }
+    g_module_location_head = g_module_location_tail = 0;
+    status = tai_api_initialize(TAI_API_INITIALIZE_FLAG_WARM_START, services);
+    if ( status != TAI_STATUS_SUCCESS || query_apis() != TAI_STATUS_SUCCESS ) {
+        printf("failed to initialize TAI with the warm flag\n");
+        return TAI_STATUS_FAILURE;
+    }
+    sleep(1);
+    status = create_modules();
+    if ( status != TAI_STATUS_SUCCESS ) {
+        printf("failed to create the modules again: %d\n", status);
+        return status;
+    }
+    if ( g_module_location_tail != modules ) {
+        printf("%d modules before the restart, %d after\n", modules, g_module_location_tail);
+        return TAI_STATUS_FAILURE;
+    }
+
+    /* the modules may be announced in another order */
+    for (i = 0; i < modules; i++) {
+        for (j = 0; j < modules && module_ids[j] != g_module_ids[i]; j++);
+        if ( j == modules || netif_ids[j] != g_netif_ids[i][0] ) {
+            printf("module 0x%lx got a new id on a warm start\n", g_module_ids[i]);
+            return TAI_STATUS_FAILURE;
+        }
+        attr.id = TAI_NETWORK_INTERFACE_ATTR_PULSE_SHAPING_TX_BETA;
+        status = network_interface_api->get_network_interface_attribute(g_netif_ids[i][0], &attr);
+        if ( status != TAI_STATUS_SUCCESS || attr.value.flt != (float)(0.25 + j) ) {
+            printf("pulse shaping beta not restored: %d, %f\n", status, attr.value.flt);
+            return TAI_STATUS_FAILURE;
+        }
+        for (j = 0; j < TAI_MAX_NET_IFS; j++) {
+            maps[j].value.count = TAI_MAX_HOST_IFS;
+            maps[j].value.list = hostif_ids[j];
+        }
+        attr.id = TAI_MODULE_ATTR_TRIBUTARY_MAPPING;
+        attr.value.objmaplist.count = TAI_MAX_NET_IFS;
+        attr.value.objmaplist.list = maps;
+        status = module_api->get_module_attribute(g_module_ids[i], &attr);
+        if ( status != TAI_STATUS_SUCCESS ) {
+            printf("failed to get the tributary mapping: %d\n", status);
+            return status;
+        }
+        for (j = 0; j < attr.value.objmaplist.count; j++) {
+            if ( maps[j].key == g_netif_ids[i][0] ?
+                 maps[j].value.count != 1 || hostif_ids[j][0] != g_hostif_ids[i][0] :
+                 maps[j].value.count != 0 ) {
+                printf("tributary mapping not restored\n");
+                return TAI_STATUS_FAILURE;
+            }
+        }
+    }
+    return TAI_STATUS_SUCCESS;
+}
+
 void module_event(bool present, char * module_location)
 {
     int next_head = (g_module_location_head + 1) % (TAI_MAX_MODULES+1);
@@ -141,7 +831,22 @@ tai_service_method_table_t g_service_table = {
 
 int main() {
     tai_status_t status;
+    char warm_file[3][64];
     int i;
+
+    /* a simulated chassis with two modules, unless given another one */
+    setenv("TAI_STUB_PRESENCE_BURST", "2", 0);
+    /* the hardware rejects this one, to break a transaction commit */
+    setenv("TAI_STUB_FAIL_ATTRS", "netif.differential-encoding", 0);
+    /* performance monitoring bins of 300 ms instead of 15 minutes */
+    setenv("TAI_STUB_PM_SPEEDUP", "3000", 0);
+    /* the warm start snapshots, one per module adapter of the MAI */
+    snprintf(warm_file[0], sizeof(warm_file[0]), "/tmp/tai-test-%d.warm", getpid());
+    snprintf(warm_file[1], sizeof(warm_file[1]), "/tmp/tai-test-%d.warm.a", getpid());
+    snprintf(warm_file[2], sizeof(warm_file[2]), "/tmp/tai-test-%d.warm.b", getpid());
+    setenv("TAI_STUB_WARM_FILE", warm_file[0], 1);
+    setenv("TAI_MODULE_A_WARM_FILE", warm_file[1], 1);
+    setenv("TAI_MODULE_B_WARM_FILE", warm_file[2], 1);
     status = tai_api_initialize(0, &g_service_table);
     if ( status != TAI_STATUS_SUCCESS ) {
         printf("failed to initialize TAI\n");
@@ -176,9 +881,58 @@ int main() {
     printf("host_interface_api: %p\n", host_interface_api);
 
     sleep(1);
-    create_modules();
+    if ( g_module_location_head == g_module_location_tail ) {
+        printf("no module found\n");
+        return 1;
+    }
+    status = create_modules();
+    if ( status != TAI_STATUS_SUCCESS ) {
+        printf("failed to create the modules: %d\n", status);
+        return 1;
+    }
+    for (i = 0; i < g_module_location_tail; i++) {
+        status = test_alloc_lists(i);
+        if ( status != TAI_STATUS_SUCCESS ) {
+            return 1;
+        }
+        status = test_telemetry_snapshot(i);
+        if ( status != TAI_STATUS_SUCCESS ) {
+            return 1;
+        }
+        status = test_pm_bins(i);
+        if ( status != TAI_STATUS_SUCCESS ) {
+            return 1;
+        }
+        status = test_subscription(i);
+        if ( status != TAI_STATUS_SUCCESS ) {
+            return 1;
+        }
+        status = test_tributary_mapping_generation(i);
+        if ( status != TAI_STATUS_SUCCESS ) {
+            return 1;
+        }
+        status = test_if_changed(i);
+        if ( status != TAI_STATUS_SUCCESS ) {
+            return 1;
+        }
+        status = test_transaction_rollback(i);
+        if ( status != TAI_STATUS_SUCCESS ) {
+            return 1;
+        }
+    }
+    status = test_cross_module_completion();
+    if ( status != TAI_STATUS_SUCCESS ) {
+        return 1;
+    }
+    status = test_warm_restart(&g_service_table);
+    if ( status != TAI_STATUS_SUCCESS ) {
+        return 1;
+    }
 
     status = tai_api_uninitialize();
+    for (i = 0; i < 3; i++) {
+        unlink(warm_file[i]);
+    }
     if ( status != TAI_STATUS_SUCCESS ) {
         printf("failed to uninitialize TAI\n");
         return 1;
@@ -0,0 +1,443 @@
+/**
+ *  @file    taidump.c
+ *  @brief   Offline reader of the stub TAI adapter dump
+ *
+ *  The dump written by tai_dbg_generate_dump() is mapped and printed in
+ *  place, see stub/stub_dump.h for the format.
+ *
+ *  Usage: taidump <dump file>
+ *
+ *  @copyright Copyright (C) 2018 Cumulus Networks, Inc. All rights reserved
+ *
+ *  @remark  Licensed under the Apache License, Version 2.0 (the "License"); you
+ *           may not use this file except in compliance with the License. You may
+ *           obtain a copy of the License at
+ *           http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  @remark  THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ *           CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ *           LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ *           FOR A PARTICULAR PURPOSE, MERCHANTABILITY OR NON-INFRINGEMENT.
+ *
+ *  @remark  See the Apache Version 2.0 License for specific language governing
+ *           permissions and limitations under the License.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "tai.h"
+#include "taimetadata.h"
+#include "stub_dump.h"
+
+static const char *object_type_names[TAI_OBJECT_TYPE_MAX] = {
+    [TAI_OBJECT_TYPE_NULL]      = "null",
+    [TAI_OBJECT_TYPE_MODULE]    = "module",
+    [TAI_OBJECT_TYPE_HOSTIF]    = "hostif",
+    [TAI_OBJECT_TYPE_NETWORKIF] = "networkif",
+};
+
+static const char *api_names[TAI_API_MAX] = {
+    [TAI_API_UNSPECIFIED] = "unspecified",
+    [TAI_API_MODULE]      = "module",
+    [TAI_API_HOSTIF]      = "hostif",
+    [TAI_API_NETWORKIF]   = "networkif",
+};
+
+static const char *level_names[TAI_LOG_LEVEL_MAX] = {
+    [TAI_LOG_LEVEL_DEBUG]    = "debug",
+    [TAI_LOG_LEVEL_INFO]     = "info",
+    [TAI_LOG_LEVEL_NOTICE]   = "notice",
+    [TAI_LOG_LEVEL_WARN]     = "warn",
+    [TAI_LOG_LEVEL_ERROR]    = "error",
+    [TAI_LOG_LEVEL_CRITICAL] = "critical",
+};
+
+/** @brief The mapped dump */
+typedef struct _dump_t {
+    const char               *base;
+    size_t                    size;
+    const stub_dump_header_t *hdr;
+} dump_t;
+
+/**
+ * @brief Check that a table of the dump lies within the file
+ */
+static int check_table(
+    const dump_t *dump,
+    const char   *name,
+    uint64_t      offset,
+    uint64_t      count,
+    uint32_t      size,
+    size_t        min_size)
+{
+    if (size < min_size) {
+        fprintf(stderr, "%s records of %u bytes are too small\n", name, size);
+        return -1;
+    }
+    if ((offset > dump->size) || (count > (dump->size - offset) / size)) {
+        fprintf(stderr, "%s table is out of the file\n", name);
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Validate the header and the tables of the dump
+ */
+static int check_dump(const dump_t *dump)
+{
+    const stub_dump_header_t *hdr = dump->hdr;
+
+    /* the fields up to header_size are common to every version */
+    if ((dump->size < offsetof(stub_dump_header_t, header_size) + sizeof(hdr->header_size)) ||
+        (0 != memcmp(hdr->magic, STUB_DUMP_MAGIC, sizeof(hdr->magic)))) {
+        fprintf(stderr, "Not a TAI stub dump\n");
+        return -1;
+    }
+    if (STUB_DUMP_BYTE_ORDER != hdr->byte_order) {
+        fprintf(stderr, "The dump was written with a different byte order\n");
+        return -1;
+    }
+    if (STUB_DUMP_VERSION_MAJOR != hdr->version_major) {
+        fprintf(stderr, "Unsupported dump version %u.%u\n",
+                hdr->version_major, hdr->version_minor);
+        return -1;
+    }
+    /* the rest is read only once the file is known to hold a 1.0 header */
+    if ((hdr->header_size < offsetof(stub_dump_header_t, cache_hits)) ||
+        (hdr->header_size > dump->size) || (hdr->file_size != dump->size)) {
+        fprintf(stderr, "Truncated dump\n");
+        return -1;
+    }
+    if ((0 != check_table(dump, "Object", hdr->objects_offset, hdr->object_count,
+                          hdr->object_size, sizeof(stub_dump_object_t))) ||
+        (0 != check_table(dump, "Attribute", hdr->attrs_offset, hdr->attr_count,
+                          hdr->attr_size, sizeof(stub_dump_attr_t))) ||
+        (0 != check_table(dump, "Log", hdr->logs_offset, hdr->log_count,
+                          hdr->log_size, sizeof(stub_dump_log_t))) ||
+        (0 != check_table(dump, "Data", hdr->data_offset, hdr->data_size, 1, 1))) {
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Get a pointer to an item of the data section, NULL if out of it
+ */
+static const void *data_ptr(const dump_t *dump, uint64_t offset, uint64_t len)
+{
+    if ((offset > dump->hdr->data_size) || (len > dump->hdr->data_size - offset)) {
+        return NULL;
+    }
+    return dump->base + dump->hdr->data_offset + offset;
+}
+
+static void print_enum(const tai_enum_metadata_t *meta, int32_t value)
+{
+    size_t i;
+
+    for (i = 0; i < meta->valuescount; i++) {
+        if (meta->values[i] == value) {
+            printf("%s", meta->valuesshortnames[i]);
+            return;
+        }
+    }
+    printf("%d", value);
+}
+
+/**
+ * @brief Print an object map list, as "{key: [value, ...], ...}"
+ */
+static void print_objmap(const dump_t *dump, const stub_dump_attr_t *attr)
+{
+    const char *p = data_ptr(dump, attr->value, (uint64_t)attr->count * sizeof(stub_dump_objmap_t));
+    stub_dump_objmap_t entry;
+    uint64_t key = 0;
+    uint32_t i;
+
+    if (NULL == p) {
+        printf("<out of the data section>");
+        return;
+    }
+    printf("{");
+    for (i = 0; i < attr->count; i++, p += sizeof(entry)) {
+        memcpy(&entry, p, sizeof(entry));
+        if ((0 == i) || (entry.key != key)) {
+            printf("%s0x%" PRIx64 ": [", i ? "], " : "", entry.key);
+            key = entry.key;
+        } else {
+            printf(", ");
+        }
+        if (0 != entry.value) {
+            printf("0x%" PRIx64, entry.value);
+        }
+    }
+    printf("%s}", attr->count ? "]" : "");
+}
+
+/**
+ * @brief Print the elements of a list attribute
+ */
+static void print_list(
+    const dump_t              *dump,
+    const tai_attr_metadata_t *meta,
+    const stub_dump_attr_t    *attr)
+{
+    static const size_t elem_sizes[TAI_ATTR_VALUE_TYPE_MAX] = {
+        [TAI_ATTR_VALUE_TYPE_OBJLIST]   = sizeof(tai_object_id_t),
+        [TAI_ATTR_VALUE_TYPE_CHARLIST]  = sizeof(char),
+        [TAI_ATTR_VALUE_TYPE_U8LIST]    = sizeof(uint8_t),
+        [TAI_ATTR_VALUE_TYPE_S8LIST]    = sizeof(int8_t),
+        [TAI_ATTR_VALUE_TYPE_U16LIST]   = sizeof(uint16_t),
+        [TAI_ATTR_VALUE_TYPE_S16LIST]   = sizeof(int16_t),
+        [TAI_ATTR_VALUE_TYPE_U32LIST]   = sizeof(uint32_t),
+        [TAI_ATTR_VALUE_TYPE_S32LIST]   = sizeof(int32_t),
+        [TAI_ATTR_VALUE_TYPE_FLOATLIST] = sizeof(tai_float_t),
+    };
+    size_t elem_size = elem_sizes[meta->attrvaluetype];
+    const char *p;
+    uint32_t i;
+
+    /* since version 1.2 */
+    if (TAI_ATTR_VALUE_TYPE_OBJMAPLIST == meta->attrvaluetype) {
+        print_objmap(dump, attr);
+        return;
+    }
+    if (0 == elem_size) {
+        printf("<%u elements>", attr->count);
+        return;
+    }
+    p = data_ptr(dump, attr->value, (uint64_t)attr->count * elem_size);
+    if (NULL == p) {
+        printf("<out of the data section>");
+        return;
+    }
+    if (TAI_ATTR_VALUE_TYPE_CHARLIST == meta->attrvaluetype) {
+        printf("\"%.*s\"", (int)attr->count, p);
+        return;
+    }
+    printf("[");
+    for (i = 0; i < attr->count; i++, p += elem_size) {
+        int32_t s32;
+        uint32_t u32;
+        int16_t s16;
+        uint16_t u16;
+        tai_float_t flt;
+        uint64_t oid;
+
+        printf(i ? ", " : "");
+        switch (meta->attrvaluetype) {
+            case TAI_ATTR_VALUE_TYPE_OBJLIST:
+                memcpy(&oid, p, sizeof(oid));
+                printf("0x%" PRIx64, oid);
+                break;
+            case TAI_ATTR_VALUE_TYPE_U8LIST:
+                printf("%u", *(const uint8_t *)p);
+                break;
+            case TAI_ATTR_VALUE_TYPE_S8LIST:
+                printf("%d", *(const int8_t *)p);
+                break;
+            case TAI_ATTR_VALUE_TYPE_U16LIST:
+                memcpy(&u16, p, sizeof(u16));
+                printf("%u", u16);
+                break;
+            case TAI_ATTR_VALUE_TYPE_S16LIST:
+                memcpy(&s16, p, sizeof(s16));
+                printf("%d", s16);
+                break;
+            case TAI_ATTR_VALUE_TYPE_U32LIST:
+                memcpy(&u32, p, sizeof(u32));
+                printf("%u", u32);
+                break;
+            case TAI_ATTR_VALUE_TYPE_S32LIST:
+                memcpy(&s32, p, sizeof(s32));
+                if (NULL != meta->enummetadata) {
+                    print_enum(meta->enummetadata, s32);
+                } else {
+                    printf("%d", s32);
+                }
+                break;
+            case TAI_ATTR_VALUE_TYPE_FLOATLIST:
+                memcpy(&flt, p, sizeof(flt));
+                printf("%g", flt);
+                break;
+            default:
+                break;
+        }
+    }
+    printf("]");
+}
+
+/**
+ * @brief Print the value of an attribute
+ */
+static void print_value(
+    const dump_t              *dump,
+    const tai_attr_metadata_t *meta,
+    const stub_dump_attr_t    *attr)
+{
+    tai_attribute_value_t value;
+    const char *p;
+
+    if (TAI_META_IS_LIST(meta)) {
+        print_list(dump, meta, attr);
+        return;
+    }
+    if (TAI_ATTR_VALUE_TYPE_CHARDATA == meta->attrvaluetype) {
+        p = data_ptr(dump, attr->value, attr->count);
+        printf("\"%.*s\"", p ? (int)attr->count : 0, p ? p : "");
+        return;
+    }
+    memset(&value, 0, sizeof(value));
+    memcpy(&value, &attr->value, sizeof(attr->value));
+    switch (meta->attrvaluetype) {
+        case TAI_ATTR_VALUE_TYPE_BOOLDATA:
+            printf("%s", value.booldata ? "true" : "false");
+            break;
+        case TAI_ATTR_VALUE_TYPE_U8:  printf("%u", value.u8); break;
+        case TAI_ATTR_VALUE_TYPE_S8:  printf("%d", value.s8); break;
+        case TAI_ATTR_VALUE_TYPE_U16: printf("%u", value.u16); break;
+        case TAI_ATTR_VALUE_TYPE_S16: printf("%d", value.s16); break;
+        case TAI_ATTR_VALUE_TYPE_U32: printf("%u", value.u32); break;
+        case TAI_ATTR_VALUE_TYPE_S32:
+            if (NULL != meta->enummetadata) {
+                print_enum(meta->enummetadata, value.s32);
+            } else {
+                printf("%d", value.s32);
+            }
+            break;
+        case TAI_ATTR_VALUE_TYPE_U64: printf("%" PRIu64, value.u64); break;
+        case TAI_ATTR_VALUE_TYPE_S64: printf("%" PRId64, value.s64); break;
+        case TAI_ATTR_VALUE_TYPE_FLT: printf("%g", value.flt); break;
+        case TAI_ATTR_VALUE_TYPE_PTR: printf("%p", value.ptr); break;
+        case TAI_ATTR_VALUE_TYPE_OID: printf("0x%" PRIx64, value.oid); break;
+        case TAI_ATTR_VALUE_TYPE_U32RANGE:
+            printf("%u..%u", value.u32range.min, value.u32range.max);
+            break;
+        case TAI_ATTR_VALUE_TYPE_S32RANGE:
+            printf("%d..%d", value.s32range.min, value.s32range.max);
+            break;
+        default:
+            printf("0x%" PRIx64, attr->value);
+            break;
+    }
+}
+
+static void print_objects(const dump_t *dump)
+{
+    const stub_dump_header_t *hdr = dump->hdr;
+    const stub_dump_object_t *obj;
+    const stub_dump_attr_t *attr;
+    const tai_attr_metadata_t *meta;
+    uint32_t i, j;
+
+    for (i = 0; i < hdr->object_count; i++) {
+        obj = (const void *)(dump->base + hdr->objects_offset + (uint64_t)i * hdr->object_size);
+        printf("%s 0x%" PRIx64 "\n",
+               (obj->object_type < TAI_OBJECT_TYPE_MAX) ?
+               object_type_names[obj->object_type] : "unknown", obj->oid);
+        if ((obj->first_attr > hdr->attr_count) ||
+            (obj->attr_count > hdr->attr_count - obj->first_attr)) {
+            printf("  <attributes out of the table>\n");
+            continue;
+        }
+        for (j = 0; j < obj->attr_count; j++) {
+            attr = (const void *)(dump->base + hdr->attrs_offset +
+                                  (uint64_t)(obj->first_attr + j) * hdr->attr_size);
+            meta = (obj->object_type < TAI_OBJECT_TYPE_MAX) ?
+                   tai_metadata_get_attr_metadata(obj->object_type, attr->attr_id) : NULL;
+            if (NULL == meta) {
+                printf("  %u: unknown attribute\n", attr->attr_id);
+                continue;
+            }
+            printf("  %s: ", meta->attridshortname);
+            if (TAI_STATUS_SUCCESS != attr->status) {
+                printf("<status %d>", attr->status);
+            } else {
+                print_value(dump, meta, attr);
+            }
+            printf("\n");
+        }
+    }
+}
+
+static void print_logs(const dump_t *dump)
+{
+    const stub_dump_header_t *hdr = dump->hdr;
+    const stub_dump_log_t *log;
+    const char *msg;
+    uint32_t i;
+
+    printf("log records written %" PRIu64 " dropped %" PRIu64 ", last %u:\n",
+           hdr->log_written, hdr->log_dropped, hdr->log_count);
+    for (i = 0; i < hdr->log_count; i++) {
+        log = (const void *)(dump->base + hdr->logs_offset + (uint64_t)i * hdr->log_size);
+        msg = data_ptr(dump, log->msg_offset, 1);
+        if ((NULL == msg) ||
+            (NULL == memchr(msg, '\0', hdr->data_size - log->msg_offset))) {
+            msg = "<out of the data section>";
+        }
+        printf("%" PRIu64 ".%09" PRIu64 " %u %s %s %s\n",
+               log->timestamp / 1000000000, log->timestamp % 1000000000, log->tid,
+               (log->api < TAI_API_MAX) ? api_names[log->api] : "unknown",
+               (log->level < TAI_LOG_LEVEL_MAX) ? level_names[log->level] : "unknown",
+               msg);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    struct stat st;
+    dump_t dump;
+    void *base;
+    int fd, ret;
+
+    if (argc != 2) {
+        fprintf(stderr, "Usage: %s <dump file>\n", argv[0]);
+        return 1;
+    }
+    fd = open(argv[1], O_RDONLY);
+    if (fd < 0) {
+        fprintf(stderr, "%s: %s\n", argv[1], strerror(errno));
+        return 1;
+    }
+    if ((0 != fstat(fd, &st)) || (0 == st.st_size)) {
+        fprintf(stderr, "%s: empty or unreadable\n", argv[1]);
+        close(fd);
+        return 1;
+    }
+    base = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (MAP_FAILED == base) {
+        fprintf(stderr, "%s: %s\n", argv[1], strerror(errno));
+        return 1;
+    }
+    dump.base = base;
+    dump.size = st.st_size;
+    dump.hdr = base;
+
+    ret = check_dump(&dump);
+    if (0 == ret) {
+        printf("TAI stub dump version %u.%u, taken at %" PRIu64 ".%09" PRIu64 "\n",
+               dump.hdr->version_major, dump.hdr->version_minor,
+               dump.hdr->timestamp / 1000000000, dump.hdr->timestamp % 1000000000);
+        printf("%u objects, %u attributes\n", dump.hdr->object_count,
+               dump.hdr->attr_count);
+        /* since version 1.1 */
+        if (dump.hdr->header_size >= sizeof(stub_dump_header_t)) {
+            printf("attribute cache hits %" PRIu64 " misses %" PRIu64 "\n",
+                   dump.hdr->cache_hits, dump.hdr->cache_misses);
+        }
+        print_objects(&dump);
+        print_logs(&dump);
+    }
+    munmap(base, st.st_size);
+    return ret ? 1 : 0;
+}
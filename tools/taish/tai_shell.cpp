@@ -15,6 +15,8 @@
 #include <iostream>
 #include <sstream>
 #include <map>
+#include <set>
+#include <unordered_map>
 #include <vector>
 #include <thread>
 
@@ -38,6 +40,7 @@
 #include <arpa/inet.h>
 
 #include "tai.h"
+#include "taimetadata.h"
 #include "tai_shell.hpp"
 #include "tai_shell.h"
 
@@ -69,7 +72,9 @@ std::map<std::string, tai_command_fn> tai_cli_shell::cmd2handler = {
    {"exit", tai_command_quit},
    {"logset", tai_command_logset},
    {"set_netif_attr", tai_command_set_netif_attr},
-   {"module_list", tai_command_module_list}
+   {"module_list", tai_command_module_list},
+   {"dump", tai_command_dump},
+   {"tributary_mapping", tai_command_tributary_mapping}
 };
 
 std::vector <std::string> help_msgs = {
@@ -80,8 +85,10 @@ std::vector <std::string> help_msgs = {
   {"quit  : Quit this session.\n"},
   {"exit  : Exit this session.\n"},
   {"logset: Set log level.: Usage: logset [module|hostif|networkif] [debug|info|notice|warn|error|critical] \n"},
-  {"set_netif_attr: Set netif attribute. : Usage: set_netif_attr <module-id> <attr-id> <attr-val> \n"},
+  {"set_netif_attr: Set netif attribute. : Usage: set_netif_attr <module-id|all> <attr-id> <attr-val> \n"},
   {"module_list: Show the module ID.\n"},
+  {"dump  : Write a binary dump of the adapter state.: Usage: dump <file name> \n"},
+  {"tributary_mapping: Show the tributary mapping of a module.: Usage: tributary_mapping <module-id> [<netif-id>|<hostif-id>] \n"},
 };
 
 tai_module_api_t *module_api;
@@ -92,9 +99,202 @@ int fd;
 std::queue<std::pair<bool, std::string>> q;
 std::mutex m;
 
+/*
+ * Set one attribute on every network interface in 'ids'. When the adapter
+ * provides the bulk API a single call covers all of them.
+ */
+int set_netif_attribute_bulk(const std::vector<tai_object_id_t>& ids, tai_attr_id_t attr_id, tai_attribute_value_t attr_val) {
+    tai_attribute_t attr;
+
+    attr.id = attr_id;
+    attr.value = attr_val;
+
+    if ( ids.empty() ) {
+        return 0;
+    }
+
+    if ( netif_api->bulk_set_network_interface_attributes != nullptr ) {
+        std::vector<const tai_attribute_t*> lists(ids.size(), &attr);
+        std::vector<uint32_t> counts(ids.size(), 1);
+        std::vector<tai_status_t> statuses(ids.size());
+
+        auto status = netif_api->bulk_set_network_interface_attributes(ids.size(), ids.data(), counts.data(), lists.data(),
+                                                                       TAI_BULK_OP_ERROR_MODE_IGNORE_ERROR,
+                                                                       statuses.data());
+        if (status != TAI_STATUS_SUCCESS) {
+            throw std::runtime_error("failed to set netif attribute");
+        }
+        return 0;
+    }
+
+    for (tai_object_id_t id : ids) {
+        auto status = netif_api->set_network_interface_attributes (id, 1, &attr);
+        if (status != TAI_STATUS_SUCCESS) {
+            throw std::runtime_error("failed to set netif attribute");
+        }
+    }
+    return 0;
+}
+
+/*
+ * Network interface attributes whose setting changes the tributary mapping.
+ */
+static bool netif_attr_affects_tributary_mapping(tai_attr_id_t attr_id) {
+    return attr_id == TAI_NETWORK_INTERFACE_ATTR_MODULATION_FORMAT;
+}
+
+/*
+ * Modules whose tributary mapping the adapter reported as changed. Written by
+ * the notification, from any thread, and consumed by the module's index.
+ */
+static std::mutex tributary_mutex;
+static std::set<tai_object_id_t> tributary_stale;
+
+/*
+ * Host side index of TAI_MODULE_ATTR_TRIBUTARY_MAPPING in both directions.
+ * The mapping is read once, and read again only after the index was
+ * invalidated; the entries which did not change are kept as they are.
+ */
+class tributary_index {
+    public:
+        tributary_index(tai_object_id_t module_id) : m_id(module_id), m_valid(false) {}
+        void invalidate() { m_valid = false; }
+        int refresh();
+        const std::unordered_map<tai_object_id_t, std::vector<tai_object_id_t>>& netif2hostifs() const { return m_netif2hostifs; }
+        const std::unordered_map<tai_object_id_t, tai_object_id_t>& hostif2netif() const { return m_hostif2netif; }
+    private:
+        int read(std::map<tai_object_id_t, std::vector<tai_object_id_t>>& mapping);
+        int read_buffered(std::map<tai_object_id_t, std::vector<tai_object_id_t>>& mapping);
+        void erase_netif(tai_object_id_t netif);
+        tai_object_id_t m_id;
+        bool m_valid;
+        std::unordered_map<tai_object_id_t, std::vector<tai_object_id_t>> m_netif2hostifs;
+        std::unordered_map<tai_object_id_t, tai_object_id_t> m_hostif2netif;
+};
+
+/*
+ * Read the whole mapping in lists the adapter allocates, with a single call,
+ * or with the two-call list protocol if the adapter has no alloc get.
+ */
+int tributary_index::read(std::map<tai_object_id_t, std::vector<tai_object_id_t>>& mapping) {
+    tai_attribute_t attr;
+
+    if ( module_api->get_module_attributes_alloc == nullptr ||
+         module_api->free_module_attributes == nullptr ) {
+        return read_buffered(mapping);
+    }
+    attr.id = TAI_MODULE_ATTR_TRIBUTARY_MAPPING;
+    if ( module_api->get_module_attributes_alloc(m_id, 1, &attr) != TAI_STATUS_SUCCESS ) {
+        return -1;
+    }
+    mapping.clear();
+    for ( uint32_t i = 0; i < attr.value.objmaplist.count; i++ ) {
+        auto &e = attr.value.objmaplist.list[i];
+        mapping[e.key].assign(e.value.list, e.value.list + e.value.count);
+    }
+    module_api->free_module_attributes(1, &attr);
+    return 0;
+}
+
+/*
+ * Read the whole mapping with the two-call list protocol. The adapter sets
+ * the count of every list which is too small, the buffers grow until it fits.
+ */
+int tributary_index::read_buffered(std::map<tai_object_id_t, std::vector<tai_object_id_t>>& mapping) {
+    std::vector<tai_object_map_t> entries;
+    std::vector<std::vector<tai_object_id_t>> values;
+    tai_attribute_t attr;
+
+    for ( int tries = 0; tries < 4; tries++ ) {
+        attr.id = TAI_MODULE_ATTR_TRIBUTARY_MAPPING;
+        attr.value.objmaplist.count = entries.size();
+        attr.value.objmaplist.list = entries.data();
+        for ( size_t i = 0; i < entries.size(); i++ ) {
+            entries[i].value.count = values[i].size();
+            entries[i].value.list = values[i].data();
+        }
+        auto status = module_api->get_module_attribute(m_id, &attr);
+        if ( status == TAI_STATUS_SUCCESS ) {
+            mapping.clear();
+            for ( uint32_t i = 0; i < attr.value.objmaplist.count; i++ ) {
+                auto &v = mapping[entries[i].key];
+                v.assign(entries[i].value.list, entries[i].value.list + entries[i].value.count);
+            }
+            return 0;
+        }
+        if ( status != TAI_STATUS_BUFFER_OVERFLOW ) {
+            return -1;
+        }
+        auto filled = std::min<size_t>(entries.size(), attr.value.objmaplist.count);
+        values.resize(attr.value.objmaplist.count);
+        for ( size_t i = 0; i < filled; i++ ) {
+            values[i].resize(std::max<size_t>(values[i].size(), entries[i].value.count));
+        }
+        entries.resize(attr.value.objmaplist.count);
+    }
+    return -1;
+}
+
+void tributary_index::erase_netif(tai_object_id_t netif) {
+    auto it = m_netif2hostifs.find(netif);
+    if ( it == m_netif2hostifs.end() ) {
+        return;
+    }
+    for ( auto hostif : it->second ) {
+        auto r = m_hostif2netif.find(hostif);
+        if ( r != m_hostif2netif.end() && r->second == netif ) {
+            m_hostif2netif.erase(r);
+        }
+    }
+    m_netif2hostifs.erase(it);
+}
+
+/*
+ * Bring the index up to date if it was invalidated, touching only the network
+ * interfaces whose host interfaces changed.
+ */
+int tributary_index::refresh() {
+    {
+        std::lock_guard<std::mutex> g(tributary_mutex);
+        if ( tributary_stale.erase(m_id) != 0 ) {
+            m_valid = false;
+        }
+    }
+    if ( m_valid ) {
+        return 0;
+    }
+
+    std::map<tai_object_id_t, std::vector<tai_object_id_t>> mapping;
+    if ( read(mapping) != 0 ) {
+        return -1;
+    }
+    std::vector<tai_object_id_t> gone;
+    for ( auto &e : m_netif2hostifs ) {
+        if ( mapping.find(e.first) == mapping.end() ) {
+            gone.push_back(e.first);
+        }
+    }
+    for ( auto netif : gone ) {
+        erase_netif(netif);
+    }
+    for ( auto &e : mapping ) {
+        auto it = m_netif2hostifs.find(e.first);
+        if ( it != m_netif2hostifs.end() && it->second == e.second ) {
+            continue;
+        }
+        erase_netif(e.first);
+        for ( auto hostif : e.second ) {
+            m_hostif2netif[hostif] = e.first;
+        }
+        m_netif2hostifs[e.first] = e.second;
+    }
+    m_valid = true;
+    return 0;
+}
+
 class module {
     public:
-        module(tai_object_id_t id) : m_id(id) {
+        module(tai_object_id_t id) : m_id(id), m_tributary(id) {
             std::vector<tai_attribute_t> list;
             tai_attribute_t attr;
             attr.id = TAI_MODULE_ATTR_NUM_HOST_INTERFACES;
@@ -108,11 +308,23 @@ class module {
             std::cout << "num hostif: " << list[0].value.u32 << std::endl;
             std::cout << "num netif: " << list[1].value.u32 << std::endl;
             create_hostif(list[0].value.u32);
-            create_netif(list[1].value.u32);
+            try {
+                create_netif(list[1].value.u32);
+            } catch (...) {
+                // the destructor does not run for a module failing here
+                for ( auto created : hostifs ) {
+                    hostif_api->remove_host_interface(created);
+                }
+                throw;
+            }
         }
+        ~module();
         int set_netif_attribute(tai_attr_id_t id, tai_attribute_value_t val);
+        const std::vector<tai_object_id_t>& netif_ids() const { return netifs; }
+        tributary_index& tributary() { return m_tributary; }
     private:
         tai_object_id_t m_id;
+        tributary_index m_tributary;
         std::vector<tai_object_id_t> netifs;
         std::vector<tai_object_id_t> hostifs;
         int create_hostif(uint32_t num);
@@ -121,6 +333,39 @@ class module {
 };
 
 int module::create_netif(uint32_t num) {
+    if ( num == 0 ) {
+        return 0;
+    }
+    if ( netif_api->bulk_create_network_interface != nullptr ) {
+        std::vector<tai_attribute_t> attrs(num);
+        std::vector<const tai_attribute_t*> lists(num);
+        std::vector<uint32_t> counts(num, 1);
+        std::vector<tai_object_id_t> ids(num);
+        std::vector<tai_status_t> statuses(num, TAI_STATUS_NOT_EXECUTED);
+
+        for ( uint32_t i = 0; i < num; i++ ) {
+            attrs[i].id = TAI_NETWORK_INTERFACE_ATTR_INDEX;
+            attrs[i].value.u32 = i;
+            lists[i] = &attrs[i];
+        }
+        auto status = netif_api->bulk_create_network_interface(m_id, num, counts.data(), lists.data(),
+                                                               TAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR,
+                                                               ids.data(), statuses.data());
+        if ( status != TAI_STATUS_SUCCESS ) {
+            // the objects created before the failing one are left to us
+            for ( uint32_t i = 0; i < num; i++ ) {
+                if ( statuses[i] == TAI_STATUS_SUCCESS ) {
+                    netif_api->remove_network_interface(ids[i]);
+                }
+            }
+            throw std::runtime_error("failed to create network interface");
+        }
+        for ( auto id : ids ) {
+            std::cout << "netif: " << id << std::endl;
+            netifs.push_back(id);
+        }
+        return 0;
+    }
     for ( int i = 0; i < num; i++ ) {
         tai_object_id_t id;
         std::vector<tai_attribute_t> list;
@@ -132,6 +377,10 @@ int module::create_netif(uint32_t num) {
 
         auto status = netif_api->create_network_interface(&id, m_id, list.size(), list.data());
         if ( status != TAI_STATUS_SUCCESS ) {
+            for ( auto created : netifs ) {
+                netif_api->remove_network_interface(created);
+            }
+            netifs.clear();
             throw std::runtime_error("failed to create network interface");
         }
         std::cout << "netif: " << id << std::endl;
@@ -141,6 +390,39 @@ int module::create_netif(uint32_t num) {
 }
 
 int module::create_hostif(uint32_t num) {
+    if ( num == 0 ) {
+        return 0;
+    }
+    if ( hostif_api->bulk_create_host_interface != nullptr ) {
+        std::vector<tai_attribute_t> attrs(num);
+        std::vector<const tai_attribute_t*> lists(num);
+        std::vector<uint32_t> counts(num, 1);
+        std::vector<tai_object_id_t> ids(num);
+        std::vector<tai_status_t> statuses(num, TAI_STATUS_NOT_EXECUTED);
+
+        for ( uint32_t i = 0; i < num; i++ ) {
+            attrs[i].id = TAI_HOST_INTERFACE_ATTR_INDEX;
+            attrs[i].value.u32 = i;
+            lists[i] = &attrs[i];
+        }
+        auto status = hostif_api->bulk_create_host_interface(m_id, num, counts.data(), lists.data(),
+                                                             TAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR,
+                                                             ids.data(), statuses.data());
+        if ( status != TAI_STATUS_SUCCESS ) {
+            // the objects created before the failing one are left to us
+            for ( uint32_t i = 0; i < num; i++ ) {
+                if ( statuses[i] == TAI_STATUS_SUCCESS ) {
+                    hostif_api->remove_host_interface(ids[i]);
+                }
+            }
+            throw std::runtime_error("failed to create host interface");
+        }
+        for ( auto id : ids ) {
+            std::cout << "hostif: " << id << std::endl;
+            hostifs.push_back(id);
+        }
+        return 0;
+    }
     for ( int i = 0; i < num; i++ ) {
         tai_object_id_t id;
         std::vector<tai_attribute_t> list;
@@ -150,6 +432,10 @@ int module::create_hostif(uint32_t num) {
         list.push_back(attr);
         auto status = hostif_api->create_host_interface(&id, m_id, list.size(), list.data());
         if ( status != TAI_STATUS_SUCCESS ) {
+            for ( auto created : hostifs ) {
+                hostif_api->remove_host_interface(created);
+            }
+            hostifs.clear();
             throw std::runtime_error("failed to create host interface");
         }
         std::cout << "hostif: " << id << std::endl;
@@ -158,21 +444,26 @@ int module::create_hostif(uint32_t num) {
     return 0;
 }
 
-int module::set_netif_attribute(tai_attr_id_t attr_id, tai_attribute_value_t attr_val) {
-    for (tai_object_id_t id : netifs) {
-        std::vector<tai_attribute_t> list;
-        tai_attribute_t attr;
-
-        attr.id = attr_id;
-        attr.value = attr_val; 
-        list.push_back(attr);
+/*
+ * The module was removed from the chassis, its interfaces go first.
+ */
+module::~module() {
+    for ( auto id : hostifs ) {
+        hostif_api->remove_host_interface(id);
+    }
+    for ( auto id : netifs ) {
+        netif_api->remove_network_interface(id);
+    }
+    module_api->remove_module(m_id);
+    std::lock_guard<std::mutex> g(tributary_mutex);
+    tributary_stale.erase(m_id);
+}
 
-        auto status = netif_api->set_network_interface_attributes (id, list.size(), list.data());
-        if (status != TAI_STATUS_SUCCESS) {
-            throw std::runtime_error("failed to set netif attribute");
-        }
+int module::set_netif_attribute(tai_attr_id_t attr_id, tai_attribute_value_t attr_val) {
+    if ( netif_attr_affects_tributary_mapping(attr_id) ) {
+        m_tributary.invalidate();
     }
-    return 0;
+    return set_netif_attribute_bulk(netifs, attr_id, attr_val);
 }
 
 int module::loop() {
@@ -182,12 +473,56 @@ int module::loop() {
 std::map<tai_object_id_t, module*> modules;
 
 void module_presence(bool present, char* location) {
-    uint64_t v;
-    std::lock_guard<std::mutex> g(m);
-    q.push(std::pair<bool, std::string>(present, std::string(location)));
+    uint64_t v = 1;
+    {
+        std::lock_guard<std::mutex> g(m);
+        q.push(std::pair<bool, std::string>(present, std::string(location)));
+    }
+    write(fd, &v, sizeof(uint64_t));
+}
+
+/*
+ * A burst of presence changes costs one lock and one eventfd write.
+ */
+void module_presence_batch(uint32_t count, const tai_module_presence_event_t *events) {
+    uint64_t v = 1;
+    {
+        std::lock_guard<std::mutex> g(m);
+        for (uint32_t i = 0; i < count; i++) {
+            q.push(std::pair<bool, std::string>(events[i].present, std::string(events[i].module_location)));
+        }
+    }
     write(fd, &v, sizeof(uint64_t));
 }
 
+void module_shutdown_request(tai_object_id_t module_id) {
+    std::cout << "shutdown request: module id: " << module_id << std::endl;
+}
+
+void module_state_change(tai_object_id_t module_id, tai_module_oper_status_t status) {
+    std::cout << "state change: module id: " << module_id << ", status: " << status << std::endl;
+}
+
+void module_threshold_alarm(tai_object_id_t module_id, const tai_threshold_alarm_t *alarm) {
+    std::cout << "threshold alarm: module id: " << module_id << ", object id: " << alarm->object_id
+              << ", attr: " << alarm->attr_id
+              << (alarm->type == TAI_THRESHOLD_ALARM_TYPE_HIGH ? ", high" : ", low")
+              << (alarm->raised ? " raised" : " cleared")
+              << ", value: " << alarm->value << std::endl;
+}
+
+void module_tributary_mapping_change(tai_object_id_t module_id) {
+    std::lock_guard<std::mutex> g(tributary_mutex);
+    tributary_stale.insert(module_id);
+}
+
+tai_module_notification_t module_notifications = {
+    .shutdown_request         = module_shutdown_request,
+    .state_change             = module_state_change,
+    .threshold_alarm          = module_threshold_alarm,
+    .tributary_mapping_change = module_tributary_mapping_change,
+};
+
 tai_status_t create_module(const std::string& location, tai_object_id_t& m_id) {
     std::vector<tai_attribute_t> list;
     tai_attribute_t attr;
@@ -195,7 +530,7 @@ tai_status_t create_module(const std::string& location, tai_object_id_t& m_id) {
     attr.value.charlist.count = location.size();
     attr.value.charlist.list = (char*)location.c_str();
     list.push_back(attr);
-    return module_api->create_module(&m_id, list.size(), list.data(), nullptr);
+    return module_api->create_module(&m_id, list.size(), list.data(), &module_notifications);
 }
 
 #if defined(TAISH_API_MODE)
@@ -262,28 +597,39 @@ int main(int argc, char *argv[])
         }
         if (fds[0].revents == POLLIN) {
             uint64_t v;
+            std::queue<std::pair<bool, std::string>> events;
             pthread_mutex_lock (&tai_shell_mutex);
             read(fds[0].fd, &v, sizeof(uint64_t));
             {
+                /* take every pending event, the adapter is not held up while they are handled */
                 std::lock_guard<std::mutex> g(m);
-                while ( ! q.empty() ) {
-                    auto p = q.front();
-                    std::cout << "present: " << p.first << ", loc: " << p.second << std::endl;
-                    if ( p.first ) {
-                        tai_object_id_t m_id;
-                        auto status = create_module(p.second, m_id);
-                        if ( status != TAI_STATUS_SUCCESS ) {
-                            std::cerr << "failed to create module: " << status << std::endl;
-                            return 1;
-                        }
-                        std::cout << "module id: " << m_id << std::endl;
-
-                        modules[m_id] = new module(m_id);
-                        location2module_id.insert(std::pair<std::string, tai_object_id_t>(p.second, m_id));
+                std::swap(events, q);
+            }
+            while ( ! events.empty() ) {
+                auto p = events.front();
+                std::cout << "present: " << p.first << ", loc: " << p.second << std::endl;
+                auto loc2mod = location2module_id.find(p.second);
+                if ( p.first && loc2mod == location2module_id.end() ) {
+                    tai_object_id_t m_id;
+                    auto status = create_module(p.second, m_id);
+                    if ( status != TAI_STATUS_SUCCESS ) {
+                        std::cerr << "failed to create module: " << status << std::endl;
+                        return 1;
                     }
+                    std::cout << "module id: " << m_id << std::endl;
+
+                    modules[m_id] = new module(m_id);
+                    location2module_id.insert(std::pair<std::string, tai_object_id_t>(p.second, m_id));
                     no_of_mods++;
-                    q.pop();
+                } else if ( ! p.first && loc2mod != location2module_id.end() ) {
+                    /* the module was pulled out, its objects are stale */
+                    std::cout << "module id: " << loc2mod->second << " removed" << std::endl;
+                    delete modules[loc2mod->second];
+                    modules.erase(loc2mod->second);
+                    location2module_id.erase(loc2mod);
+                    no_of_mods--;
                 }
+                events.pop();
             }
             pthread_mutex_unlock (&tai_shell_mutex);
         }
@@ -519,7 +865,7 @@ int tai_command_load (std::ostream *ostr, std::vector <std::string> *args) {
 }
 
 int tai_command_init (std::ostream *ostr, std::vector <std::string> *args) {
-  tai_service_method_table_t services;
+  tai_service_method_table_t services = {};
 
   if (args->size() != 1) {
     *ostr << "%% Invalid parameters" << std::endl;
@@ -532,6 +878,7 @@ int tai_command_init (std::ostream *ostr, std::vector <std::string> *args) {
   }
 
   services.module_presence = module_presence;
+  services.module_presence_batch = module_presence_batch;
 
   if (p_tai_api->log_set) {
     for (auto i = 0; i < TAI_API_MAX; i++) {
@@ -638,22 +985,155 @@ int tai_command_logset (std::ostream *ostr, std::vector <std::string> *args) {
   return 0;
 }
 
+/*
+ * Attribute names accepted by set_netif_attr besides the metadata short names.
+ */
+static const std::map<std::string, std::string> netif_attr_aliases = {
+  {"tx-grid", "tx-grid-spacing"},
+  {"tx-laser-freq", "tx-fine-tune-laser-freq"},
+  {"modulation", "modulation-format"},
+};
+
+static std::string enum_key (const std::string &name) {
+  std::string key;
+  for (auto c : name) {
+    if (isalnum(c)) {
+      key += tolower(c);
+    }
+  }
+  return key;
+}
+
+/*
+ * Look up an enum value by its short name. Separators and case are ignored
+ * and the name may be abbreviated as long as it is unambiguous, so "dp-16qam"
+ * and "12.5" select DP_16_QAM and 12_5_GHZ.
+ */
+static int parse_enum_value (const tai_enum_metadata_t *meta, const std::string &str, int32_t *value) {
+  auto key = enum_key(str);
+  int match = -1;
+
+  if (key.empty()) {
+    return -1;
+  }
+  for (size_t i = 0; i < meta->valuescount; i++) {
+    auto name = enum_key(meta->valuesshortnames[i]);
+    if (name == key) {
+      *value = meta->values[i];
+      return 0;
+    }
+    if (name.compare(0, key.size(), key) == 0) {
+      match = (match == -1) ? i : -2;
+    }
+  }
+  if (match < 0) {
+    return -1;
+  }
+  *value = meta->values[match];
+  return 0;
+}
+
+static std::string attr_value_help (const tai_attr_metadata_t *meta) {
+  std::string help;
+
+  if (meta->enummetadata != nullptr) {
+    for (size_t i = 0; i < meta->enummetadata->valuescount; i++) {
+      help += (i == 0 ? "" : ", ");
+      help += meta->enummetadata->valuesshortnames[i];
+    }
+    return help;
+  }
+  switch (meta->attrvaluetype) {
+  case TAI_ATTR_VALUE_TYPE_BOOLDATA:
+    return "true or false";
+  case TAI_ATTR_VALUE_TYPE_FLT:
+    return "float";
+  case TAI_ATTR_VALUE_TYPE_U8:
+  case TAI_ATTR_VALUE_TYPE_S8:
+  case TAI_ATTR_VALUE_TYPE_U16:
+  case TAI_ATTR_VALUE_TYPE_S16:
+  case TAI_ATTR_VALUE_TYPE_U32:
+  case TAI_ATTR_VALUE_TYPE_S32:
+  case TAI_ATTR_VALUE_TYPE_U64:
+  case TAI_ATTR_VALUE_TYPE_S64:
+    return "integer";
+  default:
+    return "not supported";
+  }
+}
+
+/*
+ * Convert 'str' to the union member the metadata of the attribute names.
+ */
+static int parse_attr_value (const tai_attr_metadata_t *meta, const std::string &str, tai_attribute_value_t *value) {
+  try {
+    switch (meta->attrvaluetype) {
+    case TAI_ATTR_VALUE_TYPE_BOOLDATA:
+      if (str == "true") {
+        value->booldata = true;
+      } else if (str == "false") {
+        value->booldata = false;
+      } else {
+        return -1;
+      }
+      return 0;
+    case TAI_ATTR_VALUE_TYPE_U8:
+      value->u8 = std::stoul(str, nullptr, 10);
+      return 0;
+    case TAI_ATTR_VALUE_TYPE_S8:
+      value->s8 = std::stol(str, nullptr, 10);
+      return 0;
+    case TAI_ATTR_VALUE_TYPE_U16:
+      value->u16 = std::stoul(str, nullptr, 10);
+      return 0;
+    case TAI_ATTR_VALUE_TYPE_S16:
+      value->s16 = std::stol(str, nullptr, 10);
+      return 0;
+    case TAI_ATTR_VALUE_TYPE_U32:
+      value->u32 = std::stoul(str, nullptr, 10);
+      return 0;
+    case TAI_ATTR_VALUE_TYPE_S32:
+      if (meta->enummetadata != nullptr) {
+        return parse_enum_value(meta->enummetadata, str, &value->s32);
+      }
+      value->s32 = std::stol(str, nullptr, 10);
+      return 0;
+    case TAI_ATTR_VALUE_TYPE_U64:
+      value->u64 = std::stoull(str, nullptr, 10);
+      return 0;
+    case TAI_ATTR_VALUE_TYPE_S64:
+      value->s64 = std::stoll(str, nullptr, 10);
+      return 0;
+    case TAI_ATTR_VALUE_TYPE_FLT:
+      value->flt = std::stof(str, nullptr);
+      return 0;
+    default:
+      return -1;
+    }
+  } catch (const std::exception &e) {
+    return -1;
+  }
+}
+
 int tai_command_set_netif_attr (std::ostream *ostr, std::vector <std::string> *args) {
-  tai_object_id_t id;  
+  tai_object_id_t id = TAI_NULL_OBJECT_ID;
+  bool all = false;
   tai_attr_id_t attr;
   tai_attribute_value_t attr_val;
+  const tai_attr_metadata_t *meta;
 
   if (args->size() == 1) {
     *ostr << "Usage: set_netif_attr <module-id> <attr-id> <attr-val>" << std::endl;
-    *ostr << "    <module-id>: integer." << std::endl;
-    *ostr << "    <attr-id> : tx-enable, tx-grid, tx-channel, output-power, tx-laser-freq, modulation or differential-encoding." << std::endl;
-    *ostr << "    <attr-val> :  tx-enable: true or false" << std::endl;
-    *ostr << "                  tx-grid: 100, 50, 33, 25, 12.5 or 6.25" << std::endl;
-    *ostr << "                  tx-channel: integer" << std::endl;
-    *ostr << "                  output-power: float" << std::endl;
-    *ostr << "                  tx-laser-freq: integer" << std::endl;
-    *ostr << "                  modulation: bpsk, dp-bpsk, qpsk, dp-qpsk, 8qam, dp-8qam, 16qam, dp-16qam, 32qam, dp-32qam, 64qam or dp-64qam" << std::endl;
-    *ostr << "                  differential-encoding: true or false" << std::endl;
+    *ostr << "    <module-id>: integer, or all to set every network interface of the chassis." << std::endl;
+    *ostr << "    <attr-id> <attr-val>:" << std::endl;
+    for (attr = 0; attr < tai_metadata_attr_by_object_type_count[TAI_OBJECT_TYPE_NETWORKIF]; attr++) {
+      meta = tai_metadata_get_attr_metadata(TAI_OBJECT_TYPE_NETWORKIF, attr);
+      if (meta == nullptr || TAI_META_IS_READ_ONLY(meta) || TAI_META_IS_CREATE_ONLY(meta)) {
+        continue;
+      }
+      *ostr << "        " << meta->attridshortname << ": " << attr_value_help(meta) << std::endl;
+    }
+    *ostr << "    tx-grid, tx-laser-freq and modulation are aliases of tx-grid-spacing, tx-fine-tune-laser-freq and modulation-format." << std::endl;
     return -1;
   }
 
@@ -667,114 +1147,51 @@ int tai_command_set_netif_attr (std::ostream *ostr, std::vector <std::string> *a
     return -1;
   }
 
-  id = std::stoull((*args)[1], nullptr, 10);
-  if (modules[id] == nullptr) {
-    *ostr << "%% Invalid module ID" << std::endl;
-    return -1;
+  if ((*args)[1] == "all") {
+    all = true;
+  } else {
+    id = std::stoull((*args)[1], nullptr, 10);
+    if (modules[id] == nullptr) {
+      *ostr << "%% Invalid module ID" << std::endl;
+      return -1;
+    }
   }
 
   auto com = (*args)[2];
-  if (com == "tx-enable") {
-    attr = TAI_NETWORK_INTERFACE_ATTR_TX_ENABLE;
-  } else if (com == "tx-grid") {
-    attr = TAI_NETWORK_INTERFACE_ATTR_TX_GRID_SPACING;
-  } else if (com == "tx-channel") {
-    attr = TAI_NETWORK_INTERFACE_ATTR_TX_CHANNEL;
-  } else if (com == "output-power") {
-    attr = TAI_NETWORK_INTERFACE_ATTR_OUTPUT_POWER;
-  } else if (com == "tx-laser-freq") {
-    attr = TAI_NETWORK_INTERFACE_ATTR_TX_FINE_TUNE_LASER_FREQ;
-  } else if (com == "modulation") {
-    attr = TAI_NETWORK_INTERFACE_ATTR_MODULATION_FORMAT;
-  } else if (com == "differential-encoding") { 
-    attr = TAI_NETWORK_INTERFACE_ATTR_DIFFERENTIAL_ENCODING;
-  } else {
-    *ostr << "Invalid attribute (tx-enable, tx-grid, tx-channel, output-power, tx-laser-freq, modulation or differential-encoding)" << std::endl;
+  auto alias = netif_attr_aliases.find(com);
+  if (alias != netif_attr_aliases.end()) {
+    com = alias->second;
+  }
+  meta = tai_metadata_get_attr_metadata_by_short_name(TAI_OBJECT_TYPE_NETWORKIF, com.c_str());
+  if (meta == nullptr) {
+    *ostr << "%% Invalid attribute (set_netif_attr with no argument lists them)" << std::endl;
+    return -1;
+  }
+  if (TAI_META_IS_READ_ONLY(meta) || TAI_META_IS_CREATE_ONLY(meta)) {
+    *ostr << "%% " << meta->attridshortname << " can not be set" << std::endl;
     return -1;
   }
+  attr = meta->attrid;
 
-  if (attr == TAI_NETWORK_INTERFACE_ATTR_TX_ENABLE) {
-    auto val = (*args)[3];
-    if (val == "true") {
-      attr_val.booldata = true;
-    } else if (val == "false") {
-      attr_val.booldata = false;
-    } else {
-      *ostr << "%% Invalid argument (true or false)" << std::endl;
-      return -1;
-    }
-  } else if (attr == TAI_NETWORK_INTERFACE_ATTR_TX_GRID_SPACING) {
-    auto val = (*args)[3];
-    if (val == "100") {
-      attr_val.u32 = TAI_NETWORK_INTERFACE_TX_GRID_SPACING_100_GHZ;
-    } else if (val == "50") {
-      attr_val.u32 = TAI_NETWORK_INTERFACE_TX_GRID_SPACING_50_GHZ;
-    } else if (val == "33") {
-      attr_val.u32 = TAI_NETWORK_INTERFACE_TX_GRID_SPACING_33_GHZ;
-    } else if (val == "25") {
-      attr_val.u32 = TAI_NETWORK_INTERFACE_TX_GRID_SPACING_25_GHZ;
-    } else if (val == "12.5") {
-      attr_val.u32 = TAI_NETWORK_INTERFACE_TX_GRID_SPACING_12_5_GHZ;
-    } else if (val == "6.25") {
-      attr_val.u32 = TAI_NETWORK_INTERFACE_TX_GRID_SPACING_6_25_GHZ;
-    } else {
-      *ostr << "%% Invalid argument (100, 50, 33, 25, 12.5 or 6.25" << std::endl;
-      return -1;
-    }
-  } else if (attr == TAI_NETWORK_INTERFACE_ATTR_TX_CHANNEL) {
-    auto val = std::stoi((*args)[3], nullptr, 10);
-    attr_val.u16 = val;
-  } else if (attr == TAI_NETWORK_INTERFACE_ATTR_OUTPUT_POWER) {
-    auto val = std::stof((*args)[3], nullptr);
-    attr_val.flt = val;
-  } else if (attr == TAI_NETWORK_INTERFACE_ATTR_TX_FINE_TUNE_LASER_FREQ) {
-    auto val = std::stoull((*args)[3], nullptr, 10);
-    attr_val.u64 = val;
-  } else if (attr == TAI_NETWORK_INTERFACE_ATTR_MODULATION_FORMAT) {
-    auto val = (*args)[3];
-    if (val == "bpsk") {
-      attr_val.u32 = TAI_NETWORK_INTERFACE_MODULATION_FORMAT_BPSK;
-    } else if (val == "dp-bpsk") {
-      attr_val.u32 = TAI_NETWORK_INTERFACE_MODULATION_FORMAT_DP_BPSK;
-    } else if (val == "qpsk") {
-      attr_val.u32 = TAI_NETWORK_INTERFACE_MODULATION_FORMAT_QPSK;
-    } else if (val == "dp-qpsk") {
-      attr_val.u32 = TAI_NETWORK_INTERFACE_MODULATION_FORMAT_DP_QPSK;
-    } else if (val == "8qam") {
-      attr_val.u32 = TAI_NETWORK_INTERFACE_MODULATION_FORMAT_8_QAM;
-    } else if (val == "dp-8qam") {
-      attr_val.u32 = TAI_NETWORK_INTERFACE_MODULATION_FORMAT_DP_8_QAM;
-    } else if (val == "16qam") {
-      attr_val.u32 = TAI_NETWORK_INTERFACE_MODULATION_FORMAT_16_QAM;
-    } else if (val == "dp-16qam") {
-      attr_val.u32 = TAI_NETWORK_INTERFACE_MODULATION_FORMAT_DP_16_QAM;
-    } else if (val == "32qam") {
-      attr_val.u32 = TAI_NETWORK_INTERFACE_MODULATION_FORMAT_32_QAM;
-    } else if (val == "dp-32qam") {
-      attr_val.u32 = TAI_NETWORK_INTERFACE_MODULATION_FORMAT_DP_32_QAM;
-    } else if (val == "64qam") {
-      attr_val.u32 = TAI_NETWORK_INTERFACE_MODULATION_FORMAT_64_QAM;
-    } else if (val == "dp-64qam") {
-      attr_val.u32 = TAI_NETWORK_INTERFACE_MODULATION_FORMAT_DP_64_QAM;
-    } else {
-      *ostr << "%% Invalid argument (bpsk, dp-bpsk, qpsk, dp-qpsk, 8qam, dp-8qam, 16qam, dp-16qam, 32qam, dp-32qam, 64qam or dp-64qam)" << std::endl;
-      return -1;
-    }
-  } else if (attr == TAI_NETWORK_INTERFACE_ATTR_DIFFERENTIAL_ENCODING) {
-    auto val = (*args)[3];
-    if (val == "true") {
-      attr_val.booldata = true;
-    } else if (val == "false") {
-      attr_val.booldata = false;
-    } else {
-      *ostr << "%% Invalid argument (true or false)" << std::endl;
-      return -1;
-    }
-  } else {
-    *ostr << "%% Invalid Attribute ID" << std::endl;
+  if (parse_attr_value(meta, (*args)[3], &attr_val) != 0) {
+    *ostr << "%% Invalid argument (" << attr_value_help(meta) << ")" << std::endl;
     return -1;
   }
 
+  if (all) {
+    std::vector<tai_object_id_t> ids;
+    for (auto &mod : modules) {
+      if (mod.second != nullptr) {
+        ids.insert(ids.end(), mod.second->netif_ids().begin(), mod.second->netif_ids().end());
+        if (netif_attr_affects_tributary_mapping(attr)) {
+          mod.second->tributary().invalidate();
+        }
+      }
+    }
+    set_netif_attribute_bulk (ids, attr, attr_val);
+    return 0;
+  }
+
   modules[id]->set_netif_attribute (attr, attr_val);
   return 0;
 }
@@ -791,6 +1208,97 @@ int tai_command_module_list (std::ostream *ostr, std::vector <std::string> *args
   return 0;
 }
 
+int tai_command_dump (std::ostream *ostr, std::vector <std::string> *args) {
+  if (args->size() != 2) {
+    *ostr << "Usage: dump <file name>" << std::endl;
+    return -1;
+  }
+
+  if (p_tai_api == nullptr) {
+    *ostr << "%% Need to load TAI library at first" << std::endl;
+    return -1;
+  }
+
+  if (p_tai_api->dbg_generate_dump == nullptr) {
+    *ostr << "%% The TAI library does not support dumps" << std::endl;
+    return -1;
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  auto status = p_tai_api->dbg_generate_dump((*args)[1].c_str());
+  auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+                   std::chrono::steady_clock::now() - start);
+  if (status != TAI_STATUS_SUCCESS) {
+    *ostr << "%% Failed to write the dump: " << status << std::endl;
+    return -1;
+  }
+  *ostr << "Dump written to " << (*args)[1] << " in " << elapsed.count() << " us" << std::endl;
+  return 0;
+}
+
+int tai_command_tributary_mapping (std::ostream *ostr, std::vector <std::string> *args) {
+  tai_object_id_t id, oid = TAI_NULL_OBJECT_ID;
+
+  if (args->size() != 2 && args->size() != 3) {
+    *ostr << "Usage: tributary_mapping <module-id> [<netif-id>|<hostif-id>]" << std::endl;
+    return -1;
+  }
+
+  if (p_tai_api == nullptr) {
+    *ostr << "%% Need to load TAI library at first" << std::endl;
+    return -1;
+  }
+
+  try {
+    id = std::stoull((*args)[1], nullptr, 10);
+    if (args->size() == 3) {
+      oid = std::stoull((*args)[2], nullptr, 10);
+    }
+  } catch (const std::exception &e) {
+    *ostr << "%% Invalid object ID" << std::endl;
+    return -1;
+  }
+  auto mod = modules.find(id);
+  if (mod == modules.end() || mod->second == nullptr) {
+    *ostr << "%% Invalid module ID" << std::endl;
+    return -1;
+  }
+
+  auto &index = mod->second->tributary();
+  if (index.refresh() != 0) {
+    *ostr << "%% Failed to read the tributary mapping" << std::endl;
+    return -1;
+  }
+
+  if (oid == TAI_NULL_OBJECT_ID) {
+    for (auto &e : index.netif2hostifs()) {
+      *ostr << "netif: " << e.first << "  hostif:";
+      for (auto hostif : e.second) {
+        *ostr << " " << hostif;
+      }
+      *ostr << std::endl;
+    }
+    return 0;
+  }
+
+  auto netif = index.netif2hostifs().find(oid);
+  if (netif != index.netif2hostifs().end()) {
+    *ostr << "hostif:";
+    for (auto hostif : netif->second) {
+      *ostr << " " << hostif;
+    }
+    *ostr << std::endl;
+    return 0;
+  }
+  auto hostif = index.hostif2netif().find(oid);
+  if (hostif != index.hostif2netif().end()) {
+    *ostr << "netif: " << hostif->second << std::endl;
+    return 0;
+  }
+  *ostr << "%% The object is not part of the tributary mapping" << std::endl;
+  return -1;
+}
+
 #if defined(TAISH_API_MODE)
 
 int tai_shell_thread (std::vector <std::string> args) {